@@ -58,6 +58,14 @@
 /*Default display refresh period. LVG will redraw changed ares with this period time*/
 #define LV_DISP_DEF_REFR_PERIOD     30      /*[ms]*/
 
+/*Number of invalidated areas to save for redrawing. If more areas are invalidated
+ *the two areas which can be joined with the fewest extra pixels are joined*/
+#define LV_INV_BUF_SIZE             64
+
+/*Cost of redrawing one more area expressed in pixels.
+ *Two areas are redrawn as one if it adds fewer extra pixels than this*/
+#define LV_REFR_AREA_COST           256     /*[px]*/
+
 /*Input device read period in milliseconds*/
 #define LV_INDEV_DEF_READ_PERIOD    30      /*[ms]*/
 
@@ -88,8 +96,13 @@
 
 /*Allow buffering some shadow calculation.
  *LV_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
- *Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
-#define LV_SHADOW_CACHE_SIZE    0
+ *A buffered shadow has shadow size^2 RAM cost. Several shadows are buffered and
+ *the least recently used ones are dropped if they need more than LV_SHADOW_CACHE_MEM_SIZE bytes*/
+#define LV_SHADOW_CACHE_SIZE        64
+#define LV_SHADOW_CACHE_MEM_SIZE    (32 * 1024U)
+
+/*1: Blur the shadows with one box blur instead of two. It's faster but the shadows are less smooth*/
+#define LV_SHADOW_BLUR_FAST         0
 #endif /*LV_DRAW_COMPLEX*/
 
 /*Default image cache size. Image caching keeps the images opened.
@@ -101,6 +114,9 @@
 
 /*Maximum buffer size to allocate for rotation. Only used if software rotation is enabled in the display driver.*/
 #define LV_DISP_ROT_MAX_BUF         (10*1024)
+
+/*Use the SIMD instructions of the CPU in the software blending: SSE2 and AVX2 on x86, NEON on ARM.*/
+#define LV_USE_DRAW_SIMD            1
 /*-------------
  * GPU
  *-----------*/
@@ -202,6 +218,12 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 
 #define LV_USE_USER_DATA      1
 
+/*Number of resolved style properties to cache per object. Must be a power of 2.
+ *It makes the `lv_obj_get_style_...()` functions faster but uses (LV_OBJ_STYLE_CACHE_SIZE * 8) bytes per object.
+ *The changes of the shared styles are seen only after `lv_obj_report_style_change()`.
+ *0: to disable caching*/
+#define LV_OBJ_STYLE_CACHE_SIZE 32
+
 /*Garbage Collector settings
  *Used if lvgl is binded to higher level language and the memory is managed by that language*/
 #define LV_ENABLE_GC 0
@@ -305,6 +327,10 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED  1
 
+/*Size of the atlas caching the decompressed glyphs of compressed fonts
+ *and the glyphs of FreeType fonts without FreeType's cache [bytes]. 0: disable the cache*/
+#define LV_FONT_GLYPH_CACHE_SIZE    (32 * 1024U)
+
 /*Enable subpixel rendering*/
 #define LV_USE_FONT_SUBPX       1
 #if LV_USE_FONT_SUBPX
@@ -387,6 +413,7 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 #if LV_USE_LABEL
 #  define LV_LABEL_TEXT_SELECTION         1   /*Enable selecting text of the label*/
 #  define LV_LABEL_LONG_TXT_HINT    1   /*Store some extra info in labels to speed up drawing of very long texts*/
+#  define LV_LABEL_LAYOUT_CACHE     0   /*Store the line breaks of the labels (6 bytes per line) to not measure the text again on every redraw*/
 #endif
 
 #define LV_USE_LINE         1
@@ -43,6 +43,7 @@
 #define LINE_POINT_DIFF_MAX LV_MAX(LV_HOR_RES / (LINE_POINT_NUM + 2), LINE_POINT_DIFF_MIN * 2)
 #define ARC_WIDTH_THIN LV_MAX(LV_DPI_DEF / 50, 2)
 #define ARC_WIDTH_THICK LV_MAX(LV_DPI_DEF / 10, 5)
+#define CARD_NUM        24
 /**********************
  *      TYPEDEFS
  **********************/
@@ -84,6 +85,9 @@ static void txt_create(lv_style_t * style);
 static void line_create(lv_style_t * style);
 static void arc_create(lv_style_t * style);
 static void fall_anim(lv_obj_t * obj);
+#if LV_USE_REFR_PARALLEL
+static void dashboard_create(uint32_t thread_cnt);
+#endif
 static void rnd_reset(void);
 static int32_t rnd_next(int32_t min, int32_t max);
 
@@ -524,6 +528,27 @@ static void sub_text_cb(void)
 }
 
 
+#if LV_USE_REFR_PARALLEL
+static void dashboard_1_thread_cb(void)
+{
+    dashboard_create(1);
+}
+
+static void dashboard_2_threads_cb(void)
+{
+    dashboard_create(2);
+}
+
+static void dashboard_4_threads_cb(void)
+{
+    dashboard_create(4);
+}
+
+static void dashboard_max_threads_cb(void)
+{
+    dashboard_create(LV_REFR_PARALLEL_THREAD_CNT);
+}
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -587,6 +612,14 @@ static scene_dsc_t scenes[] = {
         {.name = "Substr. arc",                .weight = 10, .create_cb = sub_arc_cb},
         {.name = "Substr. text",               .weight = 10, .create_cb = sub_text_cb},
 
+#if LV_USE_REFR_PARALLEL
+        /*Full screen redraw of a dashboard to see how the rendering scales with the number of threads*/
+        {.name = "Dashboard 1 thread",          .weight = 1, .create_cb = dashboard_1_thread_cb},
+        {.name = "Dashboard 2 threads",         .weight = 1, .create_cb = dashboard_2_threads_cb},
+        {.name = "Dashboard 4 threads",         .weight = 1, .create_cb = dashboard_4_threads_cb},
+        {.name = "Dashboard max threads",       .weight = 1, .create_cb = dashboard_max_threads_cb},
+#endif
+
         {.name = "", .create_cb = NULL}
 };
 
@@ -676,6 +709,11 @@ static void scene_next_task_cb(lv_timer_t * timer)
     LV_UNUSED(timer);
     lv_obj_clean(scene_bg);
 
+#if LV_USE_REFR_PARALLEL
+    /*The dashboard scenes change the number of rendering threads*/
+    lv_refr_set_thread_cnt(LV_REFR_PARALLEL_THREAD_CNT);
+#endif
+
     if(opa_mode) {
         if(scene_act >= 0) {
             if(scenes[scene_act].time_sum_opa == 0) scenes[scene_act].time_sum_opa = 1;
@@ -994,6 +1032,53 @@ static void fall_anim(lv_obj_t * obj)
 
 }
 
+#if LV_USE_REFR_PARALLEL
+static void invalidate_anim_cb(void * var, int32_t v)
+{
+    LV_UNUSED(v);
+    lv_obj_invalidate(var);
+}
+
+static void dashboard_create(uint32_t thread_cnt)
+{
+    lv_refr_set_thread_cnt(thread_cnt);
+
+    lv_obj_set_flex_flow(scene_bg, LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_style_pad_all(scene_bg, LV_DPI_DEF / 20, 0);
+    lv_obj_set_style_pad_gap(scene_bg, LV_DPI_DEF / 20, 0);
+
+    uint32_t i;
+    for(i = 0; i < CARD_NUM; i++) {
+        lv_obj_t * card = lv_obj_create(scene_bg);
+        lv_obj_remove_style_all(card);
+        lv_obj_set_size(card, lv_pct(15), lv_pct(22));
+        lv_obj_set_style_radius(card, RADIUS, 0);
+        lv_obj_set_style_bg_opa(card, opa_mode ? LV_OPA_50 : LV_OPA_COVER, 0);
+        lv_obj_set_style_bg_color(card, lv_color_hex(rnd_next(0, 0xFFFFF0)), 0);
+        lv_obj_set_style_bg_grad_color(card, lv_color_hex(rnd_next(0, 0xFFFFF0)), 0);
+        lv_obj_set_style_bg_grad_dir(card, LV_GRAD_DIR_VER, 0);
+        lv_obj_set_style_shadow_width(card, SHADOW_WIDTH_SMALL, 0);
+        lv_obj_set_style_shadow_opa(card, LV_OPA_50, 0);
+
+        lv_obj_t * label = lv_label_create(card);
+        lv_label_set_text(label, TXT);
+        lv_obj_set_width(label, lv_pct(100));
+        lv_obj_set_style_text_opa(label, opa_mode ? LV_OPA_50 : LV_OPA_COVER, 0);
+    }
+
+    /*Redraw the whole scene in every frame*/
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, scene_bg);
+    lv_anim_set_exec_cb(&a, invalidate_anim_cb);
+    lv_anim_set_values(&a, 0, 1);
+    lv_anim_set_time(&a, SCENE_TIME);
+    lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
+    lv_anim_del(scene_bg, invalidate_anim_cb);
+    lv_anim_start(&a);
+}
+#endif
+
 static void rnd_reset(void)
 {
     rnd_act = 0;
@@ -66,6 +66,8 @@
  *  STATIC PROTOTYPES
  **********************/
 
+static inline void set_px(uint8_t * buf, lv_coord_t x, lv_coord_t y, lv_color_t color);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -141,10 +143,29 @@ void sharp_mip_set_px(lv_disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w,
   (void) buf_w;
   (void) opa;
 
-  if (lv_color_to1(color) != 0) {
-    buf[BUFIDX(x, y)] |=  PIXIDX(x);  /*Set draw_buf pixel bit to 1 for other colors than BLACK*/
-  } else {
-    buf[BUFIDX(x, y)] &= ~PIXIDX(x);  /*Set draw_buf pixel bit to 0 for BLACK color*/
+  set_px(buf, x, y, color);
+}
+
+void sharp_mip_set_px_span(lv_disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                           const lv_color_t * colors, lv_color_t color, const lv_opa_t * mask, lv_opa_t opa) {
+  (void) disp_drv;
+  (void) buf_w;
+  (void) opa;
+
+  lv_coord_t x_end = x + len;
+
+  if (colors == NULL && mask == NULL) {
+    /* Set the partial bytes bit by bit and the whole bytes at once */
+    uint8_t byte = lv_color_to1(color) != 0 ? 0xFF : 0x00;
+    for(; x < x_end && (x & 7) != 0 ; x++) set_px(buf, x, y, color);
+    for(; x + 8 <= x_end ; x += 8) buf[BUFIDX(x, y)] = byte;
+    for(; x < x_end ; x++) set_px(buf, x, y, color);
+    return;
+  }
+
+  for(lv_coord_t i = 0 ; i < len ; i++) {
+    if (mask && mask[i] == 0) continue;  /*Leave the fully masked pixels unchanged*/
+    set_px(buf, x + i, y, colors ? colors[i] : color);
   }
 }
 
@@ -179,4 +200,12 @@ void sharp_mip_com_inversion(void) {
  *   STATIC FUNCTIONS
  **********************/
 
+static inline void set_px(uint8_t * buf, lv_coord_t x, lv_coord_t y, lv_color_t color) {
+  if (lv_color_to1(color) != 0) {
+    buf[BUFIDX(x, y)] |=  PIXIDX(x);  /*Set draw_buf pixel bit to 1 for other colors than BLACK*/
+  } else {
+    buf[BUFIDX(x, y)] &= ~PIXIDX(x);  /*Set draw_buf pixel bit to 0 for BLACK color*/
+  }
+}
+
 #endif
@@ -46,6 +46,8 @@ void sharp_mip_init(void);
 void sharp_mip_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
 void sharp_mip_rounder(lv_disp_drv_t * disp_drv, lv_area_t * area);
 void sharp_mip_set_px(lv_disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y, lv_color_t color, lv_opa_t opa);
+void sharp_mip_set_px_span(lv_disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                           const lv_color_t * colors, lv_color_t color, const lv_opa_t * mask, lv_opa_t opa);
 #if SHARP_MIP_SOFT_COM_INVERSION
 void sharp_mip_com_inversion(void);
 #endif
@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include "drm.h"
+#include "fb_damage.h"
 #if USE_DRM
 
 #include <unistd.h>
@@ -67,6 +68,9 @@ struct drm_dev {
 	drmModePropertyPtr conn_props[128];
 	struct drm_buffer drm_bufs[2]; /* DUMB buffers */
 	struct drm_buffer *cur_bufs[2]; /* double buffering handling */
+	/* direct_mode: areas of the front buffer which are not in the back buffer yet */
+	lv_area_t damage[LV_INV_BUF_SIZE];
+	uint32_t damage_cnt;
 } drm_dev;
 
 static uint32_t get_plane_property_id(const char *name)
@@ -710,6 +714,76 @@ void drm_wait_vsync(lv_disp_drv_t *disp_drv)
 	drm_dev.req = NULL;
 }
 
+bool drm_get_direct_bufs(void **buf1, void **buf2)
+{
+	if (drm_dev.fd < 0)
+		return false;
+
+	/* LVGL assumes no padding at the end of the lines */
+	if (drm_dev.drm_bufs[0].pitch != drm_dev.width * (LV_COLOR_SIZE / 8) ||
+	    drm_dev.drm_bufs[1].pitch != drm_dev.width * (LV_COLOR_SIZE / 8)) {
+		info("drm: pitch %u has padding, direct_mode can't be used", drm_dev.drm_bufs[0].pitch);
+		return false;
+	}
+
+	*buf1 = drm_dev.drm_bufs[0].map;
+	*buf2 = drm_dev.drm_bufs[1].map;
+
+	return true;
+}
+
+/*
+ * direct_mode: LVGL has drawn the dirty areas of this frame into `color_p`.
+ * The rest of the buffer is 2 frames old, so before showing it replay the
+ * previous frame's damage from the front buffer, except where it was redrawn.
+ * This way the copy cost depends only on the changed areas.
+ */
+static void drm_flush_direct(lv_disp_drv_t *disp_drv, lv_color_t *color_p)
+{
+	struct drm_buffer *fbuf, *front;
+	lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+	lv_area_t damage[LV_INV_BUF_SIZE];
+	uint32_t cnt = 0;
+	int32_t i;
+
+	if ((void *)color_p == drm_dev.drm_bufs[0].map) {
+		fbuf = &drm_dev.drm_bufs[0];
+		front = &drm_dev.drm_bufs[1];
+	} else {
+		fbuf = &drm_dev.drm_bufs[1];
+		front = &drm_dev.drm_bufs[0];
+	}
+
+	for (i = 0; i < disp->inv_p; i++) {
+		if (disp->inv_area_joined[i] == 0)
+			damage[cnt++] = disp->inv_areas[i];
+	}
+
+	for (i = 0; i < (int32_t)drm_dev.damage_cnt; i++)
+		fb_damage_copy_except(fbuf->map, front->map, fbuf->pitch, LV_COLOR_SIZE / 8,
+				      &drm_dev.damage[i], damage, cnt);
+
+	if (drm_dmabuf_set_plane(fbuf)) {
+		err("Flush fail");
+		/* The buffers stay in sync if the whole screen is replayed next time */
+		drm_dev.damage[0].x1 = 0;
+		drm_dev.damage[0].y1 = 0;
+		drm_dev.damage[0].x2 = drm_dev.width - 1;
+		drm_dev.damage[0].y2 = drm_dev.height - 1;
+		drm_dev.damage_cnt = 1;
+		lv_disp_flush_ready(disp_drv);
+		return;
+	}
+
+	/* LVGL will draw into the current front buffer next, so wait until it's not scanned out */
+	drm_wait_vsync(disp_drv);
+
+	memcpy(drm_dev.damage, damage, cnt * sizeof(lv_area_t));
+	drm_dev.damage_cnt = cnt;
+
+	lv_disp_flush_ready(disp_drv);
+}
+
 void drm_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p)
 {
 	struct drm_buffer *fbuf = drm_dev.cur_bufs[1];
@@ -719,6 +793,11 @@ void drm_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color
 
 	dbg("x %d:%d y %d:%d w %d h %d", area->x1, area->x2, area->y1, area->y2, w, h);
 
+	if (disp_drv->direct_mode) {
+		drm_flush_direct(disp_drv, color_p);
+		return;
+	}
+
 	/* Partial update */
 	if ((w != drm_dev.width || h != drm_dev.height) && drm_dev.cur_bufs[0])
 		memcpy(fbuf->map, drm_dev.cur_bufs[0]->map, fbuf->size);
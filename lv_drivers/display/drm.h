@@ -46,6 +46,16 @@ void drm_exit(void);
 void drm_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
 void drm_wait_vsync(lv_disp_drv_t * drv);
 
+/**
+ * Get the two dumb buffers to use them as screen sized draw buffers with `direct_mode = 1`.
+ * LVGL then renders straight into the back buffer and `drm_flush` only replays the
+ * previous frame's dirty areas before flipping the buffers.
+ * @param buf1 store the first buffer here
+ * @param buf2 store the second buffer here
+ * @return true: success; false: the buffers can't be used directly, use normal draw buffers
+ */
+bool drm_get_direct_bufs(void ** buf1, void ** buf2);
+
 
 /**********************
  *      MACROS
@@ -0,0 +1,74 @@
+/**
+ * @file fb_damage.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "fb_damage.h"
+#if USE_DRM || USE_FBDEV || USE_BSD_FBDEV
+
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void fb_damage_copy_except(uint8_t * dst, const uint8_t * src, uint32_t stride, uint32_t px_size,
+                           const lv_area_t * area, const lv_area_t * skip, uint32_t skip_cnt)
+{
+    lv_coord_t x;
+    lv_coord_t y;
+    uint32_t i;
+    for(y = area->y1; y <= area->y2; y++) {
+        size_t row_ofs = (size_t)y * stride;
+        x = area->x1;
+        while(x <= area->x2) {
+            lv_coord_t next = area->x2 + 1;     /*Start of the next skipped part*/
+            lv_coord_t skip_end = -1;
+            for(i = 0; i < skip_cnt; i++) {
+                const lv_area_t * s = &skip[i];
+                if(y < s->y1 || y > s->y2 || s->x2 < x) continue;
+
+                if(s->x1 <= x) skip_end = LV_MAX(skip_end, s->x2);
+                else next = LV_MIN(next, s->x1);
+            }
+
+            if(skip_end >= x) {
+                x = skip_end + 1;
+                continue;
+            }
+
+            size_t ofs = row_ofs + (size_t)x * px_size;
+            memcpy(dst + ofs, src + ofs, (size_t)(next - x) * px_size);
+            x = next;
+        }
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#endif  /*USE_DRM || USE_FBDEV || USE_BSD_FBDEV*/
@@ -0,0 +1,68 @@
+/**
+ * @file fb_damage.h
+ * Helpers for the double buffered frame buffer drivers to keep their buffers in sync
+ */
+
+#ifndef FB_DAMAGE_H
+#define FB_DAMAGE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#ifndef LV_DRV_NO_CONF
+#ifdef LV_CONF_INCLUDE_SIMPLE
+#include "lv_drv_conf.h"
+#else
+#include "../../lv_drv_conf.h"
+#endif
+#endif
+
+#if USE_DRM || USE_FBDEV || USE_BSD_FBDEV
+
+#ifdef LV_LVGL_H_INCLUDE_SIMPLE
+#include "lvgl.h"
+#else
+#include "lvgl/lvgl.h"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Copy an area from one frame buffer to an other except the parts covered by `skip`.
+ * The skipped parts are usually redrawn in `dst` already.
+ * @param dst the buffer to copy to
+ * @param src the buffer to copy from. Its layout is the same as `dst`'s.
+ * @param stride length of a row in the buffers [bytes]
+ * @param px_size size of a pixel [bytes]
+ * @param area the area to copy. It must be on the buffers.
+ * @param skip areas not to copy
+ * @param skip_cnt number of areas in `skip`
+ */
+void fb_damage_copy_except(uint8_t * dst, const uint8_t * src, uint32_t stride, uint32_t px_size,
+                           const lv_area_t * area, const lv_area_t * skip, uint32_t skip_cnt);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif  /*USE_DRM || USE_FBDEV || USE_BSD_FBDEV*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*FB_DAMAGE_H*/
@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include "fbdev.h"
+#include "fb_damage.h"
 #if USE_FBDEV || USE_BSD_FBDEV
 
 #include <stdlib.h>
@@ -33,6 +34,14 @@
 #define FBDEV_PATH  "/dev/fb0"
 #endif
 
+#ifndef FBDEV_DOUBLE_BUFFERED
+#define FBDEV_DOUBLE_BUFFERED  0
+#endif
+
+#if FBDEV_DOUBLE_BUFFERED && USE_BSD_FBDEV
+#error "FBDEV_DOUBLE_BUFFERED is supported only with the Linux frame buffer"
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -57,6 +66,16 @@ struct bsd_fb_fix_info{
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void copy_rows(uint8_t * dest, long int dest_stride, const uint8_t * src, long int src_stride,
+                      long int row_size, int32_t row_cnt);
+#if LV_COLOR_DEPTH == 32
+static void convert_32_to_16(uint16_t * dest, const uint32_t * src, int32_t px_cnt);
+#endif
+#if FBDEV_DOUBLE_BUFFERED
+static void dbuf_init(void);
+static void dbuf_replay_damage(lv_disp_drv_t * drv);
+static void dbuf_flip(void);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -72,6 +91,14 @@ static char *fbp = 0;
 static long int screensize = 0;
 static int fbfd = 0;
 
+#if FBDEV_DOUBLE_BUFFERED
+static bool dbuf_en;            /*The virtual resolution has room for 2 pages*/
+static uint32_t back_page;      /*0 or 1: the page being drawn*/
+static bool frame_started;      /*The previous frame's damage was replayed into the back page*/
+static lv_area_t damage[LV_INV_BUF_SIZE];   /*Areas of the front page which are not in the back page yet*/
+static uint32_t damage_cnt;
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -125,17 +152,22 @@ void fbdev_init(void)
     finfo.smem_len = finfo.line_length * vinfo.yres;
 #else /* USE_BSD_FBDEV */
 
-    // Get fixed screen information
-    if(ioctl(fbfd, FBIOGET_FSCREENINFO, &finfo) == -1) {
-        perror("Error reading fixed information");
-        return;
-    }
-
     // Get variable screen information
     if(ioctl(fbfd, FBIOGET_VSCREENINFO, &vinfo) == -1) {
         perror("Error reading variable information");
         return;
     }
+
+#if FBDEV_DOUBLE_BUFFERED
+    // Make room for the second page. It changes the fixed information too.
+    dbuf_init();
+#endif
+
+    // Get fixed screen information
+    if(ioctl(fbfd, FBIOGET_FSCREENINFO, &finfo) == -1) {
+        perror("Error reading fixed information");
+        return;
+    }
 #endif /* USE_BSD_FBDEV */
 
     LV_LOG_INFO("%dx%d, %dbpp", vinfo.xres, vinfo.yres, vinfo.bits_per_pixel);
@@ -153,6 +185,13 @@ void fbdev_init(void)
     // Don't initialise the memory to retain what's currently displayed / avoid clearing the screen.
     // This is important for applications that only draw to a subsection of the full framebuffer.
 
+#if FBDEV_DOUBLE_BUFFERED
+    if(dbuf_en && screensize < 2 * (long int)finfo.line_length * vinfo.yres) {
+        LV_LOG_WARN("The frame buffer memory is too small for 2 pages, double buffering is disabled");
+        dbuf_en = false;
+    }
+#endif
+
     LV_LOG_INFO("The framebuffer device was mapped to memory successfully");
 
 }
@@ -175,6 +214,11 @@ void fbdev_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color
             area->y2 < 0 ||
             area->x1 > (int32_t)vinfo.xres - 1 ||
             area->y1 > (int32_t)vinfo.yres - 1) {
+#if FBDEV_DOUBLE_BUFFERED
+        if(dbuf_en && frame_started && lv_disp_flush_is_last(drv)) {
+            dbuf_flip();
+        }
+#endif
         lv_disp_flush_ready(drv);
         return;
     }
@@ -187,43 +231,87 @@ void fbdev_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color
 
 
     lv_coord_t w = (act_x2 - act_x1 + 1);
+    lv_coord_t h = (act_y2 - act_y1 + 1);
     long int location = 0;
     long int byte_location = 0;
     unsigned char bit_location = 0;
 
+    /*Skip the clipped pixels of `color_p`*/
+    lv_coord_t src_w = lv_area_get_width(area);
+    color_p += (act_y1 - area->y1) * src_w + (act_x1 - area->x1);
+
+    uint8_t * page = (uint8_t *)fbp;
+#if FBDEV_DOUBLE_BUFFERED
+    if(dbuf_en) {
+        if(!frame_started) {
+            dbuf_replay_damage(drv);
+            frame_started = true;
+        }
+        page += back_page * vinfo.yres * finfo.line_length;
+    }
+#endif
+
     /*32 or 24 bit per pixel*/
     if(vinfo.bits_per_pixel == 32 || vinfo.bits_per_pixel == 24) {
-        uint32_t * fbp32 = (uint32_t *)fbp;
+        uint32_t * fbp32 = (uint32_t *)page;
+        location = (act_x1 + vinfo.xoffset) + (act_y1 + vinfo.yoffset) * finfo.line_length / 4;
+#if LV_COLOR_DEPTH == 32
+        copy_rows((uint8_t *)&fbp32[location], finfo.line_length, (uint8_t *)color_p, src_w * 4, w * 4, h);
+#else
+        int32_t x;
         int32_t y;
-        for(y = act_y1; y <= act_y2; y++) {
-            location = (act_x1 + vinfo.xoffset) + (y + vinfo.yoffset) * finfo.line_length / 4;
-            memcpy(&fbp32[location], (uint32_t *)color_p, (act_x2 - act_x1 + 1) * 4);
-            color_p += w;
+        for(y = 0; y < h; y++) {
+            for(x = 0; x < w; x++) {
+                fbp32[location + x] = lv_color_to32(color_p[x]);
+            }
+            location += finfo.line_length / 4;
+            color_p += src_w;
         }
+#endif
     }
     /*16 bit per pixel*/
     else if(vinfo.bits_per_pixel == 16) {
-        uint16_t * fbp16 = (uint16_t *)fbp;
+        uint16_t * fbp16 = (uint16_t *)page;
+        location = (act_x1 + vinfo.xoffset) + (act_y1 + vinfo.yoffset) * finfo.line_length / 2;
+#if LV_COLOR_DEPTH == 16
+        copy_rows((uint8_t *)&fbp16[location], finfo.line_length, (uint8_t *)color_p, src_w * 2, w * 2, h);
+#else
         int32_t y;
-        for(y = act_y1; y <= act_y2; y++) {
-            location = (act_x1 + vinfo.xoffset) + (y + vinfo.yoffset) * finfo.line_length / 2;
-            memcpy(&fbp16[location], (uint32_t *)color_p, (act_x2 - act_x1 + 1) * 2);
-            color_p += w;
+        for(y = 0; y < h; y++) {
+#if LV_COLOR_DEPTH == 32
+            convert_32_to_16(&fbp16[location], (uint32_t *)color_p, w);
+#else
+            int32_t x;
+            for(x = 0; x < w; x++) {
+                fbp16[location + x] = lv_color_to16(color_p[x]);
+            }
+#endif
+            location += finfo.line_length / 2;
+            color_p += src_w;
         }
+#endif
     }
     /*8 bit per pixel*/
     else if(vinfo.bits_per_pixel == 8) {
-        uint8_t * fbp8 = (uint8_t *)fbp;
+        uint8_t * fbp8 = (uint8_t *)page;
+        location = (act_x1 + vinfo.xoffset) + (act_y1 + vinfo.yoffset) * finfo.line_length;
+#if LV_COLOR_DEPTH == 8
+        copy_rows(&fbp8[location], finfo.line_length, (uint8_t *)color_p, src_w, w, h);
+#else
+        int32_t x;
         int32_t y;
-        for(y = act_y1; y <= act_y2; y++) {
-            location = (act_x1 + vinfo.xoffset) + (y + vinfo.yoffset) * finfo.line_length;
-            memcpy(&fbp8[location], (uint32_t *)color_p, (act_x2 - act_x1 + 1));
-            color_p += w;
+        for(y = 0; y < h; y++) {
+            for(x = 0; x < w; x++) {
+                fbp8[location + x] = lv_color_to8(color_p[x]);
+            }
+            location += finfo.line_length;
+            color_p += src_w;
         }
+#endif
     }
     /*1 bit per pixel*/
     else if(vinfo.bits_per_pixel == 1) {
-        uint8_t * fbp8 = (uint8_t *)fbp;
+        uint8_t * fbp8 = (uint8_t *)page;
         int32_t x;
         int32_t y;
         for(y = act_y1; y <= act_y2; y++) {
@@ -236,12 +324,18 @@ void fbdev_flush(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color
                 color_p++;
             }
 
-            color_p += area->x2 - act_x2;
+            color_p += src_w - w;
         }
     } else {
         /*Not supported bit per pixel*/
     }
 
+#if FBDEV_DOUBLE_BUFFERED
+    if(dbuf_en && lv_disp_flush_is_last(drv)) {
+        dbuf_flip();
+    }
+#endif
+
     //May be some direct update command is required
     //ret = ioctl(state->fd, FBIO_UPDATE, (unsigned long)((uintptr_t)rect));
 
@@ -265,4 +359,145 @@ void fbdev_set_offset(uint32_t xoffset, uint32_t yoffset) {
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Copy rows of pixels. If both buffers are continuous (full rows without padding) copy them at once.
+ */
+static void copy_rows(uint8_t * dest, long int dest_stride, const uint8_t * src, long int src_stride,
+                      long int row_size, int32_t row_cnt)
+{
+    if(dest_stride == row_size && src_stride == row_size) {
+        memcpy(dest, src, row_size * row_cnt);
+        return;
+    }
+
+    int32_t y;
+    for(y = 0; y < row_cnt; y++) {
+        memcpy(dest, src, row_size);
+        dest += dest_stride;
+        src += src_stride;
+    }
+}
+
+#if LV_COLOR_DEPTH == 32
+/**
+ * Convert ARGB8888 pixels to RGB565.
+ * A simple loop without branches so that the compiler can vectorize it (SSE2, NEON, etc).
+ */
+static void convert_32_to_16(uint16_t * dest, const uint32_t * src, int32_t px_cnt)
+{
+    int32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        uint32_t c = src[i];
+        dest[i] = (uint16_t)(((c >> 8) & 0xF800) | ((c >> 5) & 0x07E0) | ((c >> 3) & 0x001F));
+    }
+}
+#endif
+
+#if FBDEV_DOUBLE_BUFFERED
+
+/**
+ * Set the virtual resolution to 2 pages if it's not large enough yet
+ */
+static void dbuf_init(void)
+{
+    if(vinfo.bits_per_pixel < 8) {
+        LV_LOG_WARN("Double buffering is not supported with %d bit per pixel", vinfo.bits_per_pixel);
+        return;
+    }
+
+    if(vinfo.yres_virtual < 2 * vinfo.yres) {
+        struct fb_var_screeninfo new_vinfo = vinfo;
+        new_vinfo.yres_virtual = 2 * vinfo.yres;
+        if(ioctl(fbfd, FBIOPUT_VSCREENINFO, &new_vinfo) == -1 ||
+           ioctl(fbfd, FBIOGET_VSCREENINFO, &vinfo) == -1 ||
+           vinfo.yres_virtual < 2 * vinfo.yres) {
+            LV_LOG_WARN("Can't set the virtual resolution to 2 pages, double buffering is disabled");
+            return;
+        }
+    }
+
+    dbuf_en = true;
+
+    /*Draw into the page which is not visible now*/
+    back_page = vinfo.yoffset >= vinfo.yres ? 0 : 1;
+
+    /*Keep what's displayed now where the first frame doesn't draw*/
+    damage[0].x1 = 0;
+    damage[0].y1 = 0;
+    damage[0].x2 = vinfo.xres - 1;
+    damage[0].y2 = vinfo.yres - 1;
+    damage_cnt = 1;
+
+    /*The pages are selected by panning, `vinfo.yoffset` is used as an offset inside the page*/
+    vinfo.yoffset = 0;
+}
+
+/**
+ * The back page is 2 frames old. Copy the areas changed in the previous frame from the front page,
+ * except the parts which will be redrawn in this frame anyway.
+ */
+static void dbuf_replay_damage(lv_disp_drv_t * drv)
+{
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    lv_area_t skip[LV_INV_BUF_SIZE];
+    uint32_t skip_cnt = 0;
+    uint32_t i;
+
+    /*The areas of this frame, moved by the driver's offset like the flushed areas*/
+    for(i = 0; disp && disp->driver == drv && i < disp->inv_p; i++) {
+        if(disp->inv_area_joined[i]) continue;
+        skip[skip_cnt] = disp->inv_areas[i];
+        lv_area_move(&skip[skip_cnt], drv->offset_x, drv->offset_y);
+        skip_cnt++;
+    }
+
+    /*Copy from the front page to the back page. `vinfo.yoffset` and `xoffset` are offsets inside the pages.*/
+    uint32_t px_size = vinfo.bits_per_pixel / 8;
+    long int page_size = (long int)vinfo.yres * finfo.line_length;
+    long int ofs = vinfo.yoffset * finfo.line_length + vinfo.xoffset * px_size;
+    uint8_t * back = (uint8_t *)fbp + back_page * page_size + ofs;
+    uint8_t * front = (uint8_t *)fbp + (1 - back_page) * page_size + ofs;
+
+    lv_area_t scr_area = {0, 0, vinfo.xres - 1, vinfo.yres - 1};
+    for(i = 0; i < damage_cnt; i++) {
+        lv_area_t a;
+        if(!_lv_area_intersect(&a, &damage[i], &scr_area)) continue;
+        fb_damage_copy_except(back, front, finfo.line_length, px_size, &a, skip, skip_cnt);
+    }
+
+    /*These will be missing from the other page after the flip*/
+    lv_memcpy(damage, skip, skip_cnt * sizeof(lv_area_t));
+    damage_cnt = skip_cnt;
+}
+
+/**
+ * Show the back page and wait until it's really visible so the other page can be drawn
+ */
+static void dbuf_flip(void)
+{
+    struct fb_var_screeninfo pan_vinfo = vinfo;
+    pan_vinfo.xoffset = 0;
+    pan_vinfo.yoffset = back_page * vinfo.yres;
+    frame_started = false;
+
+    if(ioctl(fbfd, FBIOPAN_DISPLAY, &pan_vinfo) == -1) {
+        perror("ioctl(FBIOPAN_DISPLAY)");
+
+        /*Draw directly into the visible page from now on*/
+        long int page_size = (long int)vinfo.yres * finfo.line_length;
+        memcpy(fbp + (1 - back_page) * page_size, fbp + back_page * page_size, page_size);
+        vinfo.yoffset = (1 - back_page) * vinfo.yres;
+        dbuf_en = false;
+        return;
+    }
+
+    /*Not all drivers support it but many of them wait for the vsync in FBIOPAN_DISPLAY anyway*/
+    int crtc = 0;
+    ioctl(fbfd, FBIO_WAITFORVSYNC, &crtc);
+
+    back_page = 1 - back_page;
+}
+
+#endif /*FBDEV_DOUBLE_BUFFERED*/
+
 #endif
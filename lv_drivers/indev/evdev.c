@@ -38,7 +38,7 @@ int map(int x, int in_min, int in_max, int out_min, int out_max);
 /**********************
  *  STATIC VARIABLES
  **********************/
-int evdev_fd;
+int evdev_fd = -1;
 int evdev_root_x;
 int evdev_root_y;
 int evdev_button;
@@ -256,6 +256,15 @@ void evdev_read(lv_indev_drv_t * drv, lv_indev_data_t * data)
     return ;
 }
 
+/**
+ * Get the file descriptor of the evdev device, e.g. to wait for input with `poll()`
+ * @return the file descriptor or -1 if the device isn't opened
+ */
+int evdev_get_fd(void)
+{
+    return evdev_fd;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
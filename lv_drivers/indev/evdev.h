@@ -57,6 +57,11 @@ bool evdev_set_file(char* dev_name);
  * @param data store the evdev data here
  */
 void evdev_read(lv_indev_drv_t * drv, lv_indev_data_t * data);
+/**
+ * Get the file descriptor of the evdev device, e.g. to wait for input with `poll()`
+ * @return the file descriptor or -1 if the device isn't opened
+ */
+int evdev_get_fd(void);
 
 
 /**********************
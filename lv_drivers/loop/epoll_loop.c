@@ -0,0 +1,298 @@
+/**
+ * @file epoll_loop.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "epoll_loop.h"
+#if USE_EPOLL_LOOP
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#ifndef EPOLL_LOOP_MAX_FD
+#  define EPOLL_LOOP_MAX_FD 8
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    int fd;                 /*-1: unused*/
+    epoll_loop_cb_t cb;
+    void * user_data;
+    lv_indev_t * indev;
+} epoll_loop_src_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool add_src(int fd, epoll_loop_cb_t cb, void * user_data, lv_indev_t * indev);
+static void timer_resume_cb(void * data);
+static void indev_pause_idle(void);
+static void drain_fd(int fd);
+static void close_fds(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static int epoll_fd = -1;
+static int wakeup_fd = -1;
+static int timer_fd = -1;
+static epoll_loop_src_t srcs[EPOLL_LOOP_MAX_FD];
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize the loop. Call it after `lv_init()`.
+ * @return true: success; false: the epoll, eventfd or timerfd couldn't be created
+ */
+bool epoll_loop_init(void)
+{
+    int i;
+    for(i = 0; i < EPOLL_LOOP_MAX_FD; i++) srcs[i].fd = -1;
+
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    wakeup_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+    if(epoll_fd == -1 || wakeup_fd == -1 || timer_fd == -1) {
+        perror("epoll_loop: couldn't create the file descriptors");
+        close_fds();
+        return false;
+    }
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.ptr = &wakeup_fd;
+    if(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wakeup_fd, &ev) == -1) {
+        perror("epoll_loop: couldn't watch the wake up eventfd");
+        close_fds();
+        return false;
+    }
+
+    ev.data.ptr = &timer_fd;
+    if(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, timer_fd, &ev) == -1) {
+        perror("epoll_loop: couldn't watch the timerfd");
+        close_fds();
+        return false;
+    }
+
+    /*Wake up when e.g. an area is invalidated and the display's refresh timer is resumed*/
+    lv_timer_handler_set_resume_cb(timer_resume_cb, NULL);
+
+    return true;
+}
+
+/**
+ * Watch a file descriptor and call a function when it's readable.
+ * @param fd a file descriptor
+ * @param cb function to call from the loop when `fd` is readable
+ * @param user_data custom parameter passed to `cb`
+ * @return true: success; false: too many file descriptors (see `EPOLL_LOOP_MAX_FD`) or error
+ */
+bool epoll_loop_add_fd(int fd, epoll_loop_cb_t cb, void * user_data)
+{
+    return add_src(fd, cb, user_data, NULL);
+}
+
+/**
+ * Read an input device only when its file descriptor has data or while it's being used.
+ * @param indev pointer to an input device
+ * @param fd the file descriptor `indev` reads
+ * @return true: success; false: too many file descriptors (see `EPOLL_LOOP_MAX_FD`) or error
+ */
+bool epoll_loop_add_indev(lv_indev_t * indev, int fd)
+{
+    if(!add_src(fd, NULL, NULL, indev)) return false;
+
+    lv_timer_pause(indev->driver->read_timer);
+    return true;
+}
+
+/**
+ * Stop watching a file descriptor added by `epoll_loop_add_fd` or `epoll_loop_add_indev`.
+ * @param fd a file descriptor
+ */
+void epoll_loop_remove_fd(int fd)
+{
+    int i;
+    for(i = 0; i < EPOLL_LOOP_MAX_FD; i++) {
+        if(srcs[i].fd != fd) continue;
+
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+        /*Poll the input device again as usual*/
+        if(srcs[i].indev) lv_timer_resume(srcs[i].indev->driver->read_timer);
+        srcs[i].fd = -1;
+    }
+}
+
+/**
+ * Wake up the loop to call `lv_timer_handler()` now.
+ * Can be called from any thread or signal handler.
+ */
+void epoll_loop_wakeup(void)
+{
+    uint64_t one = 1;
+    /*If the counter is full the loop will wake up anyway*/
+    if(write(wakeup_fd, &one, sizeof(one)) < 0) return;
+}
+
+/**
+ * Call `lv_timer_handler()` once and sleep until the next timer, an input or a wake up.
+ */
+void epoll_loop_run_once(void)
+{
+    /*The timer handler will do what the wake ups so far asked for*/
+    drain_fd(wakeup_fd);
+
+    uint32_t time_till_next = lv_timer_handler();
+
+    indev_pause_idle();
+
+    /*Program the timerfd for the next timer. An all zero value disarms it if there is no timer to run.*/
+    struct itimerspec its;
+    memset(&its, 0, sizeof(its));
+    if(time_till_next != LV_NO_TIMER_READY) {
+        its.it_value.tv_sec = time_till_next / 1000;
+        its.it_value.tv_nsec = (long)(time_till_next % 1000) * 1000000;
+    }
+    timerfd_settime(timer_fd, 0, &its, NULL);
+
+    /*Check the file descriptors without sleeping if a timer is ready already*/
+    struct epoll_event events[EPOLL_LOOP_MAX_FD + 2];
+    int cnt = epoll_wait(epoll_fd, events, EPOLL_LOOP_MAX_FD + 2, time_till_next == 0 ? 0 : -1);
+    if(cnt < 0) {
+        if(errno != EINTR) perror("epoll_loop: epoll_wait failed");
+        return;
+    }
+
+    int i;
+    for(i = 0; i < cnt; i++) {
+        void * ptr = events[i].data.ptr;
+        if(ptr == &wakeup_fd) {
+            /*Drained before calling the timer handler*/
+        }
+        else if(ptr == &timer_fd) {
+            drain_fd(timer_fd);
+        }
+        else {
+            epoll_loop_src_t * src = ptr;
+            if(src->fd == -1) continue;     /*Removed by an earlier callback*/
+
+            if(src->indev) {
+                /*Let the input device read the new data in the next `lv_timer_handler()`*/
+                lv_timer_t * read_timer = src->indev->driver->read_timer;
+                lv_timer_resume(read_timer);
+                lv_timer_ready(read_timer);
+            }
+            else {
+                src->cb(src->fd, src->user_data);
+            }
+        }
+    }
+}
+
+/**
+ * Call `epoll_loop_run_once()` forever
+ */
+void epoll_loop_run(void)
+{
+    while(1) {
+        epoll_loop_run_once();
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool add_src(int fd, epoll_loop_cb_t cb, void * user_data, lv_indev_t * indev)
+{
+    int i;
+    for(i = 0; i < EPOLL_LOOP_MAX_FD; i++) {
+        if(srcs[i].fd == -1) break;
+    }
+
+    if(i == EPOLL_LOOP_MAX_FD) {
+        fprintf(stderr, "epoll_loop: too many file descriptors, increase EPOLL_LOOP_MAX_FD\n");
+        return false;
+    }
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.ptr = &srcs[i];
+    if(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) == -1) {
+        perror("epoll_loop: couldn't watch the file descriptor");
+        return false;
+    }
+
+    srcs[i].fd = fd;
+    srcs[i].cb = cb;
+    srcs[i].user_data = user_data;
+    srcs[i].indev = indev;
+
+    return true;
+}
+
+static void timer_resume_cb(void * data)
+{
+    (void)data;
+    epoll_loop_wakeup();
+}
+
+/**
+ * Stop reading the input devices which are released and have nothing to finish (e.g. scroll throw)
+ */
+static void indev_pause_idle(void)
+{
+    int i;
+    for(i = 0; i < EPOLL_LOOP_MAX_FD; i++) {
+        lv_indev_t * indev = srcs[i].indev;
+        if(srcs[i].fd == -1 || indev == NULL) continue;
+
+        if(indev->proc.state != LV_INDEV_STATE_RELEASED) continue;
+        if(indev->driver->type == LV_INDEV_TYPE_POINTER && indev->proc.types.pointer.scroll_obj) continue;
+
+        lv_timer_pause(indev->driver->read_timer);
+    }
+}
+
+static void drain_fd(int fd)
+{
+    uint64_t cnt;
+    if(read(fd, &cnt, sizeof(cnt)) < 0) return;
+}
+
+/**
+ * Close the file descriptors of a failed initialization so that the wake ups do nothing
+ */
+static void close_fds(void)
+{
+    if(epoll_fd != -1) close(epoll_fd);
+    if(wakeup_fd != -1) close(wakeup_fd);
+    if(timer_fd != -1) close(timer_fd);
+    epoll_fd = -1;
+    wakeup_fd = -1;
+    timer_fd = -1;
+}
+
+#endif /*USE_EPOLL_LOOP*/
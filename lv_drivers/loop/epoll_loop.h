@@ -0,0 +1,108 @@
+/**
+ * @file epoll_loop.h
+ * Main loop for Linux which sleeps until the next LVGL timer or input
+ */
+
+#ifndef EPOLL_LOOP_H
+#define EPOLL_LOOP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#ifndef LV_DRV_NO_CONF
+#ifdef LV_CONF_INCLUDE_SIMPLE
+#include "lv_drv_conf.h"
+#else
+#include "../../lv_drv_conf.h"
+#endif
+#endif
+
+#if USE_EPOLL_LOOP
+
+#ifdef LV_LVGL_H_INCLUDE_SIMPLE
+#include "lvgl.h"
+#else
+#include "lvgl/lvgl.h"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Called when a watched file descriptor becomes readable
+ */
+typedef void (*epoll_loop_cb_t)(int fd, void * user_data);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the loop. Call it after `lv_init()`.
+ * @return true: success; false: the epoll, eventfd or timerfd couldn't be created
+ */
+bool epoll_loop_init(void);
+
+/**
+ * Watch a file descriptor and call a function when it's readable.
+ * The callback has to read the available data, else it will be called again immediately.
+ * @param fd a file descriptor
+ * @param cb function to call from the loop when `fd` is readable
+ * @param user_data custom parameter passed to `cb`
+ * @return true: success; false: too many file descriptors (see `EPOLL_LOOP_MAX_FD`) or error
+ */
+bool epoll_loop_add_fd(int fd, epoll_loop_cb_t cb, void * user_data);
+
+/**
+ * Read an input device only when its file descriptor has data or while it's being used
+ * (pressed, scroll throw, etc), instead of polling it every `LV_INDEV_DEF_READ_PERIOD`.
+ * The input device's `read_cb` has to read all the available data from `fd` without blocking.
+ * @param indev pointer to an input device
+ * @param fd the file descriptor `indev` reads (e.g. `evdev_get_fd()`)
+ * @return true: success; false: too many file descriptors (see `EPOLL_LOOP_MAX_FD`) or error
+ */
+bool epoll_loop_add_indev(lv_indev_t * indev, int fd);
+
+/**
+ * Stop watching a file descriptor added by `epoll_loop_add_fd` or `epoll_loop_add_indev`.
+ * @param fd a file descriptor
+ */
+void epoll_loop_remove_fd(int fd);
+
+/**
+ * Wake up the loop to call `lv_timer_handler()` now.
+ * Can be called from any thread or signal handler, e.g. after modifying the UI from an other thread.
+ * Called automatically when a timer needs to run earlier (e.g. an area was invalidated).
+ */
+void epoll_loop_wakeup(void);
+
+/**
+ * Call `lv_timer_handler()` once and sleep until the next timer, an input or a wake up.
+ */
+void epoll_loop_run_once(void);
+
+/**
+ * Call `epoll_loop_run_once()` forever
+ */
+void epoll_loop_run(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /* USE_EPOLL_LOOP */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* EPOLL_LOOP_H */
@@ -321,6 +321,10 @@
 
 #if USE_FBDEV
 #  define FBDEV_PATH          "/dev/fb0"
+
+/* 1: Draw into an invisible page of the virtual resolution and show it with FBIOPAN_DISPLAY to avoid tearing.
+ * Needs 2 screen sized pages in the frame buffer's memory. */
+#  define FBDEV_DOUBLE_BUFFERED 0
 #endif
 
 /*-----------------------------------------
@@ -489,6 +493,22 @@
 /*No settings*/
 #endif
 
+
+/*********************
+ *  MAIN LOOP
+ *********************/
+
+/*-----------------------------------------------------------
+ * Linux main loop sleeping until the next timer or input (epoll)
+ *----------------------------------------------------------*/
+#ifndef USE_EPOLL_LOOP
+#  define USE_EPOLL_LOOP      0
+#endif
+
+#if USE_EPOLL_LOOP
+#  define EPOLL_LOOP_MAX_FD   8         /*Max. number of watched file descriptors (e.g. input devices)*/
+#endif
+
 #endif  /*LV_DRV_CONF_H*/
 
 #endif /*End of "Content enable"*/
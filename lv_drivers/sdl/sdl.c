@@ -57,6 +57,12 @@
  *********************/
 #define SDL_REFR_PERIOD     50  /*ms*/
 
+/*Max number of flushed areas to upload separately to the texture in a frame.
+ *If there are more their bounding box is uploaded.*/
+#ifndef SDL_DIRTY_AREA_MAX
+#define SDL_DIRTY_AREA_MAX  LV_INV_BUF_SIZE
+#endif
+
 #ifndef KEYBOARD_BUFFER_SIZE
 #define KEYBOARD_BUFFER_SIZE SDL_TEXTINPUTEVENT_TEXT_SIZE
 #endif
@@ -73,6 +79,8 @@ typedef struct {
     uint32_t * tft_fb_act;
 #else
     uint32_t * tft_fb;
+    SDL_Rect dirty[SDL_DIRTY_AREA_MAX];  /*Areas of `tft_fb` not uploaded to `texture` yet*/
+    uint16_t dirty_cnt;
 #endif
 }monitor_t;
 
@@ -81,6 +89,10 @@ typedef struct {
  **********************/
 static void window_create(monitor_t * m);
 static void window_update(monitor_t * m);
+#if SDL_DOUBLE_BUFFERED == 0
+static void window_copy_area(monitor_t * m, const lv_area_t * area, const lv_color_t * color_p);
+static void window_add_dirty(monitor_t * m, const SDL_Rect * r);
+#endif
 int quit_filter(void * userdata, SDL_Event * event);
 static void monitor_sdl_clean_up(void);
 static void sdl_event_handler(lv_timer_t * t);
@@ -174,24 +186,7 @@ void sdl_display_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_colo
 #if SDL_DOUBLE_BUFFERED
     monitor.tft_fb_act = (uint32_t *)color_p;
 #else /*SDL_DOUBLE_BUFFERED*/
-
-    int32_t y;
-#if LV_COLOR_DEPTH != 24 && LV_COLOR_DEPTH != 32    /*32 is valid but support 24 for backward compatibility too*/
-    int32_t x;
-    for(y = area->y1; y <= area->y2 && y < disp_drv->ver_res; y++) {
-        for(x = area->x1; x <= area->x2; x++) {
-            monitor.tft_fb[y * disp_drv->hor_res + x] = lv_color_to32(*color_p);
-            color_p++;
-        }
-
-    }
-#else
-    uint32_t w = lv_area_get_width(area);
-    for(y = area->y1; y <= area->y2 && y < disp_drv->ver_res; y++) {
-        memcpy(&monitor.tft_fb[y * SDL_HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
-        color_p += w;
-    }
-#endif
+    window_copy_area(&monitor, area, color_p);
 #endif /*SDL_DOUBLE_BUFFERED*/
 
     monitor.sdl_refr_qry = true;
@@ -235,24 +230,7 @@ void sdl_display_flush2(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_col
     /*IMPORTANT! It must be called to tell the system the flush is ready*/
     lv_disp_flush_ready(disp_drv);
 #else
-
-    int32_t y;
-#if LV_COLOR_DEPTH != 24 && LV_COLOR_DEPTH != 32    /*32 is valid but support 24 for backward compatibility too*/
-    int32_t x;
-    for(y = area->y1; y <= area->y2 && y < disp_drv->ver_res; y++) {
-        for(x = area->x1; x <= area->x2; x++) {
-            monitor2.tft_fb[y * disp_drv->hor_res + x] = lv_color_to32(*color_p);
-            color_p++;
-        }
-
-    }
-#else
-    uint32_t w = lv_area_get_width(area);
-    for(y = area->y1; y <= area->y2 && y < disp_drv->ver_res; y++) {
-        memcpy(&monitor2.tft_fb[y * disp_drv->hor_res + area->x1], color_p, w * sizeof(lv_color_t));
-        color_p += w;
-    }
-#endif
+    window_copy_area(&monitor2, area, color_p);
 
     monitor2.sdl_refr_qry = true;
 
@@ -451,6 +429,13 @@ static void window_create(monitor_t * m)
 #else
     m->tft_fb = (uint32_t *)malloc(sizeof(uint32_t) * SDL_HOR_RES * SDL_VER_RES);
     memset(m->tft_fb, 0x44, SDL_HOR_RES * SDL_VER_RES * sizeof(uint32_t));
+
+    /*Upload the whole frame buffer for the first time*/
+    m->dirty[0].x = 0;
+    m->dirty[0].y = 0;
+    m->dirty[0].w = SDL_HOR_RES;
+    m->dirty[0].h = SDL_VER_RES;
+    m->dirty_cnt = 1;
 #endif
 
     m->sdl_refr_qry = true;
@@ -460,7 +445,14 @@ static void window_create(monitor_t * m)
 static void window_update(monitor_t * m)
 {
 #if SDL_DOUBLE_BUFFERED == 0
-    SDL_UpdateTexture(m->texture, NULL, m->tft_fb, SDL_HOR_RES * sizeof(uint32_t));
+    /*Upload only the flushed areas. The rest of the texture still has the earlier pixels
+     *so e.g. on an "exposed" event it's enough to render the texture again.*/
+    uint16_t i;
+    for(i = 0; i < m->dirty_cnt; i++) {
+        const SDL_Rect * r = &m->dirty[i];
+        SDL_UpdateTexture(m->texture, r, &m->tft_fb[r->y * SDL_HOR_RES + r->x], SDL_HOR_RES * sizeof(uint32_t));
+    }
+    m->dirty_cnt = 0;
 #else
     if(m->tft_fb_act == NULL) return;
     SDL_UpdateTexture(m->texture, NULL, m->tft_fb_act, SDL_HOR_RES * sizeof(uint32_t));
@@ -478,6 +470,86 @@ static void window_update(monitor_t * m)
     SDL_RenderPresent(m->renderer);
 }
 
+#if SDL_DOUBLE_BUFFERED == 0
+
+/**
+ * Copy the flushed pixels to the frame buffer and remember the area to upload it to the texture
+ * @param m pointer to a monitor
+ * @param area the flushed area
+ * @param color_p pixels of `area`
+ */
+static void window_copy_area(monitor_t * m, const lv_area_t * area, const lv_color_t * color_p)
+{
+    /*Clip to the screen*/
+    lv_area_t a;
+    a.x1 = LV_MAX(area->x1, 0);
+    a.y1 = LV_MAX(area->y1, 0);
+    a.x2 = LV_MIN(area->x2, SDL_HOR_RES - 1);
+    a.y2 = LV_MIN(area->y2, SDL_VER_RES - 1);
+
+    /*Nothing to copy from an empty area or an area out of the window*/
+    int32_t w = lv_area_get_width(&a);
+    int32_t h = lv_area_get_height(&a);
+    if(w <= 0 || h <= 0) return;
+
+    int32_t src_w = lv_area_get_width(area);
+    color_p += (a.y1 - area->y1) * src_w + (a.x1 - area->x1);
+
+    int32_t y;
+    for(y = a.y1; y <= a.y2; y++) {
+        uint32_t * dest = &m->tft_fb[y * SDL_HOR_RES + a.x1];
+#if LV_COLOR_DEPTH != 24 && LV_COLOR_DEPTH != 32    /*32 is valid but support 24 for backward compatibility too*/
+        int32_t x;
+        for(x = 0; x < w; x++) {
+            dest[x] = lv_color_to32(color_p[x]);
+        }
+#else
+        memcpy(dest, color_p, w * sizeof(lv_color_t));
+#endif
+        color_p += src_w;
+    }
+
+    SDL_Rect r;
+    r.x = a.x1;
+    r.y = a.y1;
+    r.w = w;
+    r.h = h;
+    window_add_dirty(m, &r);
+}
+
+/**
+ * Add an area to upload to the texture in the next `window_update()`
+ * @param m pointer to a monitor
+ * @param r the area to add
+ */
+static void window_add_dirty(monitor_t * m, const SDL_Rect * r)
+{
+    if(m->dirty_cnt > 0) {
+        /*The parts of an area flushed with a small draw buffer come one after the other*/
+        SDL_Rect * last = &m->dirty[m->dirty_cnt - 1];
+        if(last->x == r->x && last->w == r->w && last->y + last->h == r->y) {
+            last->h += r->h;
+            return;
+        }
+    }
+
+    if(m->dirty_cnt < SDL_DIRTY_AREA_MAX) {
+        m->dirty[m->dirty_cnt] = *r;
+        m->dirty_cnt++;
+        return;
+    }
+
+    /*Too many areas: upload their bounding box*/
+    SDL_Rect u = *r;
+    uint16_t i;
+    for(i = 0; i < m->dirty_cnt; i++) {
+        SDL_UnionRect(&u, &m->dirty[i], &u);
+    }
+    m->dirty[0] = u;
+    m->dirty_cnt = 1;
+}
+#endif /*SDL_DOUBLE_BUFFERED == 0*/
+
 static void mouse_handler(SDL_Event * event)
 {
     switch(event->type) {
@@ -80,6 +80,14 @@
 /*Default display refresh period. LVG will redraw changed areas with this period time*/
 #define LV_DISP_DEF_REFR_PERIOD 30      /*[ms]*/
 
+/*Number of invalidated areas to save for redrawing. If more areas are invalidated
+ *the two areas which can be joined with the fewest extra pixels are joined*/
+#define LV_INV_BUF_SIZE 32
+
+/*Cost of redrawing one more area expressed in pixels.
+ *Two areas are redrawn as one if it adds fewer extra pixels than this*/
+#define LV_REFR_AREA_COST 256     /*[px]*/
+
 /*Input device read period in milliseconds*/
 #define LV_INDEV_DEF_READ_PERIOD 30     /*[ms]*/
 
@@ -95,6 +103,10 @@
  *(Not so important, you can adjust it to modify default sizes and spaces)*/
 #define LV_DPI_DEF 130     /*[px/inch]*/
 
+/*Enable the pthread based thread, mutex and condition variable wrappers of `lv_thread.h`.
+ *Required by the features which use worker threads. With LV_MEM_CUSTOM == 0 the built-in allocator is locked by a mutex too.*/
+#define LV_USE_PTHREAD 0
+
 /*=======================
  * FEATURE CONFIGURATION
  *=======================*/
@@ -110,12 +122,18 @@
 
 /*Allow buffering some shadow calculation.
  *LV_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
- *Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
+ *A buffered shadow has shadow size^2 RAM cost. Several shadows are buffered and
+ *the least recently used ones are dropped if they need more than LV_SHADOW_CACHE_MEM_SIZE bytes*/
 #define LV_SHADOW_CACHE_SIZE 0
+#define LV_SHADOW_CACHE_MEM_SIZE (LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE * 4)
+
+/*1: Blur the shadows with one box blur instead of two. It's faster but the shadows are less smooth*/
+#define LV_SHADOW_BLUR_FAST 0
 
 /* Set number of maximally cached circle data.
  * The circumference of 1/4 circle are saved for anti-aliasing
- * radius * 4 bytes are used per circle (the most often used radiuses are saved)
+ * radius * 6 bytes are used per circle (the least recently used radiuses are dropped)
+ * The cache is kept between the refreshes and shared by the rendering threads
  * 0: to disable caching */
 #define LV_CIRCLE_CACHE_SIZE 4
 
@@ -128,9 +146,38 @@
  *0: to disable caching*/
 #define LV_IMG_CACHE_DEF_SIZE 0
 
+/*Default memory limit of the decoded images in the image cache [bytes].
+ *If exceeded the least valuable images are closed even if there are free entries.
+ *0: no limit, only LV_IMG_CACHE_DEF_SIZE matters*/
+#define LV_IMG_CACHE_DEF_MEM_SIZE 0
+
+/*Open the images which are slow to decode (files and PNG, JPG, etc. in C arrays) on background threads.
+ *Until an image is decoded nothing is drawn in its place and its area is redrawn when it's ready.
+ *The callbacks of a decoder are called one by one (unless it's thread-safe) but the file system drivers need to be thread-safe.
+ *Requires LV_USE_PTHREAD and LV_IMG_CACHE_DEF_SIZE > 0*/
+#define LV_IMG_CACHE_ASYNC 0
+#if LV_IMG_CACHE_ASYNC
+/*Number of decoding threads*/
+#define LV_IMG_CACHE_ASYNC_THREAD_CNT 1
+#endif
+
 /*Maximum buffer size to allocate for rotation. Only used if software rotation is enabled in the display driver.*/
 #define LV_DISP_ROT_MAX_BUF (10*1024)
 
+/*Render the bands of the invalidated areas on more threads in parallel. Requires LV_USE_PTHREAD.
+ *Every extra thread allocates a draw buffer with the same size as the display's draw buffer.
+ *The draw events of the widgets are sent from the rendering threads so their handlers can't modify any objects.*/
+#define LV_USE_REFR_PARALLEL 0
+#if LV_USE_REFR_PARALLEL
+/*Max. number of rendering threads including the one calling `lv_timer_handler()`*/
+#define LV_REFR_PARALLEL_THREAD_CNT 4
+#endif
+
+/*Use the SIMD instructions of the CPU in the software blending: SSE2 and AVX2 on x86, NEON on ARM.
+ *The fastest instruction set supported by the CPU is selected in `lv_init()`.
+ *Used with 32 bit and not swapped 16 bit color depths. The result is the same as without SIMD.*/
+#define LV_USE_DRAW_SIMD 1
+
 /*-------------
  * GPU
  *-----------*/
@@ -247,6 +294,12 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 
 #define LV_USE_USER_DATA 1
 
+/*Number of resolved style properties to cache per object. Must be a power of 2.
+ *It makes the `lv_obj_get_style_...()` functions faster but uses (LV_OBJ_STYLE_CACHE_SIZE * 8) bytes per object.
+ *The changes of the shared styles are seen only after `lv_obj_report_style_change()`.
+ *0: to disable caching*/
+#define LV_OBJ_STYLE_CACHE_SIZE 0
+
 /*Garbage Collector settings
  *Used if lvgl is bound to higher level language and the memory is managed by that language*/
 #define LV_ENABLE_GC 0
@@ -347,9 +400,17 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
  *Compiler error will be triggered if a font needs it.*/
 #define LV_FONT_FMT_TXT_LARGE 0
 
+/*Number of letters whose glyph ID is cached by every built-in font to not search it again.
+ *Uses 8 bytes RAM per letter and font. Use 1 for the smallest RAM usage.*/
+#define LV_FONT_FMT_TXT_CACHE_SIZE 8
+
 /*Enables/disables support for compressed fonts.*/
 #define LV_USE_FONT_COMPRESSED 0
 
+/*Size of the atlas caching the decompressed glyphs of compressed fonts
+ *and the glyphs of FreeType fonts without FreeType's cache [bytes]. 0: disable the cache*/
+#define LV_FONT_GLYPH_CACHE_SIZE 0
+
 /*Enable subpixel rendering*/
 #define LV_USE_FONT_SUBPX 0
 #if LV_USE_FONT_SUBPX
@@ -431,6 +492,7 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 #if LV_USE_LABEL
 #  define LV_LABEL_TEXT_SELECTION 1 /*Enable selecting text of the label*/
 #  define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
+#  define LV_LABEL_LAYOUT_CACHE 0   /*Store the line breaks of the labels (6 bytes per line) to not measure the text again on every redraw*/
 #endif
 
 #define LV_USE_LINE       1
@@ -581,6 +643,25 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 /*Rlottie library*/
 #define LV_USE_RLOTTIE 0
 
+/*FFmpeg library for image decoding and playing videos
+ *Supports all major image formats so do not enable other image decoder with it*/
+#define LV_USE_FFMPEG  0
+#if LV_USE_FFMPEG
+    /*Dump input information to stderr*/
+    #define LV_FFMPEG_AV_DUMP_FORMAT 0
+
+    /*Keep the YUV 4:2:0 frames of the video player as they are decoded (LV_IMG_CF_YUV_I420/NV12)
+     *and convert only the drawn pixels. Rotating and zooming the player is not supported then.*/
+    #define LV_FFMPEG_PLAYER_USE_YUV 0
+
+    /*Demux, decode and convert the frames of the video player on a worker thread. Requires LV_USE_PTHREAD.*/
+    #define LV_FFMPEG_PLAYER_USE_THREAD 0
+    #if LV_FFMPEG_PLAYER_USE_THREAD
+        /*Number of converted frame buffers (>= 2). One is shown, the others are filled ahead by the worker thread.*/
+        #define LV_FFMPEG_PLAYER_FRAME_CNT 4
+    #endif
+#endif
+
 /*-----------
  * Others
  *----------*/
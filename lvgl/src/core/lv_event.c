@@ -8,6 +8,7 @@
  *********************/
 #include "lv_obj.h"
 #include "lv_indev.h"
+#include "../misc/lv_thread.h"
 
 /*********************
  *      DEFINES
@@ -34,7 +35,7 @@ static bool event_is_bubbled(lv_event_t * e);
 /**********************
  *  STATIC VARIABLES
  **********************/
-static lv_event_t * event_head;
+static LV_DRAW_THREAD_LOCAL lv_event_t * event_head;
 
 /**********************
  *      MACROS
@@ -240,6 +241,19 @@ bool lv_obj_remove_event_dsc(lv_obj_t * obj, struct _lv_event_dsc_t * event_dsc)
     return false;
 }
 
+bool _lv_obj_has_event_cb(const lv_obj_t * obj, lv_event_code_t first, lv_event_code_t last)
+{
+    if(obj->spec_attr == NULL) return false;
+
+    int32_t i;
+    for(i = 0; i < obj->spec_attr->event_dsc_cnt; i++) {
+        lv_event_code_t filter = obj->spec_attr->event_dsc[i].filter;
+        if(filter == LV_EVENT_ALL || (filter >= first && filter <= last)) return true;
+    }
+
+    return false;
+}
+
 lv_indev_t * lv_event_get_indev(lv_event_t * e)
 {
 
@@ -404,6 +418,11 @@ static lv_res_t event_send_core(lv_event_t * e)
 {
     EVENT_TRACE("Sending event %d to %p with %p param", e->code, (void *)e->current_target, e->param);
 
+    /*Let the handlers use the coordinates of the object and its children.
+     *On scroll only the object's are updated to keep scrolling independent of the number of children.*/
+    if(e->code == LV_EVENT_SCROLL) _lv_obj_sync_coords(e->current_target);
+    else _lv_obj_sync_children_coords(e->current_target);
+
     /*Call the input device's feedback callback if set*/
     lv_indev_t * indev_act = lv_indev_get_act();
     if(indev_act) {
@@ -245,6 +245,16 @@ bool lv_obj_remove_event_cb_with_user_data(struct _lv_obj_t * obj, lv_event_cb_t
  */
 bool lv_obj_remove_event_dsc(struct _lv_obj_t * obj, struct _lv_event_dsc_t * event_dsc);
 
+/**
+ * Check if an object has an event handler for any of the events in a range.
+ * The handlers added with `LV_EVENT_ALL` are considered too.
+ * @param obj       pointer to an object
+ * @param first     the first event code of the range
+ * @param last      the last event code of the range
+ * @return          true: an event handler was found
+ */
+bool _lv_obj_has_event_cb(const struct _lv_obj_t * obj, lv_event_code_t first, lv_event_code_t last);
+
 /**
  * Get the input device passed as parameter to indev related events.
  * @param e     pointer to an event
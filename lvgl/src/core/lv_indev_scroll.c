@@ -231,6 +231,7 @@ lv_coord_t lv_indev_scroll_throw_predict(lv_indev_t * indev, lv_dir_t dir)
 
 void lv_indev_scroll_get_snap_dist(lv_obj_t * obj, lv_point_t * p)
 {
+    _lv_obj_sync_coords(obj);
     p->x = find_snap_point_x(obj, obj->coords.x1, obj->coords.x2, 0);
     p->y = find_snap_point_y(obj, obj->coords.y1, obj->coords.y2, 0);
 }
@@ -344,6 +345,8 @@ static lv_obj_t * find_scroll_obj(_lv_indev_proc_t * proc)
 static void init_scroll_limits(_lv_indev_proc_t * proc)
 {
     lv_obj_t * obj = proc->types.pointer.scroll_obj;
+    _lv_obj_sync_coords(obj);
+
     /*If there no STOP allow scrolling anywhere*/
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_SCROLL_ONE) == false) {
         lv_area_set(&proc->types.pointer.scroll_area, LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MAX, LV_COORD_MAX);
@@ -414,6 +417,8 @@ static lv_coord_t find_snap_point_x(const lv_obj_t * obj, lv_coord_t min, lv_coo
     lv_scroll_snap_t align = lv_obj_get_scroll_snap_x(obj);
     if(align == LV_SCROLL_SNAP_NONE) return 0;
 
+    _lv_obj_sync_children_coords(obj);
+
     lv_coord_t dist = LV_COORD_MAX;
 
     lv_coord_t pad_left = lv_obj_get_style_pad_left(obj, LV_PART_MAIN);
@@ -469,6 +474,8 @@ static lv_coord_t find_snap_point_y(const lv_obj_t * obj, lv_coord_t min, lv_coo
     lv_scroll_snap_t align = lv_obj_get_scroll_snap_y(obj);
     if(align == LV_SCROLL_SNAP_NONE) return 0;
 
+    _lv_obj_sync_children_coords(obj);
+
     lv_coord_t dist = LV_COORD_MAX;
 
     lv_coord_t pad_top = lv_obj_get_style_pad_top(obj, LV_PART_MAIN);
@@ -576,6 +583,9 @@ static lv_coord_t elastic_diff(lv_obj_t * scroll_obj, lv_coord_t diff, lv_coord_
         snap = dir == LV_DIR_HOR ? lv_obj_get_scroll_snap_x(scroll_obj) : lv_obj_get_scroll_snap_y(scroll_obj);
 
         lv_obj_t * act_obj = lv_indev_get_obj_act();
+        _lv_obj_sync_coords(scroll_obj);
+        if(act_obj) _lv_obj_sync_coords(act_obj);
+
         lv_coord_t snap_point = 0;
         lv_coord_t act_obj_point = 0;
 
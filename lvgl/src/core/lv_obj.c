@@ -137,6 +137,9 @@ void lv_init(void)
     _lv_refr_init();
 
     _lv_img_decoder_init();
+#if LV_USE_DRAW_SIMD
+    _lv_draw_blend_simd_init();
+#endif
 #if LV_IMG_CACHE_DEF_SIZE
     lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
 #endif
@@ -229,6 +232,9 @@ void lv_obj_add_flag(lv_obj_t * obj, lv_obj_flag_t f)
 
     if(f & LV_OBJ_FLAG_HIDDEN) lv_obj_invalidate(obj);
 
+    /*The pending scroll of the parent is applied only to the not floating children*/
+    if((f & LV_OBJ_FLAG_FLOATING) && obj->parent) _lv_obj_sync_children_coords(obj->parent);
+
     obj->flags |= f;
 
     if(f & LV_OBJ_FLAG_HIDDEN) {
@@ -259,6 +265,9 @@ void lv_obj_clear_flag(lv_obj_t * obj, lv_obj_flag_t f)
         lv_obj_invalidate_area(obj, &ver_area);
     }
 
+    /*The pending scroll of the parent is applied only to the not floating children*/
+    if((f & LV_OBJ_FLAG_FLOATING) && obj->parent) _lv_obj_sync_children_coords(obj->parent);
+
     obj->flags &= (~f);
 
     if(f & LV_OBJ_FLAG_HIDDEN) {
@@ -425,6 +434,8 @@ static void lv_obj_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     obj->flags |= LV_OBJ_FLAG_SCROLL_MOMENTUM;
     if(parent) obj->flags |= LV_OBJ_FLAG_GESTURE_BUBBLE;
 
+    obj->measure_inv = 1;
+
     LV_TRACE_OBJ_CREATE("finished");
 }
 
@@ -447,6 +458,9 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     if(group) lv_group_remove_obj(obj);
 
     if(obj->spec_attr) {
+        /*Don't leave a pending movement of the children behind*/
+        _lv_obj_sync_children_coords(obj);
+
         if(obj->spec_attr->children) {
             lv_mem_free(obj->spec_attr->children);
             obj->spec_attr->children = NULL;
@@ -455,10 +469,21 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
             lv_mem_free(obj->spec_attr->event_dsc);
             obj->spec_attr->event_dsc = NULL;
         }
+        if(obj->spec_attr->layout_cache) {
+            lv_mem_free(obj->spec_attr->layout_cache);
+            obj->spec_attr->layout_cache = NULL;
+        }
 
         lv_mem_free(obj->spec_attr);
         obj->spec_attr = NULL;
     }
+
+#if LV_OBJ_STYLE_CACHE_SIZE
+    if(obj->style_cache) {
+        lv_mem_free(obj->style_cache);
+        obj->style_cache = NULL;
+    }
+#endif
 }
 
 static void lv_obj_draw(lv_event_t * e)
@@ -863,6 +888,10 @@ static void lv_obj_set_state(lv_obj_t * obj, lv_state_t new_state)
     /*If there is no difference in styles there is nothing else to do*/
     if(cmp_res == _LV_STYLE_STATE_CMP_SAME) return;
 
+    _lv_obj_style_cache_invalidate(obj);    /*The children might inherit different values*/
+
+    obj->measure_inv = 1;
+
     _lv_obj_style_transition_dsc_t * ts = lv_mem_buf_get(sizeof(_lv_obj_style_transition_dsc_t) * STYLE_TRANSITION_MAX);
     lv_memset_00(ts, sizeof(_lv_obj_style_transition_dsc_t) * STYLE_TRANSITION_MAX);
     uint32_t tsi = 0;
@@ -152,6 +152,8 @@ typedef struct {
 
     struct _lv_event_dsc_t * event_dsc; /**< Dynamically allocated event callback and user data array*/
     lv_point_t scroll;                  /**< The current X/Y scroll offset*/
+    lv_point_t scroll_pending;          /**< Movement of the not floating children not applied yet*/
+    lv_point_t move_pending;            /**< Movement of all the children not applied yet*/
 
     lv_coord_t ext_click_pad;           /**< Extra click padding in all direction*/
     lv_coord_t ext_draw_size;           /**< EXTend the size in every direction for drawing.*/
@@ -161,6 +163,8 @@ typedef struct {
     lv_scroll_snap_t scroll_snap_y : 2;     /**< Where to align the snappable children vertically*/
     lv_dir_t scroll_dir : 4;                /**< The allowed scroll direction(s)*/
     uint8_t event_dsc_cnt;                  /**< Number of event callbacks stored in `event_dsc` array*/
+
+    void * layout_cache;                    /**< Measurements of the children cached by the layout*/
 } _lv_obj_spec_attr_t;
 
 typedef struct _lv_obj_t {
@@ -168,6 +172,9 @@ typedef struct _lv_obj_t {
     struct _lv_obj_t * parent;
     _lv_obj_spec_attr_t * spec_attr;
     _lv_obj_style_t * styles;
+#if LV_OBJ_STYLE_CACHE_SIZE
+    _lv_obj_style_cache_t * style_cache;
+#endif
 #if LV_USE_USER_DATA
     void * user_data;
 #endif
@@ -175,11 +182,13 @@ typedef struct _lv_obj_t {
     lv_obj_flag_t flags;
     lv_state_t state;
     uint16_t layout_inv : 1;
+    uint16_t child_layout_inv : 1;  /*A descendant has `layout_inv` set*/
     uint16_t scr_layout_inv : 1;
     uint16_t skip_trans : 1;
     uint16_t style_cnt  : 6;
     uint16_t h_layout   : 1;
     uint16_t w_layout   : 1;
+    uint16_t measure_inv : 1;       /*The layout of the parent needs to read the style properties again*/
 } lv_obj_t;
 
 
@@ -84,6 +84,9 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
             lv_obj_allocate_spec_attr(parent);
         }
 
+        /*The pending movement of the parent shouldn't be applied to the new child*/
+        _lv_obj_sync_children_coords(parent);
+
         if(parent->spec_attr->children == NULL) {
             parent->spec_attr->children = lv_mem_alloc(sizeof(lv_obj_t *));
             parent->spec_attr->children[0] = obj;
@@ -26,11 +26,17 @@
 static lv_coord_t calc_content_width(lv_obj_t * obj);
 static lv_coord_t calc_content_height(lv_obj_t * obj);
 static void layout_update_core(lv_obj_t * obj);
+static void move_children_pending(lv_obj_t * obj);
+static void add_pending(lv_obj_t * obj, lv_point_t * pending, lv_coord_t x, lv_coord_t y);
+static bool has_pending(const lv_obj_t * obj);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint32_t layout_cnt;
+static lv_layout_stats_t layout_stats;
+static lv_layout_monitor_cb_t layout_monitor_cb;
+static uint32_t pending_cnt;    /*Number of objects whose children have a not applied movement*/
 
 /**********************
  *      MACROS
@@ -86,6 +92,8 @@ bool lv_obj_refr_size(lv_obj_t * obj)
     lv_obj_t * parent = lv_obj_get_parent(obj);
     if(parent == NULL) return false;
 
+    _lv_obj_sync_coords(obj);
+
     lv_coord_t sl_ori = lv_obj_get_scroll_left(obj);
     bool w_is_content = false;
     bool w_is_pct = false;
@@ -286,8 +294,14 @@ void lv_obj_mark_layout_as_dirty(lv_obj_t * obj)
 {
     obj->layout_inv = 1;
 
+    /*Mark the path to the object to skip the clean subtrees when updating the layout*/
+    lv_obj_t * scr = obj;
+    while(scr->parent) {
+        scr = scr->parent;
+        scr->child_layout_inv = 1;
+    }
+
     /*Mark the screen as dirty too to mark that there is something to do on this screen*/
-    lv_obj_t * scr = lv_obj_get_screen(obj);
     scr->scr_layout_inv = 1;
 
     /*Make the display refreshing*/
@@ -306,17 +320,31 @@ void lv_obj_update_layout(const lv_obj_t * obj)
 
     lv_obj_t * scr = lv_obj_get_screen(obj);
 
+    lv_memset_00(&layout_stats, sizeof(layout_stats));
+    uint32_t start = lv_tick_get();
+
     /*Repeat until there where layout invalidations*/
     while(scr->scr_layout_inv) {
         LV_LOG_INFO("Layout update begin");
         scr->scr_layout_inv = 0;
+        layout_stats.pass_cnt++;
         layout_update_core(scr);
         LV_LOG_TRACE("Layout update end");
     }
 
+    if(layout_monitor_cb && layout_stats.pass_cnt) {
+        layout_stats.time = lv_tick_elaps(start);
+        layout_monitor_cb(scr, &layout_stats);
+    }
+
     mutex = false;
 }
 
+void lv_layout_set_monitor_cb(lv_layout_monitor_cb_t cb)
+{
+    layout_monitor_cb = cb;
+}
+
 uint32_t lv_layout_register(lv_layout_update_cb_t cb, void * user_data)
 {
     layout_cnt++;
@@ -328,6 +356,39 @@ uint32_t lv_layout_register(lv_layout_update_cb_t cb, void * user_data)
     return layout_cnt;  /*No -1 to skip 0th index*/
 }
 
+void * _lv_layout_get_cache(lv_obj_t * cont, uint32_t layout, uint32_t size)
+{
+    lv_obj_allocate_spec_attr(cont);
+
+    lv_layout_cache_t * cache = cont->spec_attr->layout_cache;
+    if(cache && cache->layout != layout) {
+        lv_mem_free(cache);
+        cache = NULL;
+    }
+    if(cache && cache->size == size) return cache;
+
+    uint32_t old_size = cache ? cache->size : 0;
+    lv_layout_cache_t * new_cache = lv_mem_realloc(cache, size);
+    LV_ASSERT_MALLOC(new_cache);
+    if(new_cache == NULL) {
+        lv_mem_free(cache);
+        cont->spec_attr->layout_cache = NULL;
+        return NULL;
+    }
+
+    if(size > old_size) lv_memset_00((uint8_t *)new_cache + old_size, size - old_size);
+    new_cache->layout = layout;
+    new_cache->size = size;
+    cont->spec_attr->layout_cache = new_cache;
+
+    return new_cache;
+}
+
+lv_layout_stats_t * _lv_layout_get_stats(void)
+{
+    return &layout_stats;
+}
+
 void lv_obj_set_align(lv_obj_t * obj, lv_align_t align)
 {
     lv_obj_set_style_align(obj, align, 0);
@@ -352,6 +413,8 @@ void lv_obj_align_to(lv_obj_t * obj, const lv_obj_t * base, lv_align_t align, lv
     lv_coord_t y = 0;
 
     lv_obj_t * parent = lv_obj_get_parent(obj);
+    _lv_obj_sync_coords(base);
+    _lv_obj_sync_coords(obj);
     lv_coord_t pborder = lv_obj_get_style_border_width(parent, LV_PART_MAIN);
     lv_coord_t pleft = lv_obj_get_style_pad_left(parent, LV_PART_MAIN) + pborder;
     lv_coord_t ptop = lv_obj_get_style_pad_top(parent, LV_PART_MAIN) + pborder;
@@ -485,6 +548,7 @@ void lv_obj_get_coords(const lv_obj_t * obj, lv_area_t * coords)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    _lv_obj_sync_coords(obj);
     lv_area_copy(coords, &obj->coords);
 }
 
@@ -492,6 +556,8 @@ lv_coord_t lv_obj_get_x(const lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    _lv_obj_sync_coords(obj);
+
     lv_coord_t rel_x;
     lv_obj_t * parent = lv_obj_get_parent(obj);
     if(parent) {
@@ -517,6 +583,8 @@ lv_coord_t lv_obj_get_y(const lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    _lv_obj_sync_coords(obj);
+
     lv_coord_t rel_y;
     lv_obj_t * parent = lv_obj_get_parent(obj);
     if(parent) {
@@ -693,6 +761,8 @@ void lv_obj_refr_pos(lv_obj_t * obj)
 
 void lv_obj_move_to(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
 {
+    _lv_obj_sync_coords(obj);
+
     /*Convert x and y to absolute coordinates*/
     lv_obj_t * parent = obj->parent;
 
@@ -766,17 +836,53 @@ void lv_obj_move_to(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
 
 void lv_obj_move_children_by(lv_obj_t * obj, lv_coord_t x_diff, lv_coord_t y_diff, bool ignore_floating)
 {
+    if(lv_obj_get_child_cnt(obj) == 0) return;
+
+    /*Just save the movement. It's applied when the children are used.*/
+    if(ignore_floating) add_pending(obj, &obj->spec_attr->scroll_pending, x_diff, y_diff);
+    else add_pending(obj, &obj->spec_attr->move_pending, x_diff, y_diff);
+}
+
+void _lv_obj_sync_coords(const lv_obj_t * obj)
+{
+    if(pending_cnt == 0) return;
+
+    /*The drawn objects were synchronized before the rendering threads started*/
+    if(_lv_refr_is_parallel()) return;
+
+    lv_obj_t * parent = obj->parent;
+    if(parent == NULL) return;
+
+    _lv_obj_sync_coords(parent);
+    move_children_pending(parent);
+}
+
+void _lv_obj_sync_children_coords(const lv_obj_t * obj)
+{
+    if(pending_cnt == 0) return;
+    if(_lv_refr_is_parallel()) return;
+
+    _lv_obj_sync_coords(obj);
+    move_children_pending((lv_obj_t *)obj);
+}
+
+void _lv_obj_sync_area_coords(lv_obj_t * obj, const lv_area_t * area)
+{
+    if(pending_cnt == 0) return;
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+
+    lv_area_t obj_area;
+    lv_coord_t ext_size = _lv_obj_get_ext_draw_size(obj);
+    lv_area_copy(&obj_area, &obj->coords);
+    lv_area_increase(&obj_area, ext_size, ext_size);
+    if(_lv_area_is_on(&obj_area, area) == false) return;
+
+    move_children_pending(obj);
+
     uint32_t i;
     uint32_t child_cnt = lv_obj_get_child_cnt(obj);
     for(i = 0; i < child_cnt; i++) {
-        lv_obj_t * child = obj->spec_attr->children[i];
-        if(ignore_floating && lv_obj_has_flag(child, LV_OBJ_FLAG_FLOATING)) continue;
-        child->coords.x1 += x_diff;
-        child->coords.y1 += y_diff;
-        child->coords.x2 += x_diff;
-        child->coords.y2 += y_diff;
-
-        lv_obj_move_children_by(child, x_diff, y_diff, false);
+        _lv_obj_sync_area_coords(obj->spec_attr->children[i], area);
     }
 }
 
@@ -785,6 +891,8 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    _lv_obj_sync_coords(obj);
+
     lv_area_t area_tmp;
     lv_area_copy(&area_tmp, area);
     bool visible = lv_obj_area_is_visible(obj, &area_tmp);
@@ -796,6 +904,8 @@ void lv_obj_invalidate(const lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    _lv_obj_sync_coords(obj);
+
     /*Truncate the area to the object*/
     lv_area_t obj_coords;
     lv_coord_t ext_size = _lv_obj_get_ext_draw_size(obj);
@@ -813,6 +923,8 @@ bool lv_obj_area_is_visible(const lv_obj_t * obj, lv_area_t * area)
 {
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return false;
 
+    _lv_obj_sync_coords(obj);
+
     /*Invalidate the object only if it belongs to the current or previous'*/
     lv_obj_t * obj_scr = lv_obj_get_screen(obj);
     lv_disp_t * disp   = lv_obj_get_disp(obj_scr);
@@ -855,6 +967,8 @@ bool lv_obj_is_visible(const lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    _lv_obj_sync_coords(obj);
+
     lv_area_t obj_coords;
     lv_coord_t ext_size = _lv_obj_get_ext_draw_size(obj);
     lv_area_copy(&obj_coords, &obj->coords);
@@ -877,6 +991,7 @@ void lv_obj_set_ext_click_area(lv_obj_t * obj, lv_coord_t size)
 
 void lv_obj_get_click_area(const lv_obj_t * obj, lv_area_t * area)
 {
+    _lv_obj_sync_coords(obj);
     lv_area_copy(area, &obj->coords);
     if(obj->spec_attr) {
         area->x1 -= obj->spec_attr->ext_click_pad;
@@ -927,6 +1042,7 @@ lv_coord_t lv_clamp_height(lv_coord_t height, lv_coord_t min_height, lv_coord_t
 static lv_coord_t calc_content_width(lv_obj_t * obj)
 {
     lv_obj_scroll_to_x(obj, 0, LV_ANIM_OFF);
+    _lv_obj_sync_children_coords(obj);
 
     lv_coord_t border_width = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
     lv_coord_t pad_right = lv_obj_get_style_pad_right(obj, LV_PART_MAIN) + border_width;
@@ -1009,6 +1125,7 @@ static lv_coord_t calc_content_width(lv_obj_t * obj)
 static lv_coord_t calc_content_height(lv_obj_t * obj)
 {
     lv_obj_scroll_to_y(obj, 0, LV_ANIM_OFF);
+    _lv_obj_sync_children_coords(obj);
 
     lv_coord_t border_width = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
     lv_coord_t pad_top = lv_obj_get_style_pad_top(obj, LV_PART_MAIN) + border_width;
@@ -1059,16 +1176,24 @@ static lv_coord_t calc_content_height(lv_obj_t * obj)
 
 static void layout_update_core(lv_obj_t * obj)
 {
+    layout_stats.visit_cnt++;
+
     uint32_t i;
     uint32_t child_cnt = lv_obj_get_child_cnt(obj);
-    for(i = 0; i < child_cnt; i++) {
-        lv_obj_t * child = obj->spec_attr->children[i];
-        layout_update_core(child);
+
+    /*Go only into the children which are dirty or have dirty descendants*/
+    if(obj->child_layout_inv) {
+        obj->child_layout_inv = 0;
+        for(i = 0; i < child_cnt; i++) {
+            lv_obj_t * child = obj->spec_attr->children[i];
+            if(child->layout_inv || child->child_layout_inv) layout_update_core(child);
+        }
     }
 
     if(obj->layout_inv == 0) return;
 
     obj->layout_inv = 0;
+    layout_stats.refr_cnt++;
 
     lv_obj_refr_size(obj);
     lv_obj_refr_pos(obj);
@@ -1076,8 +1201,64 @@ static void layout_update_core(lv_obj_t * obj)
     if(child_cnt > 0) {
         uint32_t layout_id = lv_obj_get_style_layout(obj, LV_PART_MAIN);
         if(layout_id > 0 && layout_id <= layout_cnt) {
+            _lv_obj_sync_children_coords(obj);
             void  * user_data = LV_GC_ROOT(_lv_layout_list)[layout_id - 1].user_data;
             LV_GC_ROOT(_lv_layout_list)[layout_id - 1].cb(obj, user_data);
         }
     }
 }
+
+/**
+ * Apply the pending movement of an object to its children.
+ * The movement of the grandchildren is only added to the children's pending movement.
+ * @param obj       pointer to an object whose coordinates are up-to-date
+ */
+static void move_children_pending(lv_obj_t * obj)
+{
+    if(has_pending(obj) == false) return;
+
+    lv_point_t scroll = obj->spec_attr->scroll_pending;
+    lv_point_t move = obj->spec_attr->move_pending;
+    lv_memset_00(&obj->spec_attr->scroll_pending, sizeof(lv_point_t));
+    lv_memset_00(&obj->spec_attr->move_pending, sizeof(lv_point_t));
+    pending_cnt--;
+
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+    for(i = 0; i < child_cnt; i++) {
+        lv_obj_t * child = obj->spec_attr->children[i];
+        lv_coord_t x = move.x;
+        lv_coord_t y = move.y;
+        if(lv_obj_has_flag(child, LV_OBJ_FLAG_FLOATING) == false) {
+            x += scroll.x;
+            y += scroll.y;
+        }
+        if(x == 0 && y == 0) continue;
+
+        child->coords.x1 += x;
+        child->coords.y1 += y;
+        child->coords.x2 += x;
+        child->coords.y2 += y;
+
+        if(lv_obj_get_child_cnt(child)) add_pending(child, &child->spec_attr->move_pending, x, y);
+    }
+}
+
+static void add_pending(lv_obj_t * obj, lv_point_t * pending, lv_coord_t x, lv_coord_t y)
+{
+    bool was_pending = has_pending(obj);
+    pending->x += x;
+    pending->y += y;
+
+    bool is_pending = has_pending(obj);
+    if(!was_pending && is_pending) pending_cnt++;
+    else if(was_pending && !is_pending) pending_cnt--;
+}
+
+static bool has_pending(const lv_obj_t * obj)
+{
+    if(obj->spec_attr == NULL) return false;
+
+    return obj->spec_attr->scroll_pending.x || obj->spec_attr->scroll_pending.y ||
+           obj->spec_attr->move_pending.x || obj->spec_attr->move_pending.y;
+}
@@ -30,6 +30,34 @@ typedef struct {
     void * user_data;
 } lv_layout_dsc_t;
 
+/**
+ * Statistics about an update of the layouts of a screen
+ */
+typedef struct {
+    uint32_t visit_cnt;     /**< Number of objects visited to find the dirty ones*/
+    uint32_t refr_cnt;      /**< Number of dirty objects whose size, position and layout were recalculated*/
+    uint32_t pass_cnt;      /**< Number of passes. More passes are required if the layouts make other objects dirty*/
+    uint32_t measure_cnt;   /**< Number of children whose style properties were read again by the layouts*/
+    uint32_t arrange_cnt;   /**< Number of containers whose children were repositioned by the layouts*/
+    uint32_t time;          /**< Time spent with updating the layouts [ms]*/
+} lv_layout_stats_t;
+
+/**
+ * Header of the cache a layout can store in its containers.
+ * The layouts extend it with their own data.
+ */
+typedef struct {
+    uint32_t layout;        /**< ID of the layout which created the cache*/
+    uint32_t size;          /**< Size of the whole cache in bytes*/
+} lv_layout_cache_t;
+
+/**
+ * Called after the layouts of a screen were updated
+ * @param scr       pointer to the screen whose layout was updated
+ * @param stats     statistics about the update
+ */
+typedef void (*lv_layout_monitor_cb_t)(struct _lv_obj_t * scr, const lv_layout_stats_t * stats);
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -136,10 +164,17 @@ void lv_obj_mark_layout_as_dirty(struct _lv_obj_t * obj);
 
 /**
  * Update the layout of an object.
+ * Only the dirty objects and their parents are visited.
  * @param obj      pointer to an object whose children needs to be updated
  */
 void lv_obj_update_layout(const struct _lv_obj_t * obj);
 
+/**
+ * Set a callback to profile the layout updates. It's called when the layout of a screen was updated.
+ * @param cb        the callback or `NULL` to not profile the layout updates
+ */
+void lv_layout_set_monitor_cb(lv_layout_monitor_cb_t cb);
+
 /**
  * Regsiter a new layout
  * @param cb        the layout update callback
@@ -148,6 +183,23 @@ void lv_obj_update_layout(const struct _lv_obj_t * obj);
  */
 uint32_t lv_layout_register(lv_layout_update_cb_t cb, void * user_data);
 
+/**
+ * Get the cache of a layout from a container. The cache is kept until the object is deleted.
+ * If the cache was created by an other layout it's dropped. If only its size is different it's resized.
+ * The newly allocated bytes are set to zero.
+ * @param cont      pointer to a container
+ * @param layout    ID of the layout which uses the cache
+ * @param size      the required size of the cache in bytes including the `lv_layout_cache_t` header
+ * @return          pointer to the cache or `NULL` if out of memory
+ */
+void * _lv_layout_get_cache(struct _lv_obj_t * cont, uint32_t layout, uint32_t size);
+
+/**
+ * Get the statistics of the ongoing layout update to let the layouts add their own counters
+ * @return          pointer to the statistics
+ */
+lv_layout_stats_t * _lv_layout_get_stats(void);
+
 /**
  * Change the alignment of an object.
  * @param obj       pointer to an object to align
@@ -319,9 +371,37 @@ void lv_obj_refr_pos(struct _lv_obj_t * obj);
 
 void lv_obj_move_to(struct _lv_obj_t * obj, lv_coord_t x, lv_coord_t y);
 
-
+/**
+ * Move the children of an object.
+ * The movement is only saved and applied to the children when their coordinates are used.
+ * Therefore `obj->coords` of the descendants shouldn't be read directly, use `lv_obj_get_coords()` instead.
+ * @param obj               pointer to an object
+ * @param x_diff            the horizontal movement
+ * @param y_diff            the vertical movement
+ * @param ignore_floating   true: don't move the children with `LV_OBJ_FLAG_FLOATING`
+ */
 void lv_obj_move_children_by(struct _lv_obj_t * obj, lv_coord_t x_diff, lv_coord_t y_diff, bool ignore_floating);
 
+/**
+ * Apply the pending movement of the parents to an object to make its `coords` up-to-date.
+ * @param obj       pointer to an object
+ */
+void _lv_obj_sync_coords(const struct _lv_obj_t * obj);
+
+/**
+ * Make the `coords` of an object and its children up-to-date.
+ * @param obj       pointer to an object
+ */
+void _lv_obj_sync_children_coords(const struct _lv_obj_t * obj);
+
+/**
+ * Make the `coords` of the descendants of an object up-to-date where they might be drawn on an area.
+ * Used before rendering in more threads to not modify the coordinates while drawing.
+ * @param obj       pointer to an object whose `coords` is up-to-date
+ * @param area      the area to draw
+ */
+void _lv_obj_sync_area_coords(struct _lv_obj_t * obj, const lv_area_t * area);
+
 /**
  * Mark an area of an object as invalid.
  * The area will be truncated to the object's area and marked for redraw.
@@ -11,6 +11,7 @@
 #include "lv_indev.h"
 #include "lv_disp.h"
 #include "lv_indev_scroll.h"
+#include "lv_refr.h"
 
 /*********************
  *      DEFINES
@@ -32,6 +33,8 @@
  *  STATIC PROTOTYPES
  **********************/
 static void scroll_by_raw(lv_obj_t * obj, lv_coord_t x, lv_coord_t y);
+static bool scroll_blit(lv_obj_t * obj, lv_coord_t x, lv_coord_t y);
+static bool is_drawn_on(lv_obj_t * obj, const lv_area_t * area);
 static void scroll_x_anim(void * obj, int32_t v);
 static void scroll_y_anim(void * obj, int32_t v);
 static void scroll_anim_ready_cb(lv_anim_t * a);
@@ -136,6 +139,8 @@ lv_coord_t lv_obj_get_scroll_bottom(lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    _lv_obj_sync_children_coords(obj);
+
     lv_coord_t child_res = LV_COORD_MIN;
     uint32_t i;
     uint32_t child_cnt = lv_obj_get_child_cnt(obj);
@@ -175,6 +180,8 @@ lv_coord_t lv_obj_get_scroll_left(lv_obj_t * obj)
     lv_coord_t pad_left = lv_obj_get_style_pad_left(obj, LV_PART_MAIN);
     lv_coord_t border_width = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
 
+    _lv_obj_sync_children_coords(obj);
+
     lv_coord_t child_res = 0;
 
     uint32_t i;
@@ -214,6 +221,8 @@ lv_coord_t lv_obj_get_scroll_right(lv_obj_t * obj)
     }
 
     /*With other base direction (LTR) scrolling to the right is normal so find the right most coordinate*/
+    _lv_obj_sync_children_coords(obj);
+
     lv_coord_t child_res = LV_COORD_MIN;
     uint32_t i;
     uint32_t child_cnt = lv_obj_get_child_cnt(obj);
@@ -366,6 +375,8 @@ void lv_obj_scroll_to_view(lv_obj_t * obj, lv_anim_enable_t anim_en)
     /*Be sure the screens layout is correct*/
     lv_obj_update_layout(obj);
 
+    _lv_obj_sync_coords(obj);
+
     lv_point_t p = {0, 0};
     scroll_area_into_view(&obj->coords, obj, &p, anim_en);
 }
@@ -379,6 +390,8 @@ void lv_obj_scroll_to_view_recursive(lv_obj_t * obj, lv_anim_enable_t anim_en)
     lv_obj_t * child = obj;
     lv_obj_t * parent = lv_obj_get_parent(child);
     while(parent) {
+        /*Scrolling the parent has moved the object*/
+        _lv_obj_sync_coords(obj);
         scroll_area_into_view(&obj->coords, child, &p, anim_en);
         child = parent;
         parent = lv_obj_get_parent(parent);
@@ -411,6 +424,8 @@ void lv_obj_get_scrollbar_area(lv_obj_t * obj, lv_area_t * hor_area, lv_area_t *
 
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_SCROLLABLE) == false) return;
 
+    _lv_obj_sync_coords(obj);
+
     lv_dir_t sm = lv_obj_get_scrollbar_mode(obj);
     if(sm == LV_SCROLLBAR_MODE_OFF)  return;
 
@@ -624,7 +639,134 @@ static void scroll_by_raw(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
     lv_obj_move_children_by(obj, x, y, true);
     lv_res_t res = lv_event_send(obj, LV_EVENT_SCROLL, NULL);
     if(res != LV_RES_OK) return;
-    lv_obj_invalidate(obj);
+    if(scroll_blit(obj, x, y) == false) lv_obj_invalidate(obj);
+}
+
+/**
+ * Move the already drawn content of a scrolled object in the frame buffer instead of redrawing it.
+ * It's possible only if the object has a plain opaque background and nothing else is drawn on it.
+ * @param obj       pointer to the scrolled object
+ * @param x         the distance the children were moved horizontally
+ * @param y         the distance the children were moved vertically
+ * @return          true: the content will be moved; false: the object should be invalidated
+ */
+static bool scroll_blit(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
+{
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+    if(disp->driver->scroll_blit == 0) return false;
+    if(disp->prev_scr || lv_obj_get_screen(obj) != disp->act_scr) return false;
+
+    /*The widgets can draw anything on their content so allow only plain objects*/
+    const lv_obj_class_t * class_p;
+    for(class_p = obj->class_p; class_p && class_p != &lv_obj_class; class_p = class_p->base_class) {
+        if(class_p->event_cb) return false;
+    }
+    if(_lv_obj_has_event_cb(obj, LV_EVENT_COVER_CHECK, LV_EVENT_DRAW_PART_END)) return false;
+
+    /*The background is moved with the content so it needs to be a single opaque color*/
+    if(lv_obj_get_style_bg_opa(obj, LV_PART_MAIN) < LV_OPA_COVER) return false;
+    if(lv_obj_get_style_opa(obj, LV_PART_MAIN) < LV_OPA_COVER) return false;
+    if(lv_obj_get_style_blend_mode(obj, LV_PART_MAIN) != LV_BLEND_MODE_NORMAL) return false;
+    if(lv_obj_get_style_bg_grad_dir(obj, LV_PART_MAIN) != LV_GRAD_DIR_NONE) return false;
+    if(lv_obj_get_style_bg_img_src(obj, LV_PART_MAIN) != NULL) return false;
+    if(lv_obj_get_style_radius(obj, LV_PART_MAIN) != 0) return false;
+
+    /*The border and the scrollbars stay in place*/
+    lv_coord_t inset = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    if(lv_obj_get_scrollbar_mode(obj) != LV_SCROLLBAR_MODE_OFF) {
+        lv_coord_t sb_inset = lv_obj_get_style_pad_right(obj, LV_PART_SCROLLBAR) +
+                              lv_obj_get_style_width(obj, LV_PART_SCROLLBAR);
+        inset = LV_MAX(inset, sb_inset);
+    }
+
+    lv_area_t area;
+    lv_area_copy(&area, &obj->coords);
+    lv_area_increase(&area, -inset, -inset);
+    if(lv_obj_area_is_visible(obj, &area) == false) return false;
+
+    /*Nothing else can be drawn on the area: the younger siblings of the object and its parents,
+     *the scrollbars of the parents and the layers*/
+    lv_obj_t * child = obj;
+    lv_obj_t * parent = lv_obj_get_parent(obj);
+    while(parent) {
+        if(_lv_obj_has_event_cb(parent, LV_EVENT_DRAW_POST_BEGIN, LV_EVENT_DRAW_POST_END)) return false;
+
+        lv_area_t hor_area;
+        lv_area_t ver_area;
+        lv_obj_get_scrollbar_area(parent, &hor_area, &ver_area);
+        if(_lv_area_is_on(&area, &hor_area) || _lv_area_is_on(&area, &ver_area)) return false;
+
+        uint32_t child_cnt = lv_obj_get_child_cnt(parent);
+        uint32_t i;
+        for(i = lv_obj_get_index(child) + 1; i < child_cnt; i++) {
+            if(is_drawn_on(lv_obj_get_child(parent, i), &area)) return false;
+        }
+
+        child = parent;
+        parent = lv_obj_get_parent(parent);
+    }
+
+    lv_obj_t * layers[2] = {lv_disp_get_layer_top(disp), lv_disp_get_layer_sys(disp)};
+    uint32_t l;
+    for(l = 0; l < 2; l++) {
+        if(lv_obj_get_style_bg_opa(layers[l], LV_PART_MAIN) > LV_OPA_TRANSP) return false;
+        uint32_t child_cnt = lv_obj_get_child_cnt(layers[l]);
+        uint32_t i;
+        for(i = 0; i < child_cnt; i++) {
+            if(is_drawn_on(lv_obj_get_child(layers[l], i), &area)) return false;
+        }
+    }
+
+    if(_lv_refr_scroll_blit(disp, &area, x, y) == false) return false;
+
+    /*Redraw the frame around the moved area*/
+    lv_area_t band;
+    lv_area_set(&band, obj->coords.x1, obj->coords.y1, obj->coords.x2, area.y1 - 1);
+    lv_obj_invalidate_area(obj, &band);
+    lv_area_set(&band, obj->coords.x1, area.y2 + 1, obj->coords.x2, obj->coords.y2);
+    lv_obj_invalidate_area(obj, &band);
+    lv_area_set(&band, obj->coords.x1, area.y1, area.x1 - 1, area.y2);
+    lv_obj_invalidate_area(obj, &band);
+    lv_area_set(&band, area.x2 + 1, area.y1, obj->coords.x2, area.y2);
+    lv_obj_invalidate_area(obj, &band);
+
+    /*The floating children were not scrolled but their image was moved*/
+    uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+    uint32_t i;
+    for(i = 0; i < child_cnt; i++) {
+        child = lv_obj_get_child(obj, i);
+        if(!lv_obj_has_flag(child, LV_OBJ_FLAG_FLOATING) || lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) continue;
+
+        lv_obj_invalidate(child);
+
+        lv_area_t moved;
+        lv_coord_t ext_size = _lv_obj_get_ext_draw_size(child);
+        lv_area_copy(&moved, &child->coords);
+        lv_area_increase(&moved, ext_size, ext_size);
+        lv_area_move(&moved, x, y);
+        lv_obj_invalidate_area(obj, &moved);
+    }
+
+    return true;
+}
+
+/**
+ * Check if an object or its children can draw on an area
+ * @param obj       pointer to an object
+ * @param area      the area to check
+ * @return          true: the object is visible and its draw area is on `area`
+ */
+static bool is_drawn_on(lv_obj_t * obj, const lv_area_t * area)
+{
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return false;
+
+    _lv_obj_sync_coords(obj);
+
+    lv_area_t draw_area;
+    lv_coord_t ext_size = _lv_obj_get_ext_draw_size(obj);
+    lv_area_copy(&draw_area, &obj->coords);
+    lv_area_increase(&draw_area, ext_size, ext_size);
+    return _lv_area_is_on(&draw_area, area);
 }
 
 static void scroll_x_anim(void * obj, int32_t v)
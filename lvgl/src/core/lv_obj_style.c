@@ -8,13 +8,37 @@
  *********************/
 #include "lv_obj.h"
 #include "lv_disp.h"
+#include "lv_refr.h"
 #include "../misc/lv_gc.h"
 
+#if LV_OBJ_STYLE_CACHE_SIZE && LV_USE_REFR_PARALLEL
+#include <stdatomic.h>
+#endif
+
 /*********************
  *      DEFINES
  *********************/
 #define MY_CLASS &lv_obj_class
 
+#if LV_OBJ_STYLE_CACHE_SIZE
+#if (LV_OBJ_STYLE_CACHE_SIZE & (LV_OBJ_STYLE_CACHE_SIZE - 1)) != 0
+#error "LV_OBJ_STYLE_CACHE_SIZE must be a power of 2"
+#endif
+
+/*Check this many entries after the first free or matching entry of a property*/
+#define STYLE_CACHE_PROBE_MAX   4
+
+/*The rendering threads read the caches without locking while they might be filled by an other thread,
+ *so the value of an entry is written before its key and read after it*/
+#if LV_USE_REFR_PARALLEL
+#define STYLE_CACHE_KEY_LOAD(k)     atomic_load_explicit(&(k), memory_order_acquire)
+#define STYLE_CACHE_KEY_STORE(k, v) atomic_store_explicit(&(k), (v), memory_order_release)
+#else
+#define STYLE_CACHE_KEY_LOAD(k)     (k)
+#define STYLE_CACHE_KEY_STORE(k, v) (k) = (v)
+#endif
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -35,6 +59,21 @@ typedef enum {
     CACHE_NEED_CHECK = 4,
 } cache_t;
 
+#if LV_OBJ_STYLE_CACHE_SIZE
+#if LV_USE_REFR_PARALLEL
+typedef _Atomic uint32_t style_cache_key_t;
+#else
+typedef uint32_t style_cache_key_t;
+#endif
+
+struct _lv_obj_style_cache_t {
+    lv_state_t state;                                   /*The state the values were resolved in*/
+    uint8_t valid;                                      /*0: a style of the object or its parents has changed*/
+    style_cache_key_t keys[LV_OBJ_STYLE_CACHE_SIZE];    /*`prop | part` of the values or 0 for free entries*/
+    lv_style_value_t values[LV_OBJ_STYLE_CACHE_SIZE];   /*The final values (with color filter applied)*/
+};
+#endif
+
 /**********************
  *  GLOBAL PROTOTYPES
  **********************/
@@ -44,7 +83,13 @@ typedef enum {
  **********************/
 static lv_style_t * get_local_style(lv_obj_t * obj, lv_style_selector_t selector);
 static _lv_obj_style_t * get_trans_style(lv_obj_t * obj, uint32_t part);
+static lv_style_value_t resolve_prop(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
 static bool get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, lv_style_value_t * v);
+#if LV_OBJ_STYLE_CACHE_SIZE
+static bool style_cache_get(const lv_obj_t * obj, uint32_t key, lv_style_value_t * v);
+static void style_cache_set(lv_obj_t * obj, uint32_t key, lv_style_value_t v);
+#endif
+static void style_cache_invalidate(lv_obj_t * obj, lv_style_prop_t prop);
 static lv_style_value_t apply_color_filter(const lv_obj_t * obj, uint32_t part, lv_style_value_t v);
 static void report_style_change_core(void * style, lv_obj_t * obj);
 static void refresh_children_style(lv_obj_t * obj);
@@ -59,6 +104,10 @@ static void fade_in_anim_ready(lv_anim_t * a);
  *  STATIC VARIABLES
  **********************/
 static bool style_refr = true;
+static LV_DRAW_THREAD_LOCAL lv_obj_style_stats_t style_stats;   /*The counters of the calling thread*/
+#if LV_USE_REFR_PARALLEL
+static lv_obj_style_stats_t style_stats_workers;                /*Added by the rendering workers*/
+#endif
 
 /**********************
  *      MACROS
@@ -75,6 +124,16 @@ void _lv_obj_style_init(void)
 
 void lv_obj_add_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t selector)
 {
+#if LV_USE_ASSERT_STYLE
+    if(style->is_const) {
+        const lv_style_const_prop_t * const_prop;
+        for(const_prop = style->v_p.const_props; const_prop->prop != LV_STYLE_PROP_INV; const_prop++) {
+            LV_ASSERT_MSG(style->has_group & LV_STYLE_PROP_GROUP_BIT(const_prop->prop),
+                          "The group of a property is missing from the groups of the const style");
+        }
+    }
+#endif
+
     trans_del(obj, selector, LV_STYLE_PROP_ANY, NULL);
 
     uint32_t i;
@@ -152,7 +211,10 @@ void lv_obj_remove_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t
 
 void lv_obj_report_style_change(lv_style_t * style)
 {
+    /*The style caches of the objects need to be dropped even if the refresh is disabled*/
+#if LV_OBJ_STYLE_CACHE_SIZE == 0
     if(!style_refr) return;
+#endif
     lv_disp_t * d = lv_disp_get_next(NULL);
 
     while(d) {
@@ -168,12 +230,15 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    style_cache_invalidate(obj, prop);
+
+    lv_part_t part = lv_obj_style_get_selector_part(selector);
+    if(part == LV_PART_ANY || part == LV_PART_MAIN) obj->measure_inv = 1;
+
     if(!style_refr) return;
 
     lv_obj_invalidate(obj);
 
-    lv_part_t part = lv_obj_style_get_selector_part(selector);
-
     if(prop & LV_STYLE_PROP_LAYOUT_REFR) {
         if(part == LV_PART_ANY ||
            part == LV_PART_MAIN ||
@@ -209,49 +274,52 @@ void lv_obj_enable_style_refresh(bool en)
 
 lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
 {
-    lv_style_value_t value_act;
-    bool inherit = prop & LV_STYLE_PROP_INHERIT ? true : false;
-    bool filter = prop & LV_STYLE_PROP_FILTER ? true : false;
-    if(filter) {
-        prop &= ~LV_STYLE_PROP_FILTER;
-    }
-    bool found = false;
-    while(obj) {
-        found = get_prop_core(obj, part, prop, &value_act);
-        if(found) break;
-        if(!inherit) break;
+    style_stats.lookup_cnt++;
 
-        /*If not found, check the `MAIN` style first*/
-        if(part != LV_PART_MAIN) {
-            part = LV_PART_MAIN;
-            continue;
-        }
+#if LV_OBJ_STYLE_CACHE_SIZE
+    /*The widgets set `skip_trans` while they temporarily change their state to draw something. Don't cache it.*/
+    if(obj->skip_trans) return resolve_prop(obj, part, prop);
 
-        /*Check the parent too.*/
-        obj = lv_obj_get_parent(obj);
+    uint32_t key = (uint32_t)prop | part;
+    lv_style_value_t value;
+    if(style_cache_get(obj, key, &value)) {
+        style_stats.hit_cnt++;
+        return value;
     }
 
-    if(!found) {
-        if(part == LV_PART_MAIN && (prop == LV_STYLE_WIDTH || prop == LV_STYLE_HEIGHT)) {
-            const lv_obj_class_t * cls = obj->class_p;
-            while(cls) {
-                if(prop == LV_STYLE_WIDTH) {
-                    if(cls->width_def != 0) break;
-                }
-                else {
-                    if(cls->height_def != 0) break;
-                }
-                cls = cls->base_class;
-            }
+    value = resolve_prop(obj, part, prop);
+    style_cache_set((lv_obj_t *)obj, key, value);
+    return value;
+#else
+    return resolve_prop(obj, part, prop);
+#endif
+}
 
-            value_act.num = prop == LV_STYLE_WIDTH ? cls->width_def : cls->height_def;
-        }
-        else {
-            value_act = lv_style_prop_get_default(prop);
-        }
-    }
-    if(filter) value_act = apply_color_filter(obj, part, value_act);
-    return value_act;
+void lv_obj_get_style_stats(lv_obj_style_stats_t * stats)
+{
+    *stats = style_stats;
+#if LV_USE_REFR_PARALLEL
+    _lv_refr_draw_lock();
+    stats->lookup_cnt += style_stats_workers.lookup_cnt;
+    stats->hit_cnt += style_stats_workers.hit_cnt;
+    _lv_refr_draw_unlock();
+#endif
+}
+
+void _lv_obj_style_flush_stats(void)
+{
+#if LV_USE_REFR_PARALLEL
+    _lv_refr_draw_lock();
+    style_stats_workers.lookup_cnt += style_stats.lookup_cnt;
+    style_stats_workers.hit_cnt += style_stats.hit_cnt;
+    _lv_refr_draw_unlock();
+    lv_memset_00(&style_stats, sizeof(style_stats));
+#endif
+}
+
+void _lv_obj_style_cache_invalidate(lv_obj_t * obj)
+{
+    style_cache_invalidate(obj, LV_STYLE_PROP_ANY);
 }
 
 void lv_obj_set_local_style_prop(lv_obj_t * obj, lv_style_prop_t prop, lv_style_value_t value,
@@ -293,7 +361,10 @@ bool lv_obj_remove_local_style_prop(lv_obj_t * obj, lv_style_prop_t prop, lv_sty
     /*The style is not found*/
     if(i == obj->style_cnt) return false;
 
-    return lv_style_remove_prop(obj->styles[i].style, prop);
+    if(!lv_style_remove_prop(obj->styles[i].style, prop)) return false;
+
+    style_cache_invalidate(obj, prop);
+    return true;
 }
 
 void _lv_obj_style_create_transition(lv_obj_t * obj, lv_part_t part, lv_state_t prev_state, lv_state_t new_state,
@@ -316,6 +387,7 @@ void _lv_obj_style_create_transition(lv_obj_t * obj, lv_part_t part, lv_state_t
 
     _lv_obj_style_t * style_trans = get_trans_style(obj, part);
     lv_style_set_prop(style_trans->style, tr_dsc->prop, v1);   /*Be sure `trans_style` has a valid value*/
+    style_cache_invalidate(obj, tr_dsc->prop);
 
     if(tr_dsc->prop == LV_STYLE_RADIUS) {
         if(v1.num == LV_RADIUS_CIRCLE || v2.num == LV_RADIUS_CIRCLE) {
@@ -535,6 +607,59 @@ static _lv_obj_style_t * get_trans_style(lv_obj_t * obj,  lv_style_selector_t se
     return &obj->styles[0];
 }
 
+/**
+ * Get the value of a style property by checking the styles of the object and its parents
+ * @param obj       pointer to an object
+ * @param part      a part from which the property should be get
+ * @param prop      the property to get
+ * @return          the value of the property
+ */
+static lv_style_value_t resolve_prop(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
+{
+    lv_style_value_t value_act;
+    bool inherit = prop & LV_STYLE_PROP_INHERIT ? true : false;
+    bool filter = prop & LV_STYLE_PROP_FILTER ? true : false;
+    if(filter) {
+        prop &= ~LV_STYLE_PROP_FILTER;
+    }
+    bool found = false;
+    while(obj) {
+        found = get_prop_core(obj, part, prop, &value_act);
+        if(found) break;
+        if(!inherit) break;
+
+        /*If not found, check the `MAIN` style first*/
+        if(part != LV_PART_MAIN) {
+            part = LV_PART_MAIN;
+            continue;
+        }
+
+        /*Check the parent too.*/
+        obj = lv_obj_get_parent(obj);
+    }
+
+    if(!found) {
+        if(part == LV_PART_MAIN && (prop == LV_STYLE_WIDTH || prop == LV_STYLE_HEIGHT)) {
+            const lv_obj_class_t * cls = obj->class_p;
+            while(cls) {
+                if(prop == LV_STYLE_WIDTH) {
+                    if(cls->width_def != 0) break;
+                }
+                else {
+                    if(cls->height_def != 0) break;
+                }
+                cls = cls->base_class;
+            }
+
+            value_act.num = prop == LV_STYLE_WIDTH ? cls->width_def : cls->height_def;
+        }
+        else {
+            value_act = lv_style_prop_get_default(prop);
+        }
+    }
+    if(filter) value_act = apply_color_filter(obj, part, value_act);
+    return value_act;
+}
 
 static bool get_prop_core(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, lv_style_value_t * v)
 {
@@ -609,6 +734,128 @@ static lv_style_value_t apply_color_filter(const lv_obj_t * obj, uint32_t part,
     return v;
 }
 
+#if LV_OBJ_STYLE_CACHE_SIZE
+
+static inline uint32_t style_cache_hash(uint32_t key)
+{
+    return ((key & 0x3FF) + (key >> 16) * 37) & (LV_OBJ_STYLE_CACHE_SIZE - 1);
+}
+
+/**
+ * Get a resolved style property from the cache of an object
+ * @param obj       pointer to an object
+ * @param key       `prop | part`
+ * @param v         store the value here
+ * @return          true: the value is found in the cache
+ */
+static bool style_cache_get(const lv_obj_t * obj, uint32_t key, lv_style_value_t * v)
+{
+    const _lv_obj_style_cache_t * cache = obj->style_cache;
+    if(cache == NULL) return false;
+
+    /*A style has changed since the values were resolved or they were resolved in an other state*/
+    if(!cache->valid || cache->state != obj->state) return false;
+
+    uint32_t idx = style_cache_hash(key);
+    uint32_t i;
+    for(i = 0; i < STYLE_CACHE_PROBE_MAX; i++) {
+        uint32_t key_act = STYLE_CACHE_KEY_LOAD(cache->keys[idx]);
+        if(key_act == key) {
+            *v = cache->values[idx];
+            return true;
+        }
+        if(key_act == 0) return false;
+        idx = (idx + 1) & (LV_OBJ_STYLE_CACHE_SIZE - 1);
+    }
+
+    return false;
+}
+
+/**
+ * Save a resolved style property to the cache of an object.
+ * While the rendering threads work in parallel only the free entries of an up-to-date cache are filled,
+ * because the other threads might read the cache meanwhile.
+ * @param obj       pointer to an object
+ * @param key       `prop | part`
+ * @param v         the resolved value
+ */
+static void style_cache_set(lv_obj_t * obj, uint32_t key, lv_style_value_t v)
+{
+    _lv_obj_style_cache_t * cache = obj->style_cache;
+    uint32_t idx_first = style_cache_hash(key);
+    uint32_t idx = idx_first;
+    uint32_t i;
+
+    if(_lv_refr_is_parallel()) {
+        if(cache == NULL || !cache->valid || cache->state != obj->state) return;
+
+        _lv_refr_draw_lock();
+        for(i = 0; i < STYLE_CACHE_PROBE_MAX; i++) {
+            uint32_t key_act = STYLE_CACHE_KEY_LOAD(cache->keys[idx]);
+            if(key_act == key) break;   /*Added by an other thread*/
+            if(key_act == 0) {
+                cache->values[idx] = v;
+                STYLE_CACHE_KEY_STORE(cache->keys[idx], key);
+                break;
+            }
+            idx = (idx + 1) & (LV_OBJ_STYLE_CACHE_SIZE - 1);
+        }
+        _lv_refr_draw_unlock();
+        return;
+    }
+
+    if(cache == NULL) {
+        cache = lv_mem_alloc(sizeof(_lv_obj_style_cache_t));
+        if(cache == NULL) return;   /*It works without cache too*/
+        cache->valid = 0;
+        obj->style_cache = cache;
+    }
+
+    if(!cache->valid || cache->state != obj->state) {
+        for(i = 0; i < LV_OBJ_STYLE_CACHE_SIZE; i++) {
+            STYLE_CACHE_KEY_STORE(cache->keys[i], 0);
+        }
+        cache->state = obj->state;
+        cache->valid = 1;
+    }
+
+    /*Use the first free entry or overwrite the first one if all are used*/
+    for(i = 0; i < STYLE_CACHE_PROBE_MAX; i++) {
+        uint32_t key_act = STYLE_CACHE_KEY_LOAD(cache->keys[idx]);
+        if(key_act == 0 || key_act == key) break;
+        idx = (idx + 1) & (LV_OBJ_STYLE_CACHE_SIZE - 1);
+    }
+    if(i == STYLE_CACHE_PROBE_MAX) idx = idx_first;
+
+    cache->values[idx] = v;
+    STYLE_CACHE_KEY_STORE(cache->keys[idx], key);
+}
+
+#endif /*LV_OBJ_STYLE_CACHE_SIZE*/
+
+/**
+ * Drop the cached style properties of an object and, if the property is inherited, of its children too
+ * @param obj       pointer to an object
+ * @param prop      the changed property or `LV_STYLE_PROP_ANY`
+ */
+static void style_cache_invalidate(lv_obj_t * obj, lv_style_prop_t prop)
+{
+#if LV_OBJ_STYLE_CACHE_SIZE
+    if(obj->style_cache) obj->style_cache->valid = 0;
+
+    if(prop != LV_STYLE_PROP_ANY && (prop & LV_STYLE_PROP_INHERIT) == 0) return;
+
+    uint32_t i;
+    uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+    for(i = 0; i < child_cnt; i++) {
+        style_cache_invalidate(obj->spec_attr->children[i], prop);
+    }
+#else
+    LV_UNUSED(obj);
+    LV_UNUSED(prop);
+#endif
+}
+
 /**
  * Refresh the style of all children of an object. (Called recursively)
  * @param style refresh objects only with this
@@ -677,6 +924,7 @@ static bool trans_del(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, tran
             for(i = 0; i < obj->style_cnt; i++) {
                 if(obj->styles[i].is_trans && (part == LV_PART_ANY || obj->styles[i].selector == part)) {
                     lv_style_remove_prop(obj->styles[i].style, tr->prop);
+                    style_cache_invalidate(obj, tr->prop);
                     lv_anim_del(tr, NULL);
                     _lv_ll_remove(&LV_GC_ROOT(_lv_obj_style_trans_ll), tr);
                     lv_mem_free(tr);
@@ -771,7 +1019,7 @@ static void trans_anim_start_cb(lv_anim_t * a)
 
     _lv_obj_style_t * style_trans = get_trans_style(tr->obj, tr->selector);
     lv_style_set_prop(style_trans->style, tr->prop, tr->start_value);   /*Be sure `trans_style` has a valid value*/
-
+    style_cache_invalidate(tr->obj, tr->prop);
 }
 
 static void trans_anim_ready_cb(lv_anim_t * a)
@@ -801,6 +1049,7 @@ static void trans_anim_ready_cb(lv_anim_t * a)
 
                 _lv_obj_style_t * obj_style = &obj->styles[i];
                 lv_style_remove_prop(obj_style->style, prop);
+                style_cache_invalidate(obj, prop);
 
                 if(lv_style_is_empty(obj->styles[i].style)) {
                     lv_obj_remove_style(obj, obj_style->style, obj_style->selector);
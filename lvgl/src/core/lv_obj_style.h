@@ -54,6 +54,18 @@ typedef struct {
 #endif
 } _lv_obj_style_transition_dsc_t;
 
+/*The resolved style properties of an object. Defined in `lv_obj_style.c`*/
+struct _lv_obj_style_cache_t;
+typedef struct _lv_obj_style_cache_t _lv_obj_style_cache_t;
+
+/**
+ * Statistics about getting the style properties of the objects
+ */
+typedef struct {
+    uint32_t lookup_cnt;        /**< Number of style properties got*/
+    uint32_t hit_cnt;           /**< Number of style properties found in the cache of the objects*/
+} lv_obj_style_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -130,6 +142,27 @@ void lv_obj_enable_style_refresh(bool en);
  */
 lv_style_value_t lv_obj_get_style_prop(const struct _lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop);
 
+/**
+ * Get the number of style properties got since `lv_init()`.
+ * The styles are resolved for the `lookup_cnt - hit_cnt` properties not found in the style cache of the objects.
+ * @param stats     store the statistics here
+ * @note            with `LV_USE_REFR_PARALLEL` it has to be called from the thread of `lv_timer_handler()`
+ */
+void lv_obj_get_style_stats(lv_obj_style_stats_t * stats);
+
+/**
+ * Add the style lookup counters of the calling thread to the ones returned by `lv_obj_get_style_stats()`.
+ * Called by the rendering workers of `LV_USE_REFR_PARALLEL` when they finished drawing.
+ */
+void _lv_obj_style_flush_stats(void);
+
+/**
+ * Drop the cached style properties of an object and its children.
+ * Used when the resolved properties change without refreshing the style, e.g. the parent or the state changes.
+ * @param obj       pointer to an object
+ */
+void _lv_obj_style_cache_invalidate(struct _lv_obj_t * obj);
+
 /**
  * Set local style property on an object's part and state.
  * @param obj       pointer to an object
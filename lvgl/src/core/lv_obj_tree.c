@@ -147,6 +147,9 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
 
     lv_obj_allocate_spec_attr(parent);
 
+    /*The pending movement of the new parent shouldn't be applied to the object*/
+    _lv_obj_sync_children_coords(parent);
+
     lv_obj_t * old_parent = obj->parent;
     /*Remove the object from the old parent's child list*/
     int32_t i;
@@ -170,6 +173,8 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
     parent->spec_attr->children[lv_obj_get_child_cnt(parent) - 1] = obj;
 
     obj->parent = parent;
+    _lv_obj_style_cache_invalidate(obj);    /*Different values might be inherited from the new parent*/
+    obj->measure_inv = 1;
 
     /*Notify the original parent because one of its children is lost*/
     lv_event_send(old_parent, LV_EVENT_CHILD_CHANGED, obj);
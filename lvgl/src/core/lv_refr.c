@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include <stddef.h>
+#include <string.h>
 #include "lv_refr.h"
 #include "lv_disp.h"
 #include "../hal/lv_hal_tick.h"
@@ -15,6 +16,7 @@
 #include "../misc/lv_mem.h"
 #include "../misc/lv_math.h"
 #include "../misc/lv_gc.h"
+#include "../misc/lv_thread.h"
 #include "../draw/lv_draw.h"
 #include "../font/lv_font_fmt_txt.h"
 
@@ -25,29 +27,107 @@
 /*********************
  *      DEFINES
  *********************/
+#define REFR_OCCLUDER_MAX   8   /*Number of opaque areas to remember while drawing an area*/
+#define REFR_CROP_MAX       32  /*Number of objects which can be skipped or cropped while drawing an area*/
+
+#if LV_USE_REFR_PARALLEL
+    #if LV_USE_PTHREAD == 0
+        #error "LV_USE_REFR_PARALLEL requires LV_USE_PTHREAD"
+    #endif
+    #if LV_REFR_PARALLEL_THREAD_CNT < 1
+        #error "LV_REFR_PARALLEL_THREAD_CNT must be at least 1"
+    #endif
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
+/**
+ * The part of an object which is not hidden by the opaque objects drawn after it.
+ * `area` is empty (`x2 < x1`) if the object is fully hidden.
+ */
+typedef struct {
+    lv_obj_t * obj;
+    lv_area_t area;
+} refr_crop_t;
+
+#if LV_USE_REFR_PARALLEL
+typedef enum {
+    REFR_JOB_NONE,
+    REFR_JOB_DRAW,
+    REFR_JOB_CLEANUP,
+} refr_job_t;
+
+/**
+ * A rendering thread with its own copy of the display and draw buffer.
+ * The drawing functions see `disp` as the display being refreshed (like `lv_canvas` does)
+ * so they render into `buf` instead of the display's draw buffer.
+ */
+typedef struct {
+    lv_thread_t thread;
+    lv_cond_t start_cond;
+    refr_job_t job;
+    lv_disp_t disp;
+    lv_disp_drv_t drv;
+    lv_disp_draw_buf_t draw_buf;
+    lv_color_t * buf;
+    uint32_t buf_size;
+    lv_area_t inv_area;
+} refr_worker_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void lv_refr_join_area(void);
+static void inv_area_remove_in(lv_disp_t * disp, const lv_area_t * area_p, int32_t skip);
+static void inv_area_merge(lv_disp_t * disp, const lv_area_t * area_p);
+static void refr_area_remove_overlap(uint32_t in_i, uint32_t from_i);
+static bool area_crop_side(lv_area_t * area_p, const lv_area_t * cover_p);
+static uint32_t area_split(const lv_area_t * area_p, const lv_area_t * hole_p, lv_area_t * pieces);
 static void lv_refr_areas(void);
 static void lv_refr_area(const lv_area_t * area_p);
 static void lv_refr_area_part(const lv_area_t * area_p);
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void lv_refr_obj_and_children(lv_obj_t * top_p, const lv_area_t * mask_p);
 static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p);
+static void refr_area_part_draw(const lv_area_t * area_p);
+static void refr_occlusion_collect(lv_obj_t * obj, const lv_area_t * mask_ori_p);
+static bool refr_occlusion_crop(lv_area_t * area_p);
+static void refr_occlusion_add(const lv_area_t * area_p);
+static bool refr_occlusion_get_mask(lv_obj_t * obj, const lv_area_t * mask_ori_p, lv_area_t * mask_p);
+static void refr_scroll_blit(void);
 static void draw_buf_flush(void);
 static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
+#if LV_USE_REFR_PARALLEL
+    static bool refr_parallel_is_possible(void);
+    static void refr_area_parallel(const lv_area_t * area_p, int32_t max_row, lv_coord_t y2);
+    static lv_res_t refr_workers_start(uint32_t cnt);
+    static void refr_workers_run(refr_job_t job, uint32_t cnt);
+    static void refr_workers_wait(void);
+    static void refr_worker_flush(refr_worker_t * w);
+    static void refr_worker_thread(void * p);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint32_t px_num;
-static lv_disp_t * disp_refr; /*Display being refreshed*/
+static LV_DRAW_THREAD_LOCAL lv_disp_t * disp_refr; /*Display being refreshed*/
+static LV_DRAW_THREAD_LOCAL lv_area_t occluders[REFR_OCCLUDER_MAX];
+static LV_DRAW_THREAD_LOCAL uint32_t occluder_cnt;
+static LV_DRAW_THREAD_LOCAL refr_crop_t refr_crops[REFR_CROP_MAX];
+static LV_DRAW_THREAD_LOCAL uint32_t refr_crop_cnt;
+#if LV_USE_REFR_PARALLEL
+    static refr_worker_t refr_workers[LV_REFR_PARALLEL_THREAD_CNT - 1];
+    static uint32_t refr_workers_started;
+    static uint32_t refr_jobs_pending;
+    static uint32_t refr_thread_cnt = LV_REFR_PARALLEL_THREAD_CNT;
+    static bool refr_parallel_active;
+    static lv_mutex_t refr_mutex;
+    static lv_cond_t refr_done_cond;
+    static lv_mutex_t refr_draw_mutex;
+#endif
 #if LV_USE_PERF_MONITOR
     static uint32_t fps_sum_cnt;
     static uint32_t fps_sum_all;
@@ -71,7 +151,11 @@ static lv_disp_t * disp_refr; /*Display being refreshed*/
  */
 void _lv_refr_init(void)
 {
-    /*Nothing to do*/
+#if LV_USE_REFR_PARALLEL
+    lv_mutex_init(&refr_mutex);
+    lv_mutex_init(&refr_draw_mutex);
+    lv_cond_init(&refr_done_cond);
+#endif
 }
 
 /**
@@ -112,6 +196,8 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     /*Clear the invalidate buffer if the parameter is NULL*/
     if(area_p == NULL) {
         disp->inv_p = 0;
+        disp->scroll_blit_ofs.x = 0;
+        disp->scroll_blit_ofs.y = 0;
         return;
     }
 
@@ -143,18 +229,93 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
         if(_lv_area_is_in(&com_area, &disp->inv_areas[i], 0) != false) return;
     }
 
+    /*The saved areas in the new area are not required anymore*/
+    inv_area_remove_in(disp, &com_area, -1);
+
     /*Save the area*/
     if(disp->inv_p < LV_INV_BUF_SIZE) {
         lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
+        disp->inv_area_joined[disp->inv_p] = 0;
+        disp->inv_p++;
     }
-    else {   /*If no place for the area add the screen*/
-        disp->inv_p = 0;
-        lv_area_copy(&disp->inv_areas[disp->inv_p], &scr_area);
+    else {   /*If no place for the area join two areas*/
+        inv_area_merge(disp, &com_area);
+        disp->inv_stats.merge_cnt++;
     }
-    disp->inv_p++;
+    disp->inv_stats.inv_cnt++;
     lv_timer_resume(disp->refr_timer);
 }
 
+bool _lv_refr_scroll_blit(lv_disp_t * disp, const lv_area_t * area_p, lv_coord_t x, lv_coord_t y)
+{
+    if(!disp) disp = lv_disp_get_default();
+    if(!disp) return false;
+
+    /*The frame buffer has to contain the last frame with the native color format and orientation*/
+    lv_disp_drv_t * drv = disp->driver;
+    if(!drv->scroll_blit || !drv->direct_mode || drv->full_refresh) return false;
+    if(drv->draw_buf->buf2 || drv->set_px_cb || drv->set_px_span_cb) return false;
+    if(drv->sw_rotate && drv->rotated != LV_DISP_ROT_NONE) return false;
+
+    lv_area_t scr_area;
+    scr_area.x1 = 0;
+    scr_area.y1 = 0;
+    scr_area.x2 = lv_disp_get_hor_res(disp) - 1;
+    scr_area.y2 = lv_disp_get_ver_res(disp) - 1;
+    if(drv->draw_buf->size < (uint32_t)lv_area_get_size(&scr_area)) return false;
+
+    lv_area_t area;
+    if(_lv_area_intersect(&area, area_p, &scr_area) == false) return false;
+
+    /*Nothing would remain from the area*/
+    if(LV_ABS(x) >= lv_area_get_width(&area) || LV_ABS(y) >= lv_area_get_height(&area)) return false;
+
+    /*Only one area can be moved in a refresh*/
+    lv_area_t * blit_area = &disp->scroll_blit_area;
+    if(disp->scroll_blit_ofs.x != 0 || disp->scroll_blit_ofs.y != 0) {
+        if(blit_area->x1 != area.x1 || blit_area->y1 != area.y1 ||
+           blit_area->x2 != area.x2 || blit_area->y2 != area.y2) return false;
+    }
+
+    /*The content of the invalid areas is moved too so redraw their new position as well.
+     *Collect them first as invalidating can reorder the areas.*/
+    lv_area_t moved[LV_INV_BUF_SIZE];
+    uint32_t moved_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        lv_area_t a;
+        if(_lv_area_intersect(&a, &disp->inv_areas[i], &area) == false) continue;
+        lv_area_move(&a, x, y);
+        if(_lv_area_intersect(&moved[moved_cnt], &a, &area)) moved_cnt++;
+    }
+
+    for(i = 0; i < moved_cnt; i++) {
+        _lv_inv_area(disp, &moved[i]);
+    }
+
+    /*Redraw the uncovered strips*/
+    lv_area_t strip;
+    if(y != 0) {
+        lv_area_copy(&strip, &area);
+        if(y > 0) strip.y2 = strip.y1 + y - 1;
+        else strip.y1 = strip.y2 + y + 1;
+        _lv_inv_area(disp, &strip);
+    }
+
+    if(x != 0) {
+        lv_area_copy(&strip, &area);
+        if(x > 0) strip.x2 = strip.x1 + x - 1;
+        else strip.x1 = strip.x2 + x + 1;
+        _lv_inv_area(disp, &strip);
+    }
+
+    lv_area_copy(blit_area, &area);
+    disp->scroll_blit_ofs.x += x;
+    disp->scroll_blit_ofs.y += y;
+
+    return true;
+}
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -188,6 +349,9 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
 
     disp_refr = tmr->user_data;
 
+    lv_obj_style_stats_t style_stats_start;
+    lv_obj_get_style_stats(&style_stats_start);
+
 #if LV_USE_PERF_MONITOR == 0 && LV_USE_MEM_MONITOR == 0
     /**
      * Ensure the timer does not run again automatically.
@@ -206,11 +370,16 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
     /*Do nothing if there is no active screen*/
     if(disp_refr->act_scr == NULL) {
         disp_refr->inv_p = 0;
+        disp_refr->scroll_blit_ofs.x = 0;
+        disp_refr->scroll_blit_ofs.y = 0;
+        lv_memset_00(&disp_refr->inv_stats, sizeof(disp_refr->inv_stats));
         LV_LOG_WARN("there is no active screen");
         REFR_TRACE("finished");
         return;
     }
 
+    refr_scroll_blit();
+
     lv_refr_join_area();
 
     lv_refr_areas();
@@ -226,6 +395,16 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         lv_memset_00(disp_refr->inv_area_joined, sizeof(disp_refr->inv_area_joined));
         disp_refr->inv_p = 0;
 
+        disp_refr->refr_stats = disp_refr->inv_stats;
+        disp_refr->refr_stats.px_cnt = px_num;
+
+        lv_obj_style_stats_t style_stats;
+        lv_obj_get_style_stats(&style_stats);
+        disp_refr->refr_stats.style_lookup_cnt = style_stats.lookup_cnt - style_stats_start.lookup_cnt;
+        disp_refr->refr_stats.style_resolve_cnt = disp_refr->refr_stats.style_lookup_cnt -
+                                                  (style_stats.hit_cnt - style_stats_start.hit_cnt);
+        lv_memset_00(&disp_refr->inv_stats, sizeof(disp_refr->inv_stats));
+
         elaps = lv_tick_elaps(start);
         /*Call monitor cb if present*/
         if(disp_refr->driver->monitor_cb) {
@@ -236,8 +415,12 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
     lv_mem_buf_free_all();
     _lv_font_clean_up_fmt_txt();
 
-#if LV_DRAW_COMPLEX
-    _lv_draw_mask_cleanup();
+#if LV_USE_REFR_PARALLEL
+    /*The workers have their own temporary buffers and caches*/
+    if(refr_workers_started) {
+        refr_workers_run(REFR_JOB_CLEANUP, refr_workers_started);
+        refr_workers_wait();
+    }
 #endif
 
 #if LV_USE_PERF_MONITOR && LV_USE_LABEL
@@ -323,45 +506,265 @@ uint32_t lv_refr_get_fps_avg(void)
 }
 #endif
 
+void lv_refr_set_thread_cnt(uint32_t cnt)
+{
+#if LV_USE_REFR_PARALLEL
+    if(cnt < 1) cnt = 1;
+    if(cnt > LV_REFR_PARALLEL_THREAD_CNT) cnt = LV_REFR_PARALLEL_THREAD_CNT;
+    refr_thread_cnt = cnt;
+#else
+    LV_UNUSED(cnt);
+#endif
+}
+
+uint32_t lv_refr_get_thread_cnt(void)
+{
+#if LV_USE_REFR_PARALLEL
+    return refr_thread_cnt;
+#else
+    return 1;
+#endif
+}
+
+bool _lv_refr_is_parallel(void)
+{
+#if LV_USE_REFR_PARALLEL
+    return refr_parallel_active;
+#else
+    return false;
+#endif
+}
+
+void _lv_refr_draw_lock(void)
+{
+#if LV_USE_REFR_PARALLEL
+    lv_mutex_lock(&refr_draw_mutex);
+#endif
+}
+
+void _lv_refr_draw_unlock(void)
+{
+#if LV_USE_REFR_PARALLEL
+    lv_mutex_unlock(&refr_draw_mutex);
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
 /**
- * Join the areas which has got common parts
+ * Join the areas which are cheaper to redraw together and
+ * remove the overlapping parts of the others to not redraw them twice
  */
 static void lv_refr_join_area(void)
 {
     uint32_t join_from;
     uint32_t join_in;
     lv_area_t joined_area;
+    bool joined;
+
+    /*A joined area might be joined with an area checked before so repeat until there is no change*/
+    do {
+        joined = false;
+        for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
+            if(disp_refr->inv_area_joined[join_in] != 0) continue;
+
+            /*Check all areas to join them in 'join_in'*/
+            for(join_from = join_in + 1; join_from < disp_refr->inv_p; join_from++) {
+                /*Handle only unjoined areas*/
+                if(disp_refr->inv_area_joined[join_from] != 0) continue;
+
+                _lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
+
+                /*Join two area only if the joined area is cheaper to draw than the two areas*/
+                if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
+                                                     lv_area_get_size(&disp_refr->inv_areas[join_from]) + LV_REFR_AREA_COST)) {
+                    lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
+
+                    /*Mark 'join_form' is joined into 'join_in'*/
+                    disp_refr->inv_area_joined[join_from] = 1;
+                    joined = true;
+                }
+            }
+        }
+    } while(joined);
+
+    /*The cropped or split areas might not fit to the rounder*/
+    if(disp_refr->driver->rounder_cb) return;
+
+    /*The areas are only made smaller so a pair can't overlap again once it's handled.
+     *The new pieces of split areas are added to the end so they are handled too.*/
     for(join_in = 0; join_in < disp_refr->inv_p; join_in++) {
         if(disp_refr->inv_area_joined[join_in] != 0) continue;
-
-        /*Check all areas to join them in 'join_in'*/
         for(join_from = 0; join_from < disp_refr->inv_p; join_from++) {
-            /*Handle only unjoined areas and ignore itself*/
-            if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) {
-                continue;
-            }
+            if(disp_refr->inv_area_joined[join_from] != 0 || join_in == join_from) continue;
+            refr_area_remove_overlap(join_in, join_from);
+        }
+    }
+}
 
-            /*Check if the areas are on each other*/
-            if(_lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
-                continue;
+/**
+ * Remove the invalidated areas which are in an area
+ * @param disp pointer to a display
+ * @param area_p pointer to an area
+ * @param skip index of an area to keep or -1 to check all
+ */
+static void inv_area_remove_in(lv_disp_t * disp, const lv_area_t * area_p, int32_t skip)
+{
+    uint32_t i;
+    uint32_t new_p = 0;
+    for(i = 0; i < disp->inv_p; i++) {
+        if((int32_t)i != skip && _lv_area_is_in(&disp->inv_areas[i], area_p, 0)) continue;
+        disp->inv_areas[new_p] = disp->inv_areas[i];
+        disp->inv_area_joined[new_p] = disp->inv_area_joined[i];
+        new_p++;
+    }
+    disp->inv_p = new_p;
+}
+
+/**
+ * Save an area when the buffer of the invalid areas is full.
+ * Join the two areas (the saved ones and the new one) which adds the fewest extra pixels.
+ * @param disp pointer to a display
+ * @param area_p pointer to the new area
+ */
+static void inv_area_merge(lv_disp_t * disp, const lv_area_t * area_p)
+{
+    /*The new area is checked as the `inv_p`th area*/
+    uint32_t cnt = disp->inv_p + 1;
+    uint32_t best_a = 0;
+    uint32_t best_b = 1;
+    int32_t best_cost = INT32_MAX;
+    uint32_t a;
+    uint32_t b;
+    for(a = 0; a < cnt; a++) {
+        const lv_area_t * area_a = a < disp->inv_p ? &disp->inv_areas[a] : area_p;
+        for(b = a + 1; b < cnt; b++) {
+            const lv_area_t * area_b = b < disp->inv_p ? &disp->inv_areas[b] : area_p;
+            lv_area_t joined_area;
+            _lv_area_join(&joined_area, area_a, area_b);
+            int32_t cost = (int32_t)lv_area_get_size(&joined_area) - (int32_t)lv_area_get_size(area_a) -
+                           (int32_t)lv_area_get_size(area_b);
+            if(cost < best_cost) {
+                best_cost = cost;
+                best_a = a;
+                best_b = b;
             }
+        }
+    }
 
-            _lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
+    /*`best_a` is always a saved area. Put the joined area there and the new area to `best_b` if it's free.*/
+    const lv_area_t * area_b = best_b < disp->inv_p ? &disp->inv_areas[best_b] : area_p;
+    _lv_area_join(&disp->inv_areas[best_a], &disp->inv_areas[best_a], area_b);
+    if(best_b < disp->inv_p) disp->inv_areas[best_b] = *area_p;
 
-            /*Join two area only if the joined area size is smaller*/
-            if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
-                                                 lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
-                lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
+    /*Other areas might be in the joined area*/
+    lv_area_t joined_area = disp->inv_areas[best_a];
+    inv_area_remove_in(disp, &joined_area, best_a);
+}
 
-                /*Mark 'join_form' is joined into 'join_in'*/
-                disp_refr->inv_area_joined[join_from] = 1;
-            }
+/**
+ * Remove the part of an area to refresh which is on an other area to refresh.
+ * @param in_i index of the area to keep as it is
+ * @param from_i index of the area to crop or split into pieces
+ */
+static void refr_area_remove_overlap(uint32_t in_i, uint32_t from_i)
+{
+    const lv_area_t * in_p = &disp_refr->inv_areas[in_i];
+    lv_area_t * from_p = &disp_refr->inv_areas[from_i];
+    lv_area_t common;
+    if(_lv_area_intersect(&common, in_p, from_p) == false) return;
+
+    if(_lv_area_is_in(from_p, in_p, 0)) {
+        disp_refr->inv_area_joined[from_i] = 1;
+        return;
+    }
+
+    if(area_crop_side(from_p, in_p)) return;
+
+    /*Split only if the overlap is larger than the cost of the new areas*/
+    lv_area_t pieces[4];
+    uint32_t piece_cnt = area_split(from_p, in_p, pieces);
+    if(disp_refr->inv_p + piece_cnt - 1 > LV_INV_BUF_SIZE) return;
+    if(lv_area_get_size(&common) <= (piece_cnt - 1) * LV_REFR_AREA_COST) return;
+
+    *from_p = pieces[0];
+    uint32_t i;
+    for(i = 1; i < piece_cnt; i++) {
+        disp_refr->inv_areas[disp_refr->inv_p] = pieces[i];
+        disp_refr->inv_area_joined[disp_refr->inv_p] = 0;
+        disp_refr->inv_p++;
+    }
+}
+
+/**
+ * Remove a side of an area if it's covered by an other area
+ * @param area_p pointer to an area to crop. It shouldn't be fully in `cover_p`.
+ * @param cover_p pointer to the covering area
+ * @return true: the area was cropped
+ */
+static bool area_crop_side(lv_area_t * area_p, const lv_area_t * cover_p)
+{
+    /*Only a whole side can be removed to keep the area a rectangle*/
+    if(cover_p->y1 <= area_p->y1 && cover_p->y2 >= area_p->y2) {
+        if(cover_p->x1 <= area_p->x1 && cover_p->x2 >= area_p->x1) {
+            area_p->x1 = cover_p->x2 + 1;
+            return true;
+        }
+        else if(cover_p->x1 <= area_p->x2 && cover_p->x2 >= area_p->x2) {
+            area_p->x2 = cover_p->x1 - 1;
+            return true;
         }
     }
+    else if(cover_p->x1 <= area_p->x1 && cover_p->x2 >= area_p->x2) {
+        if(cover_p->y1 <= area_p->y1 && cover_p->y2 >= area_p->y1) {
+            area_p->y1 = cover_p->y2 + 1;
+            return true;
+        }
+        else if(cover_p->y1 <= area_p->y2 && cover_p->y2 >= area_p->y2) {
+            area_p->y2 = cover_p->y1 - 1;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Split the part of an area which is not on an other area into rectangles
+ * @param area_p pointer to the area to split
+ * @param hole_p pointer to an area which is on `area_p`
+ * @param pieces array of 4 areas to store the pieces
+ * @return number of pieces
+ */
+static uint32_t area_split(const lv_area_t * area_p, const lv_area_t * hole_p, lv_area_t * pieces)
+{
+    uint32_t cnt = 0;
+    lv_coord_t y1 = area_p->y1;
+    lv_coord_t y2 = area_p->y2;
+
+    /*Full width pieces above and below the hole and the parts next to the hole*/
+    if(hole_p->y1 > area_p->y1) {
+        lv_area_set(&pieces[cnt], area_p->x1, area_p->y1, area_p->x2, hole_p->y1 - 1);
+        y1 = hole_p->y1;
+        cnt++;
+    }
+    if(hole_p->y2 < area_p->y2) {
+        lv_area_set(&pieces[cnt], area_p->x1, hole_p->y2 + 1, area_p->x2, area_p->y2);
+        y2 = hole_p->y2;
+        cnt++;
+    }
+    if(hole_p->x1 > area_p->x1) {
+        lv_area_set(&pieces[cnt], area_p->x1, y1, hole_p->x1 - 1, y2);
+        cnt++;
+    }
+    if(hole_p->x2 < area_p->x2) {
+        lv_area_set(&pieces[cnt], hole_p->x2 + 1, y1, area_p->x2, y2);
+        cnt++;
+    }
+
+    return cnt;
 }
 
 /**
@@ -395,6 +798,7 @@ static void lv_refr_areas(void)
             lv_refr_area(&disp_refr->inv_areas[i]);
 
             px_num += lv_area_get_size(&disp_refr->inv_areas[i]);
+            disp_refr->inv_stats.area_cnt++;
         }
     }
 }
@@ -469,6 +873,12 @@ static void lv_refr_area(const lv_area_t * area_p)
     }
     /*Else assume the buffer starts at the given area*/
     else {
+#if LV_USE_REFR_PARALLEL
+        if(refr_parallel_is_possible()) {
+            refr_area_parallel(area_p, max_row, y2);
+            return;
+        }
+#endif
         /*Always use the full row*/
         lv_coord_t row;
         lv_coord_t row_last = 0;
@@ -514,6 +924,25 @@ static void lv_refr_area_part(const lv_area_t * area_p)
         }
     }
 
+    refr_area_part_draw(area_p);
+
+    /*In true double buffered mode flush only once when all areas were rendered.
+     *In direct mode all areas are drawn into the same buffer so flush (and swap the buffers) after the last one.
+     *In normal mode flush after every area*/
+    if(disp_refr->driver->full_refresh == false &&
+       (disp_refr->driver->direct_mode == 0 || disp_refr->driver->draw_buf->last_area)) {
+        draw_buf_flush();
+    }
+}
+
+/**
+ * Draw the part of an area which is on the actual draw buffer of the display being refreshed
+ * @param area_p pointer to an area to refresh
+ */
+static void refr_area_part_draw(const lv_area_t * area_p)
+{
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp_refr);
+
     lv_obj_t * top_act_scr = NULL;
     lv_obj_t * top_prev_scr = NULL;
 
@@ -528,6 +957,17 @@ static void lv_refr_area_part(const lv_area_t * area_p)
         top_prev_scr = lv_refr_get_top_obj(&start_mask, disp_refr->prev_scr);
     }
 
+    /*Find the objects hidden by opaque objects drawn after them.
+     *Go from front to back, i.e. in the reverse order of drawing*/
+    occluder_cnt = 0;
+    refr_crop_cnt = 0;
+    refr_occlusion_collect(lv_disp_get_layer_sys(disp_refr), &start_mask);
+    refr_occlusion_collect(lv_disp_get_layer_top(disp_refr), &start_mask);
+    refr_occlusion_collect(lv_disp_get_scr_act(disp_refr), &start_mask);
+    if(disp_refr->prev_scr) {
+        refr_occlusion_collect(disp_refr->prev_scr, &start_mask);
+    }
+
     /*Draw a display background if there is no top object*/
     if(top_act_scr == NULL && top_prev_scr == NULL) {
         if(disp_refr->bg_fn) {
@@ -578,11 +1018,7 @@ static void lv_refr_area_part(const lv_area_t * area_p)
     lv_refr_obj_and_children(lv_disp_get_layer_top(disp_refr), &start_mask);
     lv_refr_obj_and_children(lv_disp_get_layer_sys(disp_refr), &start_mask);
 
-    /*In true double buffered mode flush only once when all areas were rendered.
-     *In normal mode flush after every area*/
-    if(disp_refr->driver->full_refresh == false) {
-        draw_buf_flush();
-    }
+    refr_crop_cnt = 0;
 }
 
 /**
@@ -595,6 +1031,8 @@ static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
 {
     lv_obj_t * found_p = NULL;
 
+    _lv_obj_sync_coords(obj);
+
     /*If this object is fully cover the draw area check the children too*/
     if(_lv_area_is_in(area_p, &obj->coords, 0) && lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN) == false) {
         lv_cover_check_info_t info;
@@ -687,6 +1125,11 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
     /*Do not refresh hidden objects*/
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
 
+    /*Do not refresh the parts covered by opaque objects drawn later*/
+    lv_area_t mask_visible;
+    if(refr_occlusion_get_mask(obj, mask_ori_p, &mask_visible) == false) return;
+    mask_ori_p = &mask_visible;
+
     bool union_ok; /*Store the return value of area_union*/
     /*Truncate the original mask to the coordinates of the parent
      *because the parent and its children are visible only here*/
@@ -754,6 +1197,147 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
     }
 }
 
+/**
+ * Find the parts of an object and its children which are hidden by opaque objects drawn after them
+ * and add the object to the opaque areas if it covers its area. (Called recursively)
+ * The objects need to be visited in the reverse order of drawing.
+ * @param obj pointer to an object
+ * @param mask_ori_p pointer to an area, the object will be drawn only here
+ */
+static void refr_occlusion_collect(lv_obj_t * obj, const lv_area_t * mask_ori_p)
+{
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+
+    lv_area_t obj_ext_mask;
+    lv_area_t obj_area;
+    lv_coord_t ext_size = _lv_obj_get_ext_draw_size(obj);
+    lv_obj_get_coords(obj, &obj_area);
+    obj_area.x1 -= ext_size;
+    obj_area.y1 -= ext_size;
+    obj_area.x2 += ext_size;
+    obj_area.y2 += ext_size;
+    if(_lv_area_intersect(&obj_ext_mask, mask_ori_p, &obj_area) == false) return;
+
+    if(refr_occlusion_crop(&obj_ext_mask)) {
+        /*If there is no space to save it the object will be simply drawn*/
+        if(refr_crop_cnt < REFR_CROP_MAX) {
+            refr_crops[refr_crop_cnt].obj = obj;
+            refr_crops[refr_crop_cnt].area = obj_ext_mask;
+            refr_crop_cnt++;
+        }
+
+        /*Fully hidden so the children are hidden too*/
+        if(obj_ext_mask.x2 < obj_ext_mask.x1) return;
+    }
+
+    /*The children are drawn only on the object's area*/
+    lv_area_t cover_area;
+    if(_lv_area_intersect(&cover_area, mask_ori_p, &obj->coords) == false) return;
+
+    lv_cover_check_info_t info;
+    info.res = LV_COVER_RES_COVER;
+    info.area = &cover_area;
+    lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
+
+    /*The children are masked (e.g. by rounded corners) so they don't hide anything (as in `lv_refr_get_top_obj`)*/
+    if(info.res == LV_COVER_RES_MASKED) return;
+
+    /*The children are drawn after the object so check them first*/
+    lv_area_t obj_mask;
+    if(_lv_area_intersect(&obj_mask, &obj_ext_mask, &obj->coords)) {
+        int32_t i;
+        for(i = (int32_t)lv_obj_get_child_cnt(obj) - 1; i >= 0; i--) {
+            refr_occlusion_collect(obj->spec_attr->children[i], &obj_mask);
+        }
+    }
+
+    /*Where the object is opaque it hides everything drawn before it*/
+    if(info.res == LV_COVER_RES_COVER) refr_occlusion_add(&cover_area);
+}
+
+/**
+ * Remove the sides of an area which are covered by the opaque areas
+ * @param area_p pointer to an area to crop. `x2 < x1` if it's fully covered.
+ * @return true: the area has changed
+ */
+static bool refr_occlusion_crop(lv_area_t * area_p)
+{
+    bool changed = false;
+    bool cropped;
+    do {
+        cropped = false;
+        uint32_t i;
+        for(i = 0; i < occluder_cnt; i++) {
+            const lv_area_t * occ = &occluders[i];
+            if(_lv_area_is_in(area_p, occ, 0)) {
+                area_p->x2 = area_p->x1 - 1;
+                return true;
+            }
+
+            if(area_crop_side(area_p, occ)) cropped = true;
+        }
+        changed |= cropped;
+        /*A cropped area might be covered by an opaque area checked before*/
+    } while(cropped);
+
+    return changed;
+}
+
+/**
+ * Save an opaque area. If there are too many, the smallest one is dropped.
+ * @param area_p pointer to an area which is fully covered
+ */
+static void refr_occlusion_add(const lv_area_t * area_p)
+{
+    uint32_t size = lv_area_get_size(area_p);
+    uint32_t min_i = 0;
+    uint32_t min_size = UINT32_MAX;
+    uint32_t i;
+    for(i = 0; i < occluder_cnt; i++) {
+        if(_lv_area_is_in(area_p, &occluders[i], 0)) return;
+
+        /*Replace an area which is covered by the new one*/
+        if(_lv_area_is_in(&occluders[i], area_p, 0)) {
+            occluders[i] = *area_p;
+            return;
+        }
+
+        uint32_t s = lv_area_get_size(&occluders[i]);
+        if(s < min_size) {
+            min_size = s;
+            min_i = i;
+        }
+    }
+
+    if(occluder_cnt < REFR_OCCLUDER_MAX) {
+        occluders[occluder_cnt] = *area_p;
+        occluder_cnt++;
+    }
+    else if(min_size < size) {
+        occluders[min_i] = *area_p;
+    }
+}
+
+/**
+ * Get the area where an object needs to be drawn
+ * @param obj pointer to an object
+ * @param mask_ori_p pointer to the area where the object would be drawn
+ * @param mask_p store the part of `mask_ori_p` which is not hidden by the objects drawn later
+ * @return false: the object is fully hidden
+ */
+static bool refr_occlusion_get_mask(lv_obj_t * obj, const lv_area_t * mask_ori_p, lv_area_t * mask_p)
+{
+    uint32_t i;
+    for(i = 0; i < refr_crop_cnt; i++) {
+        if(refr_crops[i].obj == obj) {
+            return _lv_area_intersect(mask_p, mask_ori_p, &refr_crops[i].area);
+        }
+    }
+
+    *mask_p = *mask_ori_p;
+    return true;
+}
+
 static void draw_buf_rotate_180(lv_disp_drv_t * drv, lv_area_t * area, lv_color_t * color_p)
 {
     lv_coord_t area_w = lv_area_get_width(area);
@@ -931,6 +1515,53 @@ static void draw_buf_rotate(lv_area_t * area, lv_color_t * color_p)
     }
 }
 
+/**
+ * Move the content of the scrolled area in the frame buffer (see `_lv_refr_scroll_blit`)
+ */
+static void refr_scroll_blit(void)
+{
+    lv_point_t ofs = disp_refr->scroll_blit_ofs;
+    if(ofs.x == 0 && ofs.y == 0) return;
+
+    disp_refr->scroll_blit_ofs.x = 0;
+    disp_refr->scroll_blit_ofs.y = 0;
+
+    /*The part of the area which remains in the area after moving*/
+    lv_area_t dest;
+    lv_area_copy(&dest, &disp_refr->scroll_blit_area);
+    lv_area_move(&dest, ofs.x, ofs.y);
+    if(_lv_area_intersect(&dest, &dest, &disp_refr->scroll_blit_area) == false) return;
+
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp_refr);
+    while(draw_buf->flushing) {
+        if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
+    }
+    if(disp_refr->driver->gpu_wait_cb) disp_refr->driver->gpu_wait_cb(disp_refr->driver);
+
+    int32_t stride = lv_disp_get_hor_res(disp_refr);
+    lv_coord_t w = lv_area_get_width(&dest);
+    lv_coord_t h = lv_area_get_height(&dest);
+    lv_color_t * dest_p = draw_buf->buf_act;
+    dest_p += stride * dest.y1 + dest.x1;
+    lv_color_t * src_p = dest_p - (stride * ofs.y + ofs.x);
+
+    /*Go from the bottom when moving down to not overwrite the rows to copy*/
+    if(ofs.y > 0) {
+        dest_p += stride * (h - 1);
+        src_p += stride * (h - 1);
+        stride = -stride;
+    }
+
+    lv_coord_t y;
+    for(y = 0; y < h; y++) {
+        memmove(dest_p, src_p, w * sizeof(lv_color_t));
+        dest_p += stride;
+        src_p += stride;
+    }
+
+    disp_refr->inv_stats.blit_px_cnt += (uint32_t)w * h;
+}
+
 /**
  * Flush the content of the draw buffer
  */
@@ -987,3 +1618,215 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
 
     drv->flush_cb(drv, &offset_area, color_p);
 }
+
+#if LV_USE_REFR_PARALLEL
+
+/**
+ * Check whether the display being refreshed can be rendered in parallel bands
+ * @return true: the normal draw buffer mode is used and more threads are enabled
+ */
+static bool refr_parallel_is_possible(void)
+{
+    if(refr_thread_cnt < 2) return false;
+
+    /*The rotation works in place on the draw buffer and uses the buffer of the rotation*/
+    lv_disp_drv_t * drv = disp_refr->driver;
+    if(drv->sw_rotate && drv->rotated != LV_DISP_ROT_NONE) return false;
+
+    return true;
+}
+
+/**
+ * Refresh an area by rendering its bands concurrently.
+ * The first band of every round is rendered by this thread into the normal draw buffer (and flushed as usual)
+ * while the workers render the next bands into their own buffers. The workers' bands are flushed in order after it.
+ * @param area_p pointer to an area to refresh
+ * @param max_row max. number of rows fitting into a draw buffer
+ * @param y2 the last row of the area to refresh
+ */
+static void refr_area_parallel(const lv_area_t * area_p, int32_t max_row, lv_coord_t y2)
+{
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp_refr);
+
+    uint32_t worker_cnt = refr_thread_cnt - 1;
+    if(refr_workers_start(worker_cnt) != LV_RES_OK) worker_cnt = refr_workers_started;
+
+    /*Fall back to a single thread if the buffer of the workers can't be allocated*/
+    uint32_t buf_size = draw_buf->size;
+    uint32_t i;
+    for(i = 0; i < worker_cnt; i++) {
+        refr_worker_t * w = &refr_workers[i];
+        if(w->buf_size >= buf_size) continue;
+        lv_color_t * buf = lv_mem_realloc(w->buf, buf_size * sizeof(lv_color_t));
+        if(buf == NULL) {
+            LV_LOG_WARN("couldn't allocate the draw buffer of a rendering thread");
+            worker_cnt = i;
+            break;
+        }
+        w->buf = buf;
+        w->buf_size = buf_size;
+    }
+
+    /*The pending movements can't be applied while drawing so apply them before starting*/
+    if(worker_cnt) {
+        if(disp_refr->prev_scr) _lv_obj_sync_area_coords(disp_refr->prev_scr, area_p);
+        _lv_obj_sync_area_coords(disp_refr->act_scr, area_p);
+        _lv_obj_sync_area_coords(disp_refr->top_layer, area_p);
+        _lv_obj_sync_area_coords(disp_refr->sys_layer, area_p);
+    }
+
+    lv_coord_t row = area_p->y1;
+    while(row <= y2) {
+        lv_area_t band;
+        band.x1 = area_p->x1;
+        band.x2 = area_p->x2;
+        band.y1 = row;
+        band.y2 = LV_MIN(row + max_row - 1, y2);
+        row = band.y2 + 1;
+
+        /*Give the next bands to the workers*/
+        uint32_t used = 0;
+        while(used < worker_cnt && row <= y2) {
+            refr_worker_t * w = &refr_workers[used];
+            w->disp = *disp_refr;
+            w->drv = *disp_refr->driver;
+            w->draw_buf = *draw_buf;
+            w->disp.driver = &w->drv;
+            w->drv.draw_buf = &w->draw_buf;
+            w->draw_buf.buf1 = w->buf;
+            w->draw_buf.buf2 = NULL;
+            w->draw_buf.buf_act = w->buf;
+            w->draw_buf.flushing = 0;
+            w->draw_buf.area.x1 = area_p->x1;
+            w->draw_buf.area.x2 = area_p->x2;
+            w->draw_buf.area.y1 = row;
+            w->draw_buf.area.y2 = LV_MIN(row + max_row - 1, y2);
+            w->inv_area = *area_p;
+            row = w->draw_buf.area.y2 + 1;
+            used++;
+        }
+        /*Set before starting the workers to be seen by them too*/
+        refr_parallel_active = used ? true : false;
+        if(used) refr_workers_run(REFR_JOB_DRAW, used);
+
+        /*Meanwhile render and flush the first band here*/
+        draw_buf->area = band;
+        draw_buf->last_part = used == 0 && row > y2 ? 1 : 0;
+        lv_refr_area_part(area_p);
+
+        if(used == 0) continue;
+
+        refr_workers_wait();
+        refr_parallel_active = false;
+        for(i = 0; i < used; i++) {
+            draw_buf->last_part = i == used - 1 && row > y2 ? 1 : 0;
+            refr_worker_flush(&refr_workers[i]);
+        }
+
+        /*The buffers of the workers are reused in the next round*/
+        while(draw_buf->flushing) {
+            if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
+        }
+    }
+}
+
+/**
+ * Make sure that the given number of worker threads are running
+ * @param cnt number of required workers
+ * @return LV_RES_OK: all the workers are running; LV_RES_INV: some threads couldn't be created
+ */
+static lv_res_t refr_workers_start(uint32_t cnt)
+{
+    while(refr_workers_started < cnt) {
+        refr_worker_t * w = &refr_workers[refr_workers_started];
+        lv_memset_00(w, sizeof(refr_worker_t));
+        lv_cond_init(&w->start_cond);
+        if(lv_thread_init(&w->thread, refr_worker_thread, w) != LV_RES_OK) {
+            lv_cond_delete(&w->start_cond);
+            return LV_RES_INV;
+        }
+        refr_workers_started++;
+    }
+
+    return LV_RES_OK;
+}
+
+/**
+ * Give a job to the first `cnt` workers
+ * @param job the job to do
+ * @param cnt number of workers to start
+ */
+static void refr_workers_run(refr_job_t job, uint32_t cnt)
+{
+    lv_mutex_lock(&refr_mutex);
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        refr_workers[i].job = job;
+        lv_cond_signal(&refr_workers[i].start_cond);
+    }
+    refr_jobs_pending += cnt;
+    lv_mutex_unlock(&refr_mutex);
+}
+
+/**
+ * Wait until all the workers finished their job
+ */
+static void refr_workers_wait(void)
+{
+    lv_mutex_lock(&refr_mutex);
+    while(refr_jobs_pending) {
+        lv_cond_wait(&refr_done_cond, &refr_mutex);
+    }
+    lv_mutex_unlock(&refr_mutex);
+}
+
+/**
+ * Flush the band rendered by a worker
+ * @param w pointer to a worker
+ */
+static void refr_worker_flush(refr_worker_t * w)
+{
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp_refr);
+    lv_disp_drv_t * drv = disp_refr->driver;
+
+    while(draw_buf->flushing) {
+        if(drv->wait_cb) drv->wait_cb(drv);
+    }
+
+    draw_buf->flushing = 1;
+    draw_buf->flushing_last = draw_buf->last_area && draw_buf->last_part ? 1 : 0;
+
+    if(drv->flush_cb) call_flush_cb(drv, &w->draw_buf.area, w->buf);
+}
+
+static void refr_worker_thread(void * p)
+{
+    refr_worker_t * w = p;
+
+    lv_mutex_lock(&refr_mutex);
+    while(1) {
+        while(w->job == REFR_JOB_NONE) {
+            lv_cond_wait(&w->start_cond, &refr_mutex);
+        }
+        refr_job_t job = w->job;
+        lv_mutex_unlock(&refr_mutex);
+
+        if(job == REFR_JOB_DRAW) {
+            disp_refr = &w->disp;
+            refr_area_part_draw(&w->inv_area);
+            disp_refr = NULL;
+            _lv_obj_style_flush_stats();
+        }
+        else {
+            lv_mem_buf_free_all();
+            _lv_font_clean_up_fmt_txt();
+        }
+
+        lv_mutex_lock(&refr_mutex);
+        w->job = REFR_JOB_NONE;
+        refr_jobs_pending--;
+        if(refr_jobs_pending == 0) lv_cond_signal(&refr_done_cond);
+    }
+}
+
+#endif /*LV_USE_REFR_PARALLEL*/
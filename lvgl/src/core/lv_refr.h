@@ -64,6 +64,18 @@ void lv_refr_now(lv_disp_t * disp);
  */
 void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p);
 
+/**
+ * Move the content of an area of the frame buffer before the next refresh instead of redrawing it.
+ * The parts of the invalidated areas moved by it and the uncovered strip are invalidated.
+ * Only one area can be moved in a refresh but it can be moved several times.
+ * @param disp pointer to a display with `scroll_blit` and `direct_mode` enabled
+ * @param area_p the area to move. Its content has to be moved together.
+ * @param x distance to move the content horizontally
+ * @param y distance to move the content vertically
+ * @return true: the content will be moved; false: moving is not possible, the area should be invalidated instead
+ */
+bool _lv_refr_scroll_blit(lv_disp_t * disp, const lv_area_t * area_p, lv_coord_t x, lv_coord_t y);
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -86,6 +98,38 @@ void _lv_refr_set_disp_refreshing(lv_disp_t * disp);
 uint32_t lv_refr_get_fps_avg(void);
 #endif
 
+/**
+ * Set the number of threads used to render the invalidated areas.
+ * Has effect only if `LV_USE_REFR_PARALLEL` is enabled, else the rendering is always single threaded.
+ * @param cnt number of rendering threads including the one which calls `lv_timer_handler()`.
+ *            It's limited to `[1, LV_REFR_PARALLEL_THREAD_CNT]`.
+ */
+void lv_refr_set_thread_cnt(uint32_t cnt);
+
+/**
+ * Get the number of threads used to render the invalidated areas
+ * @return number of rendering threads (1 if the parallel renderer is disabled)
+ */
+uint32_t lv_refr_get_thread_cnt(void);
+
+/**
+ * Check if the area being drawn is rendered by several threads concurrently.
+ * The drawing code can use it to avoid modifying shared data only when it's really needed.
+ * @return true: the bands of the current area are rendered in parallel
+ */
+bool _lv_refr_is_parallel(void);
+
+/**
+ * Serialize the parts of drawing which use shared, non thread-safe data (e.g. the image cache and the decoders).
+ * It does nothing if the parallel renderer is disabled.
+ */
+void _lv_refr_draw_lock(void);
+
+/**
+ * Release the lock taken by `_lv_refr_draw_lock()`
+ */
+void _lv_refr_draw_unlock(void);
+
 /**
  * Called periodically to handle the refreshing
  * @param timer pointer to the timer itself
@@ -27,6 +27,7 @@ extern "C" {
 #include "lv_draw_triangle.h"
 #include "lv_draw_arc.h"
 #include "lv_draw_blend.h"
+#include "lv_draw_blend_simd.h"
 #include "lv_draw_mask.h"
 
 /*********************
@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include "lv_draw_blend.h"
+#include "lv_draw_blend_simd.h"
 #include "lv_img_decoder.h"
 #include "../misc/lv_math.h"
 #include "../hal/lv_hal_disp.h"
@@ -34,6 +35,10 @@
  **********************/
 
 #if LV_USE_EXTERNAL_RENDERER == 0
+#if LV_USE_DRAW_SIMD
+static inline const _lv_draw_blend_simd_kernels_t * get_simd_kernels(lv_disp_t * disp);
+#endif
+
 static void fill_set_px(const lv_area_t * disp_area, lv_color_t * disp_buf,  const lv_area_t * draw_area,
                         lv_color_t color, lv_opa_t opa,
                         const lv_opa_t * mask, lv_draw_mask_res_t mask_res);
@@ -157,7 +162,7 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_fill(const lv_area_t * clip_area, const lv_
         for(i = 0; i < mask_w; i++)  mask[i] = mask[i] > 128 ? LV_OPA_COVER : LV_OPA_TRANSP;
     }
 
-    if(disp->driver->set_px_cb) {
+    if(disp->driver->set_px_cb || disp->driver->set_px_span_cb) {
         fill_set_px(disp_area, disp_buf, &draw_area, color, opa, mask, mask_res);
     }
     else if(mode == LV_BLEND_MODE_NORMAL) {
@@ -219,7 +224,7 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_map(const lv_area_t * clip_area, const lv_a
         int32_t i;
         for(i = 0; i < mask_w; i++)  mask[i] = mask[i] > 128 ? LV_OPA_COVER : LV_OPA_TRANSP;
     }
-    if(disp->driver->set_px_cb) {
+    if(disp->driver->set_px_cb || disp->driver->set_px_span_cb) {
         map_set_px(disp_area, disp_buf, &draw_area, map_area, map_buf, opa, mask, mask_res);
     }
     else if(mode == LV_BLEND_MODE_NORMAL) {
@@ -236,6 +241,24 @@ LV_ATTRIBUTE_FAST_MEM void _lv_blend_map(const lv_area_t * clip_area, const lv_a
  *   STATIC FUNCTIONS
  **********************/
 
+#if LV_USE_DRAW_SIMD
+/**
+ * Get the SIMD kernels if they can be used to draw on a display
+ * @param disp pointer to the display being refreshed
+ * @return the kernels or NULL if the plain C code should be used
+ */
+static inline const _lv_draw_blend_simd_kernels_t * get_simd_kernels(lv_disp_t * disp)
+{
+#if LV_COLOR_SCREEN_TRANSP
+    /*The kernels don't handle the alpha channel of the display*/
+    if(disp->driver->screen_transp) return NULL;
+#else
+    LV_UNUSED(disp);
+#endif
+    return _lv_draw_blend_simd_get_kernels();
+}
+#endif
+
 static void fill_set_px(const lv_area_t * disp_area, lv_color_t * disp_buf,  const lv_area_t * draw_area,
                         lv_color_t color, lv_opa_t opa,
                         const lv_opa_t * mask, lv_draw_mask_res_t mask_res)
@@ -249,6 +272,18 @@ static void fill_set_px(const lv_area_t * disp_area, lv_color_t * disp_buf,  con
     int32_t x;
     int32_t y;
 
+    /*Pass the whole lines if the driver can handle them*/
+    if(disp->driver->set_px_span_cb) {
+        int32_t draw_area_w = lv_area_get_width(draw_area);
+        const lv_opa_t * mask_tmp = mask_res == LV_DRAW_MASK_RES_FULL_COVER ? NULL : mask;
+        for(y = draw_area->y1; y <= draw_area->y2; y++) {
+            disp->driver->set_px_span_cb(disp->driver, (void *)disp_buf, disp_w, draw_area->x1, y, draw_area_w,
+                                         NULL, color, mask_tmp, opa);
+            if(mask_tmp) mask_tmp += draw_area_w;
+        }
+        return;
+    }
+
     if(mask_res == LV_DRAW_MASK_RES_FULL_COVER) {
         for(y = draw_area->y1; y <= draw_area->y2; y++) {
             for(x = draw_area->x1; x <= draw_area->x2; x++) {
@@ -337,6 +372,17 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
                 return;
             }
 
+#if LV_USE_DRAW_SIMD
+            const _lv_draw_blend_simd_kernels_t * simd = get_simd_kernels(disp);
+            if(simd) {
+                for(y = 0; y < draw_area_h; y++) {
+                    simd->fill(disp_buf_first, color, draw_area_w);
+                    disp_buf_first += disp_w;
+                }
+                return;
+            }
+#endif
+
             /*Software rendering*/
             for(y = 0; y < draw_area_h; y++) {
                 lv_color_fill(disp_buf_first, color, draw_area_w);
@@ -358,13 +404,25 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
                 /*Fall down to SW render in case of error*/
             }
 #endif
-            lv_color_t last_dest_color = lv_color_black();
-            lv_color_t last_res_color = lv_color_mix(color, last_dest_color, opa);
+#if LV_USE_DRAW_SIMD
+            const _lv_draw_blend_simd_kernels_t * simd = get_simd_kernels(disp);
+            if(simd) {
+                for(y = 0; y < draw_area_h; y++) {
+                    simd->fill_opa(disp_buf_first, color, opa, draw_area_w);
+                    disp_buf_first += disp_w;
+                }
+                return;
+            }
+#endif
 
             uint16_t color_premult[3];
             lv_color_premult(color, opa, color_premult);
             lv_opa_t opa_inv = 255 - opa;
 
+            /*Calculate the first result in the same way as the others*/
+            lv_color_t last_dest_color = lv_color_black();
+            lv_color_t last_res_color = lv_color_mix_premult(color_premult, last_dest_color, opa_inv);
+
             for(y = 0; y < draw_area_h; y++) {
                 for(x = 0; x < draw_area_w; x++) {
                     if(last_dest_color.full != disp_buf_first[x].full) {
@@ -389,6 +447,18 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(const lv_area_t * disp_area, lv_co
     }
     /*Masked*/
     else {
+#if LV_USE_DRAW_SIMD
+        const _lv_draw_blend_simd_kernels_t * simd = get_simd_kernels(disp);
+        if(simd) {
+            for(y = 0; y < draw_area_h; y++) {
+                simd->fill_mask(disp_buf_first, color, opa, mask, draw_area_w);
+                disp_buf_first += disp_w;
+                mask += draw_area_w;
+            }
+            return;
+        }
+#endif
+
         int32_t x_end4 = draw_area_w - 4;
 
 #if LV_COLOR_DEPTH == 16
@@ -606,6 +676,18 @@ static void map_set_px(const lv_area_t * disp_area, lv_color_t * disp_buf,  cons
     int32_t x;
     int32_t y;
 
+    /*Pass the whole lines if the driver can handle them*/
+    if(disp->driver->set_px_span_cb) {
+        const lv_opa_t * mask_tmp = mask_res == LV_DRAW_MASK_RES_FULL_COVER ? NULL : mask;
+        for(y = draw_area->y1; y <= draw_area->y2; y++) {
+            disp->driver->set_px_span_cb(disp->driver, (void *)disp_buf, disp_w, draw_area->x1, y, draw_area_w,
+                                         map_buf_tmp + draw_area->x1, lv_color_black(), mask_tmp, opa);
+            if(mask_tmp) mask_tmp += draw_area_w;
+            map_buf_tmp += map_w;
+        }
+        return;
+    }
+
     if(mask_res == LV_DRAW_MASK_RES_FULL_COVER) {
         for(y = draw_area->y1; y <= draw_area->y2; y++) {
             for(x = draw_area->x1; x <= draw_area->x2; x++) {
@@ -668,9 +750,12 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(const lv_area_t * disp_area, lv_col
     const lv_color_t * map_buf_first = map_buf + map_w * (draw_area->y1 - (map_area->y1 - disp_area->y1));
     map_buf_first += (draw_area->x1 - (map_area->x1 - disp_area->x1));
 
-#if LV_COLOR_SCREEN_TRANSP
+#if LV_COLOR_SCREEN_TRANSP || LV_USE_DRAW_SIMD
     lv_disp_t * disp = _lv_refr_get_disp_refreshing();
 #endif
+#if LV_USE_DRAW_SIMD
+    const _lv_draw_blend_simd_kernels_t * simd = get_simd_kernels(disp);
+#endif
 
     int32_t x;
     int32_t y;
@@ -770,6 +855,17 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(const lv_area_t * disp_area, lv_col
             }
 #endif
 
+#if LV_USE_DRAW_SIMD
+            if(simd) {
+                for(y = 0; y < draw_area_h; y++) {
+                    simd->map_opa(disp_buf_first, map_buf_first, opa, draw_area_w);
+                    disp_buf_first += disp_w;
+                    map_buf_first += map_w;
+                }
+                return;
+            }
+#endif
+
             /*Software rendering*/
 
             for(y = 0; y < draw_area_h; y++) {
@@ -792,6 +888,18 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(const lv_area_t * disp_area, lv_col
     }
     /*Masked*/
     else {
+#if LV_USE_DRAW_SIMD
+        if(simd) {
+            for(y = 0; y < draw_area_h; y++) {
+                simd->map_mask(disp_buf_first, map_buf_first, opa, mask, draw_area_w);
+                disp_buf_first += disp_w;
+                mask += draw_area_w;
+                map_buf_first += map_w;
+            }
+            return;
+        }
+#endif
+
         /*Only the mask matters*/
         if(opa > LV_OPA_MAX) {
             /*Go to the first pixel of the row*/
@@ -0,0 +1,987 @@
+/**
+ * @file lv_draw_blend_simd.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_blend_simd.h"
+#if LV_USE_DRAW_SIMD
+
+#include "../misc/lv_math.h"
+#include "../misc/lv_log.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+/*The kernels work with the native color formats only*/
+#if LV_COLOR_DEPTH == 32 || (LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0)
+    #if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+        #define BLEND_SIMD_SSE2 1
+        #include <emmintrin.h>
+    #endif
+
+    /*AVX2 is enabled for the functions which use it and selected only if the CPU supports it*/
+    #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(BLEND_SIMD_SSE2)
+        #define BLEND_SIMD_AVX2 1
+        #define AVX2_ATTR __attribute__((target("avx2")))
+        #include <immintrin.h>
+    #endif
+
+    #if defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #define BLEND_SIMD_NEON 1
+        #include <arm_neon.h>
+    #endif
+#endif
+
+#if defined(BLEND_SIMD_SSE2) || defined(BLEND_SIMD_AVX2) || defined(BLEND_SIMD_NEON)
+    #define BLEND_SIMD_ANY 1
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#ifdef BLEND_SIMD_ANY
+static void fill_opa_px(lv_color_t * dest, lv_color_t color, lv_opa_t opa, int32_t len);
+static void fill_mask_px(lv_color_t * dest, lv_color_t color, lv_opa_t opa, const lv_opa_t * mask, int32_t len);
+static void map_opa_px(lv_color_t * dest, const lv_color_t * src, lv_opa_t opa, int32_t len);
+static void map_mask_px(lv_color_t * dest, const lv_color_t * src, lv_opa_t opa, const lv_opa_t * mask, int32_t len);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#ifdef BLEND_SIMD_SSE2
+static const _lv_draw_blend_simd_kernels_t sse2_kernels;
+#endif
+#ifdef BLEND_SIMD_AVX2
+static const _lv_draw_blend_simd_kernels_t avx2_kernels;
+#endif
+#ifdef BLEND_SIMD_NEON
+static const _lv_draw_blend_simd_kernels_t neon_kernels;
+#endif
+
+static lv_draw_blend_simd_t simd_act = LV_DRAW_BLEND_SIMD_NONE;
+static const _lv_draw_blend_simd_kernels_t * kernels_act;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void _lv_draw_blend_simd_init(void)
+{
+    lv_draw_blend_simd_t simd;
+    for(simd = _LV_DRAW_BLEND_SIMD_LAST - 1; simd > LV_DRAW_BLEND_SIMD_NONE; simd--) {
+        if(lv_draw_blend_simd_is_supported(simd)) break;
+    }
+
+    lv_draw_blend_simd_set(simd);
+    LV_LOG_INFO("blend instruction set: %d", simd);
+}
+
+bool lv_draw_blend_simd_is_supported(lv_draw_blend_simd_t simd)
+{
+    switch(simd) {
+        case LV_DRAW_BLEND_SIMD_NONE:
+            return true;
+#ifdef BLEND_SIMD_SSE2
+        case LV_DRAW_BLEND_SIMD_SSE2:
+            return true;
+#endif
+#ifdef BLEND_SIMD_AVX2
+        case LV_DRAW_BLEND_SIMD_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") ? true : false;
+#endif
+#ifdef BLEND_SIMD_NEON
+        case LV_DRAW_BLEND_SIMD_NEON:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+lv_res_t lv_draw_blend_simd_set(lv_draw_blend_simd_t simd)
+{
+    if(!lv_draw_blend_simd_is_supported(simd)) return LV_RES_INV;
+
+    switch(simd) {
+#ifdef BLEND_SIMD_SSE2
+        case LV_DRAW_BLEND_SIMD_SSE2:
+            kernels_act = &sse2_kernels;
+            break;
+#endif
+#ifdef BLEND_SIMD_AVX2
+        case LV_DRAW_BLEND_SIMD_AVX2:
+            kernels_act = &avx2_kernels;
+            break;
+#endif
+#ifdef BLEND_SIMD_NEON
+        case LV_DRAW_BLEND_SIMD_NEON:
+            kernels_act = &neon_kernels;
+            break;
+#endif
+        default:
+            kernels_act = NULL;
+            break;
+    }
+
+    simd_act = simd;
+    return LV_RES_OK;
+}
+
+lv_draw_blend_simd_t lv_draw_blend_simd_get(void)
+{
+    return simd_act;
+}
+
+const _lv_draw_blend_simd_kernels_t * _lv_draw_blend_simd_get_kernels(void)
+{
+    return kernels_act;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#ifdef BLEND_SIMD_ANY
+
+/*The pixels which don't fill a whole vector are blended with the same calculation as `lv_draw_blend.c` uses*/
+
+static void fill_opa_px(lv_color_t * dest, lv_color_t color, lv_opa_t opa, int32_t len)
+{
+    uint16_t color_premult[3];
+    lv_color_premult(color, opa, color_premult);
+    lv_opa_t opa_inv = 255 - opa;
+
+    int32_t i;
+    for(i = 0; i < len; i++) {
+        dest[i] = lv_color_mix_premult(color_premult, dest[i], opa_inv);
+    }
+}
+
+static void fill_mask_px(lv_color_t * dest, lv_color_t color, lv_opa_t opa, const lv_opa_t * mask, int32_t len)
+{
+    int32_t i;
+    for(i = 0; i < len; i++) {
+        if(mask[i] == LV_OPA_TRANSP) continue;
+        if(opa > LV_OPA_MAX) {
+            dest[i] = mask[i] == LV_OPA_COVER ? color : lv_color_mix(color, dest[i], mask[i]);
+        }
+        else {
+            lv_opa_t opa_tmp = mask[i] == LV_OPA_COVER ? opa : (uint32_t)((uint32_t)mask[i] * opa) >> 8;
+            dest[i] = lv_color_mix(color, dest[i], opa_tmp);
+        }
+    }
+}
+
+static void map_opa_px(lv_color_t * dest, const lv_color_t * src, lv_opa_t opa, int32_t len)
+{
+    int32_t i;
+    for(i = 0; i < len; i++) {
+        dest[i] = lv_color_mix(src[i], dest[i], opa);
+    }
+}
+
+static void map_mask_px(lv_color_t * dest, const lv_color_t * src, lv_opa_t opa, const lv_opa_t * mask, int32_t len)
+{
+    int32_t i;
+    for(i = 0; i < len; i++) {
+        if(mask[i] == LV_OPA_TRANSP) continue;
+        if(opa > LV_OPA_MAX) {
+            dest[i] = mask[i] == LV_OPA_COVER ? src[i] : lv_color_mix(src[i], dest[i], mask[i]);
+        }
+        else {
+            lv_opa_t opa_tmp = mask[i] >= LV_OPA_MAX ? opa : ((opa * mask[i]) >> 8);
+            dest[i] = lv_color_mix(src[i], dest[i], opa_tmp);
+        }
+    }
+}
+
+#endif /*BLEND_SIMD_ANY*/
+
+/*=====================
+ * SSE2
+ *====================*/
+
+#ifdef BLEND_SIMD_SSE2
+
+/*ARGB8888: 4 pixels in a vector and the mask values are in 32 bit lanes.
+ *RGB565: 8 pixels in a vector and the mask values are in 16 bit lanes.*/
+#define SSE2_PX_CNT     (int32_t)(sizeof(__m128i) / sizeof(lv_color_t))
+
+/*(fg * mix + bg * (255 - mix) + LV_COLOR_MIX_ROUND_OFS) / 255 on 16 bit lanes. The division is `LV_UDIV255()`*/
+static inline __m128i sse2_mix_ch(__m128i fg, __m128i bg, __m128i mix)
+{
+    __m128i x = _mm_mullo_epi16(fg, mix);
+    x = _mm_add_epi16(x, _mm_mullo_epi16(bg, _mm_sub_epi16(_mm_set1_epi16(255), mix)));
+    x = _mm_add_epi16(x, _mm_set1_epi16(LV_COLOR_MIX_ROUND_OFS));
+    return _mm_srli_epi16(_mm_mulhi_epu16(x, _mm_set1_epi16((short)0x8081)), 7);
+}
+
+#if LV_COLOR_DEPTH == 16
+/*`lv_color_mix()` of RGB565: bg + ((fg - bg) * ((mix + 4) >> 3)) >> 5 on every channel*/
+static inline __m128i sse2_mix565_ch(__m128i fg, __m128i bg, __m128i mix)
+{
+    return _mm_add_epi16(bg, _mm_srai_epi16(_mm_mullo_epi16(_mm_sub_epi16(fg, bg), mix), 5));
+}
+#endif
+
+/*Mix the pixels like `lv_color_mix()`*/
+static inline __m128i sse2_mix(__m128i fg, __m128i bg, __m128i mix)
+{
+#if LV_COLOR_DEPTH == 32
+    const __m128i zero = _mm_setzero_si128();
+    /*Repeat the mix ratio for every channel of the pixels*/
+    mix = _mm_or_si128(mix, _mm_slli_epi32(mix, 16));
+    __m128i lo = sse2_mix_ch(_mm_unpacklo_epi8(fg, zero), _mm_unpacklo_epi8(bg, zero), _mm_unpacklo_epi32(mix, mix));
+    __m128i hi = sse2_mix_ch(_mm_unpackhi_epi8(fg, zero), _mm_unpackhi_epi8(bg, zero), _mm_unpackhi_epi32(mix, mix));
+    return _mm_or_si128(_mm_packus_epi16(lo, hi), _mm_set1_epi32((int)0xFF000000));
+#else
+    const __m128i m5 = _mm_set1_epi16(0x1F);
+    const __m128i m6 = _mm_set1_epi16(0x3F);
+    mix = _mm_srli_epi16(_mm_add_epi16(mix, _mm_set1_epi16(4)), 3);
+    __m128i r = sse2_mix565_ch(_mm_srli_epi16(fg, 11), _mm_srli_epi16(bg, 11), mix);
+    __m128i g = sse2_mix565_ch(_mm_and_si128(_mm_srli_epi16(fg, 5), m6), _mm_and_si128(_mm_srli_epi16(bg, 5), m6), mix);
+    __m128i b = sse2_mix565_ch(_mm_and_si128(fg, m5), _mm_and_si128(bg, m5), mix);
+    return _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b);
+#endif
+}
+
+/*Mix the pixels like `lv_color_mix_premult()`*/
+static inline __m128i sse2_mix_premult(__m128i fg, __m128i bg, __m128i mix)
+{
+#if LV_COLOR_DEPTH == 32
+    return sse2_mix(fg, bg, mix);
+#else
+    const __m128i m5 = _mm_set1_epi16(0x1F);
+    const __m128i m6 = _mm_set1_epi16(0x3F);
+    __m128i r = sse2_mix_ch(_mm_srli_epi16(fg, 11), _mm_srli_epi16(bg, 11), mix);
+    __m128i g = sse2_mix_ch(_mm_and_si128(_mm_srli_epi16(fg, 5), m6), _mm_and_si128(_mm_srli_epi16(bg, 5), m6), mix);
+    __m128i b = sse2_mix_ch(_mm_and_si128(fg, m5), _mm_and_si128(bg, m5), mix);
+    return _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b);
+#endif
+}
+
+static inline __m128i sse2_set1_px(lv_color_t color)
+{
+#if LV_COLOR_DEPTH == 32
+    return _mm_set1_epi32((int)color.full);
+#else
+    return _mm_set1_epi16((short)color.full);
+#endif
+}
+
+/*Set a value for every pixel*/
+static inline __m128i sse2_set1_lane(uint8_t v)
+{
+#if LV_COLOR_DEPTH == 32
+    return _mm_set1_epi32(v);
+#else
+    return _mm_set1_epi16(v);
+#endif
+}
+
+static inline __m128i sse2_load_mask(const lv_opa_t * mask)
+{
+    const __m128i zero = _mm_setzero_si128();
+#if LV_COLOR_DEPTH == 32
+    uint32_t m;
+    memcpy(&m, mask, sizeof(m));
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int)m), zero), zero);
+#else
+    return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)mask), zero);
+#endif
+}
+
+static inline __m128i sse2_cmpeq_lane(__m128i a, __m128i b)
+{
+#if LV_COLOR_DEPTH == 32
+    return _mm_cmpeq_epi32(a, b);
+#else
+    return _mm_cmpeq_epi16(a, b);
+#endif
+}
+
+static inline __m128i sse2_cmpgt_lane(__m128i a, __m128i b)
+{
+#if LV_COLOR_DEPTH == 32
+    return _mm_cmpgt_epi32(a, b);
+#else
+    return _mm_cmpgt_epi16(a, b);
+#endif
+}
+
+/*(mask * opa) >> 8. It fits into the lower 16 bits of the lanes for both color depths*/
+static inline __m128i sse2_mask_opa(__m128i mask, __m128i opa)
+{
+    return _mm_srli_epi16(_mm_mullo_epi16(mask, opa), 8);
+}
+
+/*Take `a` where `cond` is set and `b` elsewhere*/
+static inline __m128i sse2_select(__m128i cond, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(cond, a), _mm_andnot_si128(cond, b));
+}
+
+static void sse2_fill(lv_color_t * dest, lv_color_t color, int32_t len)
+{
+    const __m128i c = sse2_set1_px(color);
+    int32_t i;
+    for(i = 0; i + SSE2_PX_CNT <= len; i += SSE2_PX_CNT) {
+        _mm_storeu_si128((__m128i *)(dest + i), c);
+    }
+    if(i < len) lv_color_fill(dest + i, color, len - i);
+}
+
+static void sse2_fill_opa(lv_color_t * dest, lv_color_t color, lv_opa_t opa, int32_t len)
+{
+    const __m128i c = sse2_set1_px(color);
+    const __m128i mix = sse2_set1_lane(opa);
+    int32_t i;
+    for(i = 0; i + SSE2_PX_CNT <= len; i += SSE2_PX_CNT) {
+        __m128i d = _mm_loadu_si128((const __m128i *)(dest + i));
+        _mm_storeu_si128((__m128i *)(dest + i), sse2_mix_premult(c, d, mix));
+    }
+    fill_opa_px(dest + i, color, opa, len - i);
+}
+
+static void sse2_fill_mask(lv_color_t * dest, lv_color_t color, lv_opa_t opa, const lv_opa_t * mask, int32_t len)
+{
+    const __m128i c = sse2_set1_px(color);
+    const __m128i opa_v = sse2_set1_lane(opa);
+    const __m128i transp = _mm_setzero_si128();
+    const __m128i cover = sse2_set1_lane(LV_OPA_COVER);
+    int32_t i;
+    for(i = 0; i + SSE2_PX_CNT <= len; i += SSE2_PX_CNT) {
+        __m128i m = sse2_load_mask(mask + i);
+        __m128i m_transp = sse2_cmpeq_lane(m, transp);
+        if(_mm_movemask_epi8(m_transp) == 0xFFFF) continue;
+
+        __m128i m_cover = sse2_cmpeq_lane(m, cover);
+        __m128i d = _mm_loadu_si128((const __m128i *)(dest + i));
+        __m128i res;
+        if(opa > LV_OPA_MAX) {
+            if(_mm_movemask_epi8(m_cover) == 0xFFFF) {
+                _mm_storeu_si128((__m128i *)(dest + i), c);
+                continue;
+            }
+            res = sse2_select(m_cover, c, sse2_mix(c, d, m));
+        }
+        else {
+            res = sse2_mix(c, d, sse2_select(m_cover, opa_v, sse2_mask_opa(m, opa_v)));
+        }
+        _mm_storeu_si128((__m128i *)(dest + i), sse2_select(m_transp, d, res));
+    }
+    fill_mask_px(dest + i, color, opa, mask + i, len - i);
+}
+
+static void sse2_map_opa(lv_color_t * dest, const lv_color_t * src, lv_opa_t opa, int32_t len)
+{
+    const __m128i mix = sse2_set1_lane(opa);
+    int32_t i;
+    for(i = 0; i + SSE2_PX_CNT <= len; i += SSE2_PX_CNT) {
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i d = _mm_loadu_si128((const __m128i *)(dest + i));
+        _mm_storeu_si128((__m128i *)(dest + i), sse2_mix(s, d, mix));
+    }
+    map_opa_px(dest + i, src + i, opa, len - i);
+}
+
+static void sse2_map_mask(lv_color_t * dest, const lv_color_t * src, lv_opa_t opa, const lv_opa_t * mask, int32_t len)
+{
+    const __m128i opa_v = sse2_set1_lane(opa);
+    const __m128i transp = _mm_setzero_si128();
+    const __m128i cover = sse2_set1_lane(LV_OPA_COVER);
+    const __m128i max = sse2_set1_lane(LV_OPA_MAX - 1);
+    int32_t i;
+    for(i = 0; i + SSE2_PX_CNT <= len; i += SSE2_PX_CNT) {
+        __m128i m = sse2_load_mask(mask + i);
+        __m128i m_transp = sse2_cmpeq_lane(m, transp);
+        if(_mm_movemask_epi8(m_transp) == 0xFFFF) continue;
+
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i res;
+        if(opa > LV_OPA_MAX) {
+            __m128i m_cover = sse2_cmpeq_lane(m, cover);
+            if(_mm_movemask_epi8(m_cover) == 0xFFFF) {
+                _mm_storeu_si128((__m128i *)(dest + i), s);
+                continue;
+            }
+            __m128i d = _mm_loadu_si128((const __m128i *)(dest + i));
+            res = sse2_select(m_cover, s, sse2_mix(s, d, m));
+            res = sse2_select(m_transp, d, res);
+        }
+        else {
+            __m128i d = _mm_loadu_si128((const __m128i *)(dest + i));
+            __m128i mix = sse2_select(sse2_cmpgt_lane(m, max), opa_v, sse2_mask_opa(m, opa_v));
+            res = sse2_select(m_transp, d, sse2_mix(s, d, mix));
+        }
+        _mm_storeu_si128((__m128i *)(dest + i), res);
+    }
+    map_mask_px(dest + i, src + i, opa, mask + i, len - i);
+}
+
+static const _lv_draw_blend_simd_kernels_t sse2_kernels = {
+    .fill = sse2_fill,
+    .fill_opa = sse2_fill_opa,
+    .fill_mask = sse2_fill_mask,
+    .map_opa = sse2_map_opa,
+    .map_mask = sse2_map_mask,
+};
+
+#endif /*BLEND_SIMD_SSE2*/
+
+/*=====================
+ * AVX2
+ *====================*/
+
+#ifdef BLEND_SIMD_AVX2
+
+/*The same as the SSE2 kernels with twice as wide vectors.
+ *The unpack and pack instructions work on the 128 bit halves so the pixels stay in order.*/
+#define AVX2_PX_CNT     (int32_t)(sizeof(__m256i) / sizeof(lv_color_t))
+
+AVX2_ATTR static inline __m256i avx2_mix_ch(__m256i fg, __m256i bg, __m256i mix)
+{
+    __m256i x = _mm256_mullo_epi16(fg, mix);
+    x = _mm256_add_epi16(x, _mm256_mullo_epi16(bg, _mm256_sub_epi16(_mm256_set1_epi16(255), mix)));
+    x = _mm256_add_epi16(x, _mm256_set1_epi16(LV_COLOR_MIX_ROUND_OFS));
+    return _mm256_srli_epi16(_mm256_mulhi_epu16(x, _mm256_set1_epi16((short)0x8081)), 7);
+}
+
+#if LV_COLOR_DEPTH == 16
+AVX2_ATTR static inline __m256i avx2_mix565_ch(__m256i fg, __m256i bg, __m256i mix)
+{
+    return _mm256_add_epi16(bg, _mm256_srai_epi16(_mm256_mullo_epi16(_mm256_sub_epi16(fg, bg), mix), 5));
+}
+#endif
+
+AVX2_ATTR static inline __m256i avx2_mix(__m256i fg, __m256i bg, __m256i mix)
+{
+#if LV_COLOR_DEPTH == 32
+    const __m256i zero = _mm256_setzero_si256();
+    mix = _mm256_or_si256(mix, _mm256_slli_epi32(mix, 16));
+    __m256i lo = avx2_mix_ch(_mm256_unpacklo_epi8(fg, zero), _mm256_unpacklo_epi8(bg, zero),
+                             _mm256_unpacklo_epi32(mix, mix));
+    __m256i hi = avx2_mix_ch(_mm256_unpackhi_epi8(fg, zero), _mm256_unpackhi_epi8(bg, zero),
+                             _mm256_unpackhi_epi32(mix, mix));
+    return _mm256_or_si256(_mm256_packus_epi16(lo, hi), _mm256_set1_epi32((int)0xFF000000));
+#else
+    const __m256i m5 = _mm256_set1_epi16(0x1F);
+    const __m256i m6 = _mm256_set1_epi16(0x3F);
+    mix = _mm256_srli_epi16(_mm256_add_epi16(mix, _mm256_set1_epi16(4)), 3);
+    __m256i r = avx2_mix565_ch(_mm256_srli_epi16(fg, 11), _mm256_srli_epi16(bg, 11), mix);
+    __m256i g = avx2_mix565_ch(_mm256_and_si256(_mm256_srli_epi16(fg, 5), m6),
+                               _mm256_and_si256(_mm256_srli_epi16(bg, 5), m6), mix);
+    __m256i b = avx2_mix565_ch(_mm256_and_si256(fg, m5), _mm256_and_si256(bg, m5), mix);
+    return _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(r, 11), _mm256_slli_epi16(g, 5)), b);
+#endif
+}
+
+AVX2_ATTR static inline __m256i avx2_mix_premult(__m256i fg, __m256i bg, __m256i mix)
+{
+#if LV_COLOR_DEPTH == 32
+    return avx2_mix(fg, bg, mix);
+#else
+    const __m256i m5 = _mm256_set1_epi16(0x1F);
+    const __m256i m6 = _mm256_set1_epi16(0x3F);
+    __m256i r = avx2_mix_ch(_mm256_srli_epi16(fg, 11), _mm256_srli_epi16(bg, 11), mix);
+    __m256i g = avx2_mix_ch(_mm256_and_si256(_mm256_srli_epi16(fg, 5), m6),
+                            _mm256_and_si256(_mm256_srli_epi16(bg, 5), m6), mix);
+    __m256i b = avx2_mix_ch(_mm256_and_si256(fg, m5), _mm256_and_si256(bg, m5), mix);
+    return _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(r, 11), _mm256_slli_epi16(g, 5)), b);
+#endif
+}
+
+AVX2_ATTR static inline __m256i avx2_set1_px(lv_color_t color)
+{
+#if LV_COLOR_DEPTH == 32
+    return _mm256_set1_epi32((int)color.full);
+#else
+    return _mm256_set1_epi16((short)color.full);
+#endif
+}
+
+AVX2_ATTR static inline __m256i avx2_set1_lane(uint8_t v)
+{
+#if LV_COLOR_DEPTH == 32
+    return _mm256_set1_epi32(v);
+#else
+    return _mm256_set1_epi16(v);
+#endif
+}
+
+AVX2_ATTR static inline __m256i avx2_load_mask(const lv_opa_t * mask)
+{
+#if LV_COLOR_DEPTH == 32
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)mask));
+#else
+    return _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)mask));
+#endif
+}
+
+AVX2_ATTR static inline __m256i avx2_cmpeq_lane(__m256i a, __m256i b)
+{
+#if LV_COLOR_DEPTH == 32
+    return _mm256_cmpeq_epi32(a, b);
+#else
+    return _mm256_cmpeq_epi16(a, b);
+#endif
+}
+
+AVX2_ATTR static inline __m256i avx2_cmpgt_lane(__m256i a, __m256i b)
+{
+#if LV_COLOR_DEPTH == 32
+    return _mm256_cmpgt_epi32(a, b);
+#else
+    return _mm256_cmpgt_epi16(a, b);
+#endif
+}
+
+AVX2_ATTR static inline __m256i avx2_mask_opa(__m256i mask, __m256i opa)
+{
+    return _mm256_srli_epi16(_mm256_mullo_epi16(mask, opa), 8);
+}
+
+AVX2_ATTR static inline __m256i avx2_select(__m256i cond, __m256i a, __m256i b)
+{
+    return _mm256_blendv_epi8(b, a, cond);
+}
+
+AVX2_ATTR static inline bool avx2_all_set(__m256i cond)
+{
+    return _mm256_movemask_epi8(cond) == -1;
+}
+
+AVX2_ATTR static void avx2_fill(lv_color_t * dest, lv_color_t color, int32_t len)
+{
+    const __m256i c = avx2_set1_px(color);
+    int32_t i;
+    for(i = 0; i + AVX2_PX_CNT <= len; i += AVX2_PX_CNT) {
+        _mm256_storeu_si256((__m256i *)(dest + i), c);
+    }
+    if(i < len) lv_color_fill(dest + i, color, len - i);
+}
+
+AVX2_ATTR static void avx2_fill_opa(lv_color_t * dest, lv_color_t color, lv_opa_t opa, int32_t len)
+{
+    const __m256i c = avx2_set1_px(color);
+    const __m256i mix = avx2_set1_lane(opa);
+    int32_t i;
+    for(i = 0; i + AVX2_PX_CNT <= len; i += AVX2_PX_CNT) {
+        __m256i d = _mm256_loadu_si256((const __m256i *)(dest + i));
+        _mm256_storeu_si256((__m256i *)(dest + i), avx2_mix_premult(c, d, mix));
+    }
+    fill_opa_px(dest + i, color, opa, len - i);
+}
+
+AVX2_ATTR static void avx2_fill_mask(lv_color_t * dest, lv_color_t color, lv_opa_t opa, const lv_opa_t * mask,
+                                     int32_t len)
+{
+    const __m256i c = avx2_set1_px(color);
+    const __m256i opa_v = avx2_set1_lane(opa);
+    const __m256i transp = _mm256_setzero_si256();
+    const __m256i cover = avx2_set1_lane(LV_OPA_COVER);
+    int32_t i;
+    for(i = 0; i + AVX2_PX_CNT <= len; i += AVX2_PX_CNT) {
+        __m256i m = avx2_load_mask(mask + i);
+        __m256i m_transp = avx2_cmpeq_lane(m, transp);
+        if(avx2_all_set(m_transp)) continue;
+
+        __m256i m_cover = avx2_cmpeq_lane(m, cover);
+        __m256i d = _mm256_loadu_si256((const __m256i *)(dest + i));
+        __m256i res;
+        if(opa > LV_OPA_MAX) {
+            if(avx2_all_set(m_cover)) {
+                _mm256_storeu_si256((__m256i *)(dest + i), c);
+                continue;
+            }
+            res = avx2_select(m_cover, c, avx2_mix(c, d, m));
+        }
+        else {
+            res = avx2_mix(c, d, avx2_select(m_cover, opa_v, avx2_mask_opa(m, opa_v)));
+        }
+        _mm256_storeu_si256((__m256i *)(dest + i), avx2_select(m_transp, d, res));
+    }
+    fill_mask_px(dest + i, color, opa, mask + i, len - i);
+}
+
+AVX2_ATTR static void avx2_map_opa(lv_color_t * dest, const lv_color_t * src, lv_opa_t opa, int32_t len)
+{
+    const __m256i mix = avx2_set1_lane(opa);
+    int32_t i;
+    for(i = 0; i + AVX2_PX_CNT <= len; i += AVX2_PX_CNT) {
+        __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i d = _mm256_loadu_si256((const __m256i *)(dest + i));
+        _mm256_storeu_si256((__m256i *)(dest + i), avx2_mix(s, d, mix));
+    }
+    map_opa_px(dest + i, src + i, opa, len - i);
+}
+
+AVX2_ATTR static void avx2_map_mask(lv_color_t * dest, const lv_color_t * src, lv_opa_t opa, const lv_opa_t * mask,
+                                    int32_t len)
+{
+    const __m256i opa_v = avx2_set1_lane(opa);
+    const __m256i transp = _mm256_setzero_si256();
+    const __m256i cover = avx2_set1_lane(LV_OPA_COVER);
+    const __m256i max = avx2_set1_lane(LV_OPA_MAX - 1);
+    int32_t i;
+    for(i = 0; i + AVX2_PX_CNT <= len; i += AVX2_PX_CNT) {
+        __m256i m = avx2_load_mask(mask + i);
+        __m256i m_transp = avx2_cmpeq_lane(m, transp);
+        if(avx2_all_set(m_transp)) continue;
+
+        __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i res;
+        if(opa > LV_OPA_MAX) {
+            __m256i m_cover = avx2_cmpeq_lane(m, cover);
+            if(avx2_all_set(m_cover)) {
+                _mm256_storeu_si256((__m256i *)(dest + i), s);
+                continue;
+            }
+            __m256i d = _mm256_loadu_si256((const __m256i *)(dest + i));
+            res = avx2_select(m_cover, s, avx2_mix(s, d, m));
+            res = avx2_select(m_transp, d, res);
+        }
+        else {
+            __m256i d = _mm256_loadu_si256((const __m256i *)(dest + i));
+            __m256i mix = avx2_select(avx2_cmpgt_lane(m, max), opa_v, avx2_mask_opa(m, opa_v));
+            res = avx2_select(m_transp, d, avx2_mix(s, d, mix));
+        }
+        _mm256_storeu_si256((__m256i *)(dest + i), res);
+    }
+    map_mask_px(dest + i, src + i, opa, mask + i, len - i);
+}
+
+static const _lv_draw_blend_simd_kernels_t avx2_kernels = {
+    .fill = avx2_fill,
+    .fill_opa = avx2_fill_opa,
+    .fill_mask = avx2_fill_mask,
+    .map_opa = avx2_map_opa,
+    .map_mask = avx2_map_mask,
+};
+
+#endif /*BLEND_SIMD_AVX2*/
+
+/*=====================
+ * NEON
+ *====================*/
+
+#ifdef BLEND_SIMD_NEON
+
+/*8 pixels are processed at once.
+ *ARGB8888: the channels are loaded into separate vectors by `vld4` and the mask values are in 8 bit lanes.
+ *RGB565: the pixels and the mask values are in 16 bit lanes.*/
+#define NEON_PX_CNT     8
+
+#if LV_COLOR_DEPTH == 32
+typedef uint8x8x4_t neon_px_t;
+typedef uint8x8_t neon_lane_t;
+#else
+typedef uint16x8_t neon_px_t;
+typedef uint16x8_t neon_lane_t;
+#endif
+
+/*`LV_UDIV255()` of 16 bit lanes*/
+static inline uint16x8_t neon_udiv255(uint16x8_t x)
+{
+    const uint16x4_t div = vdup_n_u16(0x8081);
+    uint16x8_t q = vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(x), div), 16),
+                                vshrn_n_u32(vmull_u16(vget_high_u16(x), div), 16));
+    return vshrq_n_u16(q, 7);
+}
+
+#if LV_COLOR_DEPTH == 32
+static inline uint8x8_t neon_mix_ch(uint8x8_t fg, uint8x8_t bg, uint8x8_t mix)
+{
+    uint16x8_t x = vmull_u8(fg, mix);
+    x = vmlal_u8(x, bg, vmvn_u8(mix));
+    x = vaddq_u16(x, vdupq_n_u16(LV_COLOR_MIX_ROUND_OFS));
+    return vmovn_u16(neon_udiv255(x));
+}
+#else
+static inline uint16x8_t neon_mix_ch(uint16x8_t fg, uint16x8_t bg, uint16x8_t mix)
+{
+    uint16x8_t x = vmulq_u16(fg, mix);
+    x = vmlaq_u16(x, bg, vsubq_u16(vdupq_n_u16(255), mix));
+    x = vaddq_u16(x, vdupq_n_u16(LV_COLOR_MIX_ROUND_OFS));
+    return neon_udiv255(x);
+}
+
+static inline uint16x8_t neon_mix565_ch(uint16x8_t fg, uint16x8_t bg, uint16x8_t mix)
+{
+    int16x8_t d = vsubq_s16(vreinterpretq_s16_u16(fg), vreinterpretq_s16_u16(bg));
+    d = vshrq_n_s16(vmulq_s16(d, vreinterpretq_s16_u16(mix)), 5);
+    return vreinterpretq_u16_s16(vaddq_s16(vreinterpretq_s16_u16(bg), d));
+}
+
+static inline uint16x8_t neon_pack565(uint16x8_t r, uint16x8_t g, uint16x8_t b)
+{
+    return vorrq_u16(vorrq_u16(vshlq_n_u16(r, 11), vshlq_n_u16(g, 5)), b);
+}
+#endif
+
+static inline neon_px_t neon_mix(neon_px_t fg, neon_px_t bg, neon_lane_t mix)
+{
+#if LV_COLOR_DEPTH == 32
+    neon_px_t res;
+    res.val[0] = neon_mix_ch(fg.val[0], bg.val[0], mix);
+    res.val[1] = neon_mix_ch(fg.val[1], bg.val[1], mix);
+    res.val[2] = neon_mix_ch(fg.val[2], bg.val[2], mix);
+    res.val[3] = vdup_n_u8(0xFF);
+    return res;
+#else
+    const uint16x8_t m5 = vdupq_n_u16(0x1F);
+    const uint16x8_t m6 = vdupq_n_u16(0x3F);
+    mix = vshrq_n_u16(vaddq_u16(mix, vdupq_n_u16(4)), 3);
+    uint16x8_t r = neon_mix565_ch(vshrq_n_u16(fg, 11), vshrq_n_u16(bg, 11), mix);
+    uint16x8_t g = neon_mix565_ch(vandq_u16(vshrq_n_u16(fg, 5), m6), vandq_u16(vshrq_n_u16(bg, 5), m6), mix);
+    uint16x8_t b = neon_mix565_ch(vandq_u16(fg, m5), vandq_u16(bg, m5), mix);
+    return neon_pack565(r, g, b);
+#endif
+}
+
+static inline neon_px_t neon_mix_premult(neon_px_t fg, neon_px_t bg, neon_lane_t mix)
+{
+#if LV_COLOR_DEPTH == 32
+    return neon_mix(fg, bg, mix);
+#else
+    const uint16x8_t m5 = vdupq_n_u16(0x1F);
+    const uint16x8_t m6 = vdupq_n_u16(0x3F);
+    uint16x8_t r = neon_mix_ch(vshrq_n_u16(fg, 11), vshrq_n_u16(bg, 11), mix);
+    uint16x8_t g = neon_mix_ch(vandq_u16(vshrq_n_u16(fg, 5), m6), vandq_u16(vshrq_n_u16(bg, 5), m6), mix);
+    uint16x8_t b = neon_mix_ch(vandq_u16(fg, m5), vandq_u16(bg, m5), mix);
+    return neon_pack565(r, g, b);
+#endif
+}
+
+static inline neon_px_t neon_load_px(const lv_color_t * p)
+{
+#if LV_COLOR_DEPTH == 32
+    return vld4_u8((const uint8_t *)p);
+#else
+    return vld1q_u16((const uint16_t *)p);
+#endif
+}
+
+static inline void neon_store_px(lv_color_t * p, neon_px_t px)
+{
+#if LV_COLOR_DEPTH == 32
+    vst4_u8((uint8_t *)p, px);
+#else
+    vst1q_u16((uint16_t *)p, px);
+#endif
+}
+
+static inline neon_px_t neon_set1_px(lv_color_t color)
+{
+#if LV_COLOR_DEPTH == 32
+    neon_px_t px;
+    px.val[0] = vdup_n_u8(color.ch.blue);
+    px.val[1] = vdup_n_u8(color.ch.green);
+    px.val[2] = vdup_n_u8(color.ch.red);
+    px.val[3] = vdup_n_u8(color.ch.alpha);
+    return px;
+#else
+    return vdupq_n_u16(color.full);
+#endif
+}
+
+static inline neon_lane_t neon_set1_lane(uint8_t v)
+{
+#if LV_COLOR_DEPTH == 32
+    return vdup_n_u8(v);
+#else
+    return vdupq_n_u16(v);
+#endif
+}
+
+static inline neon_lane_t neon_widen_mask(uint8x8_t m)
+{
+#if LV_COLOR_DEPTH == 32
+    return m;
+#else
+    return vmovl_u8(m);
+#endif
+}
+
+static inline neon_lane_t neon_cmpeq_lane(neon_lane_t a, neon_lane_t b)
+{
+#if LV_COLOR_DEPTH == 32
+    return vceq_u8(a, b);
+#else
+    return vceqq_u16(a, b);
+#endif
+}
+
+static inline neon_lane_t neon_cmpge_lane(neon_lane_t a, neon_lane_t b)
+{
+#if LV_COLOR_DEPTH == 32
+    return vcge_u8(a, b);
+#else
+    return vcgeq_u16(a, b);
+#endif
+}
+
+static inline neon_lane_t neon_mask_opa(neon_lane_t mask, neon_lane_t opa)
+{
+#if LV_COLOR_DEPTH == 32
+    return vshrn_n_u16(vmull_u8(mask, opa), 8);
+#else
+    return vshrq_n_u16(vmulq_u16(mask, opa), 8);
+#endif
+}
+
+static inline neon_lane_t neon_select_lane(neon_lane_t cond, neon_lane_t a, neon_lane_t b)
+{
+#if LV_COLOR_DEPTH == 32
+    return vbsl_u8(cond, a, b);
+#else
+    return vbslq_u16(cond, a, b);
+#endif
+}
+
+static inline neon_px_t neon_select_px(neon_lane_t cond, neon_px_t a, neon_px_t b)
+{
+#if LV_COLOR_DEPTH == 32
+    neon_px_t res;
+    res.val[0] = vbsl_u8(cond, a.val[0], b.val[0]);
+    res.val[1] = vbsl_u8(cond, a.val[1], b.val[1]);
+    res.val[2] = vbsl_u8(cond, a.val[2], b.val[2]);
+    res.val[3] = vbsl_u8(cond, a.val[3], b.val[3]);
+    return res;
+#else
+    return vbslq_u16(cond, a, b);
+#endif
+}
+
+static inline uint64_t neon_mask_bits(uint8x8_t m)
+{
+    return vget_lane_u64(vreinterpret_u64_u8(m), 0);
+}
+
+static void neon_fill(lv_color_t * dest, lv_color_t color, int32_t len)
+{
+#if LV_COLOR_DEPTH == 32
+    const uint32x4_t c = vdupq_n_u32(color.full);
+    int32_t i;
+    for(i = 0; i + 4 <= len; i += 4) {
+        vst1q_u32((uint32_t *)(dest + i), c);
+    }
+#else
+    const uint16x8_t c = vdupq_n_u16(color.full);
+    int32_t i;
+    for(i = 0; i + 8 <= len; i += 8) {
+        vst1q_u16((uint16_t *)(dest + i), c);
+    }
+#endif
+    if(i < len) lv_color_fill(dest + i, color, len - i);
+}
+
+static void neon_fill_opa(lv_color_t * dest, lv_color_t color, lv_opa_t opa, int32_t len)
+{
+    const neon_px_t c = neon_set1_px(color);
+    const neon_lane_t mix = neon_set1_lane(opa);
+    int32_t i;
+    for(i = 0; i + NEON_PX_CNT <= len; i += NEON_PX_CNT) {
+        neon_store_px(dest + i, neon_mix_premult(c, neon_load_px(dest + i), mix));
+    }
+    fill_opa_px(dest + i, color, opa, len - i);
+}
+
+static void neon_fill_mask(lv_color_t * dest, lv_color_t color, lv_opa_t opa, const lv_opa_t * mask, int32_t len)
+{
+    const neon_px_t c = neon_set1_px(color);
+    const neon_lane_t opa_v = neon_set1_lane(opa);
+    const neon_lane_t transp = neon_set1_lane(LV_OPA_TRANSP);
+    const neon_lane_t cover = neon_set1_lane(LV_OPA_COVER);
+    int32_t i;
+    for(i = 0; i + NEON_PX_CNT <= len; i += NEON_PX_CNT) {
+        uint8x8_t m8 = vld1_u8(mask + i);
+        uint64_t bits = neon_mask_bits(m8);
+        if(bits == 0) continue;
+        if(opa > LV_OPA_MAX && bits == UINT64_MAX) {
+            neon_store_px(dest + i, c);
+            continue;
+        }
+
+        neon_lane_t m = neon_widen_mask(m8);
+        neon_lane_t m_cover = neon_cmpeq_lane(m, cover);
+        neon_px_t d = neon_load_px(dest + i);
+        neon_px_t res;
+        if(opa > LV_OPA_MAX) {
+            res = neon_select_px(m_cover, c, neon_mix(c, d, m));
+        }
+        else {
+            res = neon_mix(c, d, neon_select_lane(m_cover, opa_v, neon_mask_opa(m, opa_v)));
+        }
+        neon_store_px(dest + i, neon_select_px(neon_cmpeq_lane(m, transp), d, res));
+    }
+    fill_mask_px(dest + i, color, opa, mask + i, len - i);
+}
+
+static void neon_map_opa(lv_color_t * dest, const lv_color_t * src, lv_opa_t opa, int32_t len)
+{
+    const neon_lane_t mix = neon_set1_lane(opa);
+    int32_t i;
+    for(i = 0; i + NEON_PX_CNT <= len; i += NEON_PX_CNT) {
+        neon_store_px(dest + i, neon_mix(neon_load_px(src + i), neon_load_px(dest + i), mix));
+    }
+    map_opa_px(dest + i, src + i, opa, len - i);
+}
+
+static void neon_map_mask(lv_color_t * dest, const lv_color_t * src, lv_opa_t opa, const lv_opa_t * mask, int32_t len)
+{
+    const neon_lane_t opa_v = neon_set1_lane(opa);
+    const neon_lane_t transp = neon_set1_lane(LV_OPA_TRANSP);
+    const neon_lane_t cover = neon_set1_lane(LV_OPA_COVER);
+    const neon_lane_t max = neon_set1_lane(LV_OPA_MAX);
+    int32_t i;
+    for(i = 0; i + NEON_PX_CNT <= len; i += NEON_PX_CNT) {
+        uint8x8_t m8 = vld1_u8(mask + i);
+        uint64_t bits = neon_mask_bits(m8);
+        if(bits == 0) continue;
+        if(opa > LV_OPA_MAX && bits == UINT64_MAX) {
+            neon_store_px(dest + i, neon_load_px(src + i));
+            continue;
+        }
+
+        neon_lane_t m = neon_widen_mask(m8);
+        neon_px_t s = neon_load_px(src + i);
+        neon_px_t d = neon_load_px(dest + i);
+        neon_px_t res;
+        if(opa > LV_OPA_MAX) {
+            res = neon_select_px(neon_cmpeq_lane(m, cover), s, neon_mix(s, d, m));
+        }
+        else {
+            neon_lane_t mix = neon_select_lane(neon_cmpge_lane(m, max), opa_v, neon_mask_opa(m, opa_v));
+            res = neon_mix(s, d, mix);
+        }
+        neon_store_px(dest + i, neon_select_px(neon_cmpeq_lane(m, transp), d, res));
+    }
+    map_mask_px(dest + i, src + i, opa, mask + i, len - i);
+}
+
+static const _lv_draw_blend_simd_kernels_t neon_kernels = {
+    .fill = neon_fill,
+    .fill_opa = neon_fill_opa,
+    .fill_mask = neon_fill_mask,
+    .map_opa = neon_map_opa,
+    .map_mask = neon_map_mask,
+};
+
+#endif /*BLEND_SIMD_NEON*/
+
+#endif /*LV_USE_DRAW_SIMD*/
@@ -0,0 +1,101 @@
+/**
+ * @file lv_draw_blend_simd.h
+ *
+ */
+
+#ifndef LV_DRAW_BLEND_SIMD_H
+#define LV_DRAW_BLEND_SIMD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "../misc/lv_color.h"
+
+#include <stdbool.h>
+
+#if LV_USE_DRAW_SIMD
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** The instruction sets the blend kernels can use*/
+enum {
+    LV_DRAW_BLEND_SIMD_NONE = 0,    /**< Plain C, the reference implementation*/
+    LV_DRAW_BLEND_SIMD_SSE2,        /**< x86 SSE2*/
+    LV_DRAW_BLEND_SIMD_AVX2,        /**< x86 AVX2, selected only if the CPU supports it*/
+    LV_DRAW_BLEND_SIMD_NEON,        /**< ARM NEON, selected if the compiler targets it*/
+    _LV_DRAW_BLEND_SIMD_LAST
+};
+
+typedef uint8_t lv_draw_blend_simd_t;
+
+/**
+ * Kernels blending one row of pixels. They give exactly the same result as the plain C code of `lv_draw_blend.c`.
+ * `mask` has one opacity value for every pixel. `opa > LV_OPA_MAX` means only the mask matters.
+ */
+typedef struct {
+    void (*fill)(lv_color_t * dest, lv_color_t color, int32_t len);
+    void (*fill_opa)(lv_color_t * dest, lv_color_t color, lv_opa_t opa, int32_t len);
+    void (*fill_mask)(lv_color_t * dest, lv_color_t color, lv_opa_t opa, const lv_opa_t * mask, int32_t len);
+    void (*map_opa)(lv_color_t * dest, const lv_color_t * src, lv_opa_t opa, int32_t len);
+    void (*map_mask)(lv_color_t * dest, const lv_color_t * src, lv_opa_t opa, const lv_opa_t * mask, int32_t len);
+} _lv_draw_blend_simd_kernels_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Select the fastest instruction set supported by the CPU. Called by `lv_init()`.
+ */
+void _lv_draw_blend_simd_init(void);
+
+/**
+ * Check whether an instruction set can be used on this CPU with the current color format.
+ * @param simd an element of `LV_DRAW_BLEND_SIMD_...`
+ * @return true: `simd` can be used
+ */
+bool lv_draw_blend_simd_is_supported(lv_draw_blend_simd_t simd);
+
+/**
+ * Select the instruction set of the software blending. Should be called when nothing is rendered.
+ * @param simd an element of `LV_DRAW_BLEND_SIMD_...`
+ * @return LV_RES_OK: `simd` is selected; LV_RES_INV: it's not supported so nothing has changed
+ */
+lv_res_t lv_draw_blend_simd_set(lv_draw_blend_simd_t simd);
+
+/**
+ * Get the instruction set used by the software blending.
+ * @return an element of `LV_DRAW_BLEND_SIMD_...`
+ */
+lv_draw_blend_simd_t lv_draw_blend_simd_get(void);
+
+//! @cond Doxygen_Suppress
+/**
+ * Get the kernels of the selected instruction set.
+ * @return pointer to the kernels or NULL if `LV_DRAW_BLEND_SIMD_NONE` is selected
+ */
+const _lv_draw_blend_simd_kernels_t * _lv_draw_blend_simd_get_kernels(void);
+//! @endcond
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DRAW_SIMD*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_BLEND_SIMD_H*/
@@ -83,8 +83,11 @@ void lv_draw_img(const lv_area_t * coords, const lv_area_t * mask, const void *
 
     if(dsc->opa <= LV_OPA_MIN) return;
 
+    /*The image cache and the decoders are shared by the rendering threads*/
     lv_res_t res;
+    _lv_refr_draw_lock();
     res = lv_img_draw_core(coords, mask, src, dsc);
+    _lv_refr_draw_unlock();
 
     if(res == LV_RES_INV) {
         LV_LOG_WARN("Image draw error");
@@ -131,6 +134,10 @@ uint8_t lv_img_cf_get_px_size(lv_img_cf_t cf)
         case LV_IMG_CF_ALPHA_8BIT:
             px_size = 8;
             break;
+        case LV_IMG_CF_YUV_I420:
+        case LV_IMG_CF_YUV_NV12:
+            px_size = 12;   /*On average. 8 bit luma for each pixel and 2 x 8 bit chroma for every 2x2 pixels*/
+            break;
         default:
             px_size = 0;
             break;
@@ -240,10 +247,30 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t lv_img_draw_core(const lv_area_t * coords,
 {
     if(draw_dsc->opa <= LV_OPA_MIN) return LV_RES_OK;
 
-    _lv_img_cache_entry_t * cdsc = _lv_img_cache_open(src, draw_dsc->recolor, draw_dsc->frame_id);
+    /*The area of the transformed image*/
+    lv_area_t map_area_rot;
+    lv_area_copy(&map_area_rot, coords);
+    if(draw_dsc->angle || draw_dsc->zoom != LV_IMG_ZOOM_NONE) {
+        int32_t w = lv_area_get_width(coords);
+        int32_t h = lv_area_get_height(coords);
+
+        _lv_img_buf_get_transformed_area(&map_area_rot, w, h, draw_dsc->angle, draw_dsc->zoom, &draw_dsc->pivot);
+
+        map_area_rot.x1 += coords->x1;
+        map_area_rot.y1 += coords->y1;
+        map_area_rot.x2 += coords->x1;
+        map_area_rot.y2 += coords->y1;
+    }
+
+    _lv_img_cache_entry_t * cdsc = _lv_img_cache_open_async(src, draw_dsc->recolor, draw_dsc->frame_id, &map_area_rot);
 
     if(cdsc == NULL) return LV_RES_INV;
 
+#if LV_IMG_CACHE_ASYNC
+    /*Being decoded in the background. Draw nothing now, the area will be redrawn when the image is ready.*/
+    if(cdsc->job) return LV_RES_OK;
+#endif
+
     bool chroma_keyed = lv_img_cf_is_chroma_keyed(cdsc->dec_dsc.header.cf);
     bool alpha_byte   = lv_img_cf_has_alpha(cdsc->dec_dsc.header.cf);
 
@@ -255,20 +282,6 @@ LV_ATTRIBUTE_FAST_MEM static lv_res_t lv_img_draw_core(const lv_area_t * coords,
     /*The decoder could open the image and gave the entire uncompressed image.
      *Just draw it!*/
     else if(cdsc->dec_dsc.img_data) {
-        lv_area_t map_area_rot;
-        lv_area_copy(&map_area_rot, coords);
-        if(draw_dsc->angle || draw_dsc->zoom != LV_IMG_ZOOM_NONE) {
-            int32_t w = lv_area_get_width(coords);
-            int32_t h = lv_area_get_height(coords);
-
-            _lv_img_buf_get_transformed_area(&map_area_rot, w, h, draw_dsc->angle, draw_dsc->zoom, &draw_dsc->pivot);
-
-            map_area_rot.x1 += coords->x1;
-            map_area_rot.y1 += coords->y1;
-            map_area_rot.x2 += coords->x1;
-            map_area_rot.y2 += coords->y1;
-        }
-
         lv_area_t mask_com; /*Common area of mask and coords*/
         bool union_ok;
         union_ok = _lv_area_intersect(&mask_com, clip_area, &map_area_rot);
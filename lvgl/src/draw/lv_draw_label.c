@@ -12,6 +12,8 @@
 #include "../core/lv_refr.h"
 #include "../misc/lv_bidi.h"
 #include "../misc/lv_assert.h"
+#include "../misc/lv_thread.h"
+#include <string.h>
 
 #if LV_USE_GPU_SDL
     #include "../gpu/lv_gpu_sdl.h"
@@ -48,6 +50,9 @@ static void draw_letter_subpx(lv_coord_t pos_x, lv_coord_t pos_y, lv_font_glyph_
 #endif /*LV_USE_EXTERNAL_RENDERER*/
 
 static uint8_t hex_char_to_num(char hex);
+static lv_res_t layout_calc(lv_draw_label_layout_t * layout, const char * txt, uint32_t line_id);
+static lv_coord_t get_line_width(const lv_draw_label_layout_t * layout, uint32_t line_id, const char * txt,
+                                 uint32_t len, const lv_draw_label_dsc_t * dsc);
 
 /**********************
  *  STATIC VARIABLES
@@ -141,10 +146,21 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
 
     lv_bidi_calculate_align(&align, &base_dir, txt);
 
+    /*Use the layout only if it was calculated for this text with the same parameters*/
+    const lv_draw_label_layout_t * layout = dsc->layout;
+    if(layout && !_lv_draw_label_layout_is_valid(layout, txt, font, dsc->letter_space, lv_area_get_width(coords),
+                                                  dsc->flag)) {
+        layout = NULL;
+    }
+
     if((dsc->flag & LV_TEXT_FLAG_EXPAND) == 0) {
         /*Normally use the label's width as width*/
         w = lv_area_get_width(coords);
     }
+    else if(layout) {
+        /*The lines are already known, no need to measure the text*/
+        w = LV_COORD_MAX;
+    }
     else {
         /*If EXAPND is enabled then not limit the text's width to the object's width*/
         lv_point_t p;
@@ -169,52 +185,68 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
     pos.y += y_ofs;
 
     uint32_t line_start     = 0;
+    uint32_t line_end;
+    uint32_t line_id        = 0;
     int32_t last_line_start = -1;
 
-    /*Check the hint to use the cached info*/
-    if(hint && y_ofs == 0 && coords->y1 < 0) {
-        /*If the label changed too much recalculate the hint.*/
-        if(LV_ABS(hint->coord_y - coords->y1) > LV_LABEL_HINT_UPDATE_TH - 2 * line_height) {
-            hint->line_start = -1;
+    if(layout) {
+        /*All lines have the same height so the first visible line can be calculated directly*/
+        if(line_height > 0 && pos.y + line_height_font < mask->y1) {
+            line_id = (mask->y1 - pos.y - line_height_font + line_height - 1) / line_height;
         }
-        last_line_start = hint->line_start;
-    }
 
-    /*Use the hint if it's valid*/
-    if(hint && last_line_start >= 0) {
-        line_start = last_line_start;
-        pos.y += hint->y;
+        if(line_id >= layout->line_cnt) return;
+
+        line_start = layout->line_starts[line_id];
+        line_end = layout->line_starts[line_id + 1];
+        pos.y += line_id * line_height;
     }
+    else {
+        /*Check the hint to use the cached info*/
+        if(hint && y_ofs == 0 && coords->y1 < 0) {
+            /*If the label changed too much recalculate the hint.*/
+            if(LV_ABS(hint->coord_y - coords->y1) > LV_LABEL_HINT_UPDATE_TH - 2 * line_height) {
+                hint->line_start = -1;
+            }
+            last_line_start = hint->line_start;
+        }
 
-    uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+        /*Use the hint if it's valid*/
+        if(hint && last_line_start >= 0) {
+            line_start = last_line_start;
+            pos.y += hint->y;
+        }
 
-    /*Go the first visible line*/
-    while(pos.y + line_height_font < mask->y1) {
-        /*Go to next line*/
-        line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
-        pos.y += line_height;
+        line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
 
-        /*Save at the threshold coordinate*/
-        if(hint && pos.y >= -LV_LABEL_HINT_UPDATE_TH && hint->line_start < 0) {
-            hint->line_start = line_start;
-            hint->y          = pos.y - coords->y1;
-            hint->coord_y    = coords->y1;
-        }
+        /*Go the first visible line*/
+        while(pos.y + line_height_font < mask->y1) {
+            /*Go to next line*/
+            line_start = line_end;
+            line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+            pos.y += line_height;
 
-        if(txt[line_start] == '\0') return;
+            /*Save at the threshold coordinate*/
+            if(hint && pos.y >= -LV_LABEL_HINT_UPDATE_TH && hint->line_start < 0) {
+                hint->line_start = line_start;
+                hint->y          = pos.y - coords->y1;
+                hint->coord_y    = coords->y1;
+            }
+
+            if(txt[line_start] == '\0') return;
+        }
     }
 
     /*Align to middle*/
     if(align == LV_TEXT_ALIGN_CENTER) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        line_width = get_line_width(layout, line_id, &txt[line_start], line_end - line_start, dsc);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(align == LV_TEXT_ALIGN_RIGHT) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        line_width = get_line_width(layout, line_id, &txt[line_start], line_end - line_start, dsc);
         pos.x += lv_area_get_width(coords) - line_width;
     }
 
@@ -368,21 +400,25 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
 #endif
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+        line_id++;
+        if(layout) {
+            if(line_id < layout->line_cnt) line_end = layout->line_starts[line_id + 1];
+        }
+        else {
+            line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, dsc->flag);
+        }
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(align == LV_TEXT_ALIGN_CENTER) {
-            line_width =
-                lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            line_width = get_line_width(layout, line_id, &txt[line_start], line_end - line_start, dsc);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
         }
         /*Align to the right*/
         else if(align == LV_TEXT_ALIGN_RIGHT) {
-            line_width =
-                lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            line_width = get_line_width(layout, line_id, &txt[line_start], line_end - line_start, dsc);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -395,6 +431,149 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
     LV_ASSERT_MEM_INTEGRITY();
 }
 
+/**
+ * Calculate the line breaks of a text
+ * @param layout pointer to a layout. Should be zeroed before the first use.
+ * @param txt `\0` terminated text
+ * @param font pointer to a font
+ * @param letter_space letter space
+ * @param max_w max width of the lines
+ * @param flag settings for the text from `lv_text_flag_t`
+ * @return LV_RES_OK: the layout is ready; LV_RES_INV: out of memory, the layout is invalid
+ */
+lv_res_t _lv_draw_label_layout_update(lv_draw_label_layout_t * layout, const char * txt, const lv_font_t * font,
+                                      lv_coord_t letter_space, lv_coord_t max_w, lv_text_flag_t flag)
+{
+    layout->txt = NULL;
+    layout->line_cnt = 0;
+    if(txt == NULL || font == NULL) return LV_RES_INV;
+
+    /*The same as in `lv_txt_get_size()`*/
+    if(flag & LV_TEXT_FLAG_EXPAND) max_w = LV_COORD_MAX;
+
+    layout->font = font;
+    layout->letter_space = letter_space;
+    layout->max_w = max_w;
+    layout->flag = flag;
+
+    return layout_calc(layout, txt, 0);
+}
+
+/**
+ * Update a layout after some text was appended to its text.
+ * Only the last lines are measured again, the others are kept.
+ * @param layout pointer to a valid layout
+ * @param txt the text with the appended characters. Might be reallocated since the layout was calculated.
+ * @param changed_line store the index of the first line which was measured again here. Can be NULL.
+ * @return LV_RES_OK: the layout is ready; LV_RES_INV: out of memory, the layout is invalid
+ */
+lv_res_t _lv_draw_label_layout_append(lv_draw_label_layout_t * layout, const char * txt, uint32_t * changed_line)
+{
+    /*The appended text can continue the last word, so the last line can break differently.
+     *In case of long words it can also change the end of the line before.*/
+    uint32_t line_id = layout->line_cnt > 2 ? layout->line_cnt - 2 : 0;
+    if(changed_line) *changed_line = line_id;
+
+    return layout_calc(layout, txt, line_id);
+}
+
+/**
+ * Remove the first lines from a layout after they were removed from the beginning of its text.
+ * @param layout pointer to a valid layout
+ * @param line_cnt number of lines to remove
+ */
+void _lv_draw_label_layout_remove_lines(lv_draw_label_layout_t * layout, uint32_t line_cnt)
+{
+    if(line_cnt == 0) return;
+    if(line_cnt > layout->line_cnt) line_cnt = layout->line_cnt;
+
+    uint32_t byte_cnt = layout->line_starts[line_cnt];
+    bool max_removed = false;
+    uint32_t i;
+    for(i = 0; i < line_cnt; i++) {
+        if(layout->line_widths[i] == layout->max_line_w) max_removed = true;
+    }
+
+    layout->line_cnt -= line_cnt;
+    for(i = 0; i <= layout->line_cnt; i++) {
+        layout->line_starts[i] = layout->line_starts[i + line_cnt] - byte_cnt;
+    }
+    memmove(layout->line_widths, &layout->line_widths[line_cnt], layout->line_cnt * sizeof(lv_coord_t));
+
+    if(max_removed) {
+        layout->max_line_w = 0;
+        for(i = 0; i < layout->line_cnt; i++) layout->max_line_w = LV_MAX(layout->max_line_w, layout->line_widths[i]);
+    }
+}
+
+/**
+ * Check if a layout was calculated with the given parameters
+ * @param layout pointer to a layout
+ * @param txt the text
+ * @param font pointer to a font
+ * @param letter_space letter space
+ * @param max_w max width of the lines
+ * @param flag settings for the text from `lv_text_flag_t`
+ * @return true: the layout can be used
+ */
+bool _lv_draw_label_layout_is_valid(const lv_draw_label_layout_t * layout, const char * txt, const lv_font_t * font,
+                                    lv_coord_t letter_space, lv_coord_t max_w, lv_text_flag_t flag)
+{
+    if(flag & LV_TEXT_FLAG_EXPAND) max_w = LV_COORD_MAX;
+
+    return layout->txt != NULL && layout->txt == txt && layout->font == font &&
+           layout->letter_space == letter_space && layout->max_w == max_w && layout->flag == flag;
+}
+
+/**
+ * Mark a layout as invalid. Needs to be called if the text was modified.
+ * @param layout pointer to a layout
+ */
+void _lv_draw_label_layout_invalidate(lv_draw_label_layout_t * layout)
+{
+    layout->txt = NULL;
+}
+
+/**
+ * Free the memory used by a layout
+ * @param layout pointer to a layout
+ */
+void _lv_draw_label_layout_free(lv_draw_label_layout_t * layout)
+{
+    lv_mem_free(layout->line_starts);
+    lv_mem_free(layout->line_widths);
+    lv_memset_00(layout, sizeof(lv_draw_label_layout_t));
+}
+
+/**
+ * Get the size of the text from its layout. The same as `lv_txt_get_size()`.
+ * @param layout pointer to a valid layout
+ * @param line_space line space
+ * @param size_res store the result here
+ */
+void _lv_draw_label_layout_get_size(const lv_draw_label_layout_t * layout, lv_coord_t line_space,
+                                    lv_point_t * size_res)
+{
+    int32_t letter_height = lv_font_get_line_height(layout->font);
+    int32_t line_cnt = layout->line_cnt;
+
+    /*Make the text one line taller if the last character is '\n' or '\r'*/
+    uint32_t txt_len = layout->line_starts[layout->line_cnt];
+    if(txt_len != 0 && (layout->txt[txt_len - 1] == '\n' || layout->txt[txt_len - 1] == '\r')) line_cnt++;
+
+    int32_t h;
+    if(line_cnt == 0) h = letter_height;
+    else h = line_cnt * (letter_height + line_space) - line_space;
+
+    if(h > (int32_t)LV_MAX_OF(lv_coord_t)) {
+        LV_LOG_WARN("_lv_draw_label_layout_get_size: integer overflow while calculating text height");
+        h = (int32_t)LV_MAX_OF(lv_coord_t);
+    }
+
+    size_res->x = layout->max_line_w;
+    size_res->y = h;
+}
+
 #if LV_USE_EXTERNAL_RENDERER == 0
 /**********************
  *   STATIC FUNCTIONS
@@ -504,9 +683,9 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_coord_t pos_x, lv_coord_
             return; /*Invalid bpp. Can't render the letter*/
     }
 
-    static lv_opa_t opa_table[256];
-    static lv_opa_t prev_opa = LV_OPA_TRANSP;
-    static uint32_t prev_bpp = 0;
+    static LV_DRAW_THREAD_LOCAL lv_opa_t opa_table[256];
+    static LV_DRAW_THREAD_LOCAL lv_opa_t prev_opa = LV_OPA_TRANSP;
+    static LV_DRAW_THREAD_LOCAL uint32_t prev_bpp = 0;
     if(opa < LV_OPA_MAX) {
         if(prev_opa != opa || prev_bpp != bpp) {
             uint32_t i;
@@ -876,3 +1055,79 @@ static uint8_t hex_char_to_num(char hex)
     return result;
 }
 
+
+/**
+ * Get the width of a line from the layout or measure it if there is no layout
+ */
+static lv_coord_t get_line_width(const lv_draw_label_layout_t * layout, uint32_t line_id, const char * txt,
+                                 uint32_t len, const lv_draw_label_dsc_t * dsc)
+{
+    if(layout) return line_id < layout->line_cnt ? layout->line_widths[line_id] : 0;
+
+    return lv_txt_get_width(txt, len, dsc->font, dsc->letter_space, dsc->flag);
+}
+
+/**
+ * Measure the lines of a layout's text from a given line. The lines before it are kept.
+ * @param layout pointer to a layout with the parameters set
+ * @param txt the text
+ * @param line_id index of the first line to measure. Should be <= `layout->line_cnt`
+ * @return LV_RES_OK: the layout is ready; LV_RES_INV: out of memory, the layout is invalid
+ */
+static lv_res_t layout_calc(lv_draw_label_layout_t * layout, const char * txt, uint32_t line_id)
+{
+    uint32_t line_start = line_id > 0 ? layout->line_starts[line_id] : 0;
+
+    /*The longest line needs to be searched again if it's measured again*/
+    bool max_removed = line_id == 0;
+    uint32_t i;
+    for(i = line_id; i < layout->line_cnt && !max_removed; i++) {
+        if(layout->line_widths[i] == layout->max_line_w) max_removed = true;
+    }
+
+    if(max_removed) {
+        layout->max_line_w = 0;
+        for(i = 0; i < line_id; i++) layout->max_line_w = LV_MAX(layout->max_line_w, layout->line_widths[i]);
+    }
+
+    layout->txt = NULL;
+    layout->line_cnt = line_id;
+
+    while(1) {
+        /*Keep space for the closing line start too*/
+        if(layout->line_cnt + 1 >= layout->line_cap) {
+            uint32_t new_cap = layout->line_cap ? layout->line_cap * 2 : 4;
+            uint32_t * new_starts = lv_mem_realloc(layout->line_starts, new_cap * sizeof(uint32_t));
+            LV_ASSERT_MALLOC(new_starts);
+            if(new_starts == NULL) {
+                _lv_draw_label_layout_free(layout);
+                return LV_RES_INV;
+            }
+            layout->line_starts = new_starts;
+
+            lv_coord_t * new_widths = lv_mem_realloc(layout->line_widths, new_cap * sizeof(lv_coord_t));
+            LV_ASSERT_MALLOC(new_widths);
+            if(new_widths == NULL) {
+                _lv_draw_label_layout_free(layout);
+                return LV_RES_INV;
+            }
+            layout->line_widths = new_widths;
+            layout->line_cap = new_cap;
+        }
+
+        layout->line_starts[layout->line_cnt] = line_start;
+        if(txt[line_start] == '\0') break;
+
+        uint32_t line_len = _lv_txt_get_next_line(&txt[line_start], layout->font, layout->letter_space, layout->max_w,
+                                                  layout->flag);
+        lv_coord_t line_w = lv_txt_get_width(&txt[line_start], line_len, layout->font, layout->letter_space, layout->flag);
+        layout->line_widths[layout->line_cnt] = line_w;
+        layout->max_line_w = LV_MAX(layout->max_line_w, line_w);
+        layout->line_cnt++;
+        line_start += line_len;
+    }
+
+    layout->txt = txt;
+
+    return LV_RES_OK;
+}
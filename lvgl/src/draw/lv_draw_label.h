@@ -38,6 +38,7 @@ typedef struct {
     lv_coord_t letter_space;
     lv_coord_t ofs_x;
     lv_coord_t ofs_y;
+    const struct _lv_draw_label_layout_t * layout; /**< Line breaks of the text calculated in advance. Can be NULL*/
     lv_opa_t opa;
     lv_base_dir_t bidi_dir;
     lv_text_align_t align;
@@ -63,6 +64,36 @@ typedef struct _lv_draw_label_hint_t {
     int32_t coord_y;
 } lv_draw_label_hint_t;
 
+/** The line breaks of a text calculated in advance.
+ * With it the first visible line can be found without measuring all the previous lines
+ * and the lines don't need to be measured again while drawing.
+ * The `y` coordinate of a line is `line_index * (line_height + line_space)`.*/
+typedef struct _lv_draw_label_layout_t {
+    /** The text the layout was calculated for. NULL if the layout is invalid.*/
+    const char * txt;
+
+    /** Byte index of the first character of the lines. It has `line_cnt + 1` elements, the last is the text's length.*/
+    uint32_t * line_starts;
+
+    /** Width of the lines*/
+    lv_coord_t * line_widths;
+
+    /** Number of lines*/
+    uint32_t line_cnt;
+
+    /** Number of lines the arrays have space for*/
+    uint32_t line_cap;
+
+    /** Width of the longest line*/
+    lv_coord_t max_line_w;
+
+    /*The parameters the layout was calculated with*/
+    const lv_font_t * font;
+    lv_coord_t letter_space;
+    lv_coord_t max_w;
+    lv_text_flag_t flag;
+} lv_draw_label_layout_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -84,6 +115,70 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(const lv_area_t * coords, const lv_area
                                          const lv_draw_label_dsc_t * dsc,
                                          const char * txt, lv_draw_label_hint_t * hint);
 
+/**
+ * Calculate the line breaks of a text
+ * @param layout pointer to a layout. Should be zeroed before the first use.
+ * @param txt `\0` terminated text
+ * @param font pointer to a font
+ * @param letter_space letter space
+ * @param max_w max width of the lines
+ * @param flag settings for the text from `lv_text_flag_t`
+ * @return LV_RES_OK: the layout is ready; LV_RES_INV: out of memory, the layout is invalid
+ */
+lv_res_t _lv_draw_label_layout_update(lv_draw_label_layout_t * layout, const char * txt, const lv_font_t * font,
+                                      lv_coord_t letter_space, lv_coord_t max_w, lv_text_flag_t flag);
+
+/**
+ * Update a layout after some text was appended to its text.
+ * Only the last lines are measured again, the others are kept.
+ * @param layout pointer to a valid layout
+ * @param txt the text with the appended characters. Might be reallocated since the layout was calculated.
+ * @param changed_line store the index of the first line which was measured again here. Can be NULL.
+ * @return LV_RES_OK: the layout is ready; LV_RES_INV: out of memory, the layout is invalid
+ */
+lv_res_t _lv_draw_label_layout_append(lv_draw_label_layout_t * layout, const char * txt, uint32_t * changed_line);
+
+/**
+ * Remove the first lines from a layout after they were removed from the beginning of its text.
+ * @param layout pointer to a valid layout
+ * @param line_cnt number of lines to remove
+ */
+void _lv_draw_label_layout_remove_lines(lv_draw_label_layout_t * layout, uint32_t line_cnt);
+
+/**
+ * Check if a layout was calculated with the given parameters
+ * @param layout pointer to a layout
+ * @param txt the text
+ * @param font pointer to a font
+ * @param letter_space letter space
+ * @param max_w max width of the lines
+ * @param flag settings for the text from `lv_text_flag_t`
+ * @return true: the layout can be used
+ */
+bool _lv_draw_label_layout_is_valid(const lv_draw_label_layout_t * layout, const char * txt, const lv_font_t * font,
+                                    lv_coord_t letter_space, lv_coord_t max_w, lv_text_flag_t flag);
+
+/**
+ * Mark a layout as invalid. Needs to be called if the text was modified.
+ * @param layout pointer to a layout
+ */
+void _lv_draw_label_layout_invalidate(lv_draw_label_layout_t * layout);
+
+/**
+ * Free the memory used by a layout
+ * @param layout pointer to a layout
+ */
+void _lv_draw_label_layout_free(lv_draw_label_layout_t * layout);
+
+/**
+ * Get the size of the text from its layout. The same as `lv_txt_get_size()`.
+ * @param layout pointer to a valid layout
+ * @param line_space line space
+ * @param size_res store the result here
+ */
+void _lv_draw_label_layout_get_size(const lv_draw_label_layout_t * layout, lv_coord_t line_space,
+                                    lv_point_t * size_res);
+
 LV_ATTRIBUTE_FAST_MEM void lv_draw_letter(const lv_point_t * pos_p, const lv_area_t * clip_area,
                                           const lv_font_t * font_p,
                                           uint32_t letter, lv_color_t color, lv_opa_t opa, lv_blend_mode_t blend_mode);
@@ -12,12 +12,12 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_assert.h"
 #include "../misc/lv_gc.h"
+#include "../core/lv_refr.h"
 
 /*********************
  *      DEFINES
  *********************/
-#define CIRCLE_CACHE_LIFE_MAX   1000
-#define CIRCLE_CACHE_AGING(life, r)   life = LV_MIN(life + (r < 16 ? 1 : (r >> 4)), 1000)
+#define CIRCLE_CACHE_MEM_SIZE(r)    ((r) * 6 + 6)
 
 /**********************
  *      TYPEDEFS
@@ -55,11 +55,15 @@ static void circ_next(lv_point_t * c, lv_coord_t * tmp);
 static void circ_calc_aa4(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_t radius);
 static lv_opa_t * get_next_line(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_t y, lv_coord_t * len,
                                 lv_coord_t * x_start);
+static bool circle_is_cached(const _lv_draw_mask_radius_circle_dsc_t * c);
+static _lv_draw_mask_radius_circle_dsc_t * circle_cache_find(lv_coord_t radius);
 LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t mask_mix(lv_opa_t mask_act, lv_opa_t mask_new);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+static uint32_t circle_cache_life;
+static lv_draw_mask_circle_cache_stats_t circle_cache_stats;
 
 /**********************
  *      MACROS
@@ -210,12 +214,15 @@ void lv_draw_mask_free_param(void * p)
     if(pdsc->type == LV_DRAW_MASK_TYPE_RADIUS) {
         lv_draw_mask_radius_param_t * radius_p = (lv_draw_mask_radius_param_t *) p;
         if(radius_p->circle) {
-            if(radius_p->circle->life < 0) {
+            if(!circle_is_cached(radius_p->circle)) {
                 lv_mem_free(radius_p->circle->cir_opa);
                 lv_mem_free(radius_p->circle);
             }
             else {
+                /*The cache is shared by the rendering threads*/
+                _lv_refr_draw_lock();
                 radius_p->circle->used_cnt--;
+                _lv_refr_draw_unlock();
             }
         }
     }
@@ -223,13 +230,26 @@ void lv_draw_mask_free_param(void * p)
 
 void _lv_draw_mask_cleanup(void)
 {
+    _lv_refr_draw_lock();
     uint8_t i;
     for(i = 0; i < LV_CIRCLE_CACHE_SIZE; i++) {
-        if(LV_GC_ROOT(_lv_circle_cache[i]).buf) {
-            lv_mem_free(LV_GC_ROOT(_lv_circle_cache[i]).buf);
+        _lv_draw_mask_radius_circle_dsc_t * c = &LV_GC_ROOT(_lv_circle_cache[i]);
+        if(c->used_cnt) continue;
+        if(c->buf) {
+            lv_mem_free(c->buf);
+            circle_cache_stats.mem_size -= CIRCLE_CACHE_MEM_SIZE(c->radius);
+            circle_cache_stats.circle_cnt--;
         }
-        lv_memset_00(&LV_GC_ROOT(_lv_circle_cache[i]), sizeof(LV_GC_ROOT(_lv_circle_cache[i])));
+        lv_memset_00(c, sizeof(_lv_draw_mask_radius_circle_dsc_t));
     }
+    _lv_refr_draw_unlock();
+}
+
+void lv_draw_mask_circle_cache_get_stats(lv_draw_mask_circle_cache_stats_t * stats)
+{
+    _lv_refr_draw_lock();
+    *stats = circle_cache_stats;
+    _lv_refr_draw_unlock();
 }
 
 /**
@@ -486,20 +506,40 @@ void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area
         return;
     }
 
-    uint32_t i;
+    /*The cache is shared by the rendering threads and kept between the refreshes*/
+    _lv_refr_draw_lock();
+    circle_cache_life++;
 
     /*Try to reuse a circle cache entry*/
-    for(i = 0; i < LV_CIRCLE_CACHE_SIZE; i++) {
-        if(LV_GC_ROOT(_lv_circle_cache[i]).radius == radius) {
-            LV_GC_ROOT(_lv_circle_cache[i]).used_cnt++;
-            CIRCLE_CACHE_AGING(LV_GC_ROOT(_lv_circle_cache[i]).life, radius);
-            param->circle = &LV_GC_ROOT(_lv_circle_cache[i]);
-            return;
-        }
+    _lv_draw_mask_radius_circle_dsc_t * entry = circle_cache_find(radius);
+    if(entry) {
+        circle_cache_stats.hit_cnt++;
+        param->circle = entry;
+        _lv_refr_draw_unlock();
+        return;
     }
 
-    /*If not found find a free entry with lowest life*/
-    _lv_draw_mask_radius_circle_dsc_t * entry = NULL;
+    circle_cache_stats.miss_cnt++;
+    _lv_refr_draw_unlock();
+
+    /*Calculate the circle without blocking the other rendering threads*/
+    _lv_draw_mask_radius_circle_dsc_t circle;
+    lv_memset_00(&circle, sizeof(circle));
+    circ_calc_aa4(&circle, radius);
+
+    _lv_refr_draw_lock();
+
+    /*An other thread might have added the same circle in the meantime*/
+    entry = circle_cache_find(radius);
+    if(entry) {
+        _lv_refr_draw_unlock();
+        lv_mem_free(circle.buf);
+        param->circle = entry;
+        return;
+    }
+
+    /*If not found find the least recently used free entry*/
+    uint32_t i;
     for(i = 0; i < LV_CIRCLE_CACHE_SIZE; i++) {
         if(LV_GC_ROOT(_lv_circle_cache[i]).used_cnt == 0) {
             if(!entry) entry = &LV_GC_ROOT(_lv_circle_cache[i]);
@@ -508,20 +548,35 @@ void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area
     }
 
     if(!entry) {
+        /*All entries are in use so keep the circle only for this mask*/
+        circle_cache_stats.uncached_cnt++;
+        _lv_refr_draw_unlock();
+
         entry = lv_mem_alloc(sizeof(_lv_draw_mask_radius_circle_dsc_t));
         LV_ASSERT_MALLOC(entry);
-        lv_memset_00(entry, sizeof(_lv_draw_mask_radius_circle_dsc_t));
-        entry->life = -1;
+        *entry = circle;
+        entry->used_cnt = 1;
+        param->circle = entry;
+        return;
+    }
+
+    uint8_t * old_buf = entry->buf;
+    if(old_buf) {
+        circle_cache_stats.evict_cnt++;
+        circle_cache_stats.mem_size -= CIRCLE_CACHE_MEM_SIZE(entry->radius);
     }
     else {
-        entry->used_cnt++;
-        entry->life = 0;
-        CIRCLE_CACHE_AGING(entry->life, radius);
+        circle_cache_stats.circle_cnt++;
     }
+    circle_cache_stats.mem_size += CIRCLE_CACHE_MEM_SIZE(radius);
 
+    *entry = circle;
+    entry->used_cnt = 1;
+    entry->life = circle_cache_life;
     param->circle = entry;
+    _lv_refr_draw_unlock();
 
-    circ_calc_aa4(param->circle, radius);
+    if(old_buf) lv_mem_free(old_buf);
 }
 
 /**
@@ -1267,7 +1322,7 @@ static void circ_calc_aa4(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_t radi
     /*Allocate buffers*/
     if(c->buf) lv_mem_free(c->buf);
 
-    c->buf = lv_mem_alloc(radius * 6 + 6);  /*Use uint16_t for opa_start_on_y and x_start_on_y*/
+    c->buf = lv_mem_alloc(CIRCLE_CACHE_MEM_SIZE(radius));  /*Use uint16_t for opa_start_on_y and x_start_on_y*/
     LV_ASSERT_MALLOC(c->buf);
     c->cir_opa = c->buf;
     c->opa_start_on_y = (uint16_t *)(c->buf + 2 * radius + 2);
@@ -1415,6 +1470,27 @@ static lv_opa_t * get_next_line(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_
     return &c->cir_opa[c->opa_start_on_y[y]];
 }
 
+static bool circle_is_cached(const _lv_draw_mask_radius_circle_dsc_t * c)
+{
+    return c >= &LV_GC_ROOT(_lv_circle_cache[0]) && c < &LV_GC_ROOT(_lv_circle_cache[LV_CIRCLE_CACHE_SIZE]);
+}
+
+/*Find the cached circle of a radius and mark it as used. Call it with the draw lock taken.*/
+static _lv_draw_mask_radius_circle_dsc_t * circle_cache_find(lv_coord_t radius)
+{
+    uint32_t i;
+    for(i = 0; i < LV_CIRCLE_CACHE_SIZE; i++) {
+        _lv_draw_mask_radius_circle_dsc_t * c = &LV_GC_ROOT(_lv_circle_cache[i]);
+        if(c->radius == radius) {
+            c->used_cnt++;
+            c->life = circle_cache_life;
+            return c;
+        }
+    }
+
+    return NULL;
+}
+
 
 LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t mask_mix(lv_opa_t mask_act, lv_opa_t mask_new)
 {
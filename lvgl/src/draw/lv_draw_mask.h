@@ -160,11 +160,23 @@ typedef struct  {
     lv_opa_t * cir_opa;         /*Opacity of values on the circumference of an 1/4 circle*/
     uint16_t * x_start_on_y;        /*The x coordinate of the circle for each y value*/
     uint16_t * opa_start_on_y;      /*The index of `cir_opa` for each y value*/
-    int32_t life;               /*How many times the entry way used*/
+    uint32_t life;              /*The value of a counter when the entry was last used to find the least recently used*/
     uint32_t used_cnt;          /*Like a semaphore to count the referencing masks*/
     lv_coord_t radius;          /*The radius of the entry*/
 } _lv_draw_mask_radius_circle_dsc_t;
 
+/**
+ * Statistics about the usage of the circle cache of the radius masks
+ */
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of radius masks which found their circle in the cache*/
+    uint32_t miss_cnt;      /**< Number of radius masks which calculated their circle*/
+    uint32_t evict_cnt;     /**< Number of cached circles replaced by an other radius*/
+    uint32_t uncached_cnt;  /**< Number of circles not cached because all entries were in use*/
+    uint32_t mem_size;      /**< Memory used by the cached circles [bytes]*/
+    uint32_t circle_cnt;    /**< Number of cached circles*/
+} lv_draw_mask_circle_cache_stats_t;
+
 typedef _lv_draw_mask_radius_circle_dsc_t _lv_draw_mask_radius_circle_dsc_arr_t[LV_CIRCLE_CACHE_SIZE];
 
 typedef struct {
@@ -280,11 +292,17 @@ void * lv_draw_mask_remove_custom(void * custom_id);
 void lv_draw_mask_free_param(void * p);
 
 /**
- * Called by LVGL the rendering of a screen is ready to clean up
- * the temporal (cache) data of the masks
+ * Free the circles cached for the radius masks which are not in use.
+ * The cached circles are kept between the refreshes so it needs to be called only to free memory.
  */
 void _lv_draw_mask_cleanup(void);
 
+/**
+ * Get the statistics of the circle cache of the radius masks
+ * @param stats pointer to a variable to store the statistics
+ */
+void lv_draw_mask_circle_cache_get_stats(lv_draw_mask_circle_cache_stats_t * stats);
+
 //! @cond Doxygen_Suppress
 
 /**
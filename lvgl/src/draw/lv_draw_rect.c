@@ -13,12 +13,14 @@
 #include "../misc/lv_txt_ap.h"
 #include "../core/lv_refr.h"
 #include "../misc/lv_assert.h"
+#include "../misc/lv_thread.h"
+#include "../misc/lv_gc.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define SHADOW_UPSCALE_SHIFT   6
-#define SHADOW_ENHANCE          1
+#define SHADOW_ENHANCE          (LV_SHADOW_BLUR_FAST == 0)
 #define SPLIT_LIMIT             50
 
 /**********************
@@ -44,6 +46,11 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(const lv_area_t * coords, const lv
 LV_ATTRIBUTE_FAST_MEM static void shadow_draw_corner_buf(const lv_area_t * coords,  uint16_t * sh_buf, lv_coord_t s,
                                                          lv_coord_t r);
 LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t sw, uint16_t * sh_ups_buf);
+#if LV_SHADOW_CACHE_SIZE
+static bool shadow_cache_get(lv_opa_t * sh_buf, lv_coord_t sw, lv_coord_t r, lv_coord_t w, lv_coord_t h);
+static void shadow_cache_add(const lv_opa_t * sh_buf, lv_coord_t sw, lv_coord_t r, lv_coord_t w, lv_coord_t h);
+static void shadow_cache_drop(_lv_draw_shadow_cache_entry_t * entry);
+#endif
 #endif
 
 void draw_border_generic(const lv_area_t * clip_area, const lv_area_t * outer_area, const lv_area_t * inner_area,
@@ -60,11 +67,6 @@ static void draw_border_simple(const lv_area_t * clip, const lv_area_t * outer_a
 /**********************
  *  STATIC VARIABLES
  **********************/
-#if defined(LV_SHADOW_CACHE_SIZE) && LV_SHADOW_CACHE_SIZE > 0
-    static uint8_t sh_cache[LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE];
-    static int32_t sh_cache_size = -1;
-    static int32_t sh_cache_r = -1;
-#endif
 
 /**********************
  *      MACROS
@@ -115,6 +117,27 @@ void lv_draw_rect(const lv_area_t * coords, const lv_area_t * clip, const lv_dra
     LV_ASSERT_MEM_INTEGRITY();
 }
 
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE
+
+void lv_draw_rect_shadow_cache_clean(void)
+{
+    _lv_refr_draw_lock();
+    uint32_t i;
+    for(i = 0; i < _LV_SHADOW_CACHE_ENTRY_CNT; i++) {
+        shadow_cache_drop(&LV_GC_ROOT(_lv_shadow_cache).entries[i]);
+    }
+    _lv_refr_draw_unlock();
+}
+
+void lv_draw_rect_shadow_cache_get_stats(lv_draw_rect_shadow_cache_stats_t * stats)
+{
+    _lv_refr_draw_lock();
+    *stats = LV_GC_ROOT(_lv_shadow_cache).stats;
+    _lv_refr_draw_unlock();
+}
+
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -479,22 +502,16 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(const lv_area_t * coords, const lv
     lv_opa_t * sh_buf;
 
 #if LV_SHADOW_CACHE_SIZE
-    if(sh_cache_size == corner_size && sh_cache_r == r_sh) {
-        /*Use the cache if available*/
-        sh_buf = lv_mem_buf_get(corner_size * corner_size);
-        lv_memcpy(sh_buf, sh_cache, corner_size * corner_size);
-    }
-    else {
-        /*A larger buffer is required for calculation*/
-        sh_buf = lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
-        shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
+    /*The corner depends on the size of the blurred rectangle only if it's small.
+     *Wider rectangles have the same corner so they can use the same cached corner.*/
+    lv_coord_t core_w = LV_MIN(lv_area_get_width(&core_area), corner_size * 2);
+    lv_coord_t core_h = LV_MIN(lv_area_get_height(&core_area), corner_size * 2);
 
-        /*Cache the corner if it fits into the cache size*/
-        if((uint32_t)corner_size * corner_size < sizeof(sh_cache)) {
-            lv_memcpy(sh_cache, sh_buf, corner_size * corner_size);
-            sh_cache_size = corner_size;
-            sh_cache_r = r_sh;
-        }
+    /*A larger buffer is required for calculation*/
+    sh_buf = lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
+    if(!shadow_cache_get(sh_buf, dsc->shadow_width, r_sh, core_w, core_h)) {
+        shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
+        shadow_cache_add(sh_buf, dsc->shadow_width, r_sh, core_w, core_h);
     }
 #else
     sh_buf = lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
@@ -1036,6 +1053,118 @@ LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t
     lv_mem_buf_release(sh_ups_blur_buf);
 }
 
+#if LV_SHADOW_CACHE_SIZE
+
+/**
+ * Copy a cached corner to `sh_buf`
+ * @param sh_buf a buffer for the corner. Its size should be `(sw + r)^2`
+ * @param sw shadow width
+ * @param r radius of the shadow
+ * @param w width of the blurred rectangle limited to `2 * (sw + r)`
+ * @param h height of the blurred rectangle limited to `2 * (sw + r)`
+ * @return true: the corner was cached and copied; false: not cached
+ */
+static bool shadow_cache_get(lv_opa_t * sh_buf, lv_coord_t sw, lv_coord_t r, lv_coord_t w, lv_coord_t h)
+{
+    _lv_draw_shadow_cache_t * cache = &LV_GC_ROOT(_lv_shadow_cache);
+    bool found = false;
+
+    /*Another rendering thread might drop or add a corner meanwhile*/
+    _lv_refr_draw_lock();
+    uint32_t i;
+    for(i = 0; i < _LV_SHADOW_CACHE_ENTRY_CNT; i++) {
+        _lv_draw_shadow_cache_entry_t * entry = &cache->entries[i];
+        if(entry->buf && entry->sw == sw && entry->r == r && entry->w == w && entry->h == h) {
+            uint32_t size = sw + r;
+            lv_memcpy(sh_buf, entry->buf, size * size);
+            cache->life++;
+            entry->life = cache->life;
+            found = true;
+            break;
+        }
+    }
+
+    if(found) cache->stats.hit_cnt++;
+    else cache->stats.miss_cnt++;
+    _lv_refr_draw_unlock();
+
+    return found;
+}
+
+/**
+ * Save a corner in the cache. The least recently used corners are dropped if the memory limit is reached.
+ * The parameters are the same as the ones of `shadow_cache_get()`
+ */
+static void shadow_cache_add(const lv_opa_t * sh_buf, lv_coord_t sw, lv_coord_t r, lv_coord_t w, lv_coord_t h)
+{
+    uint32_t size = sw + r;
+    if(size > LV_SHADOW_CACHE_SIZE) return;
+    if(size * size > LV_SHADOW_CACHE_MEM_SIZE) return;
+
+    _lv_draw_shadow_cache_t * cache = &LV_GC_ROOT(_lv_shadow_cache);
+
+    _lv_refr_draw_lock();
+    _lv_draw_shadow_cache_entry_t * free_entry;
+    while(1) {
+        free_entry = NULL;
+        _lv_draw_shadow_cache_entry_t * lru_entry = NULL;
+        uint32_t i;
+        for(i = 0; i < _LV_SHADOW_CACHE_ENTRY_CNT; i++) {
+            _lv_draw_shadow_cache_entry_t * entry = &cache->entries[i];
+            if(entry->buf == NULL) {
+                if(free_entry == NULL) free_entry = entry;
+            }
+            else if(lru_entry == NULL || entry->life < lru_entry->life) {
+                lru_entry = entry;
+            }
+        }
+
+        if(free_entry && cache->stats.mem_size + size * size <= LV_SHADOW_CACHE_MEM_SIZE) break;
+
+        /*Can't happen as the new corner fits into the empty cache*/
+        if(lru_entry == NULL) {
+            _lv_refr_draw_unlock();
+            return;
+        }
+
+        shadow_cache_drop(lru_entry);
+        cache->stats.evict_cnt++;
+    }
+
+    free_entry->buf = lv_mem_alloc(size * size);
+    if(free_entry->buf) {
+        lv_memcpy(free_entry->buf, sh_buf, size * size);
+        free_entry->sw = sw;
+        free_entry->r = r;
+        free_entry->w = w;
+        free_entry->h = h;
+        cache->life++;
+        free_entry->life = cache->life;
+        cache->stats.mem_size += size * size;
+        cache->stats.corner_cnt++;
+    }
+    _lv_refr_draw_unlock();
+}
+
+/**
+ * Free the corner of a cache entry. Should be called with `_lv_refr_draw_lock()`.
+ * @param entry pointer to an entry of the shadow cache
+ */
+static void shadow_cache_drop(_lv_draw_shadow_cache_entry_t * entry)
+{
+    if(entry->buf == NULL) return;
+
+    _lv_draw_shadow_cache_t * cache = &LV_GC_ROOT(_lv_shadow_cache);
+    uint32_t size = entry->sw + entry->r;
+    cache->stats.mem_size -= size * size;
+    cache->stats.corner_cnt--;
+
+    lv_mem_free(entry->buf);
+    lv_memset_00(entry, sizeof(_lv_draw_shadow_cache_entry_t));
+}
+
+#endif /*LV_SHADOW_CACHE_SIZE*/
+
 #endif
 
 static void draw_outline(const lv_area_t * coords, const lv_area_t * clip, const lv_draw_rect_dsc_t * dsc)
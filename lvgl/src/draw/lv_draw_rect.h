@@ -22,6 +22,10 @@ extern "C" {
 #define LV_RADIUS_CIRCLE 0x7FFF /**< A very big radius to always draw as circle*/
 LV_EXPORT_CONST_INT(LV_RADIUS_CIRCLE);
 
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE > 0
+#define _LV_SHADOW_CACHE_ENTRY_CNT  16  /**< Max. number of buffered shadow corners*/
+#endif
+
 
 /**********************
  *      TYPEDEFS
@@ -69,6 +73,36 @@ typedef struct {
     lv_opa_t shadow_opa;
 } lv_draw_rect_dsc_t;
 
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE > 0
+
+/**
+ * Statistics about the usage of the shadow cache
+ */
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of shadows whose corner was found in the cache*/
+    uint32_t miss_cnt;      /**< Number of shadows whose corner had to be blurred*/
+    uint32_t evict_cnt;     /**< Number of corners dropped to make room for others*/
+    uint32_t mem_size;      /**< Memory used by the cached corners [bytes]*/
+    uint32_t corner_cnt;    /**< Number of cached corners*/
+} lv_draw_rect_shadow_cache_stats_t;
+
+typedef struct {
+    lv_opa_t * buf;         /*The blurred corner, `(sw + r)^2` opacity values*/
+    uint32_t life;          /*The value of the cache's `life` when it was last used*/
+    lv_coord_t sw;          /*Shadow width*/
+    lv_coord_t r;           /*Radius of the shadow*/
+    lv_coord_t w;           /*Width and height of the blurred rectangle. Matter only if they are small*/
+    lv_coord_t h;
+} _lv_draw_shadow_cache_entry_t;
+
+typedef struct {
+    _lv_draw_shadow_cache_entry_t entries[_LV_SHADOW_CACHE_ENTRY_CNT];
+    uint32_t life;          /*Increased on every use to find the least recently used corner*/
+    lv_draw_rect_shadow_cache_stats_t stats;
+} _lv_draw_shadow_cache_t;
+
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -85,6 +119,21 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_rect_dsc_init(lv_draw_rect_dsc_t * dsc);
  */
 void lv_draw_rect(const lv_area_t * coords, const lv_area_t * clip, const lv_draw_rect_dsc_t * dsc);
 
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE > 0
+
+/**
+ * Free all shadow corners buffered by the shadow cache
+ */
+void lv_draw_rect_shadow_cache_clean(void);
+
+/**
+ * Get the statistics of the shadow cache
+ * @param stats pointer to a variable to store the statistics
+ */
+void lv_draw_rect_shadow_cache_get_stats(lv_draw_rect_shadow_cache_stats_t * stats);
+
+#endif
+
 /**
  * Draw a pixel
  * @param point the coordinates of the point to draw
@@ -405,6 +405,9 @@ uint32_t lv_img_buf_get_img_size(lv_coord_t w, lv_coord_t h, lv_img_cf_t cf)
             return LV_IMG_BUF_SIZE_INDEXED_4BIT(w, h);
         case LV_IMG_CF_INDEXED_8BIT:
             return LV_IMG_BUF_SIZE_INDEXED_8BIT(w, h);
+        case LV_IMG_CF_YUV_I420:
+        case LV_IMG_CF_YUV_NV12:
+            return LV_IMG_BUF_SIZE_YUV420(w, h);
         default:
             return 0;
     }
@@ -45,6 +45,9 @@ extern "C" {
 #define LV_IMG_BUF_SIZE_INDEXED_4BIT(w, h) (LV_IMG_BUF_SIZE_ALPHA_4BIT(w, h) + 4 * 16)
 #define LV_IMG_BUF_SIZE_INDEXED_8BIT(w, h) (LV_IMG_BUF_SIZE_ALPHA_8BIT(w, h) + 4 * 256)
 
+/*Full resolution Y plane + U and V planes with half width and height (rounded up)*/
+#define LV_IMG_BUF_SIZE_YUV420(w, h) ((w) * (h) + 2 * (((w) + 1) / 2) * (((h) + 1) / 2))
+
 #define _LV_TRANSFORM_TRIGO_SHIFT 10
 #define _LV_ZOOM_INV_UPSCALE 5
 
@@ -77,8 +80,8 @@ enum {
     LV_IMG_CF_ALPHA_4BIT, /**< Can have one color but 16 different alpha value*/
     LV_IMG_CF_ALPHA_8BIT, /**< Can have one color but 256 different alpha value*/
 
-    LV_IMG_CF_RESERVED_15,              /**< Reserved for further use.*/
-    LV_IMG_CF_RESERVED_16,              /**< Reserved for further use.*/
+    LV_IMG_CF_YUV_I420,     /**< YUV 4:2:0 (BT.601 limited range) with a Y, a U and a V plane. Converted while drawing*/
+    LV_IMG_CF_YUV_NV12,     /**< YUV 4:2:0 (BT.601 limited range) with a Y and an interleaved UV plane*/
     LV_IMG_CF_RESERVED_17,              /**< Reserved for further use.*/
     LV_IMG_CF_RESERVED_18,              /**< Reserved for further use.*/
     LV_IMG_CF_RESERVED_19,              /**< Reserved for further use.*/
@@ -12,6 +12,9 @@
 #include "lv_draw_img.h"
 #include "../hal/lv_hal_tick.h"
 #include "../misc/lv_gc.h"
+#include "../misc/lv_thread.h"
+#include "../misc/lv_timer.h"
+#include "../core/lv_refr.h"
 
 /*********************
  *      DEFINES
@@ -26,15 +29,81 @@
  * "die" from very high values*/
 #define LV_IMG_CACHE_LIFE_LIMIT 1000
 
+/*Rebase the lives to the clock when the clock reaches this value to avoid overflow*/
+#define LV_IMG_CACHE_CLOCK_MAX (INT32_MAX / 2)
+
+/*Marks the end of a hash chain*/
+#define LV_IMG_CACHE_HASH_END 0xFFFF
+
+#if LV_IMG_CACHE_ASYNC
+    #if LV_USE_PTHREAD == 0
+        #error "LV_IMG_CACHE_ASYNC requires LV_USE_PTHREAD"
+    #endif
+    #if LV_IMG_CACHE_DEF_SIZE == 0
+        #error "LV_IMG_CACHE_ASYNC requires LV_IMG_CACHE_DEF_SIZE > 0"
+    #endif
+    #if LV_IMG_CACHE_ASYNC_THREAD_CNT < 1
+        #error "LV_IMG_CACHE_ASYNC_THREAD_CNT must be at least 1"
+    #endif
+
+/*Period of checking the finished background decodes [ms]*/
+#define LV_IMG_CACHE_ASYNC_PERIOD 10
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_IMG_CACHE_ASYNC
+/**
+ * An image to open on a background thread.
+ * Only `done`, `res` and `dec_dsc` are touched by the decoding threads and only while `job_mutex` is locked
+ * (or before `done` is set).
+ */
+typedef struct _lv_img_cache_job_t {
+    struct _lv_img_cache_job_t * next;          /**< Next job in `job_ll` (used only by the LVGL thread)*/
+    struct _lv_img_cache_job_t * queue_next;    /**< Next job waiting for a decoding thread*/
+    _lv_img_cache_entry_t * entry;              /**< The entry of the image or NULL if it was closed meanwhile*/
+    const void * src;                           /**< Source of the image. The path is copied for files.*/
+    lv_color_t color;
+    int32_t frame_id;
+    lv_img_decoder_dsc_t dec_dsc;               /**< The opened image*/
+    lv_res_t res;                               /**< Result of the open*/
+    lv_disp_t * disp;                           /**< Display to invalidate `inv_area` on. NULL: all displays*/
+    lv_area_t inv_area;                         /**< Area to invalidate when the image is ready*/
+    bool inv_area_valid;
+    bool done;                                  /**< The decoding thread has finished with the job*/
+} _lv_img_cache_job_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
     static bool lv_img_cache_match(const void * src1, const void * src2);
+    static uint32_t lv_img_cache_hash(const void * src);
+    static void lv_img_cache_release(_lv_img_cache_entry_t * entry);
+    static _lv_img_cache_entry_t * lv_img_cache_find_weakest(const _lv_img_cache_entry_t * skip, bool need_data);
+    static void lv_img_cache_trim(const _lv_img_cache_entry_t * skip);
+    static uint32_t lv_img_cache_get_data_size(const lv_img_decoder_dsc_t * dsc);
+    static void lv_img_cache_tick(void);
+    static _lv_img_cache_entry_t * lv_img_cache_lookup(const void * src, lv_color_t color, int32_t frame_id,
+                                                       uint32_t hash);
+    static void lv_img_cache_hit(_lv_img_cache_entry_t * entry);
+    static _lv_img_cache_entry_t * lv_img_cache_get_free_entry(void);
+    static void lv_img_cache_add(_lv_img_cache_entry_t * entry, uint32_t hash);
+#endif
+static lv_res_t lv_img_cache_decode(lv_img_decoder_dsc_t * dsc, const void * src, lv_color_t color, int32_t frame_id);
+#if LV_IMG_CACHE_ASYNC
+    static bool lv_img_cache_is_slow(const void * src);
+    static bool lv_img_cache_is_failed(const _lv_img_cache_entry_t * entry);
+    static lv_res_t lv_img_cache_job_init(void);
+    static _lv_img_cache_entry_t * lv_img_cache_job_start(const void * src, lv_color_t color, int32_t frame_id,
+                                                          uint32_t hash);
+    static void lv_img_cache_job_add_area(_lv_img_cache_job_t * job, const lv_area_t * area);
+    static void lv_img_cache_job_wait(_lv_img_cache_job_t * job);
+    static void lv_img_cache_job_finish(_lv_img_cache_job_t * job, bool invalidate);
+    static void lv_img_cache_job_timer_cb(lv_timer_t * t);
+    static void lv_img_cache_job_thread(void * user_data);
 #endif
 
 /**********************
@@ -42,6 +111,23 @@
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
     static uint16_t entry_cnt;
+    static uint16_t * hash_table;   /*Index of the first entry in every hash slot. Allocated after the entries*/
+    static uint32_t hash_mask;
+    static int32_t cache_clock;
+    static uint32_t mem_size_max = LV_IMG_CACHE_DEF_MEM_SIZE;
+    static lv_img_cache_stats_t cache_stats;
+#endif
+
+#if LV_IMG_CACHE_ASYNC
+    static _lv_img_cache_job_t * job_ll;            /*All the unfinished jobs*/
+    static _lv_img_cache_job_t * job_queue_head;    /*The jobs waiting for a decoding thread*/
+    static _lv_img_cache_job_t * job_queue_tail;
+    static lv_timer_t * job_timer;
+    static lv_thread_t job_threads[LV_IMG_CACHE_ASYNC_THREAD_CNT];
+    static uint32_t job_thread_cnt;
+    static lv_mutex_t job_mutex;
+    static lv_cond_t job_queue_cond;                /*Signaled when a job is added to the queue*/
+    static lv_cond_t job_done_cond;                 /*Signaled when a job is done*/
 #endif
 
 /**********************
@@ -71,73 +157,136 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
         return NULL;
     }
 
-    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    lv_img_cache_tick();
 
-    /*Decrement all lifes. Make the entries older*/
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(cache[i].life > INT32_MIN + LV_IMG_CACHE_AGING) {
-            cache[i].life -= LV_IMG_CACHE_AGING;
-        }
-    }
+    uint32_t hash = lv_img_cache_hash(src);
+    cached_src = lv_img_cache_lookup(src, color, frame_id, hash);
+#if LV_IMG_CACHE_ASYNC
+    if(cached_src) {
+        /*It's being decoded in the background but it's needed right now*/
+        if(cached_src->job) lv_img_cache_job_wait(cached_src->job);
 
-    for(i = 0; i < entry_cnt; i++) {
-        if(color.full == cache[i].dec_dsc.color.full &&
-           frame_id == cache[i].dec_dsc.frame_id &&
-           lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            /*If opened increment its life.
-             *Image difficult to open should live longer to keep avoid frequent their recaching.
-             *Therefore increase `life` with `time_to_open`*/
-            cached_src = &cache[i];
-            cached_src->life += cached_src->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
-            if(cached_src->life > LV_IMG_CACHE_LIFE_LIMIT) cached_src->life = LV_IMG_CACHE_LIFE_LIMIT;
-            LV_LOG_TRACE("image source found in the cache");
-            break;
+        /*The background decode failed. Try to open it again now.*/
+        if(lv_img_cache_is_failed(cached_src)) {
+            lv_img_cache_release(cached_src);
+            cached_src = NULL;
         }
     }
-
-    /*The image is not cached then cache it now*/
-    if(cached_src) return cached_src;
-
-    /*Find an entry to reuse. Select the entry with the least life*/
-    cached_src = &cache[0];
-    for(i = 1; i < entry_cnt; i++) {
-        if(cache[i].life < cached_src->life) {
-            cached_src = &cache[i];
-        }
+#endif
+    if(cached_src) {
+        lv_img_cache_hit(cached_src);
+        return cached_src;
     }
 
-    /*Close the decoder to reuse if it was opened (has a valid source)*/
-    if(cached_src->dec_dsc.src) {
-        lv_img_decoder_close(&cached_src->dec_dsc);
-        LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
-    }
-    else {
-        LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
-    }
+    /*The image is not cached then cache it now*/
+    cache_stats.miss_cnt++;
+    cached_src = lv_img_cache_get_free_entry();
 #else
     cached_src = &LV_GC_ROOT(_lv_img_cache_single);
 #endif
-    /*Open the image and measure the time to open*/
-    uint32_t t_start  = lv_tick_get();
-    lv_res_t open_res = lv_img_decoder_open(&cached_src->dec_dsc, src, color, frame_id);
-    if(open_res == LV_RES_INV) {
+    if(lv_img_cache_decode(&cached_src->dec_dsc, src, color, frame_id) == LV_RES_INV) {
         LV_LOG_WARN("Image draw cannot open the image resource");
         lv_memset_00(cached_src, sizeof(_lv_img_cache_entry_t));
         cached_src->life = INT32_MIN; /*Make the empty entry very "weak" to force its us*/
+#if LV_IMG_CACHE_DEF_SIZE
+        cached_src->hash_next = LV_IMG_CACHE_HASH_END;
+#endif
         return NULL;
     }
 
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_img_cache_add(cached_src, hash);
+#else
     cached_src->life = 0;
+#endif
 
-    /*If `time_to_open` was not set in the open function set it here*/
-    if(cached_src->dec_dsc.time_to_open == 0) {
-        cached_src->dec_dsc.time_to_open = lv_tick_elaps(t_start);
+    return cached_src;
+}
+
+/**
+ * Like `_lv_img_cache_open` but with `LV_IMG_CACHE_ASYNC` images which are slow to open are decoded
+ * on a background thread. Until it's ready the returned entry's `job` is not NULL and
+ * `inv_area` of the display being refreshed will be invalidated when the image is opened.
+ * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
+ * @param color The color of the image with `LV_IMG_CF_ALPHA_...`
+ * @param frame_id the index of the frame. Used only with animated images, set 0 for normal images
+ * @param inv_area the area to redraw when the image is decoded (the area of the image)
+ * @return pointer to the cache entry or NULL if can open the image
+ */
+_lv_img_cache_entry_t * _lv_img_cache_open_async(const void * src, lv_color_t color, int32_t frame_id,
+                                                 const lv_area_t * inv_area)
+{
+#if LV_IMG_CACHE_ASYNC
+    if(entry_cnt == 0 || !lv_img_cache_is_slow(src) || lv_img_cache_job_init() != LV_RES_OK) {
+        return _lv_img_cache_open(src, color, frame_id);
     }
 
-    if(cached_src->dec_dsc.time_to_open == 0) cached_src->dec_dsc.time_to_open = 1;
+    /*Canvases draw to a display without refresh timer. They can't be redrawn later so open the image now.*/
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(disp && disp->refr_timer == NULL) return _lv_img_cache_open(src, color, frame_id);
+
+    lv_img_cache_tick();
+
+    uint32_t hash = lv_img_cache_hash(src);
+    _lv_img_cache_entry_t * cached_src = lv_img_cache_lookup(src, color, frame_id, hash);
+    if(cached_src == NULL) {
+        cache_stats.miss_cnt++;
+        cached_src = lv_img_cache_job_start(src, color, frame_id, hash);
+        if(cached_src == NULL) return NULL;
+    }
+    /*The failed entry only tells that the image can't be opened until its source is invalidated*/
+    else if(lv_img_cache_is_failed(cached_src)) {
+        return NULL;
+    }
+    else {
+        lv_img_cache_hit(cached_src);
+    }
+
+    if(cached_src->job) lv_img_cache_job_add_area(cached_src->job, inv_area);
 
     return cached_src;
+#else
+    LV_UNUSED(inv_area);
+    return _lv_img_cache_open(src, color, frame_id);
+#endif
+}
+
+/**
+ * Open an image in advance to have it in the cache when it's drawn, e.g. the images of the next screen.
+ * With `LV_IMG_CACHE_ASYNC` the image is decoded on a background thread, else it's opened right now.
+ * The image is opened with the default recolor (black) and frame 0 as `lv_img` draws it.
+ * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
+ * @return LV_RES_OK: the image is cached or being decoded; LV_RES_INV: the image couldn't be opened or queued
+ */
+lv_res_t lv_img_cache_prefetch(const void * src)
+{
+#if LV_IMG_CACHE_DEF_SIZE == 0
+    LV_UNUSED(src);
+    LV_LOG_WARN("Can't prefetch an image because the cache is disabled by LV_IMG_CACHE_DEF_SIZE = 0");
+    return LV_RES_INV;
+#elif LV_IMG_CACHE_ASYNC
+    if(entry_cnt == 0) return LV_RES_INV;
+    if(!lv_img_cache_is_slow(src) || lv_img_cache_job_init() != LV_RES_OK) {
+        return _lv_img_cache_open(src, lv_color_black(), 0) ? LV_RES_OK : LV_RES_INV;
+    }
+
+    lv_img_cache_tick();
+
+    uint32_t hash = lv_img_cache_hash(src);
+    _lv_img_cache_entry_t * cached_src = lv_img_cache_lookup(src, lv_color_black(), 0, hash);
+    if(cached_src && !lv_img_cache_is_failed(cached_src)) {
+        lv_img_cache_hit(cached_src);
+        return LV_RES_OK;
+    }
+
+    /*Try to open the failed image again*/
+    if(cached_src) lv_img_cache_release(cached_src);
+
+    cache_stats.miss_cnt++;
+    return lv_img_cache_job_start(src, lv_color_black(), 0, hash) ? LV_RES_OK : LV_RES_INV;
+#else
+    return _lv_img_cache_open(src, lv_color_black(), 0) ? LV_RES_OK : LV_RES_INV;
+#endif
 }
 
 /**
@@ -158,17 +307,61 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
         lv_mem_free(LV_GC_ROOT(_lv_img_cache_array));
     }
 
-    /*Reallocate the cache*/
-    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(_lv_img_cache_entry_t) * new_entry_cnt);
+    /*The last index marks the end of the hash chains*/
+    if(new_entry_cnt >= LV_IMG_CACHE_HASH_END) new_entry_cnt = LV_IMG_CACHE_HASH_END - 1;
+
+    /*Have at least as many hash slots as entries*/
+    uint32_t slot_cnt = 1;
+    while(slot_cnt < new_entry_cnt) slot_cnt <<= 1;
+
+    /*Reallocate the cache. The hash table is stored after the entries.*/
+    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(_lv_img_cache_entry_t) * new_entry_cnt +
+                                                   sizeof(uint16_t) * slot_cnt);
     LV_ASSERT_MALLOC(LV_GC_ROOT(_lv_img_cache_array));
     if(LV_GC_ROOT(_lv_img_cache_array) == NULL) {
         entry_cnt = 0;
+        hash_table = NULL;
         return;
     }
     entry_cnt = new_entry_cnt;
+    hash_table = (uint16_t *)&LV_GC_ROOT(_lv_img_cache_array)[entry_cnt];
+    hash_mask = slot_cnt - 1;
 
     /*Clean the cache*/
     lv_memset_00(LV_GC_ROOT(_lv_img_cache_array), entry_cnt * sizeof(_lv_img_cache_entry_t));
+    uint32_t i;
+    for(i = 0; i < entry_cnt; i++) LV_GC_ROOT(_lv_img_cache_array)[i].hash_next = LV_IMG_CACHE_HASH_END;
+    for(i = 0; i < slot_cnt; i++) hash_table[i] = LV_IMG_CACHE_HASH_END;
+#endif
+}
+
+/**
+ * Limit the memory used by the decoded images in the cache.
+ * If the limit is exceeded the least valuable images are closed even if there are free entries.
+ * Images which don't need extra memory (e.g. C arrays in true color format) are not counted.
+ * @param mem_size the limit in bytes. 0: no limit, only the number of entries matters
+ */
+void lv_img_cache_set_mem_size(uint32_t mem_size)
+{
+#if LV_IMG_CACHE_DEF_SIZE == 0
+    LV_UNUSED(mem_size);
+    LV_LOG_WARN("Can't change cache memory size because it's disabled by LV_IMG_CACHE_DEF_SIZE = 0");
+#else
+    mem_size_max = mem_size;
+    lv_img_cache_trim(NULL);
+#endif
+}
+
+/**
+ * Get the statistics of the image cache
+ * @param stats pointer to a variable to store the statistics. All zero if the cache is disabled.
+ */
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats)
+{
+#if LV_IMG_CACHE_DEF_SIZE == 0
+    lv_memset_00(stats, sizeof(lv_img_cache_stats_t));
+#else
+    *stats = cache_stats;
 #endif
 }
 
@@ -182,16 +375,24 @@ void lv_img_cache_invalidate_src(const void * src)
     LV_UNUSED(src);
 #if LV_IMG_CACHE_DEF_SIZE
     _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
-
     uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(src == NULL || lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            if(cache[i].dec_dsc.src != NULL) {
-                lv_img_decoder_close(&cache[i].dec_dsc);
-            }
 
-            lv_memset_00(&cache[i], sizeof(_lv_img_cache_entry_t));
+    if(src == NULL) {
+        for(i = 0; i < entry_cnt; i++) {
+            lv_img_cache_release(&cache[i]);
+        }
+        return;
+    }
+
+    /*The hash depends only on the source so all its colors and frames are in the same chain*/
+    uint32_t hash = lv_img_cache_hash(src);
+    i = hash_table[hash & hash_mask];
+    while(i != LV_IMG_CACHE_HASH_END) {
+        uint16_t next = cache[i].hash_next;
+        if(hash == cache[i].hash && lv_img_cache_match(src, cache[i].dec_dsc.src)) {
+            lv_img_cache_release(&cache[i]);
         }
+        i = next;
     }
 #endif
 }
@@ -212,4 +413,505 @@ static bool lv_img_cache_match(const void * src1, const void * src2)
         return false;
     return strcmp(src1, src2) == 0;
 }
+
+/**
+ * Hash an image source: the address of variables and the path of files.
+ * The color and the frame ID are not hashed, so `lv_img_cache_invalidate_src` can find all entries of a source.
+ */
+static uint32_t lv_img_cache_hash(const void * src)
+{
+    uint32_t h;
+    if(lv_img_src_get_type(src) == LV_IMG_SRC_VARIABLE) {
+        h = (uint32_t)((lv_uintptr_t)src >> 2);
+        h ^= h >> 16;
+        h *= 0x45d9f3b;
+        h ^= h >> 16;
+    }
+    else {
+        /*FNV-1a*/
+        const uint8_t * s = src;
+        h = 2166136261u;
+        while(*s) {
+            h ^= *s;
+            h *= 16777619u;
+            s++;
+        }
+    }
+
+    return h;
+}
+
+/**
+ * Close the image of an entry, remove it from the hash table and make the entry empty
+ */
+static void lv_img_cache_release(_lv_img_cache_entry_t * entry)
+{
+    if(entry->dec_dsc.src == NULL) return;
+
+    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    uint16_t idx = (uint16_t)(entry - cache);
+    uint16_t * link = &hash_table[entry->hash & hash_mask];
+    while(*link != LV_IMG_CACHE_HASH_END) {
+        if(*link == idx) {
+            *link = entry->hash_next;
+            break;
+        }
+        link = &cache[*link].hash_next;
+    }
+
+    cache_stats.mem_size -= entry->data_size;
+    cache_stats.entry_cnt--;
+
+#if LV_IMG_CACHE_ASYNC
+    /*Pending and failed background decodes have no decoder, only a copy of the source to find them*/
+    if(entry->job) entry->job->entry = NULL;
+    if(entry->dec_dsc.decoder == NULL && entry->dec_dsc.src_type == LV_IMG_SRC_FILE) {
+        lv_mem_free((void *)entry->dec_dsc.src);
+    }
+#endif
+    lv_img_decoder_close(&entry->dec_dsc);
+    lv_memset_00(entry, sizeof(_lv_img_cache_entry_t));
+    entry->hash_next = LV_IMG_CACHE_HASH_END;
+}
+
+/**
+ * Find the entry to close to make room
+ * @param skip don't return this entry
+ * @param need_data true: consider only opened images which use memory;
+ *                  false: return an empty entry if any, else the opened image with the least life
+ * @return the weakest entry or NULL if not found
+ */
+static _lv_img_cache_entry_t * lv_img_cache_find_weakest(const _lv_img_cache_entry_t * skip, bool need_data)
+{
+    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    _lv_img_cache_entry_t * weakest = NULL;
+#if LV_IMG_CACHE_ASYNC
+    _lv_img_cache_entry_t * weakest_pending = NULL;
+#endif
+    uint16_t i;
+    for(i = 0; i < entry_cnt; i++) {
+        if(&cache[i] == skip) continue;
+        if(cache[i].dec_dsc.src == NULL) {
+            if(need_data) continue;
+            return &cache[i];
+        }
+        if(need_data && cache[i].data_size == 0) continue;
+#if LV_IMG_CACHE_ASYNC
+        /*Cancel the images being decoded only if there is no other choice*/
+        if(cache[i].job) {
+            if(weakest_pending == NULL || cache[i].life < weakest_pending->life) weakest_pending = &cache[i];
+            continue;
+        }
+#endif
+        if(weakest == NULL || cache[i].life < weakest->life) weakest = &cache[i];
+    }
+
+#if LV_IMG_CACHE_ASYNC
+    if(weakest == NULL) weakest = weakest_pending;
+#endif
+
+    return weakest;
+}
+
+/**
+ * Close the least valuable images until the decoded images fit into the memory limit
+ * @param skip don't close this entry (e.g. the just opened image)
+ */
+static void lv_img_cache_trim(const _lv_img_cache_entry_t * skip)
+{
+    if(mem_size_max == 0) return;
+
+    while(cache_stats.mem_size > mem_size_max) {
+        _lv_img_cache_entry_t * entry = lv_img_cache_find_weakest(skip, true);
+        if(entry == NULL) break;
+
+        LV_LOG_INFO("image cache: close an image to fit into the memory limit");
+        lv_img_cache_release(entry);
+        cache_stats.evict_cnt++;
+    }
+}
+
+/**
+ * Get how much memory an opened image uses
+ * @return the size of the decoded image in bytes or 0 if it's read line-by-line or used from the source directly
+ */
+static uint32_t lv_img_cache_get_data_size(const lv_img_decoder_dsc_t * dsc)
+{
+    if(dsc->img_data == NULL) return 0;
+
+    if(dsc->src_type == LV_IMG_SRC_VARIABLE && dsc->img_data == ((const lv_img_dsc_t *)dsc->src)->data) return 0;
+
+    /*The raw formats are decoded to their true color pairs*/
+    lv_img_cf_t cf = dsc->header.cf;
+    if(cf == LV_IMG_CF_RAW) cf = LV_IMG_CF_TRUE_COLOR;
+    else if(cf == LV_IMG_CF_RAW_ALPHA) cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    else if(cf == LV_IMG_CF_RAW_CHROMA_KEYED) cf = LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED;
+
+    return lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, cf);
+}
+
+/**
+ * Make the entries older. Instead of decrementing all lives move the clock forward.
+ */
+static void lv_img_cache_tick(void)
+{
+    cache_clock += LV_IMG_CACHE_AGING;
+    if(cache_clock > LV_IMG_CACHE_CLOCK_MAX) {
+        _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+        uint16_t i;
+        for(i = 0; i < entry_cnt; i++) {
+            if(cache[i].dec_dsc.src == NULL) continue;
+            cache[i].life = LV_MAX(cache[i].life - cache_clock, -LV_IMG_CACHE_CLOCK_MAX);
+        }
+        cache_clock = 0;
+    }
+}
+
+/**
+ * Find an image in the cache. It's not counted as a hit until it's used.
+ * @return the entry of the image or NULL if not cached
+ */
+static _lv_img_cache_entry_t * lv_img_cache_lookup(const void * src, lv_color_t color, int32_t frame_id,
+                                                   uint32_t hash)
+{
+    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    uint16_t i;
+    for(i = hash_table[hash & hash_mask]; i != LV_IMG_CACHE_HASH_END; i = cache[i].hash_next) {
+        if(hash == cache[i].hash &&
+           color.full == cache[i].dec_dsc.color.full &&
+           frame_id == cache[i].dec_dsc.frame_id &&
+           lv_img_cache_match(src, cache[i].dec_dsc.src)) {
+            return &cache[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Count a hit for a cached image which is used and make it more alive
+ */
+static void lv_img_cache_hit(_lv_img_cache_entry_t * entry)
+{
+    /*If opened increment its life.
+     *Image difficult to open should live longer to keep avoid frequent their recaching.
+     *Therefore increase `life` with `time_to_open`*/
+    entry->life += entry->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
+    if(entry->life > cache_clock + LV_IMG_CACHE_LIFE_LIMIT) {
+        entry->life = cache_clock + LV_IMG_CACHE_LIFE_LIMIT;
+    }
+    cache_stats.hit_cnt++;
+    LV_LOG_TRACE("image source found in the cache");
+}
+
+/**
+ * Get an entry for a new image. Select an empty entry or close the image with the least life.
+ */
+static _lv_img_cache_entry_t * lv_img_cache_get_free_entry(void)
+{
+    _lv_img_cache_entry_t * cached_src = lv_img_cache_find_weakest(NULL, false);
+
+    /*Close the decoder to reuse if it was opened (has a valid source)*/
+    if(cached_src->dec_dsc.src) {
+        lv_img_cache_release(cached_src);
+        cache_stats.evict_cnt++;
+        LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
+    }
+    else {
+        LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
+    }
+
+    return cached_src;
+}
+
+/**
+ * Add an entry with an opened (or being opened) image to the hash table and the statistics
+ */
+static void lv_img_cache_add(_lv_img_cache_entry_t * entry, uint32_t hash)
+{
+    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+
+    entry->life = cache_clock;
+    entry->hash = hash;
+    entry->hash_next = hash_table[hash & hash_mask];
+    hash_table[hash & hash_mask] = (uint16_t)(entry - cache);
+
+    entry->data_size = lv_img_cache_get_data_size(&entry->dec_dsc);
+    cache_stats.mem_size += entry->data_size;
+    cache_stats.entry_cnt++;
+
+    /*Keep the memory budget by closing other images*/
+    lv_img_cache_trim(entry);
+}
 #endif
+
+/**
+ * Open an image with the decoders and measure the time to open
+ */
+static lv_res_t lv_img_cache_decode(lv_img_decoder_dsc_t * dsc, const void * src, lv_color_t color, int32_t frame_id)
+{
+    uint32_t t_start  = lv_tick_get();
+    lv_res_t open_res = lv_img_decoder_open(dsc, src, color, frame_id);
+    if(open_res == LV_RES_INV) return LV_RES_INV;
+
+    /*If `time_to_open` was not set in the open function set it here*/
+    if(dsc->time_to_open == 0) {
+        dsc->time_to_open = lv_tick_elaps(t_start);
+    }
+
+    if(dsc->time_to_open == 0) dsc->time_to_open = 1;
+
+    return LV_RES_OK;
+}
+
+#if LV_IMG_CACHE_ASYNC
+/**
+ * Tell whether it's worth opening an image in the background.
+ * Files and the images to decode from C arrays (PNG, JPG, etc.) are slow, the built-in formats in C arrays aren't.
+ */
+static bool lv_img_cache_is_slow(const void * src)
+{
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    if(src_type == LV_IMG_SRC_FILE) return true;
+    if(src_type != LV_IMG_SRC_VARIABLE) return false;
+
+    lv_img_cf_t cf = ((const lv_img_dsc_t *)src)->header.cf;
+    return cf == LV_IMG_CF_RAW || cf == LV_IMG_CF_RAW_ALPHA || cf == LV_IMG_CF_RAW_CHROMA_KEYED;
+}
+
+/**
+ * Tell whether an entry is the result of a failed background decode. Such entries have no decoder.
+ */
+static bool lv_img_cache_is_failed(const _lv_img_cache_entry_t * entry)
+{
+    return entry->job == NULL && entry->dec_dsc.decoder == NULL;
+}
+
+/**
+ * Start the decoding threads and the timer to collect the decoded images on the first use
+ * @return LV_RES_OK: images can be opened in the background; LV_RES_INV: no decoding thread could be started
+ */
+static lv_res_t lv_img_cache_job_init(void)
+{
+    if(job_thread_cnt == LV_IMG_CACHE_ASYNC_THREAD_CNT) return LV_RES_OK;
+
+    if(job_timer == NULL) {
+        job_timer = lv_timer_create(lv_img_cache_job_timer_cb, LV_IMG_CACHE_ASYNC_PERIOD, NULL);
+        LV_ASSERT_MALLOC(job_timer);
+        if(job_timer == NULL) return LV_RES_INV;
+        lv_timer_pause(job_timer);
+
+        lv_mutex_init(&job_mutex);
+        lv_cond_init(&job_queue_cond);
+        lv_cond_init(&job_done_cond);
+    }
+
+    while(job_thread_cnt < LV_IMG_CACHE_ASYNC_THREAD_CNT) {
+        if(lv_thread_init(&job_threads[job_thread_cnt], lv_img_cache_job_thread, NULL) != LV_RES_OK) break;
+        job_thread_cnt++;
+    }
+
+    return job_thread_cnt > 0 ? LV_RES_OK : LV_RES_INV;
+}
+
+/**
+ * Add a pending entry for an image and queue it to open on a decoding thread
+ * @return the pending entry or NULL on error
+ */
+static _lv_img_cache_entry_t * lv_img_cache_job_start(const void * src, lv_color_t color, int32_t frame_id,
+                                                      uint32_t hash)
+{
+    _lv_img_cache_job_t * job = lv_mem_alloc(sizeof(_lv_img_cache_job_t));
+    LV_ASSERT_MALLOC(job);
+    if(job == NULL) return NULL;
+    lv_memset_00(job, sizeof(_lv_img_cache_job_t));
+
+    /*The entry and the job need their own copy of the path*/
+    const void * entry_src = src;
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    if(src_type == LV_IMG_SRC_FILE) {
+        size_t len = strlen(src) + 1;
+        char * job_path = lv_mem_alloc(len);
+        char * entry_path = lv_mem_alloc(len);
+        if(job_path == NULL || entry_path == NULL) {
+            LV_LOG_WARN("out of memory");
+            lv_mem_free(job_path);
+            lv_mem_free(entry_path);
+            lv_mem_free(job);
+            return NULL;
+        }
+        lv_memcpy(job_path, src, len);
+        lv_memcpy(entry_path, src, len);
+        src = job_path;
+        entry_src = entry_path;
+    }
+
+    job->src = src;
+    job->color = color;
+    job->frame_id = frame_id;
+
+    /*Add a pending entry which is found by the next opens but has no decoder yet*/
+    _lv_img_cache_entry_t * entry = lv_img_cache_get_free_entry();
+    entry->dec_dsc.src = entry_src;
+    entry->dec_dsc.src_type = src_type;
+    entry->dec_dsc.color = color;
+    entry->dec_dsc.frame_id = frame_id;
+    entry->job = job;
+    job->entry = entry;
+    lv_img_cache_add(entry, hash);
+
+    job->next = job_ll;
+    job_ll = job;
+    lv_timer_resume(job_timer);
+
+    lv_mutex_lock(&job_mutex);
+    if(job_queue_tail) job_queue_tail->queue_next = job;
+    else job_queue_head = job;
+    job_queue_tail = job;
+    lv_cond_signal(&job_queue_cond);
+    lv_mutex_unlock(&job_mutex);
+
+    return entry;
+}
+
+/**
+ * Remember the area to redraw when the image of a job is ready
+ */
+static void lv_img_cache_job_add_area(_lv_img_cache_job_t * job, const lv_area_t * area)
+{
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(disp == NULL || area == NULL) return;
+
+    /*The rendering threads of the parallel renderer use a copy of the display. Its refresh timer knows the real one.*/
+    disp = disp->refr_timer->user_data;
+
+    if(!job->inv_area_valid) {
+        job->disp = disp;
+        job->inv_area = *area;
+        job->inv_area_valid = true;
+        return;
+    }
+
+    /*The image is drawn on more displays. Invalidate the area on all of them.*/
+    if(job->disp != disp) job->disp = NULL;
+    _lv_area_join(&job->inv_area, &job->inv_area, area);
+}
+
+/**
+ * Wait until a decoding thread finishes a job and move its image to its entry
+ */
+static void lv_img_cache_job_wait(_lv_img_cache_job_t * job)
+{
+    lv_mutex_lock(&job_mutex);
+    while(!job->done) {
+        lv_cond_wait(&job_done_cond, &job_mutex);
+    }
+    lv_mutex_unlock(&job_mutex);
+
+    /*The image is used right now, no need to redraw its area*/
+    lv_img_cache_job_finish(job, false);
+}
+
+/**
+ * Move the image of a done job to its entry (or close it if the entry was closed meanwhile) and free the job
+ * @param job pointer to a done job
+ * @param invalidate true: redraw the areas where the image was drawn
+ */
+static void lv_img_cache_job_finish(_lv_img_cache_job_t * job, bool invalidate)
+{
+    _lv_img_cache_job_t ** link = &job_ll;
+    while(*link != job) link = &(*link)->next;
+    *link = job->next;
+    if(job_ll == NULL) lv_timer_pause(job_timer);
+
+    _lv_img_cache_entry_t * entry = job->entry;
+    if(entry == NULL) {
+        if(job->res == LV_RES_OK) lv_img_decoder_close(&job->dec_dsc);
+    }
+    else {
+        entry->job = NULL;
+        if(job->res == LV_RES_OK) {
+            /*Replace the copy of the source with the opened image*/
+            if(entry->dec_dsc.src_type == LV_IMG_SRC_FILE) lv_mem_free((void *)entry->dec_dsc.src);
+            entry->dec_dsc = job->dec_dsc;
+            entry->data_size = lv_img_cache_get_data_size(&entry->dec_dsc);
+            cache_stats.mem_size += entry->data_size;
+            lv_img_cache_trim(entry);
+        }
+        else {
+            /*Keep the failed entry (with no decoder) to not try it again on every refresh.
+             *`_lv_img_cache_open` and `lv_img_cache_prefetch` try it again, drawing just reports the error.*/
+            LV_LOG_WARN("Image draw cannot open the image resource");
+        }
+    }
+
+    /*Redraw the image even if its entry was closed meanwhile to request it again*/
+    if(invalidate && job->inv_area_valid) {
+        lv_disp_t * disp = lv_disp_get_next(NULL);
+        while(disp) {
+            if(job->disp == NULL || job->disp == disp) _lv_inv_area(disp, &job->inv_area);
+            disp = lv_disp_get_next(disp);
+        }
+    }
+
+    if(lv_img_src_get_type(job->src) == LV_IMG_SRC_FILE) lv_mem_free((void *)job->src);
+    lv_mem_free(job);
+}
+
+/**
+ * Collect the images decoded on the background threads
+ */
+static void lv_img_cache_job_timer_cb(lv_timer_t * t)
+{
+    LV_UNUSED(t);
+
+    _lv_img_cache_job_t * done_ll = NULL;
+    _lv_img_cache_job_t * job;
+    _lv_img_cache_job_t * next;
+
+    /*Collect the done jobs first as finishing a job modifies the job list*/
+    lv_mutex_lock(&job_mutex);
+    for(job = job_ll; job; job = job->next) {
+        if(job->done) {
+            job->queue_next = done_ll;
+            done_ll = job;
+        }
+    }
+    lv_mutex_unlock(&job_mutex);
+
+    for(job = done_ll; job; job = next) {
+        next = job->queue_next;
+        lv_img_cache_job_finish(job, true);
+    }
+}
+
+/**
+ * The decoding threads: open the images of the queued jobs
+ */
+static void lv_img_cache_job_thread(void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    while(1) {
+        lv_mutex_lock(&job_mutex);
+        while(job_queue_head == NULL) {
+            lv_cond_wait(&job_queue_cond, &job_mutex);
+        }
+        _lv_img_cache_job_t * job = job_queue_head;
+        job_queue_head = job->queue_next;
+        if(job_queue_head == NULL) job_queue_tail = NULL;
+        lv_mutex_unlock(&job_mutex);
+
+        /*The decoder functions serialize the callbacks of the decoders which are not thread-safe*/
+        lv_img_decoder_dsc_t dsc;
+        lv_res_t res = lv_img_cache_decode(&dsc, job->src, job->color, job->frame_id);
+
+        lv_mutex_lock(&job_mutex);
+        job->dec_dsc = dsc;
+        job->res = res;
+        job->done = true;
+        lv_cond_broadcast(&job_done_cond);
+        lv_mutex_unlock(&job_mutex);
+    }
+}
+#endif /*LV_IMG_CACHE_ASYNC*/
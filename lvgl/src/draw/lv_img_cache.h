@@ -32,11 +32,30 @@ typedef struct {
     lv_img_decoder_dsc_t dec_dsc; /**< Image information*/
 
     /** Count the cache entries's life. Add `time_to_open` to `life` when the entry is used.
-     * Decrement all lifes by one every in every ::lv_img_cache_open.
-     * If life == 0 the entry can be reused*/
+     * The entries get older by one in every ::lv_img_cache_open.
+     * (The cache's clock is incremented instead of decrementing every life, so `life` is relative to the clock)
+     * The entry with the least life is reused first*/
     int32_t life;
+
+    uint32_t hash;          /**< Hash of the source to find the entry quickly*/
+    uint32_t data_size;     /**< Memory used by the decoded image [bytes]*/
+    uint16_t hash_next;     /**< Index of the next entry with the same hash slot*/
+#if LV_IMG_CACHE_ASYNC
+    struct _lv_img_cache_job_t * job;   /**< Not NULL while the image is being decoded on a background thread*/
+#endif
 } _lv_img_cache_entry_t;
 
+/**
+ * Statistics about the usage of the image cache
+ */
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of opens served from the cache*/
+    uint32_t miss_cnt;      /**< Number of opens which required to open the image*/
+    uint32_t evict_cnt;     /**< Number of cached images closed to make room for an other*/
+    uint32_t mem_size;      /**< Memory currently used by the cached decoded images [bytes]*/
+    uint16_t entry_cnt;     /**< Number of used entries*/
+} lv_img_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -52,6 +71,28 @@ typedef struct {
  */
 _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, int32_t frame_id);
 
+/**
+ * Like `_lv_img_cache_open` but with `LV_IMG_CACHE_ASYNC` images which are slow to open are decoded
+ * on a background thread. Until it's ready the returned entry's `job` is not NULL and
+ * `inv_area` of the display being refreshed will be invalidated when the image is opened.
+ * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
+ * @param color The color of the image with `LV_IMG_CF_ALPHA_...`
+ * @param frame_id the index of the frame. Used only with animated images, set 0 for normal images
+ * @param inv_area the area to redraw when the image is decoded (the area of the image)
+ * @return pointer to the cache entry or NULL if can open the image
+ */
+_lv_img_cache_entry_t * _lv_img_cache_open_async(const void * src, lv_color_t color, int32_t frame_id,
+                                                 const lv_area_t * inv_area);
+
+/**
+ * Open an image in advance to have it in the cache when it's drawn, e.g. the images of the next screen.
+ * With `LV_IMG_CACHE_ASYNC` the image is decoded on a background thread, else it's opened right now.
+ * The image is opened with the default recolor (black) and frame 0 as `lv_img` draws it.
+ * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
+ * @return LV_RES_OK: the image is cached or being decoded; LV_RES_INV: the image couldn't be opened or queued
+ */
+lv_res_t lv_img_cache_prefetch(const void * src);
+
 /**
  * Set the number of images to be cached.
  * More cached images mean more opened image at same time which might mean more memory usage.
@@ -60,6 +101,20 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
  */
 void lv_img_cache_set_size(uint16_t new_slot_num);
 
+/**
+ * Limit the memory used by the decoded images in the cache.
+ * If the limit is exceeded the least valuable images are closed even if there are free entries.
+ * Images which don't need extra memory (e.g. C arrays in true color format) are not counted.
+ * @param mem_size the limit in bytes. 0: no limit, only the number of entries matters
+ */
+void lv_img_cache_set_mem_size(uint32_t mem_size);
+
+/**
+ * Get the statistics of the image cache
+ * @param stats pointer to a variable to store the statistics. All zero if the cache is disabled.
+ */
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats);
+
 /**
  * Invalidate an image source in the cache.
  * Useful if the image source is updated therefore it needs to be cached again.
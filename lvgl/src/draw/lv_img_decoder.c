@@ -11,12 +11,13 @@
 #include "../draw/lv_draw_img.h"
 #include "../misc/lv_ll.h"
 #include "../misc/lv_gc.h"
+#include "../misc/lv_thread.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define CF_BUILT_IN_FIRST LV_IMG_CF_TRUE_COLOR
-#define CF_BUILT_IN_LAST LV_IMG_CF_ALPHA_8BIT
+#define CF_BUILT_IN_LAST LV_IMG_CF_YUV_NV12
 
 /**********************
  *      TYPEDEFS
@@ -37,10 +38,16 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
                                                    lv_coord_t len, uint8_t * buf);
 static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
                                                      lv_coord_t len, uint8_t * buf);
+static lv_res_t lv_img_decoder_built_in_line_yuv(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                 lv_coord_t len, uint8_t * buf);
+static lv_img_decoder_t * decoder_get_next(lv_img_decoder_t * decoder);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_IMG_CACHE_ASYNC
+    static lv_mutex_t decoder_ll_mutex;     /*The decoding threads of the image cache walk the list of decoders too*/
+#endif
 
 /**********************
  *      MACROS
@@ -57,6 +64,10 @@ void _lv_img_decoder_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_img_decoder_ll), sizeof(lv_img_decoder_t));
 
+#if LV_IMG_CACHE_ASYNC
+    lv_mutex_init(&decoder_ll_mutex);
+#endif
+
     lv_img_decoder_t * decoder;
 
     /*Create a decoder for the built in color format*/
@@ -71,6 +82,7 @@ void _lv_img_decoder_init(void)
     lv_img_decoder_set_open_cb(decoder, lv_img_decoder_built_in_open);
     lv_img_decoder_set_read_line_cb(decoder, lv_img_decoder_built_in_read_line);
     lv_img_decoder_set_close_cb(decoder, lv_img_decoder_built_in_close);
+    lv_img_decoder_set_thread_safe(decoder, true);
 }
 
 /**
@@ -94,9 +106,11 @@ lv_res_t lv_img_decoder_get_info(const void * src, lv_img_header_t * header)
 
     lv_res_t res = LV_RES_INV;
     lv_img_decoder_t * d;
-    _LV_LL_READ(&LV_GC_ROOT(_lv_img_decoder_ll), d) {
+    for(d = decoder_get_next(NULL); d != NULL; d = decoder_get_next(d)) {
         if(d->info_cb) {
+            _lv_img_decoder_lock(d);
             res = d->info_cb(d, src, header);
+            _lv_img_decoder_unlock(d);
             if(res == LV_RES_OK) break;
         }
     }
@@ -136,15 +150,17 @@ lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t * dsc, const void * src, lv_co
     lv_res_t res = LV_RES_INV;
 
     lv_img_decoder_t * decoder;
-    _LV_LL_READ(&LV_GC_ROOT(_lv_img_decoder_ll), decoder) {
+    for(decoder = decoder_get_next(NULL); decoder != NULL; decoder = decoder_get_next(decoder)) {
         /*Info and Open callbacks are required*/
         if(decoder->info_cb == NULL || decoder->open_cb == NULL) continue;
 
+        _lv_img_decoder_lock(decoder);
         res = decoder->info_cb(decoder, src, &dsc->header);
-        if(res != LV_RES_OK) continue;
-
-        dsc->decoder = decoder;
-        res = decoder->open_cb(decoder, dsc);
+        if(res == LV_RES_OK) {
+            dsc->decoder = decoder;
+            res = decoder->open_cb(decoder, dsc);
+        }
+        _lv_img_decoder_unlock(decoder);
 
         /*Opened successfully. It is a good decoder to for this image source*/
         if(res == LV_RES_OK) return res;
@@ -176,7 +192,9 @@ lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t * dsc, const void * src, lv_co
 lv_res_t lv_img_decoder_read_line(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf)
 {
     lv_res_t res = LV_RES_INV;
+    _lv_img_decoder_lock(dsc->decoder);
     if(dsc->decoder->read_line_cb) res = dsc->decoder->read_line_cb(dsc->decoder, dsc, x, y, len, buf);
+    _lv_img_decoder_unlock(dsc->decoder);
 
     return res;
 }
@@ -188,7 +206,9 @@ lv_res_t lv_img_decoder_read_line(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_c
 void lv_img_decoder_close(lv_img_decoder_dsc_t * dsc)
 {
     if(dsc->decoder) {
+        _lv_img_decoder_lock(dsc->decoder);
         if(dsc->decoder->close_cb) dsc->decoder->close_cb(dsc->decoder, dsc);
+        _lv_img_decoder_unlock(dsc->decoder);
 
         if(dsc->src_type == LV_IMG_SRC_FILE) {
             lv_mem_free((void *)dsc->src);
@@ -197,6 +217,33 @@ void lv_img_decoder_close(lv_img_decoder_dsc_t * dsc)
     }
 }
 
+/**
+ * Lock a decoder to call its callbacks directly. Thread-safe decoders are not locked.
+ * The `lv_img_decoder_...` functions take this lock themselves, so the callbacks must not call them.
+ * @param decoder pointer to an image decoder
+ */
+void _lv_img_decoder_lock(lv_img_decoder_t * decoder)
+{
+#if LV_IMG_CACHE_ASYNC
+    if(!decoder->thread_safe) lv_mutex_lock(&decoder->mutex);
+#else
+    LV_UNUSED(decoder);
+#endif
+}
+
+/**
+ * Unlock a decoder locked by `_lv_img_decoder_lock`
+ * @param decoder pointer to an image decoder
+ */
+void _lv_img_decoder_unlock(lv_img_decoder_t * decoder)
+{
+#if LV_IMG_CACHE_ASYNC
+    if(!decoder->thread_safe) lv_mutex_unlock(&decoder->mutex);
+#else
+    LV_UNUSED(decoder);
+#endif
+}
+
 /**
  * Create a new image decoder
  * @return pointer to the new image decoder
@@ -204,11 +251,21 @@ void lv_img_decoder_close(lv_img_decoder_dsc_t * dsc)
 lv_img_decoder_t * lv_img_decoder_create(void)
 {
     lv_img_decoder_t * decoder;
+    /*Add it in one step as the decoding threads can find it right away*/
+#if LV_IMG_CACHE_ASYNC
+    lv_mutex_lock(&decoder_ll_mutex);
+#endif
     decoder = _lv_ll_ins_head(&LV_GC_ROOT(_lv_img_decoder_ll));
+    if(decoder != NULL) {
+        lv_memset_00(decoder, sizeof(lv_img_decoder_t));
+#if LV_IMG_CACHE_ASYNC
+        lv_mutex_init(&decoder->mutex);
+#endif
+    }
+#if LV_IMG_CACHE_ASYNC
+    lv_mutex_unlock(&decoder_ll_mutex);
+#endif
     LV_ASSERT_MALLOC(decoder);
-    if(decoder == NULL) return NULL;
-
-    lv_memset_00(decoder, sizeof(lv_img_decoder_t));
 
     return decoder;
 }
@@ -219,7 +276,14 @@ lv_img_decoder_t * lv_img_decoder_create(void)
  */
 void lv_img_decoder_delete(lv_img_decoder_t * decoder)
 {
+#if LV_IMG_CACHE_ASYNC
+    lv_mutex_lock(&decoder_ll_mutex);
+#endif
     _lv_ll_remove(&LV_GC_ROOT(_lv_img_decoder_ll), decoder);
+#if LV_IMG_CACHE_ASYNC
+    lv_mutex_unlock(&decoder_ll_mutex);
+    lv_mutex_delete(&decoder->mutex);
+#endif
     lv_mem_free(decoder);
 }
 
@@ -263,6 +327,17 @@ void lv_img_decoder_set_close_cb(lv_img_decoder_t * decoder, lv_img_decoder_clos
     decoder->close_cb = close_cb;
 }
 
+/**
+ * Tell that the callbacks of a decoder can be called from more threads at the same time.
+ * Otherwise the `lv_img_decoder_...` functions call them one by one.
+ * @param decoder pointer to an image decoder
+ * @param en true: the callbacks are thread-safe
+ */
+void lv_img_decoder_set_thread_safe(lv_img_decoder_t * decoder, bool en)
+{
+    decoder->thread_safe = en ? 1 : 0;
+}
+
 /**
  * Get info about a built-in image
  * @param decoder the decoder where this function belongs
@@ -430,6 +505,14 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
             cf == LV_IMG_CF_ALPHA_8BIT) {
         return LV_RES_OK; /*Nothing to process*/
     }
+    /*YUV images are converted line-by-line while drawing so only the visible pixels are converted*/
+    else if(cf == LV_IMG_CF_YUV_I420 || cf == LV_IMG_CF_YUV_NV12) {
+        if(dsc->src_type != LV_IMG_SRC_VARIABLE) {
+            LV_LOG_WARN("Image decoder open: YUV images are supported only from variables");
+            return LV_RES_INV;
+        }
+        return LV_RES_OK;
+    }
     /*Unknown format. Can't decode it.*/
     else {
         /*Free the potentially allocated memories*/
@@ -474,6 +557,9 @@ lv_res_t lv_img_decoder_built_in_read_line(lv_img_decoder_t * decoder, lv_img_de
             dsc->header.cf == LV_IMG_CF_INDEXED_4BIT || dsc->header.cf == LV_IMG_CF_INDEXED_8BIT) {
         res = lv_img_decoder_built_in_line_indexed(dsc, x, y, len, buf);
     }
+    else if(dsc->header.cf == LV_IMG_CF_YUV_I420 || dsc->header.cf == LV_IMG_CF_YUV_NV12) {
+        res = lv_img_decoder_built_in_line_yuv(dsc, x, y, len, buf);
+    }
     else {
         LV_LOG_WARN("Built-in image decoder read not supports the color format");
         return LV_RES_INV;
@@ -702,3 +788,85 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
     lv_mem_buf_release(fs_buf);
     return LV_RES_OK;
 }
+
+static lv_res_t lv_img_decoder_built_in_line_yuv(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y,
+                                                 lv_coord_t len, uint8_t * buf)
+{
+    const uint8_t * data = ((lv_img_dsc_t *)dsc->src)->data;
+    uint32_t w = dsc->header.w;
+    uint32_t h = dsc->header.h;
+    uint32_t uv_w = (w + 1) / 2;
+
+    const uint8_t * y_p = &data[(uint32_t)y * w + x];
+    const uint8_t * uv_plane = &data[w * h];
+    const uint8_t * u_p;
+    const uint8_t * v_p;
+    uint32_t uv_step;
+    if(dsc->header.cf == LV_IMG_CF_YUV_I420) {
+        u_p = &uv_plane[(y / 2) * uv_w + x / 2];
+        v_p = u_p + uv_w * ((h + 1) / 2);
+        uv_step = 1;
+    }
+    else {
+        u_p = &uv_plane[(y / 2) * uv_w * 2 + (x / 2) * 2];
+        v_p = u_p + 1;
+        uv_step = 2;
+    }
+
+    /*BT.601 limited range in 8 bit fixed point:
+     *R = 1.164(Y-16) + 1.596(V-128)
+     *G = 1.164(Y-16) - 0.391(U-128) - 0.813(V-128)
+     *B = 1.164(Y-16) + 2.018(U-128)*/
+    int32_t r_add = 0;
+    int32_t g_add = 0;
+    int32_t b_add = 0;
+    bool uv_load = true;
+    lv_color_t * cbuf = (lv_color_t *)buf;
+    lv_coord_t i;
+    for(i = 0; i < len; i++) {
+        /*The chroma of 2 neighboring pixels is the same*/
+        if(uv_load) {
+            int32_t u = *u_p - 128;
+            int32_t v = *v_p - 128;
+            r_add = 409 * v + 128;
+            g_add = -100 * u - 208 * v + 128;
+            b_add = 516 * u + 128;
+            uv_load = false;
+        }
+
+        int32_t luma = 298 * (*y_p - 16);
+        int32_t r = (luma + r_add) >> 8;
+        int32_t g = (luma + g_add) >> 8;
+        int32_t b = (luma + b_add) >> 8;
+        cbuf[i] = lv_color_make(LV_CLAMP(0, r, 255), LV_CLAMP(0, g, 255), LV_CLAMP(0, b, 255));
+        y_p++;
+
+        if((x + i) & 0x1) {
+            u_p += uv_step;
+            v_p += uv_step;
+            uv_load = true;
+        }
+    }
+
+    return LV_RES_OK;
+}
+
+/**
+ * Get the next decoder from the list of decoders
+ * @param decoder pointer to a decoder or NULL to get the first one
+ * @return the next decoder or NULL if there are no more decoders
+ */
+static lv_img_decoder_t * decoder_get_next(lv_img_decoder_t * decoder)
+{
+#if LV_IMG_CACHE_ASYNC
+    lv_mutex_lock(&decoder_ll_mutex);
+#endif
+    lv_img_decoder_t * next;
+    if(decoder == NULL) next = _lv_ll_get_head(&LV_GC_ROOT(_lv_img_decoder_ll));
+    else next = _lv_ll_get_next(&LV_GC_ROOT(_lv_img_decoder_ll), decoder);
+#if LV_IMG_CACHE_ASYNC
+    lv_mutex_unlock(&decoder_ll_mutex);
+#endif
+
+    return next;
+}
@@ -20,6 +20,7 @@ extern "C" {
 #include "../misc/lv_fs.h"
 #include "../misc/lv_types.h"
 #include "../misc/lv_area.h"
+#include "../misc/lv_thread.h"
 
 /*********************
  *      DEFINES
@@ -89,6 +90,11 @@ typedef struct _lv_img_decoder_t {
     lv_img_decoder_read_line_f_t read_line_cb;
     lv_img_decoder_close_f_t close_cb;
 
+    uint8_t thread_safe : 1;    /**< The callbacks can be called from more threads at the same time*/
+#if LV_IMG_CACHE_ASYNC
+    lv_mutex_t mutex;           /**< Serializes the callbacks if they are not thread-safe*/
+#endif
+
 #if LV_USE_USER_DATA
     void * user_data;
 #endif
@@ -185,6 +191,20 @@ lv_res_t lv_img_decoder_read_line(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_c
  */
 void lv_img_decoder_close(lv_img_decoder_dsc_t * dsc);
 
+/**
+ * Lock a decoder to call its callbacks directly. Thread-safe decoders are not locked.
+ * The `lv_img_decoder_...` functions take this lock themselves, so the callbacks must not call them.
+ * With `LV_IMG_CACHE_ASYNC` the decoding threads of the image cache use the decoders too. Without it, it does nothing.
+ * @param decoder pointer to an image decoder
+ */
+void _lv_img_decoder_lock(lv_img_decoder_t * decoder);
+
+/**
+ * Unlock a decoder locked by `_lv_img_decoder_lock`
+ * @param decoder pointer to an image decoder
+ */
+void _lv_img_decoder_unlock(lv_img_decoder_t * decoder);
+
 /**
  * Create a new image decoder
  * @return pointer to the new image decoder
@@ -225,6 +245,14 @@ void lv_img_decoder_set_read_line_cb(lv_img_decoder_t * decoder, lv_img_decoder_
  */
 void lv_img_decoder_set_close_cb(lv_img_decoder_t * decoder, lv_img_decoder_close_f_t close_cb);
 
+/**
+ * Tell that the callbacks of a decoder can be called from more threads at the same time.
+ * Otherwise the `lv_img_decoder_...` functions call them one by one.
+ * @param decoder pointer to an image decoder
+ * @param en true: the callbacks are thread-safe
+ */
+void lv_img_decoder_set_thread_safe(lv_img_decoder_t * decoder, bool en);
+
 /**
  * Get info about a built-in image
  * @param decoder the decoder where this function belongs
@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include "../lv_layouts.h"
+#include <string.h>
 
 #if LV_USE_FLEX
 
@@ -26,8 +27,47 @@ typedef struct {
     uint8_t rev : 1;
 } flex_t;
 
+/*The measurements of a child. The style properties are read again only if the child reported a style change*/
 typedef struct {
-    lv_obj_t * item;
+    lv_obj_t * obj;             /*The child whose measurements are stored*/
+    lv_point_t pos;             /*Position relative to the content area where the child was placed*/
+    lv_coord_t w;
+    lv_coord_t h;
+    lv_coord_t min_size;        /*Minimal size in the main direction*/
+    lv_coord_t max_size;        /*Maximal size in the main direction*/
+    lv_coord_t tr_x;            /*Translation from the style. Can be percentage too*/
+    lv_coord_t tr_y;
+    uint8_t grow;
+    uint8_t ignored : 1;        /*Hidden, floating or ignores the layout*/
+    uint8_t new_track : 1;
+} flex_item_t;
+
+/*Everything on the container which affects the placement of the children*/
+typedef struct {
+    lv_flex_flow_t flow;
+    lv_flex_align_t main_place;
+    lv_flex_align_t cross_place;
+    lv_flex_align_t track_place;
+    lv_coord_t item_gap;
+    lv_coord_t track_gap;
+    lv_coord_t max_main_size;
+    lv_coord_t max_cross_size;
+    lv_coord_t w_set;
+    lv_coord_t h_set;
+    uint32_t child_cnt;
+    uint8_t rtl : 1;
+    uint8_t w_layout : 1;
+    uint8_t h_layout : 1;
+} flex_sign_t;
+
+typedef struct {
+    lv_layout_cache_t head;
+    flex_sign_t sign;
+    flex_item_t * items;        /*Measurements of the children. Stored right after this struct*/
+} flex_cache_t;
+
+typedef struct {
+    flex_item_t * item;
     lv_coord_t min_size;
     lv_coord_t max_size;
     lv_coord_t final_size;
@@ -54,13 +94,14 @@ typedef struct {
  *  STATIC PROTOTYPES
  **********************/
 static void flex_update(lv_obj_t * cont, void * user_data);
-static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id, lv_coord_t item_gap,
-                              lv_coord_t max_main_size, track_t * t);
-static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, int32_t item_last_id, lv_coord_t abs_x,
-                           lv_coord_t abs_y, lv_coord_t max_main_size, lv_coord_t item_gap, track_t * t);
+static bool measure(lv_obj_t * cont, flex_t * f, flex_item_t * items, lv_coord_t abs_x, lv_coord_t abs_y, bool force);
+static int32_t find_track_end(lv_obj_t * cont, flex_t * f, flex_item_t * items, int32_t item_start_id,
+                              lv_coord_t max_main_size, lv_coord_t item_gap, track_t * t);
+static void children_repos(lv_obj_t * cont, flex_t * f, flex_item_t * items, int32_t item_first_id,
+                           int32_t item_last_id, lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t max_main_size, lv_coord_t item_gap,
+                           track_t * t);
 static void place_content(lv_flex_align_t place, lv_coord_t max_size, lv_coord_t content_size, lv_coord_t item_cnt,
                           lv_coord_t * start_pos, lv_coord_t * gap);
-static lv_obj_t * get_next_item(lv_obj_t * cont, bool rev, int32_t * item_id);
 
 /**********************
  *  GLOBAL VARIABLES
@@ -226,11 +267,14 @@ static void flex_update(lv_obj_t * cont, void * user_data)
     lv_coord_t item_gap = f.row ? lv_obj_get_style_pad_column(cont, LV_PART_MAIN) : lv_obj_get_style_pad_row(cont,
                                                                                                              LV_PART_MAIN);
     lv_coord_t max_main_size = (f.row ? lv_obj_get_content_width(cont) : lv_obj_get_content_height(cont));
+    lv_coord_t max_cross_size = (f.row ? lv_obj_get_content_height(cont) : lv_obj_get_content_width(cont));
     lv_coord_t border_width = lv_obj_get_style_border_width(cont, LV_PART_MAIN);
     lv_coord_t abs_y = cont->coords.y1 + lv_obj_get_style_pad_top(cont,
                                                                   LV_PART_MAIN) + border_width - lv_obj_get_scroll_y(cont);
     lv_coord_t abs_x = cont->coords.x1 + lv_obj_get_style_pad_left(cont,
                                                                    LV_PART_MAIN) + border_width - lv_obj_get_scroll_x(cont);
+    lv_coord_t content_x = abs_x;
+    lv_coord_t content_y = abs_y;
 
     lv_flex_align_t track_cross_place = f.track_place;
     lv_coord_t * cross_pos = (f.row ? &abs_y : &abs_x);
@@ -238,6 +282,46 @@ static void flex_update(lv_obj_t * cont, void * user_data)
     lv_coord_t w_set = lv_obj_get_style_width(cont, LV_PART_MAIN);
     lv_coord_t h_set = lv_obj_get_style_height(cont, LV_PART_MAIN);
 
+    /*Can't wrap if the size if auto (i.e. the size depends on the children)*/
+    if(f.wrap && ((f.row && w_set == LV_SIZE_CONTENT) || (!f.row && h_set == LV_SIZE_CONTENT))) {
+        f.wrap = false;
+    }
+
+    uint32_t child_cnt = cont->spec_attr->child_cnt;
+    flex_cache_t * cache = _lv_layout_get_cache(cont, LV_LAYOUT_FLEX,
+                                                sizeof(flex_cache_t) + child_cnt * sizeof(flex_item_t));
+    if(cache == NULL) return;
+    cache->items = (flex_item_t *)(cache + 1);
+
+    flex_sign_t sign;
+    lv_memset_00(&sign, sizeof(sign));
+    sign.flow = flow;
+    sign.main_place = f.main_place;
+    sign.cross_place = f.cross_place;
+    sign.track_place = f.track_place;
+    sign.item_gap = item_gap;
+    sign.track_gap = track_gap;
+    sign.max_main_size = max_main_size;
+    sign.max_cross_size = max_cross_size;
+    sign.w_set = w_set;
+    sign.h_set = h_set;
+    sign.child_cnt = child_cnt;
+    sign.rtl = rtl;
+    sign.w_layout = cont->w_layout;
+    sign.h_layout = cont->h_layout;
+
+    /*The min. and max. sizes are measured in the main direction so measure everything if the direction has changed*/
+    bool force = (sign.flow & _LV_FLEX_COLUMN) != (cache->sign.flow & _LV_FLEX_COLUMN);
+    bool changed = measure(cont, &f, cache->items, content_x, content_y, force);
+
+    /*Nothing to arrange if neither the children nor the container has changed*/
+    if(!changed && memcmp(&sign, &cache->sign, sizeof(flex_sign_t)) == 0) {
+        LV_TRACE_LAYOUT("nothing has changed");
+        return;
+    }
+    cache->sign = sign;
+    _lv_layout_get_stats()->arrange_cnt++;
+
     /*Content sized objects should squeezed the gap between the children, therefore any alignment will look like `START`*/
     if((f.row && h_set == LV_SIZE_CONTENT && cont->h_layout == 0) ||
        (!f.row && w_set == LV_SIZE_CONTENT && cont->w_layout == 0)) {
@@ -256,12 +340,12 @@ static void flex_update(lv_obj_t * cont, void * user_data)
     int32_t next_track_first_item;
 
     if(track_cross_place != LV_FLEX_ALIGN_START) {
-        track_first_item = f.rev ? cont->spec_attr->child_cnt - 1 : 0;
+        track_first_item = f.rev ? child_cnt - 1 : 0;
         track_t t;
-        while(track_first_item < (int32_t)cont->spec_attr->child_cnt && track_first_item >= 0) {
+        while(track_first_item < (int32_t)child_cnt && track_first_item >= 0) {
             /*Search the first item of the next row*/
             t.grow_dsc_calc = 0;
-            next_track_first_item = find_track_end(cont, &f, track_first_item, max_main_size, item_gap, &t);
+            next_track_first_item = find_track_end(cont, &f, cache->items, track_first_item, max_main_size, item_gap, &t);
             total_track_cross_size += t.track_cross_size + track_gap;
             track_cnt++;
             track_first_item = next_track_first_item;
@@ -270,29 +354,33 @@ static void flex_update(lv_obj_t * cont, void * user_data)
         if(track_cnt) total_track_cross_size -= track_gap;   /*No gap after the last track*/
 
         /*Place the tracks to get the start position*/
-        lv_coord_t max_cross_size = (f.row ? lv_obj_get_content_height(cont) : lv_obj_get_content_width(cont));
         place_content(track_cross_place, max_cross_size, total_track_cross_size, track_cnt, cross_pos, &gap);
     }
 
-    track_first_item =  f.rev ? cont->spec_attr->child_cnt - 1 : 0;
+    track_first_item =  f.rev ? child_cnt - 1 : 0;
 
     if(rtl && !f.row) {
         *cross_pos += total_track_cross_size;
     }
 
-    while(track_first_item < (int32_t)cont->spec_attr->child_cnt && track_first_item >= 0) {
+    /*A track can't have more grow items than children so allocate the descriptors only once*/
+    grow_dsc_t * grow_dsc = lv_mem_buf_get(sizeof(grow_dsc_t) * child_cnt);
+    LV_ASSERT_MALLOC(grow_dsc);
+    if(grow_dsc == NULL) return;
+
+    while(track_first_item < (int32_t)child_cnt && track_first_item >= 0) {
         track_t t;
         t.grow_dsc_calc = 1;
+        t.grow_dsc = grow_dsc;
         /*Search the first item of the next row*/
-        next_track_first_item = find_track_end(cont, &f, track_first_item, max_main_size, item_gap, &t);
+        next_track_first_item = find_track_end(cont, &f, cache->items, track_first_item, max_main_size, item_gap, &t);
 
         if(rtl && !f.row) {
             *cross_pos -= t.track_cross_size;
         }
-        children_repos(cont, &f, track_first_item, next_track_first_item, abs_x, abs_y, max_main_size, item_gap, &t);
+        children_repos(cont, &f, cache->items, track_first_item, next_track_first_item, abs_x, abs_y, max_main_size,
+                       item_gap, &t);
         track_first_item = next_track_first_item;
-        lv_mem_buf_release(t.grow_dsc);
-        t.grow_dsc = NULL;
         if(rtl && !f.row) {
             *cross_pos -= gap + track_gap;
         }
@@ -300,8 +388,25 @@ static void flex_update(lv_obj_t * cont, void * user_data)
             *cross_pos += t.track_cross_size + gap + track_gap;
         }
     }
+    lv_mem_buf_release(grow_dsc);
     LV_ASSERT_MEM_INTEGRITY();
 
+    /*Save where the children were placed to notice if they are moved by something else.
+     *The event handlers might have deleted some children so check them again.*/
+    uint32_t i;
+    for(i = 0; i < child_cnt && i < cont->spec_attr->child_cnt; i++) {
+        flex_item_t * item = &cache->items[i];
+        lv_obj_t * child = cont->spec_attr->children[i];
+        if(item->obj != child) {
+            item->obj = NULL;
+            continue;
+        }
+        item->pos.x = child->coords.x1 - content_x;
+        item->pos.y = child->coords.y1 - content_y;
+        item->w = lv_area_get_width(&child->coords);
+        item->h = lv_area_get_height(&child->coords);
+    }
+
     if(w_set == LV_SIZE_CONTENT || h_set == LV_SIZE_CONTENT) {
         lv_obj_refr_size(cont);
     }
@@ -312,72 +417,111 @@ static void flex_update(lv_obj_t * cont, void * user_data)
 }
 
 /**
- * Find the last item of a track
+ * Update the measurements of the children.
+ * The style properties are read only for the new children and for the ones whose style has changed.
+ * @return true: something has changed since the last arrangement
  */
-static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id, lv_coord_t max_main_size,
-                              lv_coord_t item_gap, track_t * t)
+static bool measure(lv_obj_t * cont, flex_t * f, flex_item_t * items, lv_coord_t abs_x, lv_coord_t abs_y, bool force)
 {
-    lv_coord_t w_set = lv_obj_get_style_width(cont, LV_PART_MAIN);
-    lv_coord_t h_set = lv_obj_get_style_height(cont, LV_PART_MAIN);
+    lv_layout_stats_t * stats = _lv_layout_get_stats();
+    bool changed = false;
+    uint32_t i;
+    for(i = 0; i < cont->spec_attr->child_cnt; i++) {
+        lv_obj_t * child = cont->spec_attr->children[i];
+        flex_item_t * item = &items[i];
+
+        bool ignored = lv_obj_has_flag_any(child, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING);
+        bool new_track = lv_obj_has_flag(child, LV_OBJ_FLAG_FLEX_IN_NEW_TRACK);
+        lv_coord_t w = lv_area_get_width(&child->coords);
+        lv_coord_t h = lv_area_get_height(&child->coords);
+
+        if(item->obj != child || item->ignored != ignored || item->new_track != new_track ||
+           item->w != w || item->h != h) {
+            changed = true;
+        }
+        else if(!ignored && (item->pos.x != child->coords.x1 - abs_x || item->pos.y != child->coords.y1 - abs_y)) {
+            changed = true;
+        }
 
-    /*Can't wrap if the size if auto (i.e. the size depends on the children)*/
-    if(f->wrap && ((f->row && w_set == LV_SIZE_CONTENT) || (!f->row && h_set == LV_SIZE_CONTENT))) {
-        f->wrap = false;
+        if(item->obj != child || child->measure_inv || force) {
+            flex_item_t old = *item;
+            item->obj = child;
+            item->grow = lv_obj_get_style_flex_grow(child, LV_PART_MAIN);
+            if(item->grow) {
+                item->min_size = f->row ? lv_obj_get_style_min_width(child, LV_PART_MAIN) : lv_obj_get_style_min_height(child,
+                                                                                                                         LV_PART_MAIN);
+                item->max_size = f->row ? lv_obj_get_style_max_width(child, LV_PART_MAIN) : lv_obj_get_style_max_height(child,
+                                                                                                                         LV_PART_MAIN);
+            }
+            else {
+                item->min_size = 0;
+                item->max_size = 0;
+            }
+            item->tr_x = lv_obj_get_style_translate_x(child, LV_PART_MAIN);
+            item->tr_y = lv_obj_get_style_translate_y(child, LV_PART_MAIN);
+            child->measure_inv = 0;
+            stats->measure_cnt++;
+
+            if(old.grow != item->grow || old.min_size != item->min_size || old.max_size != item->max_size ||
+               old.tr_x != item->tr_x || old.tr_y != item->tr_y) {
+                changed = true;
+            }
+        }
+
+        item->ignored = ignored;
+        item->new_track = new_track;
+        item->w = w;
+        item->h = h;
     }
-    lv_coord_t(*get_main_size)(const lv_obj_t *) = (f->row ? lv_obj_get_width : lv_obj_get_height);
-    lv_coord_t(*get_cross_size)(const lv_obj_t *) = (!f->row ? lv_obj_get_width : lv_obj_get_height);
+
+    return changed;
+}
+
+/**
+ * Find the last item of a track
+ */
+static int32_t find_track_end(lv_obj_t * cont, flex_t * f, flex_item_t * items, int32_t item_start_id,
+                              lv_coord_t max_main_size, lv_coord_t item_gap, track_t * t)
+{
+    int32_t child_cnt = (int32_t)cont->spec_attr->child_cnt;
 
     t->track_main_size = 0;
     t->track_fix_main_size = 0;
     t->grow_item_cnt = 0;
     t->track_cross_size = 0;
     t->item_cnt = 0;
-    t->grow_dsc = NULL;
 
     int32_t item_id = item_start_id;
 
-    lv_obj_t * item = lv_obj_get_child(cont, item_id);
-    while(item) {
-        if(item_id != item_start_id && lv_obj_has_flag(item, LV_OBJ_FLAG_FLEX_IN_NEW_TRACK)) break;
+    while(item_id >= 0 && item_id < child_cnt) {
+        flex_item_t * item = &items[item_id];
+        if(item_id != item_start_id && item->new_track) break;
 
-        if(!lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) {
-            uint8_t grow_value = lv_obj_get_style_flex_grow(item, LV_PART_MAIN);
-            if(grow_value) {
-                t->grow_item_cnt++;
-                t->track_fix_main_size += item_gap;
+        if(!item->ignored) {
+            lv_coord_t main_size = f->row ? item->w : item->h;
+            lv_coord_t cross_size = f->row ? item->h : item->w;
+            if(item->grow) {
                 if(t->grow_dsc_calc) {
-                    grow_dsc_t * new_dsc = lv_mem_buf_get(sizeof(grow_dsc_t) * (t->grow_item_cnt));
-                    LV_ASSERT_MALLOC(new_dsc);
-                    if(new_dsc == NULL) return item_id;
-
-                    if(t->grow_dsc) {
-                        lv_memcpy(new_dsc, t->grow_dsc, sizeof(grow_dsc_t) * (t->grow_item_cnt - 1));
-                        lv_mem_buf_release(t->grow_dsc);
-                    }
-                    new_dsc[t->grow_item_cnt - 1].item = item;
-                    new_dsc[t->grow_item_cnt - 1].min_size = f->row ? lv_obj_get_style_min_width(item,
-                                                                                                 LV_PART_MAIN) : lv_obj_get_style_min_height(item, LV_PART_MAIN);
-                    new_dsc[t->grow_item_cnt - 1].max_size = f->row ? lv_obj_get_style_max_width(item,
-                                                                                                 LV_PART_MAIN) : lv_obj_get_style_max_height(item, LV_PART_MAIN);
-                    new_dsc[t->grow_item_cnt - 1].grow_value = grow_value;
-                    new_dsc[t->grow_item_cnt - 1].clamped = 0;
-                    t->grow_dsc = new_dsc;
+                    grow_dsc_t * dsc = &t->grow_dsc[t->grow_item_cnt];
+                    dsc->item = item;
+                    dsc->min_size = item->min_size;
+                    dsc->max_size = item->max_size;
+                    dsc->grow_value = item->grow;
+                    dsc->clamped = 0;
                 }
+                t->grow_item_cnt++;
+                t->track_fix_main_size += item_gap;
             }
             else {
-                lv_coord_t item_size = get_main_size(item);
-                if(f->wrap && t->track_fix_main_size + item_size > max_main_size) break;
-                t->track_fix_main_size += item_size + item_gap;
+                if(f->wrap && t->track_fix_main_size + main_size > max_main_size) break;
+                t->track_fix_main_size += main_size + item_gap;
             }
 
-
-            t->track_cross_size = LV_MAX(get_cross_size(item), t->track_cross_size);
+            t->track_cross_size = LV_MAX(cross_size, t->track_cross_size);
             t->item_cnt++;
         }
 
         item_id += f->rev ? -1 : +1;
-        if(item_id < 0) break;
-        item = lv_obj_get_child(cont, item_id);
     }
 
     if(t->track_fix_main_size > 0) t->track_fix_main_size -= item_gap; /*There is no gap after the last item*/
@@ -386,14 +530,12 @@ static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id
     t->track_main_size = t->grow_item_cnt ? max_main_size : t->track_fix_main_size;
 
     /*Have at least one item in a row*/
-    if(item && item_id == item_start_id) {
-        item = cont->spec_attr->children[item_id];
-        get_next_item(cont, f->rev, &item_id);
-        if(item) {
-            t->track_cross_size = get_cross_size(item);
-            t->track_main_size = get_main_size(item);
-            t->item_cnt = 1;
-        }
+    if(item_id >= 0 && item_id < child_cnt && item_id == item_start_id) {
+        flex_item_t * item = &items[item_id];
+        item_id += f->rev ? -1 : +1;
+        t->track_cross_size = f->row ? item->h : item->w;
+        t->track_main_size = f->row ? item->w : item->h;
+        t->item_cnt = 1;
     }
 
     return item_id;
@@ -402,8 +544,9 @@ static int32_t find_track_end(lv_obj_t * cont, flex_t * f, int32_t item_start_id
 /**
  * Position the children in the same track
  */
-static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, int32_t item_last_id, lv_coord_t abs_x,
-                           lv_coord_t abs_y, lv_coord_t max_main_size, lv_coord_t item_gap, track_t * t)
+static void children_repos(lv_obj_t * cont, flex_t * f, flex_item_t * items, int32_t item_first_id,
+                           int32_t item_last_id, lv_coord_t abs_x, lv_coord_t abs_y, lv_coord_t max_main_size, lv_coord_t item_gap,
+                           track_t * t)
 {
     void (*area_set_main_size)(lv_area_t *, lv_coord_t) = (f->row ? lv_area_set_width : lv_area_set_height);
     lv_coord_t (*area_get_main_size)(const lv_area_t *) = (f->row ? lv_area_get_width : lv_area_get_height);
@@ -452,21 +595,22 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
     place_content(f->main_place, max_main_size, t->track_main_size, t->item_cnt, &main_pos, &place_gap);
     if(f->row && rtl) main_pos += lv_obj_get_content_width(cont);
 
-    lv_obj_t * item = lv_obj_get_child(cont, item_first_id);
+    /*The grow items are in the same order as the children*/
+    grow_dsc_t * grow_dsc = t->grow_dsc;
+
     /*Reposition the children*/
-    while(item && item_first_id != item_last_id) {
-        if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) {
-            item = get_next_item(cont, f->rev, &item_first_id);
-            continue;
-        }
-        lv_coord_t grow_size = lv_obj_get_style_flex_grow(item, LV_PART_MAIN);
-        if(grow_size) {
+    while(item_first_id != item_last_id) {
+        flex_item_t * fi = &items[item_first_id];
+        lv_obj_t * item = fi->obj;
+        item_first_id += f->rev ? -1 : +1;
+
+        if(fi->ignored) continue;
+
+        if(fi->grow) {
             lv_coord_t s = 0;
-            for(i = 0; i < t->grow_item_cnt; i++) {
-                if(t->grow_dsc[i].item == item) {
-                    s = t->grow_dsc[i].final_size;
-                    break;
-                }
+            if(grow_dsc < t->grow_dsc + t->grow_item_cnt && grow_dsc->item == fi) {
+                s = grow_dsc->final_size;
+                grow_dsc++;
             }
 
             if(f->row) item->w_layout = 1;
@@ -506,8 +650,8 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
 
 
         /*Handle percentage value of translate*/
-        lv_coord_t tr_x = lv_obj_get_style_translate_x(item, LV_PART_MAIN);
-        lv_coord_t tr_y = lv_obj_get_style_translate_y(item, LV_PART_MAIN);
+        lv_coord_t tr_x = fi->tr_x;
+        lv_coord_t tr_y = fi->tr_y;
         lv_coord_t w = lv_obj_get_width(item);
         lv_coord_t h = lv_obj_get_height(item);
         if(LV_COORD_IS_PCT(tr_x)) tr_x = (w * LV_COORD_GET_PCT(tr_x)) / 100;
@@ -530,8 +674,6 @@ static void children_repos(lv_obj_t * cont, flex_t * f, int32_t item_first_id, i
 
         if(!(f->row && rtl)) main_pos += area_get_main_size(&item->coords) + item_gap + place_gap;
         else main_pos -= item_gap + place_gap;
-
-        item = get_next_item(cont, f->rev, &item_first_id);
     }
 }
 
@@ -578,18 +720,4 @@ static void place_content(lv_flex_align_t place, lv_coord_t max_size, lv_coord_t
     }
 }
 
-static lv_obj_t * get_next_item(lv_obj_t * cont, bool rev, int32_t * item_id)
-{
-    if(rev) {
-        (*item_id)--;
-        if(*item_id >= 0) return cont->spec_attr->children[*item_id];
-        else return NULL;
-    }
-    else {
-        (*item_id)++;
-        if((*item_id) < (int32_t)cont->spec_attr->child_cnt) return cont->spec_attr->children[*item_id];
-        else return NULL;
-    }
-}
-
 #endif /*LV_USE_FLEX*/
@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include "../lv_layouts.h"
+#include <string.h>
 
 #if LV_USE_GRID
 
@@ -29,6 +30,33 @@ typedef struct {
     lv_point_t grid_abs;
 } item_repos_hint_t;
 
+/*The measurements of a child. The style properties are read again only if the child reported a style change*/
+typedef struct {
+    lv_obj_t * obj;             /*The child whose measurements are stored*/
+    lv_point_t pos;             /*Position relative to the content area where the child was placed*/
+    lv_coord_t w;
+    lv_coord_t h;
+    lv_coord_t tr_x;            /*Translation from the style. Can be percentage too*/
+    lv_coord_t tr_y;
+    uint8_t col_pos;
+    uint8_t col_span;
+    uint8_t row_pos;
+    uint8_t row_span;
+    uint8_t col_align : 3;
+    uint8_t row_align : 3;
+    uint8_t rtl : 1;
+    uint8_t ignored : 1;        /*Hidden, floating or ignores the layout*/
+} grid_item_t;
+
+typedef struct {
+    lv_layout_cache_t head;
+    uint32_t child_cnt;
+    uint32_t col_num;
+    uint32_t row_num;
+    grid_item_t * items;        /*Measurements of the children. Stored right after this struct*/
+    lv_coord_t * tracks;        /*x, w of the columns and y, h of the rows of the last arrangement. Stored after the items*/
+} grid_cache_t;
+
 typedef struct {
     lv_coord_t * x;
     lv_coord_t * y;
@@ -49,11 +77,13 @@ typedef struct {
  *  STATIC PROTOTYPES
  **********************/
 static void grid_update(lv_obj_t * cont, void * user_data);
-static void calc(lv_obj_t * obj, _lv_grid_calc_t * calc);
+static bool measure(lv_obj_t * cont, grid_item_t * items, lv_coord_t abs_x, lv_coord_t abs_y);
+static bool tracks_changed(grid_cache_t * cache, _lv_grid_calc_t * c, uint32_t child_cnt);
+static void calc(lv_obj_t * obj, grid_item_t * items, _lv_grid_calc_t * calc);
 static void calc_free(_lv_grid_calc_t * calc);
-static void calc_cols(lv_obj_t * cont, _lv_grid_calc_t * c);
-static void calc_rows(lv_obj_t * cont, _lv_grid_calc_t * c);
-static void item_repos(lv_obj_t * item, _lv_grid_calc_t * c, item_repos_hint_t * hint);
+static void calc_cols(lv_obj_t * cont, grid_item_t * items, _lv_grid_calc_t * c);
+static void calc_rows(lv_obj_t * cont, grid_item_t * items, _lv_grid_calc_t * c);
+static void item_repos(grid_item_t * item, _lv_grid_calc_t * c, item_repos_hint_t * hint);
 static lv_coord_t grid_align(lv_coord_t cont_size,  bool auto_size, uint8_t align, lv_coord_t gap, uint32_t track_num,
                              lv_coord_t * size_array, lv_coord_t * pos_array, bool reverse);
 static uint32_t count_tracks(const lv_coord_t * templ);
@@ -350,9 +380,6 @@ static void grid_update(lv_obj_t * cont, void * user_data)
     const lv_coord_t * row_templ = get_row_dsc(cont);
     if(col_templ == NULL || row_templ == NULL) return;
 
-    _lv_grid_calc_t c;
-    calc(cont, &c);
-
     item_repos_hint_t hint;
     lv_memset_00(&hint, sizeof(hint));
 
@@ -364,13 +391,51 @@ static void grid_update(lv_obj_t * cont, void * user_data)
     hint.grid_abs.x = pad_left + cont->coords.x1 - lv_obj_get_scroll_x(cont);
     hint.grid_abs.y = pad_top + cont->coords.y1 - lv_obj_get_scroll_y(cont);
 
+    uint32_t child_cnt = cont->spec_attr->child_cnt;
+    uint32_t col_num = count_tracks(col_templ);
+    uint32_t row_num = count_tracks(row_templ);
+    uint32_t items_size = child_cnt * sizeof(grid_item_t);
+    uint32_t tracks_size = 2 * (col_num + row_num) * sizeof(lv_coord_t);
+    grid_cache_t * cache = _lv_layout_get_cache(cont, LV_LAYOUT_GRID, sizeof(grid_cache_t) + items_size + tracks_size);
+    if(cache == NULL) return;
+    cache->items = (grid_item_t *)(cache + 1);
+    cache->tracks = (lv_coord_t *)((uint8_t *)cache->items + items_size);
+
+    bool changed = measure(cont, cache->items, hint.grid_abs.x, hint.grid_abs.y);
+
+    _lv_grid_calc_t c;
+    calc(cont, cache->items, &c);
+
+    /*If the tracks are the same and the children haven't changed, the children are already in place*/
+    if(tracks_changed(cache, &c, child_cnt)) changed = true;
+    if(!changed) {
+        calc_free(&c);
+        LV_TRACE_LAYOUT("nothing has changed");
+        return;
+    }
+    _lv_layout_get_stats()->arrange_cnt++;
+
     uint32_t i;
-    for(i = 0; i < cont->spec_attr->child_cnt; i++) {
-        lv_obj_t * item = cont->spec_attr->children[i];
-        item_repos(item, &c, &hint);
+    for(i = 0; i < child_cnt; i++) {
+        item_repos(&cache->items[i], &c, &hint);
     }
     calc_free(&c);
 
+    /*Save where the children were placed to notice if they are moved by something else.
+     *The event handlers might have deleted some children so check them again.*/
+    for(i = 0; i < child_cnt && i < cont->spec_attr->child_cnt; i++) {
+        grid_item_t * item = &cache->items[i];
+        lv_obj_t * child = cont->spec_attr->children[i];
+        if(item->obj != child) {
+            item->obj = NULL;
+            continue;
+        }
+        item->pos.x = child->coords.x1 - hint.grid_abs.x;
+        item->pos.y = child->coords.y1 - hint.grid_abs.y;
+        item->w = lv_area_get_width(&child->coords);
+        item->h = lv_area_get_height(&child->coords);
+    }
+
     lv_coord_t w_set = lv_obj_get_style_width(cont, LV_PART_MAIN);
     lv_coord_t h_set = lv_obj_get_style_height(cont, LV_PART_MAIN);
     if(w_set == LV_SIZE_CONTENT || h_set == LV_SIZE_CONTENT) {
@@ -382,21 +447,117 @@ static void grid_update(lv_obj_t * cont, void * user_data)
     LV_TRACE_LAYOUT("finished");
 }
 
+/**
+ * Update the measurements of the children.
+ * The style properties are read only for the new children and for the ones whose style has changed.
+ * @return true: something has changed since the last arrangement
+ */
+static bool measure(lv_obj_t * cont, grid_item_t * items, lv_coord_t abs_x, lv_coord_t abs_y)
+{
+    lv_layout_stats_t * stats = _lv_layout_get_stats();
+    bool changed = false;
+    uint32_t i;
+    for(i = 0; i < cont->spec_attr->child_cnt; i++) {
+        lv_obj_t * child = cont->spec_attr->children[i];
+        grid_item_t * item = &items[i];
+
+        bool ignored = lv_obj_has_flag_any(child, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING);
+        lv_coord_t w = lv_area_get_width(&child->coords);
+        lv_coord_t h = lv_area_get_height(&child->coords);
+
+        if(item->obj != child || item->ignored != ignored || item->w != w || item->h != h) {
+            changed = true;
+        }
+        else if(!ignored && (item->pos.x != child->coords.x1 - abs_x || item->pos.y != child->coords.y1 - abs_y)) {
+            changed = true;
+        }
+
+        if(item->obj != child || child->measure_inv) {
+            grid_item_t old = *item;
+            item->obj = child;
+            item->col_pos = get_col_pos(child);
+            item->col_span = get_col_span(child);
+            item->row_pos = get_row_pos(child);
+            item->row_span = get_row_span(child);
+            item->col_align = get_cell_col_align(child);
+            item->row_align = get_cell_row_align(child);
+            item->rtl = lv_obj_get_style_base_dir(child, LV_PART_MAIN) == LV_BASE_DIR_RTL ? 1 : 0;
+            item->tr_x = lv_obj_get_style_translate_x(child, LV_PART_MAIN);
+            item->tr_y = lv_obj_get_style_translate_y(child, LV_PART_MAIN);
+            child->measure_inv = 0;
+            stats->measure_cnt++;
+
+            if(old.col_pos != item->col_pos || old.col_span != item->col_span ||
+               old.row_pos != item->row_pos || old.row_span != item->row_span ||
+               old.col_align != item->col_align || old.row_align != item->row_align ||
+               old.rtl != item->rtl || old.tr_x != item->tr_x || old.tr_y != item->tr_y) {
+                changed = true;
+            }
+        }
+
+        item->ignored = ignored;
+        item->w = w;
+        item->h = h;
+    }
+
+    return changed;
+}
+
+/**
+ * Compare the calculated tracks with the tracks of the last arrangement and save the new ones.
+ * @return true: the tracks or the number of children are different
+ */
+static bool tracks_changed(grid_cache_t * cache, _lv_grid_calc_t * c, uint32_t child_cnt)
+{
+    bool changed = false;
+    if(cache->child_cnt != child_cnt || cache->col_num != c->col_num || cache->row_num != c->row_num) {
+        changed = true;
+    }
+
+    lv_coord_t * x = cache->tracks;
+    lv_coord_t * w = x + c->col_num;
+    lv_coord_t * y = w + c->col_num;
+    lv_coord_t * h = y + c->row_num;
+    uint32_t col_size = c->col_num * sizeof(lv_coord_t);
+    uint32_t row_size = c->row_num * sizeof(lv_coord_t);
+    if(!changed && c->col_num && c->row_num) {
+        if(memcmp(x, c->x, col_size) || memcmp(w, c->w, col_size) ||
+           memcmp(y, c->y, row_size) || memcmp(h, c->h, row_size)) {
+            changed = true;
+        }
+    }
+
+    if(changed) {
+        cache->child_cnt = child_cnt;
+        cache->col_num = c->col_num;
+        cache->row_num = c->row_num;
+        if(c->col_num && c->row_num) {
+            lv_memcpy(x, c->x, col_size);
+            lv_memcpy(w, c->w, col_size);
+            lv_memcpy(y, c->y, row_size);
+            lv_memcpy(h, c->h, row_size);
+        }
+    }
+
+    return changed;
+}
+
 /**
  * Calculate the grid cells coordinates
  * @param cont an object that has a grid
+ * @param items the measurements of the children
  * @param calc store the calculated cells sizes here
  * @note `_lv_grid_calc_free(calc_out)` needs to be called when `calc_out` is not needed anymore
  */
-static void calc(lv_obj_t * cont, _lv_grid_calc_t * calc_out)
+static void calc(lv_obj_t * cont, grid_item_t * items, _lv_grid_calc_t * calc_out)
 {
     if(lv_obj_get_child(cont, 0) == NULL) {
         lv_memset_00(calc_out, sizeof(_lv_grid_calc_t));
         return;
     }
 
-    calc_rows(cont, calc_out);
-    calc_cols(cont, calc_out);
+    calc_rows(cont, items, calc_out);
+    calc_cols(cont, items, calc_out);
 
     lv_coord_t col_gap = lv_obj_get_style_pad_column(cont, LV_PART_MAIN);
     lv_coord_t row_gap = lv_obj_get_style_pad_row(cont, LV_PART_MAIN);
@@ -430,7 +591,7 @@ static void calc_free(_lv_grid_calc_t * calc)
     lv_mem_buf_release(calc->h);
 }
 
-static void calc_cols(lv_obj_t * cont, _lv_grid_calc_t * c)
+static void calc_cols(lv_obj_t * cont, grid_item_t * items, _lv_grid_calc_t * c)
 {
     const lv_coord_t * col_templ = get_col_dsc(cont);
     lv_coord_t cont_w = lv_obj_get_content_width(cont);
@@ -439,27 +600,16 @@ static void calc_cols(lv_obj_t * cont, _lv_grid_calc_t * c)
     c->x = lv_mem_buf_get(sizeof(lv_coord_t) * c->col_num);
     c->w = lv_mem_buf_get(sizeof(lv_coord_t) * c->col_num);
 
-    /*Set sizes for CONTENT cells*/
+    /*Set sizes for CONTENT cells from the children with single span in them*/
     uint32_t i;
     for(i = 0; i < c->col_num; i++) {
-        lv_coord_t size = LV_COORD_MIN;
-        if(IS_CONTENT(col_templ[i])) {
-            /*Check the size of children of this cell*/
-            uint32_t ci;
-            for(ci = 0; ci < lv_obj_get_child_cnt(cont); ci++) {
-                lv_obj_t * item = lv_obj_get_child(cont, ci);
-                if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
-                uint32_t col_span = get_col_span(item);
-                if(col_span != 1) continue;
-
-                uint32_t col_pos = get_col_pos(item);
-                if(col_pos != i) continue;
-
-                size = LV_MAX(size, lv_obj_get_width(item));
-            }
-            if(size >= 0) c->w[i] = size;
-            else c->w[i] = 0;
-        }
+        c->w[i] = 0;
+    }
+    for(i = 0; i < cont->spec_attr->child_cnt; i++) {
+        grid_item_t * item = &items[i];
+        if(item->ignored || item->col_span != 1) continue;
+        if(item->col_pos >= c->col_num || !IS_CONTENT(col_templ[item->col_pos])) continue;
+        c->w[item->col_pos] = LV_MAX(c->w[item->col_pos], item->w);
     }
 
     uint32_t col_fr_cnt = 0;
@@ -502,33 +652,22 @@ static void calc_cols(lv_obj_t * cont, _lv_grid_calc_t * c)
     }
 }
 
-static void calc_rows(lv_obj_t * cont, _lv_grid_calc_t * c)
+static void calc_rows(lv_obj_t * cont, grid_item_t * items, _lv_grid_calc_t * c)
 {
     uint32_t i;
     const lv_coord_t * row_templ = get_row_dsc(cont);
     c->row_num = count_tracks(row_templ);
     c->y = lv_mem_buf_get(sizeof(lv_coord_t) * c->row_num);
     c->h = lv_mem_buf_get(sizeof(lv_coord_t) * c->row_num);
-    /*Set sizes for CONTENT cells*/
+    /*Set sizes for CONTENT cells from the children with single span in them*/
     for(i = 0; i < c->row_num; i++) {
-        lv_coord_t size = LV_COORD_MIN;
-        if(IS_CONTENT(row_templ[i])) {
-            /*Check the size of children of this cell*/
-            uint32_t ci;
-            for(ci = 0; ci < lv_obj_get_child_cnt(cont); ci++) {
-                lv_obj_t * item = lv_obj_get_child(cont, ci);
-                if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) continue;
-                uint32_t row_span = get_row_span(item);
-                if(row_span != 1) continue;
-
-                uint32_t row_pos = get_row_pos(item);
-                if(row_pos != i) continue;
-
-                size = LV_MAX(size, lv_obj_get_height(item));
-            }
-            if(size >= 0) c->h[i] = size;
-            else c->h[i] = 0;
-        }
+        c->h[i] = 0;
+    }
+    for(i = 0; i < cont->spec_attr->child_cnt; i++) {
+        grid_item_t * item = &items[i];
+        if(item->ignored || item->row_span != 1) continue;
+        if(item->row_pos >= c->row_num || !IS_CONTENT(row_templ[item->row_pos])) continue;
+        c->h[item->row_pos] = LV_MAX(c->h[item->row_pos], item->h);
     }
 
     uint32_t row_fr_cnt = 0;
@@ -572,22 +711,23 @@ static void calc_rows(lv_obj_t * cont, _lv_grid_calc_t * c)
 
 /**
  * Reposition a grid item in its cell
- * @param item a grid item to reposition
+ * @param gi the measurements of the grid item to reposition
  * @param calc the calculated grid of `cont`
  * @param child_id_ext helper value if the ID of the child is know (order from the oldest) else -1
  * @param grid_abs helper value, the absolute position of the grid, NULL if unknown
  */
-static void item_repos(lv_obj_t * item, _lv_grid_calc_t * c, item_repos_hint_t * hint)
+static void item_repos(grid_item_t * gi, _lv_grid_calc_t * c, item_repos_hint_t * hint)
 {
-    if(lv_obj_has_flag_any(item, LV_OBJ_FLAG_IGNORE_LAYOUT | LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_FLOATING)) return;
-    uint32_t col_span = get_col_span(item);
-    uint32_t row_span = get_row_span(item);
+    if(gi->ignored) return;
+    uint32_t col_span = gi->col_span;
+    uint32_t row_span = gi->row_span;
     if(row_span == 0 || col_span == 0) return;
 
-    uint32_t col_pos = get_col_pos(item);
-    uint32_t row_pos = get_row_pos(item);
-    lv_grid_align_t col_align = get_cell_col_align(item);
-    lv_grid_align_t row_align = get_cell_row_align(item);
+    lv_obj_t * item = gi->obj;
+    uint32_t col_pos = gi->col_pos;
+    uint32_t row_pos = gi->row_pos;
+    lv_grid_align_t col_align = gi->col_align;
+    lv_grid_align_t row_align = gi->row_align;
 
 
     lv_coord_t col_x1 = c->x[col_pos];
@@ -600,7 +740,7 @@ static void item_repos(lv_obj_t * item, _lv_grid_calc_t * c, item_repos_hint_t *
 
 
     /*If the item has RTL base dir switch start and end*/
-    if(lv_obj_get_style_base_dir(item, LV_PART_MAIN) == LV_BASE_DIR_RTL) {
+    if(gi->rtl) {
         if(col_align == LV_GRID_ALIGN_START) col_align = LV_GRID_ALIGN_END;
         else if(col_align == LV_GRID_ALIGN_END) col_align = LV_GRID_ALIGN_START;
     }
@@ -666,8 +806,8 @@ static void item_repos(lv_obj_t * item, _lv_grid_calc_t * c, item_repos_hint_t *
     }
 
     /*Handle percentage value of translate*/
-    lv_coord_t tr_x = lv_obj_get_style_translate_x(item, LV_PART_MAIN);
-    lv_coord_t tr_y = lv_obj_get_style_translate_y(item, LV_PART_MAIN);
+    lv_coord_t tr_x = gi->tr_x;
+    lv_coord_t tr_y = gi->tr_y;
     lv_coord_t w = lv_obj_get_width(item);
     lv_coord_t h = lv_obj_get_height(item);
     if(LV_COORD_IS_PCT(tr_x)) tr_x = (w * LV_COORD_GET_PCT(tr_x)) / 100;
@@ -16,6 +16,10 @@
 #include <libavutil/timestamp.h>
 #include <libswscale/swscale.h>
 
+#if LV_FFMPEG_PLAYER_USE_THREAD
+    #include "../../../misc/lv_thread.h"
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -33,10 +37,24 @@
     #error Unsupported  LV_COLOR_DEPTH
 #endif
 
+#if LV_FFMPEG_PLAYER_USE_THREAD
+    #if LV_USE_PTHREAD == 0
+        #error "LV_FFMPEG_PLAYER_USE_THREAD requires LV_USE_PTHREAD"
+    #endif
+    #if LV_FFMPEG_PLAYER_FRAME_CNT < 2
+        #error "LV_FFMPEG_PLAYER_FRAME_CNT has to be at least 2"
+    #endif
+#endif
+
 #define MY_CLASS &lv_ffmpeg_player_class
 
 #define FRAME_DEF_REFR_PERIOD   33  /*[ms]*/
 
+/* Max. number of frames dropped in a row when the playback is late.
+ * After that a frame is shown anyway to keep the image moving.
+ */
+#define FRAME_DROP_MAX          8
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -54,6 +72,42 @@ struct ffmpeg_context_s {
     int video_dst_linesize[4];
     enum AVPixelFormat video_dst_pix_fmt;
     bool has_alpha;
+    bool yuv_passthrough;   /*The decoded YUV planes are the output, no sws_scale*/
+
+    /* `frame` is decoded but not converted yet, `frame_pts` is its presentation time [ms] */
+    bool frame_pending;
+    int64_t frame_pts;
+    uint32_t frame_period;
+
+    /* Playback clock: shows `clock_base` [ms] at `clock_tick` and runs if `clock_running` */
+    int64_t clock_base;
+    uint32_t clock_tick;
+    bool clock_valid;
+    bool clock_running;
+
+    uint32_t drop_seq;
+    uint32_t dropped_cnt;
+    uint32_t late_cnt;
+    uint32_t decode_time;
+#if LV_FFMPEG_PLAYER_USE_THREAD
+    /* Ring of converted frames. `frame_show` is the one shown by the player,
+     * `frame_cnt` frames from `frame_rd` are decoded and wait to be shown.
+     * The worker thread always writes the slot after the last ready frame
+     * and the consumer never frees a slot it still shows.
+     */
+    uint8_t * frame_data[LV_FFMPEG_PLAYER_FRAME_CNT];
+    int64_t frame_data_pts[LV_FFMPEG_PLAYER_FRAME_CNT];
+    uint32_t frame_rd;
+    uint32_t frame_cnt;
+    uint32_t frame_show;
+    lv_thread_t thread;
+    lv_mutex_t lock;
+    lv_cond_t cond;
+    bool thread_started;
+    bool quit_req;
+    bool seek_req;
+    bool eof;
+#endif
 };
 
 #pragma pack(1)
@@ -82,9 +136,27 @@ static int ffmpeg_get_img_header(const char * path, lv_img_header_t * header);
 static int ffmpeg_get_frame_refr_period(struct ffmpeg_context_s * ffmpeg_ctx);
 static uint8_t * ffmpeg_get_img_data(struct ffmpeg_context_s * ffmpeg_ctx);
 static int ffmpeg_update_next_frame(struct ffmpeg_context_s * ffmpeg_ctx);
+static int ffmpeg_decode_next_frame(struct ffmpeg_context_s * ffmpeg_ctx);
 static int ffmpeg_output_video_frame(struct ffmpeg_context_s * ffmpeg_ctx);
 static bool ffmpeg_pix_fmt_has_alpha(enum AVPixelFormat pix_fmt);
 static bool ffmpeg_pix_fmt_is_yuv(enum AVPixelFormat pix_fmt);
+static int ffmpeg_get_dst_align(struct ffmpeg_context_s * ffmpeg_ctx);
+static void ffmpeg_seek_begin(struct ffmpeg_context_s * ffmpeg_ctx);
+static void ffmpeg_lock(struct ffmpeg_context_s * ffmpeg_ctx);
+static void ffmpeg_unlock(struct ffmpeg_context_s * ffmpeg_ctx);
+static int64_t ffmpeg_clock_get(struct ffmpeg_context_s * ffmpeg_ctx);
+static void ffmpeg_clock_start(struct ffmpeg_context_s * ffmpeg_ctx, int64_t pts);
+static void ffmpeg_clock_pause(struct ffmpeg_context_s * ffmpeg_ctx);
+static void ffmpeg_clock_resume(struct ffmpeg_context_s * ffmpeg_ctx);
+static bool ffmpeg_frame_drop_check(struct ffmpeg_context_s * ffmpeg_ctx, int64_t lateness);
+static void ffmpeg_frame_late_check(struct ffmpeg_context_s * ffmpeg_ctx, int64_t lateness);
+static uint32_t ffmpeg_frame_wait_time(struct ffmpeg_context_s * ffmpeg_ctx, int64_t pts, int64_t now);
+
+#if LV_FFMPEG_PLAYER_USE_THREAD
+    static int ffmpeg_thread_start(struct ffmpeg_context_s * ffmpeg_ctx);
+    static void ffmpeg_thread_stop(struct ffmpeg_context_s * ffmpeg_ctx);
+    static void ffmpeg_thread_cb(void * user_data);
+#endif
 
 static void lv_ffmpeg_player_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_ffmpeg_player_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
@@ -164,6 +236,15 @@ lv_res_t lv_ffmpeg_player_set_src(lv_obj_t * obj, const char * path)
         goto failed;
     }
 
+#if LV_FFMPEG_PLAYER_USE_YUV
+    /* LVGL can draw these formats directly. Only full range (YUVJ) and other layouts are converted. */
+    enum AVPixelFormat src_pix_fmt = player->ffmpeg_ctx->video_dec_ctx->pix_fmt;
+    if(src_pix_fmt == AV_PIX_FMT_YUV420P || src_pix_fmt == AV_PIX_FMT_NV12) {
+        player->ffmpeg_ctx->yuv_passthrough = true;
+        player->ffmpeg_ctx->video_dst_pix_fmt = src_pix_fmt;
+    }
+#endif
+
     if(ffmpeg_image_allocate(player->ffmpeg_ctx) < 0) {
         LV_LOG_ERROR("ffmpeg image allocate failed");
         ffmpeg_close(player->ffmpeg_ctx);
@@ -187,6 +268,12 @@ lv_res_t lv_ffmpeg_player_set_src(lv_obj_t * obj, const char * path)
     player->imgdsc.header.h = height;
     player->imgdsc.data_size = data_size;
     player->imgdsc.header.cf = has_alpha ? LV_IMG_CF_TRUE_COLOR_ALPHA : LV_IMG_CF_TRUE_COLOR;
+
+    if(player->ffmpeg_ctx->yuv_passthrough) {
+        bool nv12 = player->ffmpeg_ctx->video_dst_pix_fmt == AV_PIX_FMT_NV12;
+        player->imgdsc.data_size = LV_IMG_BUF_SIZE_YUV420(width, height);
+        player->imgdsc.header.cf = nv12 ? LV_IMG_CF_YUV_NV12 : LV_IMG_CF_YUV_I420;
+    }
     player->imgdsc.data = ffmpeg_get_img_data(player->ffmpeg_ctx);
 
     lv_img_set_src(&player->img.obj, &(player->imgdsc));
@@ -196,12 +283,31 @@ lv_res_t lv_ffmpeg_player_set_src(lv_obj_t * obj, const char * path)
     if(period > 0) {
         LV_LOG_INFO("frame refresh period = %d ms, rate = %d fps",
                     period, 1000 / period);
-        lv_timer_set_period(player->timer, period);
     }
     else {
         LV_LOG_WARN("unable to get frame refresh period");
+        period = FRAME_DEF_REFR_PERIOD;
     }
 
+    /* The frames are shown by their PTS. The timer period is only the polling interval. */
+    player->ffmpeg_ctx->frame_period = period;
+    lv_timer_set_period(player->timer, period);
+
+    player->frame_dropped_cnt = 0;
+    player->frame_late_cnt = 0;
+    player->decode_time = 0;
+
+#if LV_FFMPEG_PLAYER_USE_THREAD
+    if(ffmpeg_thread_start(player->ffmpeg_ctx) < 0) {
+        LV_LOG_ERROR("ffmpeg decoder thread start failed");
+        ffmpeg_close(player->ffmpeg_ctx);
+        player->ffmpeg_ctx = NULL;
+        goto failed;
+    }
+
+    player->imgdsc.data = player->ffmpeg_ctx->frame_data[player->ffmpeg_ctx->frame_show];
+#endif
+
     res = LV_RES_OK;
 
 failed:
@@ -222,22 +328,22 @@ void lv_ffmpeg_player_set_cmd(lv_obj_t * obj, lv_ffmpeg_player_cmd_t cmd)
 
     switch(cmd) {
         case LV_FFMPEG_PLAYER_CMD_START:
-            av_seek_frame(player->ffmpeg_ctx->fmt_ctx,
-                          0, 0, AVSEEK_FLAG_BACKWARD);
+            ffmpeg_seek_begin(player->ffmpeg_ctx);
             lv_timer_resume(timer);
             LV_LOG_INFO("ffmpeg player start");
             break;
         case LV_FFMPEG_PLAYER_CMD_STOP:
-            av_seek_frame(player->ffmpeg_ctx->fmt_ctx,
-                          0, 0, AVSEEK_FLAG_BACKWARD);
+            ffmpeg_seek_begin(player->ffmpeg_ctx);
             lv_timer_pause(timer);
             LV_LOG_INFO("ffmpeg player stop");
             break;
         case LV_FFMPEG_PLAYER_CMD_PAUSE:
+            ffmpeg_clock_pause(player->ffmpeg_ctx);
             lv_timer_pause(timer);
             LV_LOG_INFO("ffmpeg player pause");
             break;
         case LV_FFMPEG_PLAYER_CMD_RESUME:
+            ffmpeg_clock_resume(player->ffmpeg_ctx);
             lv_timer_resume(timer);
             LV_LOG_INFO("ffmpeg player resume");
             break;
@@ -383,6 +489,12 @@ static bool ffmpeg_pix_fmt_is_yuv(enum AVPixelFormat pix_fmt)
     return !(desc->flags & AV_PIX_FMT_FLAG_RGB) && desc->nb_components >= 2;
 }
 
+static int ffmpeg_get_dst_align(struct ffmpeg_context_s * ffmpeg_ctx)
+{
+    /* LV_IMG_CF_YUV_... expects the planes without padding */
+    return ffmpeg_ctx->yuv_passthrough ? 1 : 4;
+}
+
 static int ffmpeg_output_video_frame(struct ffmpeg_context_s * ffmpeg_ctx)
 {
     int ret = -1;
@@ -413,6 +525,14 @@ static int ffmpeg_output_video_frame(struct ffmpeg_context_s * ffmpeg_ctx)
 
     LV_LOG_TRACE("video_frame coded_n:%d", frame->coded_picture_number);
 
+    if(ffmpeg_ctx->yuv_passthrough) {
+        /* Only remove the padding of the lines, the conversion happens while drawing */
+        av_image_copy(ffmpeg_ctx->video_dst_data, ffmpeg_ctx->video_dst_linesize,
+                      (const uint8_t **)(frame->data), frame->linesize,
+                      ffmpeg_ctx->video_dst_pix_fmt, width, height);
+        return 0;
+    }
+
     /* copy decoded frame to destination buffer:
      * this is required since rawvideo expects non aligned data
      */
@@ -472,48 +592,66 @@ failed:
     return ret;
 }
 
-static int ffmpeg_decode_packet(AVCodecContext * dec, const AVPacket * pkt,
-                                struct ffmpeg_context_s * ffmpeg_ctx)
+static int ffmpeg_decode_next_frame(struct ffmpeg_context_s * ffmpeg_ctx)
 {
-    int ret = 0;
-
-    /* submit the packet to the decoder */
-    ret = avcodec_send_packet(dec, pkt);
-    if(ret < 0) {
-        LV_LOG_ERROR("Error submitting a packet for decoding (%s)",
-                     av_err2str(ret));
-        return ret;
-    }
+    AVCodecContext * dec = ffmpeg_ctx->video_dec_ctx;
+    int ret;
 
-    /* get all the available frames from the decoder */
-    while(ret >= 0) {
+    while(1) {
         ret = avcodec_receive_frame(dec, ffmpeg_ctx->frame);
-        if(ret < 0) {
+        if(ret >= 0) {
+            break;
+        }
 
-            /* those two return values are special and mean there is
-             * no output frame available,
-             * but there were no errors during decoding
-             */
-            if(ret == AVERROR_EOF || ret == AVERROR(EAGAIN)) {
-                return 0;
+        /* AVERROR_EOF: the decoder was drained and has no more frames */
+        if(ret != AVERROR(EAGAIN)) {
+            if(ret != AVERROR_EOF) {
+                LV_LOG_ERROR("Error during decoding (%s)", av_err2str(ret));
             }
-
-            LV_LOG_ERROR("Error during decoding (%s)", av_err2str(ret));
             return ret;
         }
 
-        /* write the frame data to output file */
-        if(dec->codec->type == AVMEDIA_TYPE_VIDEO) {
-            ret = ffmpeg_output_video_frame(ffmpeg_ctx);
+        /* The decoder needs more data. Read until a packet of the video stream. */
+        if(av_read_frame(ffmpeg_ctx->fmt_ctx, &(ffmpeg_ctx->pkt)) < 0) {
+            /* End of file: flush the frames delayed in the decoder */
+            ret = avcodec_send_packet(dec, NULL);
+            if(ret < 0 && ret != AVERROR_EOF) {
+                return ret;
+            }
+            continue;
         }
 
-        av_frame_unref(ffmpeg_ctx->frame);
+        if(ffmpeg_ctx->pkt.stream_index != ffmpeg_ctx->video_stream_idx) {
+            av_packet_unref(&(ffmpeg_ctx->pkt));
+            continue;
+        }
+
+        ret = avcodec_send_packet(dec, &(ffmpeg_ctx->pkt));
+        av_packet_unref(&(ffmpeg_ctx->pkt));
         if(ret < 0) {
-            LV_LOG_WARN("ffmpeg_decode_packet ended %d", ret);
+            LV_LOG_ERROR("Error submitting a packet for decoding (%s)",
+                         av_err2str(ret));
             return ret;
         }
     }
 
+    /* Convert the presentation time to ms from the start of the stream.
+     * Without a timestamp assume that the frames follow each other evenly.
+     */
+    int64_t pts = ffmpeg_ctx->frame->best_effort_timestamp;
+    if(pts == AV_NOPTS_VALUE) {
+        ffmpeg_ctx->frame_pts += ffmpeg_ctx->frame_period;
+    }
+    else {
+        if(ffmpeg_ctx->video_stream->start_time != AV_NOPTS_VALUE) {
+            pts -= ffmpeg_ctx->video_stream->start_time;
+        }
+        AVRational ms_base = {1, 1000};
+        ffmpeg_ctx->frame_pts = av_rescale_q(pts, ffmpeg_ctx->video_stream->time_base, ms_base);
+    }
+
+    ffmpeg_ctx->frame_pending = true;
+
     return 0;
 }
 
@@ -630,41 +768,17 @@ static int ffmpeg_get_frame_refr_period(struct ffmpeg_context_s * ffmpeg_ctx)
 
 static int ffmpeg_update_next_frame(struct ffmpeg_context_s * ffmpeg_ctx)
 {
-    int ret = 0;
-
-    while(1) {
-
-        /* read frames from the file */
-        if(av_read_frame(ffmpeg_ctx->fmt_ctx, &(ffmpeg_ctx->pkt)) >= 0) {
-            bool is_image = false;
+    int ret = ffmpeg_decode_next_frame(ffmpeg_ctx);
 
-            /* check if the packet belongs to a stream we are interested in,
-             * otherwise skip it
-             */
-            if(ffmpeg_ctx->pkt.stream_index == ffmpeg_ctx->video_stream_idx) {
-                ret = ffmpeg_decode_packet(ffmpeg_ctx->video_dec_ctx,
-                                           &(ffmpeg_ctx->pkt), ffmpeg_ctx);
-                is_image = true;
-            }
-
-            av_packet_unref(&(ffmpeg_ctx->pkt));
-
-            if(ret < 0) {
-                LV_LOG_WARN("video frame is empty %d", ret);
-                break;
-            }
-
-            /* Used to filter data that is not an image */
-            if(is_image) {
-                break;
-            }
-        }
-        else {
-            ret = -1;
-            break;
-        }
+    if(ret < 0) {
+        LV_LOG_WARN("video frame is empty %d", ret);
+        return ret;
     }
 
+    ret = ffmpeg_output_video_frame(ffmpeg_ctx);
+    av_frame_unref(ffmpeg_ctx->frame);
+    ffmpeg_ctx->frame_pending = false;
+
     return ret;
 }
 
@@ -729,21 +843,25 @@ static int ffmpeg_image_allocate(struct ffmpeg_context_s * ffmpeg_ctx)
 {
     int ret;
 
-    /* allocate image where the decoded image will be put */
-    ret = av_image_alloc(
-              ffmpeg_ctx->video_src_data,
-              ffmpeg_ctx->video_src_linesize,
-              ffmpeg_ctx->video_dec_ctx->width,
-              ffmpeg_ctx->video_dec_ctx->height,
-              ffmpeg_ctx->video_dec_ctx->pix_fmt,
-              4);
+    /* allocate image where the decoded image will be put.
+     * Not needed if the decoded frame is copied to the destination as it is.
+     */
+    if(!ffmpeg_ctx->yuv_passthrough) {
+        ret = av_image_alloc(
+                  ffmpeg_ctx->video_src_data,
+                  ffmpeg_ctx->video_src_linesize,
+                  ffmpeg_ctx->video_dec_ctx->width,
+                  ffmpeg_ctx->video_dec_ctx->height,
+                  ffmpeg_ctx->video_dec_ctx->pix_fmt,
+                  4);
 
-    if(ret < 0) {
-        LV_LOG_ERROR("Could not allocate src raw video buffer");
-        return ret;
-    }
+        if(ret < 0) {
+            LV_LOG_ERROR("Could not allocate src raw video buffer");
+            return ret;
+        }
 
-    LV_LOG_INFO("alloc video_src_bufsize = %d", ret);
+        LV_LOG_INFO("alloc video_src_bufsize = %d", ret);
+    }
 
     ret = av_image_alloc(
               ffmpeg_ctx->video_dst_data,
@@ -751,7 +869,7 @@ static int ffmpeg_image_allocate(struct ffmpeg_context_s * ffmpeg_ctx)
               ffmpeg_ctx->video_dec_ctx->width,
               ffmpeg_ctx->video_dec_ctx->height,
               ffmpeg_ctx->video_dst_pix_fmt,
-              4);
+              ffmpeg_get_dst_align(ffmpeg_ctx));
 
     if(ret < 0) {
         LV_LOG_ERROR("Could not allocate dst raw video buffer");
@@ -801,6 +919,10 @@ static void ffmpeg_close(struct ffmpeg_context_s * ffmpeg_ctx)
         return;
     }
 
+#if LV_FFMPEG_PLAYER_USE_THREAD
+    ffmpeg_thread_stop(ffmpeg_ctx);
+#endif
+
     sws_freeContext(ffmpeg_ctx->sws_ctx);
     ffmpeg_close_src_ctx(ffmpeg_ctx);
     ffmpeg_close_dst_ctx(ffmpeg_ctx);
@@ -809,6 +931,296 @@ static void ffmpeg_close(struct ffmpeg_context_s * ffmpeg_ctx)
     LV_LOG_INFO("ffmpeg_ctx closed");
 }
 
+static void ffmpeg_seek_begin(struct ffmpeg_context_s * ffmpeg_ctx)
+{
+#if LV_FFMPEG_PLAYER_USE_THREAD
+    /* The worker thread owns the demuxer so only ask it to seek.
+     * The already decoded frames belong to the old position, drop them.
+     */
+    lv_mutex_lock(&ffmpeg_ctx->lock);
+    ffmpeg_ctx->seek_req = true;
+    ffmpeg_ctx->eof = false;
+    ffmpeg_ctx->frame_cnt = 0;
+    ffmpeg_ctx->clock_valid = false;
+    lv_cond_signal(&ffmpeg_ctx->cond);
+    lv_mutex_unlock(&ffmpeg_ctx->lock);
+#else
+    av_seek_frame(ffmpeg_ctx->fmt_ctx, 0, 0, AVSEEK_FLAG_BACKWARD);
+    avcodec_flush_buffers(ffmpeg_ctx->video_dec_ctx);
+
+    if(ffmpeg_ctx->frame_pending) {
+        av_frame_unref(ffmpeg_ctx->frame);
+        ffmpeg_ctx->frame_pending = false;
+    }
+
+    ffmpeg_ctx->clock_valid = false;
+#endif
+}
+
+static void ffmpeg_lock(struct ffmpeg_context_s * ffmpeg_ctx)
+{
+#if LV_FFMPEG_PLAYER_USE_THREAD
+    lv_mutex_lock(&ffmpeg_ctx->lock);
+#else
+    LV_UNUSED(ffmpeg_ctx);
+#endif
+}
+
+static void ffmpeg_unlock(struct ffmpeg_context_s * ffmpeg_ctx)
+{
+#if LV_FFMPEG_PLAYER_USE_THREAD
+    lv_mutex_unlock(&ffmpeg_ctx->lock);
+#else
+    LV_UNUSED(ffmpeg_ctx);
+#endif
+}
+
+/* The functions of the clock and the frame checks expect the context to be locked */
+
+static int64_t ffmpeg_clock_get(struct ffmpeg_context_s * ffmpeg_ctx)
+{
+    if(!ffmpeg_ctx->clock_valid) {
+        return -1;
+    }
+
+    if(!ffmpeg_ctx->clock_running) {
+        return ffmpeg_ctx->clock_base;
+    }
+
+    return ffmpeg_ctx->clock_base + lv_tick_elaps(ffmpeg_ctx->clock_tick);
+}
+
+static void ffmpeg_clock_start(struct ffmpeg_context_s * ffmpeg_ctx, int64_t pts)
+{
+    ffmpeg_ctx->clock_base = pts;
+    ffmpeg_ctx->clock_tick = lv_tick_get();
+    ffmpeg_ctx->clock_valid = true;
+    ffmpeg_ctx->clock_running = true;
+}
+
+static void ffmpeg_clock_pause(struct ffmpeg_context_s * ffmpeg_ctx)
+{
+    ffmpeg_lock(ffmpeg_ctx);
+    if(ffmpeg_ctx->clock_valid && ffmpeg_ctx->clock_running) {
+        ffmpeg_ctx->clock_base = ffmpeg_clock_get(ffmpeg_ctx);
+        ffmpeg_ctx->clock_running = false;
+    }
+    ffmpeg_unlock(ffmpeg_ctx);
+}
+
+static void ffmpeg_clock_resume(struct ffmpeg_context_s * ffmpeg_ctx)
+{
+    ffmpeg_lock(ffmpeg_ctx);
+    if(ffmpeg_ctx->clock_valid && !ffmpeg_ctx->clock_running) {
+        ffmpeg_ctx->clock_tick = lv_tick_get();
+        ffmpeg_ctx->clock_running = true;
+    }
+    ffmpeg_unlock(ffmpeg_ctx);
+}
+
+/**
+ * Decide whether a decoded frame should be dropped without converting it
+ * @param lateness the clock minus the PTS of the frame [ms]
+ * @return true: drop the frame
+ */
+static bool ffmpeg_frame_drop_check(struct ffmpeg_context_s * ffmpeg_ctx, int64_t lateness)
+{
+    /* The frame's time is over if the next frame should be shown already */
+    if(lateness >= ffmpeg_ctx->frame_period && ffmpeg_ctx->drop_seq < FRAME_DROP_MAX) {
+        ffmpeg_ctx->drop_seq++;
+        ffmpeg_ctx->dropped_cnt++;
+
+        /* Skip the frames which are not references to catch up faster */
+        ffmpeg_ctx->video_dec_ctx->skip_frame = AVDISCARD_NONREF;
+        return true;
+    }
+
+    ffmpeg_ctx->drop_seq = 0;
+    ffmpeg_ctx->video_dec_ctx->skip_frame = AVDISCARD_DEFAULT;
+    return false;
+}
+
+static void ffmpeg_frame_late_check(struct ffmpeg_context_s * ffmpeg_ctx, int64_t lateness)
+{
+    if(lateness > ffmpeg_ctx->frame_period / 2) {
+        ffmpeg_ctx->late_cnt++;
+    }
+}
+
+static uint32_t ffmpeg_frame_wait_time(struct ffmpeg_context_s * ffmpeg_ctx, int64_t pts, int64_t now)
+{
+    int64_t wait = pts - now;
+    if(wait < 1) wait = 1;
+    if(wait > ffmpeg_ctx->frame_period) wait = ffmpeg_ctx->frame_period;
+    return (uint32_t)wait;
+}
+
+#if LV_FFMPEG_PLAYER_USE_THREAD
+
+static int ffmpeg_thread_start(struct ffmpeg_context_s * ffmpeg_ctx)
+{
+    /* The first slot reuses the destination buffer allocated for the context */
+    ffmpeg_ctx->frame_data[0] = ffmpeg_ctx->video_dst_data[0];
+
+    for(uint32_t i = 1; i < LV_FFMPEG_PLAYER_FRAME_CNT; i++) {
+        uint8_t * data[4];
+        int linesize[4];
+        if(av_image_alloc(data, linesize,
+                          ffmpeg_ctx->video_dec_ctx->width,
+                          ffmpeg_ctx->video_dec_ctx->height,
+                          ffmpeg_ctx->video_dst_pix_fmt,
+                          ffmpeg_get_dst_align(ffmpeg_ctx)) < 0) {
+            LV_LOG_ERROR("Could not allocate frame buffer %d", (int)i);
+            return -1;
+        }
+
+        ffmpeg_ctx->frame_data[i] = data[0];
+    }
+
+    ffmpeg_ctx->frame_rd = 0;
+    ffmpeg_ctx->frame_cnt = 0;
+    ffmpeg_ctx->frame_show = LV_FFMPEG_PLAYER_FRAME_CNT - 1;
+    ffmpeg_ctx->quit_req = false;
+    ffmpeg_ctx->seek_req = false;
+    ffmpeg_ctx->eof = false;
+
+    if(lv_mutex_init(&ffmpeg_ctx->lock) != LV_RES_OK) {
+        return -1;
+    }
+
+    if(lv_cond_init(&ffmpeg_ctx->cond) != LV_RES_OK) {
+        lv_mutex_delete(&ffmpeg_ctx->lock);
+        return -1;
+    }
+
+    if(lv_thread_init(&ffmpeg_ctx->thread, ffmpeg_thread_cb, ffmpeg_ctx) != LV_RES_OK) {
+        lv_cond_delete(&ffmpeg_ctx->cond);
+        lv_mutex_delete(&ffmpeg_ctx->lock);
+        return -1;
+    }
+
+    ffmpeg_ctx->thread_started = true;
+
+    return 0;
+}
+
+static void ffmpeg_thread_stop(struct ffmpeg_context_s * ffmpeg_ctx)
+{
+    if(ffmpeg_ctx->thread_started) {
+        lv_mutex_lock(&ffmpeg_ctx->lock);
+        ffmpeg_ctx->quit_req = true;
+        lv_cond_signal(&ffmpeg_ctx->cond);
+        lv_mutex_unlock(&ffmpeg_ctx->lock);
+
+        lv_thread_delete(&ffmpeg_ctx->thread);
+        lv_cond_delete(&ffmpeg_ctx->cond);
+        lv_mutex_delete(&ffmpeg_ctx->lock);
+        ffmpeg_ctx->thread_started = false;
+    }
+
+    /* Give back the context's own buffer so that it's freed normally */
+    if(ffmpeg_ctx->frame_data[0] != NULL) {
+        ffmpeg_ctx->video_dst_data[0] = ffmpeg_ctx->frame_data[0];
+        ffmpeg_ctx->frame_data[0] = NULL;
+    }
+
+    for(uint32_t i = 1; i < LV_FFMPEG_PLAYER_FRAME_CNT; i++) {
+        if(ffmpeg_ctx->frame_data[i] != NULL) {
+            av_free(ffmpeg_ctx->frame_data[i]);
+            ffmpeg_ctx->frame_data[i] = NULL;
+        }
+    }
+}
+
+static void ffmpeg_thread_cb(void * user_data)
+{
+    struct ffmpeg_context_s * ffmpeg_ctx = user_data;
+
+    lv_mutex_lock(&ffmpeg_ctx->lock);
+
+    while(!ffmpeg_ctx->quit_req) {
+        if(ffmpeg_ctx->seek_req) {
+            ffmpeg_ctx->seek_req = false;
+            lv_mutex_unlock(&ffmpeg_ctx->lock);
+
+            av_seek_frame(ffmpeg_ctx->fmt_ctx, 0, 0, AVSEEK_FLAG_BACKWARD);
+            avcodec_flush_buffers(ffmpeg_ctx->video_dec_ctx);
+
+            lv_mutex_lock(&ffmpeg_ctx->lock);
+            continue;
+        }
+
+        /* One slot is always kept for the frame being shown */
+        if(ffmpeg_ctx->eof || ffmpeg_ctx->frame_cnt >= LV_FFMPEG_PLAYER_FRAME_CNT - 1) {
+            lv_cond_wait(&ffmpeg_ctx->cond, &ffmpeg_ctx->lock);
+            continue;
+        }
+
+        uint32_t wr = (ffmpeg_ctx->frame_rd + ffmpeg_ctx->frame_cnt) % LV_FFMPEG_PLAYER_FRAME_CNT;
+        lv_mutex_unlock(&ffmpeg_ctx->lock);
+
+        /* Decode without holding the lock. The slot is not visible to the player until it's committed. */
+        uint32_t t = lv_tick_get();
+        int ret = ffmpeg_decode_next_frame(ffmpeg_ctx);
+
+        lv_mutex_lock(&ffmpeg_ctx->lock);
+
+        if(ret < 0) {
+            /* After a seek request it's not the end of the new position */
+            if(!ffmpeg_ctx->seek_req) ffmpeg_ctx->eof = true;
+            continue;
+        }
+
+        if(ffmpeg_ctx->seek_req) {
+            av_frame_unref(ffmpeg_ctx->frame);
+            ffmpeg_ctx->frame_pending = false;
+            continue;
+        }
+
+        /* Don't waste time on converting a frame which wouldn't be shown anyway */
+        int64_t now = ffmpeg_clock_get(ffmpeg_ctx);
+        if(now >= 0 && ffmpeg_frame_drop_check(ffmpeg_ctx, now - ffmpeg_ctx->frame_pts)) {
+            av_frame_unref(ffmpeg_ctx->frame);
+            ffmpeg_ctx->frame_pending = false;
+            continue;
+        }
+
+        lv_mutex_unlock(&ffmpeg_ctx->lock);
+
+        av_image_fill_pointers(ffmpeg_ctx->video_dst_data, ffmpeg_ctx->video_dst_pix_fmt,
+                               ffmpeg_ctx->video_dec_ctx->height, ffmpeg_ctx->frame_data[wr],
+                               ffmpeg_ctx->video_dst_linesize);
+        ret = ffmpeg_output_video_frame(ffmpeg_ctx);
+        av_frame_unref(ffmpeg_ctx->frame);
+        ffmpeg_ctx->frame_pending = false;
+
+#if LV_COLOR_DEPTH != 32
+        if(ret >= 0 && ffmpeg_ctx->has_alpha) {
+            convert_color_depth(ffmpeg_ctx->frame_data[wr],
+                                ffmpeg_ctx->video_dec_ctx->width * ffmpeg_ctx->video_dec_ctx->height);
+        }
+#endif
+
+        lv_mutex_lock(&ffmpeg_ctx->lock);
+
+        /* A seek was requested meanwhile so the frame is from the old position */
+        if(ffmpeg_ctx->seek_req) continue;
+
+        if(ret < 0) {
+            ffmpeg_ctx->eof = true;
+        }
+        else {
+            ffmpeg_ctx->frame_data_pts[wr] = ffmpeg_ctx->frame_pts;
+            ffmpeg_ctx->frame_cnt++;
+            ffmpeg_ctx->decode_time = lv_tick_elaps(t);
+        }
+    }
+
+    lv_mutex_unlock(&ffmpeg_ctx->lock);
+}
+
+#endif /*LV_FFMPEG_PLAYER_USE_THREAD*/
+
 static void lv_ffmpeg_player_frame_update_cb(lv_timer_t * timer)
 {
     lv_obj_t * obj = (lv_obj_t *)timer->user_data;
@@ -818,22 +1230,119 @@ static void lv_ffmpeg_player_frame_update_cb(lv_timer_t * timer)
         return;
     }
 
-    int has_next = ffmpeg_update_next_frame(player->ffmpeg_ctx);
+    struct ffmpeg_context_s * ffmpeg_ctx = player->ffmpeg_ctx;
+    bool shown = false;
+    bool eof = false;
+    int64_t now;
 
-    if(has_next < 0) {
-        lv_ffmpeg_player_set_cmd(obj, player->auto_restart ? LV_FFMPEG_PLAYER_CMD_START : LV_FFMPEG_PLAYER_CMD_STOP);
-        return;
+#if LV_FFMPEG_PLAYER_USE_THREAD
+    lv_mutex_lock(&ffmpeg_ctx->lock);
+
+    if(ffmpeg_ctx->frame_cnt > 0) {
+        now = ffmpeg_clock_get(ffmpeg_ctx);
+        if(now < 0) {
+            ffmpeg_clock_start(ffmpeg_ctx, ffmpeg_ctx->frame_data_pts[ffmpeg_ctx->frame_rd]);
+            now = ffmpeg_ctx->frame_data_pts[ffmpeg_ctx->frame_rd];
+        }
+
+        /* Show the last due frame. The due frames before it are dropped
+         * and the worker can refill their slots and the slot of the previous frame.
+         */
+        while(ffmpeg_ctx->frame_cnt > 0 && ffmpeg_ctx->frame_data_pts[ffmpeg_ctx->frame_rd] <= now) {
+            if(shown) ffmpeg_ctx->dropped_cnt++;
+            ffmpeg_ctx->frame_show = ffmpeg_ctx->frame_rd;
+            ffmpeg_ctx->frame_rd = (ffmpeg_ctx->frame_rd + 1) % LV_FFMPEG_PLAYER_FRAME_CNT;
+            ffmpeg_ctx->frame_cnt--;
+            shown = true;
+        }
+
+        if(shown) {
+            ffmpeg_frame_late_check(ffmpeg_ctx, now - ffmpeg_ctx->frame_data_pts[ffmpeg_ctx->frame_show]);
+            lv_cond_signal(&ffmpeg_ctx->cond);
+        }
+    }
+    else {
+        eof = ffmpeg_ctx->eof;
     }
 
-#if LV_COLOR_DEPTH != 32
-    if(player->ffmpeg_ctx->has_alpha) {
-        convert_color_depth((uint8_t *)(player->imgdsc.data),
-                            player->imgdsc.header.w * player->imgdsc.header.h);
+    /* If the next frame is not decoded in time keep showing the current one and poll again */
+    if(ffmpeg_ctx->frame_cnt > 0) {
+        lv_timer_set_period(timer, ffmpeg_frame_wait_time(ffmpeg_ctx, ffmpeg_ctx->frame_data_pts[ffmpeg_ctx->frame_rd],
+                                                          ffmpeg_clock_get(ffmpeg_ctx)));
     }
+    else {
+        lv_timer_set_period(timer, LV_MAX(ffmpeg_ctx->frame_period / 2, 1));
+    }
+
+    player->frame_dropped_cnt = ffmpeg_ctx->dropped_cnt;
+    player->frame_late_cnt = ffmpeg_ctx->late_cnt;
+    player->decode_time = ffmpeg_ctx->decode_time;
+
+    lv_mutex_unlock(&ffmpeg_ctx->lock);
+
+    if(shown) {
+        player->imgdsc.data = ffmpeg_ctx->frame_data[ffmpeg_ctx->frame_show];
+    }
+#else
+    uint32_t t = lv_tick_get();
+
+    while(!shown) {
+        if(!ffmpeg_ctx->frame_pending && ffmpeg_decode_next_frame(ffmpeg_ctx) < 0) {
+            eof = true;
+            break;
+        }
+
+        now = ffmpeg_clock_get(ffmpeg_ctx);
+        if(now < 0) {
+            ffmpeg_clock_start(ffmpeg_ctx, ffmpeg_ctx->frame_pts);
+            now = ffmpeg_ctx->frame_pts;
+        }
+
+        /* Not due yet */
+        if(ffmpeg_ctx->frame_pts > now) {
+            break;
+        }
+
+        if(!ffmpeg_frame_drop_check(ffmpeg_ctx, now - ffmpeg_ctx->frame_pts)) {
+            ffmpeg_frame_late_check(ffmpeg_ctx, now - ffmpeg_ctx->frame_pts);
+            shown = ffmpeg_output_video_frame(ffmpeg_ctx) >= 0;
+        }
+
+        av_frame_unref(ffmpeg_ctx->frame);
+        ffmpeg_ctx->frame_pending = false;
+    }
+
+    if(shown) {
+#if LV_COLOR_DEPTH != 32
+        if(ffmpeg_ctx->has_alpha) {
+            convert_color_depth((uint8_t *)(player->imgdsc.data),
+                                player->imgdsc.header.w * player->imgdsc.header.h);
+        }
 #endif
 
-    lv_img_cache_invalidate_src(lv_img_get_src(obj));
-    lv_obj_invalidate(obj);
+        /* Decode the next frame now to know when it's due. At the end of the file it's noticed on the next call. */
+        ffmpeg_decode_next_frame(ffmpeg_ctx);
+        ffmpeg_ctx->decode_time = lv_tick_elaps(t);
+    }
+
+    if(ffmpeg_ctx->frame_pending) {
+        lv_timer_set_period(timer, ffmpeg_frame_wait_time(ffmpeg_ctx, ffmpeg_ctx->frame_pts, ffmpeg_clock_get(ffmpeg_ctx)));
+    }
+
+    player->frame_dropped_cnt = ffmpeg_ctx->dropped_cnt;
+    player->frame_late_cnt = ffmpeg_ctx->late_cnt;
+    player->decode_time = ffmpeg_ctx->decode_time;
+#endif /*LV_FFMPEG_PLAYER_USE_THREAD*/
+
+    if(eof) {
+        lv_ffmpeg_player_set_cmd(obj, player->auto_restart ? LV_FFMPEG_PLAYER_CMD_START : LV_FFMPEG_PLAYER_CMD_STOP);
+        return;
+    }
+
+    if(shown) {
+        lv_img_cache_invalidate_src(lv_img_get_src(obj));
+        lv_obj_invalidate(obj);
+    }
 }
 
 static void lv_ffmpeg_player_constructor(const lv_obj_class_t * class_p,
@@ -32,6 +32,9 @@ typedef struct {
     lv_img_dsc_t imgdsc;
     bool auto_restart;
     struct ffmpeg_context_s * ffmpeg_ctx;
+    uint32_t frame_dropped_cnt;     /*Decoded frames skipped because their presentation time had passed*/
+    uint32_t frame_late_cnt;        /*Frames shown more than half a frame period after their presentation time*/
+    uint32_t decode_time;           /*Time of decoding and converting the last frame [ms]*/
 } lv_ffmpeg_player_t;
 
 typedef enum {
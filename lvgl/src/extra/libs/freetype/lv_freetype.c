@@ -35,6 +35,8 @@ typedef struct {
     void * face_id;
 #else
     FT_Size     size;
+    uint32_t    cached_letter;  /* letter of `cached_bitmap` */
+    const uint8_t * cached_bitmap;  /* bitmap of the last glyph in the glyph cache or NULL */
 #endif
     lv_font_t * font;
     uint16_t    style;
@@ -361,6 +363,13 @@ static bool get_glyph_dsc_cb_nocache(const lv_font_t * font,
     lv_font_fmt_ft_dsc_t * dsc = (lv_font_fmt_ft_dsc_t *)(font->dsc);
     FT_Face face = dsc->size->face;
 
+    /* the glyph was rendered earlier */
+    dsc->cached_bitmap = _lv_font_glyph_cache_get(font, unicode_letter, dsc_out);
+    if(dsc->cached_bitmap) {
+        dsc->cached_letter = unicode_letter;
+        return true;
+    }
+
     FT_UInt glyph_index = FT_Get_Char_Index(face, unicode_letter);
 
     if(face->size != dsc->size) {
@@ -385,13 +394,30 @@ static bool get_glyph_dsc_cb_nocache(const lv_font_t * font,
                      face->glyph->bitmap.rows;         /*Y offset of the bitmap measured from the as line*/
     dsc_out->bpp = 8;         /*Bit per pixel: 1/2/4/8*/
 
+    /* keep the rendered glyph to not render it again */
+    uint32_t size = (uint32_t)dsc_out->box_w * dsc_out->box_h;
+    uint8_t * bitmap = size ? _lv_font_glyph_cache_add(font, unicode_letter, dsc_out, size) : NULL;
+    if(bitmap) {
+        const uint8_t * src = face->glyph->bitmap.buffer;
+        uint16_t y;
+        for(y = 0; y < dsc_out->box_h; y++) {
+            lv_memcpy(bitmap + y * dsc_out->box_w, src, dsc_out->box_w);
+            src += face->glyph->bitmap.pitch;
+        }
+        dsc->cached_letter = unicode_letter;
+        dsc->cached_bitmap = bitmap;
+    }
+
     return true;
 }
 
 static const uint8_t * get_glyph_bitmap_cb_nocache(const lv_font_t * font, uint32_t unicode_letter)
 {
-    LV_UNUSED(unicode_letter);
     lv_font_fmt_ft_dsc_t * dsc = (lv_font_fmt_ft_dsc_t *)(font->dsc);
+    if(dsc->cached_bitmap && dsc->cached_letter == unicode_letter) {
+        return dsc->cached_bitmap;
+    }
+
     FT_Face face = dsc->size->face;
     return (const uint8_t *)(face->glyph->bitmap.buffer);
 }
@@ -440,6 +466,8 @@ static bool lv_ft_font_init_nocache(lv_ft_info_t * info)
 
     FT_Set_Pixel_Sizes(face, 0, info->weight);
     dsc->size = face->size;
+    dsc->cached_letter = 0;
+    dsc->cached_bitmap = NULL;
     dsc->height = info->weight;
     dsc->style = info->style;
 
@@ -471,6 +499,8 @@ static void lv_ft_font_destroy_nocache(lv_font_t * font)
         return;
     }
 
+    lv_font_glyph_cache_invalidate_font(font);
+
     lv_font_fmt_ft_dsc_t * dsc = (lv_font_fmt_ft_dsc_t *)(font->dsc);
     if(dsc) {
         FT_Face face = dsc->size->face;
@@ -108,6 +108,7 @@ lv_res_t lv_snapshot_take_to_buf(lv_obj_t * obj, lv_img_cf_t cf, lv_img_dsc_t *
     /*Backup obj original info.*/
     lv_obj_t * parent_old = lv_obj_get_parent(obj);
     lv_area_t coords_bkp;
+    _lv_obj_sync_coords(obj);
     lv_area_copy(&coords_bkp, &obj->coords);
 
     lv_memset(buf, 0x00, buff_size);
@@ -143,6 +144,7 @@ lv_res_t lv_snapshot_take_to_buf(lv_obj_t * obj, lv_img_cf_t cf, lv_img_dsc_t *
     screen->spec_attr->children = &obj;
 
     obj->parent = screen;
+    _lv_obj_style_cache_invalidate(obj);    /*The inherited style properties are taken from the new screen*/
 
     disp->inv_p = 0;
 
@@ -158,6 +160,7 @@ lv_res_t lv_snapshot_take_to_buf(lv_obj_t * obj, lv_img_cf_t cf, lv_img_dsc_t *
 
     /*Restore obj original parameters and clean up*/
     obj->parent = parent_old;
+    _lv_obj_style_cache_invalidate(obj);
     screen->spec_attr->child_cnt = 0;
     screen->spec_attr->children = NULL;
 
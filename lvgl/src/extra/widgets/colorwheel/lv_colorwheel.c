@@ -334,6 +334,7 @@ static void invalidate_knob(lv_obj_t * obj)
 static lv_area_t get_knob_area(lv_obj_t * obj)
 {
     lv_colorwheel_t * colorwheel = (lv_colorwheel_t *)obj;
+    _lv_obj_sync_coords(obj);
 
     /*Get knob's radius*/
     uint16_t r = 0;
@@ -8,6 +8,7 @@
  *********************/
 #include "lv_font.h"
 #include "lv_font_fmt_txt.h"
+#include "lv_font_glyph_cache.h"
 #include "../misc/lv_assert.h"
 #include "../misc/lv_types.h"
 #include "../misc/lv_gc.h"
@@ -19,6 +20,13 @@
  *      DEFINES
  *********************/
 
+/*The last letter cache is shared by all the rendering threads so it can't be used by the parallel renderer*/
+#if LV_USE_REFR_PARALLEL
+    #define GLYPH_CACHE(fdsc) NULL
+#else
+    #define GLYPH_CACHE(fdsc) ((fdsc)->cache)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -32,6 +40,7 @@ typedef enum {
  *  STATIC PROTOTYPES
  **********************/
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static lv_res_t index_add_cmap(lv_font_fmt_txt_index_t * index, const lv_font_fmt_txt_cmap_t * cmap);
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
 static int32_t unicode_list_compare(const void * ref, const void * element);
 static int32_t kern_pair_8_compare(const void * ref, const void * element);
@@ -50,12 +59,12 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
  *  STATIC VARIABLES
  **********************/
 #if LV_USE_FONT_COMPRESSED
-    static uint32_t rle_rdp;
-    static const uint8_t * rle_in;
-    static uint8_t rle_bpp;
-    static uint8_t rle_prev_v;
-    static uint8_t rle_cnt;
-    static rle_state_t rle_state;
+    static LV_DRAW_THREAD_LOCAL uint32_t rle_rdp;
+    static LV_DRAW_THREAD_LOCAL const uint8_t * rle_in;
+    static LV_DRAW_THREAD_LOCAL uint8_t rle_bpp;
+    static LV_DRAW_THREAD_LOCAL uint8_t rle_prev_v;
+    static LV_DRAW_THREAD_LOCAL uint8_t rle_cnt;
+    static LV_DRAW_THREAD_LOCAL rle_state_t rle_state;
 #endif /*LV_USE_FONT_COMPRESSED*/
 
 /**********************
@@ -92,9 +101,12 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
     /*Handle compressed bitmap*/
     else {
 #if LV_USE_FONT_COMPRESSED
-        static size_t last_buf_size = 0;
+        static LV_DRAW_THREAD_LOCAL size_t last_buf_size = 0;
         if(LV_GC_ROOT(_lv_font_decompr_buf) == NULL) last_buf_size = 0;
 
+        const uint8_t * cached = _lv_font_glyph_cache_get(font, unicode_letter, NULL);
+        if(cached) return cached;
+
         uint32_t gsize = gdsc->box_w * gdsc->box_h;
         if(gsize == 0) return NULL;
 
@@ -115,18 +127,23 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
                 break;
         }
 
-        if(last_buf_size < buf_size) {
-            uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
-            LV_ASSERT_MALLOC(tmp);
-            if(tmp == NULL) return NULL;
-            LV_GC_ROOT(_lv_font_decompr_buf) = tmp;
-            last_buf_size = buf_size;
+        /*Decompress into the glyph cache if possible to not decompress it again when it's drawn next time*/
+        uint8_t * out = _lv_font_glyph_cache_add(font, unicode_letter, NULL, buf_size);
+        if(out == NULL) {
+            if(last_buf_size < buf_size) {
+                uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_decompr_buf), buf_size);
+                LV_ASSERT_MALLOC(tmp);
+                if(tmp == NULL) return NULL;
+                LV_GC_ROOT(_lv_font_decompr_buf) = tmp;
+                last_buf_size = buf_size;
+            }
+            out = LV_GC_ROOT(_lv_font_decompr_buf);
         }
 
         bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
-        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], LV_GC_ROOT(_lv_font_decompr_buf), gdsc->box_w, gdsc->box_h,
+        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], out, gdsc->box_w, gdsc->box_h,
                    (uint8_t)fdsc->bpp, prefilter);
-        return LV_GC_ROOT(_lv_font_decompr_buf);
+        return out;
 #else /*!LV_USE_FONT_COMPRESSED*/
         LV_LOG_WARN("Compressed fonts is used but LV_USE_FONT_COMPRESSED is not enabled in lv_conf.h");
         return NULL;
@@ -188,6 +205,91 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     return true;
 }
 
+/**
+ * Build an index to find the glyphs of the letters in O(1) instead of searching in the character maps.
+ * It's worth it for fonts with many sparse character maps, e.g. CJK fonts.
+ * It needs 2 bytes for every 256 letters up to the largest letter of the font
+ * and 512 bytes for every 256 letters with at least one glyph.
+ * @param font pointer to a font in LVGL's native format (built-in or loaded by `lv_font_load()`)
+ * @return LV_RES_OK: the index is built; LV_RES_INV: the font has no `cache`, out of memory
+ *         or the glyph IDs don't fit into 16 bits
+ */
+lv_res_t lv_font_fmt_txt_build_index(const lv_font_t * font)
+{
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    if(fdsc->cache == NULL) {
+        LV_LOG_WARN("The font has no cache to store the index in");
+        return LV_RES_INV;
+    }
+    if(fdsc->cache->index) return LV_RES_OK;
+
+    uint32_t page_cnt = 0;
+    uint16_t i;
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        if(fdsc->cmaps[i].range_length == 0) continue;
+        uint32_t last = fdsc->cmaps[i].range_start + fdsc->cmaps[i].range_length - 1;
+        if((last >> 8) + 1 > page_cnt) page_cnt = (last >> 8) + 1;
+    }
+
+    lv_font_fmt_txt_index_t * index = lv_mem_alloc(sizeof(lv_font_fmt_txt_index_t) + page_cnt * sizeof(uint16_t));
+    LV_ASSERT_MALLOC(index);
+    if(index == NULL) return LV_RES_INV;
+
+    index->page_cnt = page_cnt;
+    index->page_ids = (uint16_t *)(index + 1);
+    index->pages = NULL;
+    lv_memset_00(index->page_ids, page_cnt * sizeof(uint16_t));
+
+    /*Mark the pages with glyphs, then give them IDs*/
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        if(index_add_cmap(index, &fdsc->cmaps[i]) == LV_RES_INV) {
+            lv_mem_free(index);
+            return LV_RES_INV;
+        }
+    }
+
+    uint32_t used_cnt = 0;
+    uint32_t p;
+    for(p = 0; p < page_cnt; p++) {
+        if(index->page_ids[p]) {
+            used_cnt++;
+            index->page_ids[p] = used_cnt;
+        }
+    }
+
+    index->pages = lv_mem_alloc(used_cnt * 256 * sizeof(uint16_t));
+    LV_ASSERT_MALLOC(index->pages);
+    if(index->pages == NULL) {
+        lv_mem_free(index);
+        return LV_RES_INV;
+    }
+    lv_memset_00(index->pages, used_cnt * 256 * sizeof(uint16_t));
+
+    /*Add the character maps in reverse order to keep the glyph of the first map
+     *if a letter is in more maps (that's what searching in the maps finds)*/
+    for(i = fdsc->cmap_num; i > 0; i--) {
+        index_add_cmap(index, &fdsc->cmaps[i - 1]);
+    }
+
+    fdsc->cache->index = index;
+
+    return LV_RES_OK;
+}
+
+/**
+ * Free the index built by `lv_font_fmt_txt_build_index()`. `lv_font_free()` calls it automatically.
+ * @param font pointer to a font in LVGL's native format
+ */
+void lv_font_fmt_txt_free_index(const lv_font_t * font)
+{
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    if(fdsc->cache == NULL || fdsc->cache->index == NULL) return;
+
+    lv_mem_free(fdsc->cache->index->pages);
+    lv_mem_free(fdsc->cache->index);
+    fdsc->cache->index = NULL;
+}
+
 /**
  * Free the allocated memories.
  */
@@ -211,15 +313,30 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
+    /*The index is read only so it can be used by the parallel renderer too*/
+    const lv_font_fmt_txt_index_t * index = fdsc->cache ? fdsc->cache->index : NULL;
+    if(index) {
+        uint32_t page = letter >> 8;
+        if(page >= index->page_cnt) return 0;
+        uint32_t page_id = index->page_ids[page];
+        if(page_id == 0) return 0;
+        return index->pages[((page_id - 1) << 8) + (letter & 0xFF)];
+    }
+
     /*Check the cache first*/
-    if(fdsc->cache && letter == fdsc->cache->last_letter) return fdsc->cache->last_glyph_id;
+    lv_font_fmt_txt_glyph_cache_t * cache = GLYPH_CACHE(fdsc);
+    lv_font_fmt_txt_glyph_cache_entry_t * cache_entry = NULL;
+    if(cache) {
+        cache_entry = &cache->entries[letter % LV_FONT_FMT_TXT_CACHE_SIZE];
+        if(letter == cache_entry->letter) return cache_entry->glyph_id;
+    }
 
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
 
         /*Relative code point*/
         uint32_t rcp = letter - fdsc->cmaps[i].range_start;
-        if(rcp > fdsc->cmaps[i].range_length) continue;
+        if(rcp >= fdsc->cmaps[i].range_length) continue;
         uint32_t glyph_id = 0;
         if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
             glyph_id = fdsc->cmaps[i].glyph_id_start + rcp;
@@ -251,21 +368,73 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
         }
 
         /*Update the cache*/
-        if(fdsc->cache) {
-            fdsc->cache->last_letter = letter;
-            fdsc->cache->last_glyph_id = glyph_id;
+        if(cache_entry) {
+            cache_entry->letter = letter;
+            cache_entry->glyph_id = glyph_id;
         }
         return glyph_id;
     }
 
-    if(fdsc->cache) {
-        fdsc->cache->last_letter = letter;
-        fdsc->cache->last_glyph_id = 0;
+    if(cache_entry) {
+        cache_entry->letter = letter;
+        cache_entry->glyph_id = 0;
     }
     return 0;
 
 }
 
+/**
+ * Add the letters of a character map to an index.
+ * If the pages are not allocated yet only the pages of the letters are marked in `page_ids`,
+ * else their glyph IDs are written to the pages.
+ * @return LV_RES_OK: success; LV_RES_INV: a glyph ID doesn't fit into 16 bits
+ */
+static lv_res_t index_add_cmap(lv_font_fmt_txt_index_t * index, const lv_font_fmt_txt_cmap_t * cmap)
+{
+    bool sparse = cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY || cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL;
+    uint32_t cnt = sparse ? cmap->list_length : cmap->range_length;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        uint32_t letter;
+        uint32_t glyph_id;
+        if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
+            letter = cmap->range_start + i;
+            glyph_id = cmap->glyph_id_start + i;
+        }
+        else if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
+            const uint8_t * gid_ofs_8 = cmap->glyph_id_ofs_list;
+            letter = cmap->range_start + i;
+            glyph_id = cmap->glyph_id_start + gid_ofs_8[i];
+        }
+        else if(cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) {
+            letter = cmap->range_start + cmap->unicode_list[i];
+            glyph_id = cmap->glyph_id_start + i;
+        }
+        else if(cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) {
+            const uint16_t * gid_ofs_16 = cmap->glyph_id_ofs_list;
+            letter = cmap->range_start + cmap->unicode_list[i];
+            glyph_id = cmap->glyph_id_start + gid_ofs_16[i];
+        }
+        else {
+            return LV_RES_OK;
+        }
+
+        /*Same as searching in the map: letters out of the range are not found*/
+        if(letter - cmap->range_start >= cmap->range_length) continue;
+
+        if(index->pages == NULL) {
+            if(glyph_id > UINT16_MAX) return LV_RES_INV;
+            index->page_ids[letter >> 8] = 1;
+        }
+        else {
+            uint32_t page_id = index->page_ids[letter >> 8];
+            index->pages[((page_id - 1) << 8) + (letter & 0xFF)] = (uint16_t)glyph_id;
+        }
+    }
+
+    return LV_RES_OK;
+}
+
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
 {
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
@@ -17,6 +17,7 @@ extern "C" {
 #include <stddef.h>
 #include <stdbool.h>
 #include "lv_font.h"
+#include "../misc/lv_types.h"
 
 /*********************
  *      DEFINES
@@ -151,11 +152,36 @@ typedef enum {
     LV_FONT_FMT_TXT_COMPRESSED_NO_PREFILTER = 1,
 } lv_font_fmt_txt_bitmap_format_t;
 
+/** A letter and its glyph ID in `lv_font_fmt_txt_glyph_cache_t`*/
 typedef struct {
-    uint32_t last_letter;
-    uint32_t last_glyph_id;
+    uint32_t letter;
+    uint32_t glyph_id;
+} lv_font_fmt_txt_glyph_cache_entry_t;
+
+/** Find the glyph ID of any letter in O(1) with a two level table. See `lv_font_fmt_txt_build_index()`*/
+typedef struct {
+    /*Number of elements in `page_ids`. The font has no letters from `page_cnt * 256`*/
+    uint32_t page_cnt;
+
+    /*Every 256 letters has an element: 0 if there are no glyphs for them,
+     *else the index of their page in `pages` + 1*/
+    uint16_t * page_ids;
+
+    /*The glyph ID of the 256 letters on every page (0: not in the font)*/
+    uint16_t * pages;
+} lv_font_fmt_txt_index_t;
+
+/** Data of a font in RAM to find the glyph IDs faster*/
+typedef struct {
+    /*Cache the glyph IDs of the recently used letters.
+     *Direct mapped: a letter can be stored only in `entries[letter % LV_FONT_FMT_TXT_CACHE_SIZE]`*/
+    lv_font_fmt_txt_glyph_cache_entry_t entries[LV_FONT_FMT_TXT_CACHE_SIZE];
+
+    /*Optional index to find the glyph IDs without searching in the `cmaps`. See `lv_font_fmt_txt_build_index()`*/
+    lv_font_fmt_txt_index_t * index;
 } lv_font_fmt_txt_glyph_cache_t;
 
+
 /*Describe store additional data for fonts*/
 typedef struct {
     /*The bitmaps of all glyphs*/
@@ -193,7 +219,7 @@ typedef struct {
      */
     uint16_t bitmap_format  : 2;
 
-    /*Cache the last letter and is glyph id*/
+    /*Cache the glyph id of the last letters and store the index of the font*/
     lv_font_fmt_txt_glyph_cache_t * cache;
 } lv_font_fmt_txt_dsc_t;
 
@@ -220,6 +246,23 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t lett
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                    uint32_t unicode_letter_next);
 
+/**
+ * Build an index to find the glyphs of the letters in O(1) instead of searching in the character maps.
+ * It's worth it for fonts with many sparse character maps, e.g. CJK fonts.
+ * It needs 2 bytes for every 256 letters up to the largest letter of the font
+ * and 512 bytes for every 256 letters with at least one glyph.
+ * @param font pointer to a font in LVGL's native format (built-in or loaded by `lv_font_load()`)
+ * @return LV_RES_OK: the index is built; LV_RES_INV: the font has no `cache`, out of memory
+ *         or the glyph IDs don't fit into 16 bits
+ */
+lv_res_t lv_font_fmt_txt_build_index(const lv_font_t * font);
+
+/**
+ * Free the index built by `lv_font_fmt_txt_build_index()`. `lv_font_free()` calls it automatically.
+ * @param font pointer to a font in LVGL's native format
+ */
+void lv_font_fmt_txt_free_index(const lv_font_t * font);
+
 /**
  * Free the allocated memories.
  */
@@ -0,0 +1,319 @@
+/**
+ * @file lv_font_glyph_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_font_glyph_cache.h"
+#include "../misc/lv_assert.h"
+#include "../misc/lv_gc.h"
+#include "../misc/lv_mem.h"
+#include "../misc/lv_log.h"
+#include "../core/lv_refr.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*The atlas is split into this many pages. The least recently used page is emptied when more space is needed*/
+#define LV_FONT_GLYPH_CACHE_PAGE_CNT    8
+
+/*Have a hash slot for this many bytes of the atlas*/
+#define LV_FONT_GLYPH_CACHE_BYTES_PER_SLOT  256
+
+#define LV_FONT_GLYPH_CACHE_ALIGN(x)    (((x) + sizeof(void *) - 1) & ~(sizeof(void *) - 1))
+#define LV_FONT_GLYPH_CACHE_HEADER_SIZE LV_FONT_GLYPH_CACHE_ALIGN(sizeof(lv_font_glyph_cache_rec_t))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+/**
+ * Header of a glyph in the atlas. The bitmap follows it.
+ */
+typedef struct _lv_font_glyph_cache_rec_t {
+    struct _lv_font_glyph_cache_rec_t * hash_next;  /**< Next glyph in the same hash slot*/
+    const lv_font_t * font;                         /**< NULL if the glyph was invalidated*/
+    uint32_t letter;
+    uint32_t size;                                  /**< Size of the record with the bitmap [bytes]*/
+    lv_font_glyph_dsc_t dsc;
+} lv_font_glyph_cache_rec_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool cache_is_usable(void);
+static bool cache_alloc(void);
+static uint32_t cache_hash(const lv_font_t * font, uint32_t letter);
+static void cache_unlink(lv_font_glyph_cache_rec_t * rec);
+static void page_release(uint32_t page_id, const lv_font_t * font, bool evict);
+static uint32_t page_get_lru(void);
+static void page_touch(uint32_t page_id);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint32_t cache_size = LV_FONT_GLYPH_CACHE_SIZE;
+static lv_font_glyph_cache_rec_t ** hash_table;     /*The first glyph in every hash slot. At the start of the buffer*/
+static uint32_t hash_mask;
+static uint8_t * pages;                             /*The pages of the atlas. After the hash table*/
+static uint32_t page_size;
+static uint32_t page_used[LV_FONT_GLYPH_CACHE_PAGE_CNT];
+static uint32_t page_stamp[LV_FONT_GLYPH_CACHE_PAGE_CNT];
+static uint32_t page_act;                           /*New glyphs are added to this page*/
+static uint32_t cache_clock;
+static lv_font_glyph_cache_stats_t cache_stats;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Get a glyph's bitmap from the cache.
+ * @param font pointer to the font
+ * @param letter the unicode letter
+ * @param dsc_out if not NULL the glyph descriptor stored with the bitmap is copied here
+ * @return pointer to the bitmap in the font's own format (`bpp`) or NULL if not cached.
+ *         Valid only until the next `_lv_font_glyph_cache_add()`.
+ */
+const uint8_t * _lv_font_glyph_cache_get(const lv_font_t * font, uint32_t letter, lv_font_glyph_dsc_t * dsc_out)
+{
+    if(!cache_is_usable()) return NULL;
+
+    if(LV_GC_ROOT(_lv_font_glyph_cache_buf)) {
+        lv_font_glyph_cache_rec_t * rec = hash_table[cache_hash(font, letter) & hash_mask];
+        while(rec) {
+            if(rec->letter == letter && rec->font == font) {
+                cache_stats.hit_cnt++;
+                page_touch(((uint8_t *)rec - pages) / page_size);
+                if(dsc_out) *dsc_out = rec->dsc;
+                return (uint8_t *)rec + LV_FONT_GLYPH_CACHE_HEADER_SIZE;
+            }
+            rec = rec->hash_next;
+        }
+    }
+
+    cache_stats.miss_cnt++;
+    return NULL;
+}
+
+/**
+ * Reserve space in the cache for a glyph's bitmap. The caller should write the bitmap to the returned buffer.
+ * The least recently used glyphs are dropped if there is not enough space.
+ * @param font pointer to the font
+ * @param letter the unicode letter
+ * @param dsc the glyph descriptor to store with the bitmap (can be NULL if not needed)
+ * @param size size of the bitmap in bytes
+ * @return pointer to a `size` bytes long buffer or NULL if the glyph can't be cached
+ */
+uint8_t * _lv_font_glyph_cache_add(const lv_font_t * font, uint32_t letter, const lv_font_glyph_dsc_t * dsc,
+                                   uint32_t size)
+{
+    if(!cache_is_usable()) return NULL;
+    if(LV_GC_ROOT(_lv_font_glyph_cache_buf) == NULL && !cache_alloc()) return NULL;
+
+    uint32_t rec_size = LV_FONT_GLYPH_CACHE_HEADER_SIZE + LV_FONT_GLYPH_CACHE_ALIGN(size);
+    if(rec_size > page_size) return NULL;
+
+    if(page_used[page_act] + rec_size > page_size) {
+        page_act = page_get_lru();
+        page_release(page_act, NULL, true);
+    }
+
+    lv_font_glyph_cache_rec_t * rec = (lv_font_glyph_cache_rec_t *)(pages + page_act * page_size + page_used[page_act]);
+    page_used[page_act] += rec_size;
+    page_touch(page_act);
+
+    rec->font = font;
+    rec->letter = letter;
+    rec->size = rec_size;
+    if(dsc) rec->dsc = *dsc;
+    else lv_memset_00(&rec->dsc, sizeof(lv_font_glyph_dsc_t));
+
+    lv_font_glyph_cache_rec_t ** slot = &hash_table[cache_hash(font, letter) & hash_mask];
+    rec->hash_next = *slot;
+    *slot = rec;
+
+    cache_stats.glyph_cnt++;
+    cache_stats.mem_size += rec_size;
+
+    return (uint8_t *)rec + LV_FONT_GLYPH_CACHE_HEADER_SIZE;
+}
+
+/**
+ * Set the memory used by the glyph cache. The memory is allocated when the first glyph is cached.
+ * @param size size of the atlas in bytes. 0: disable the cache
+ */
+void lv_font_glyph_cache_set_size(uint32_t size)
+{
+    if(LV_GC_ROOT(_lv_font_glyph_cache_buf)) {
+        lv_mem_free(LV_GC_ROOT(_lv_font_glyph_cache_buf));
+        LV_GC_ROOT(_lv_font_glyph_cache_buf) = NULL;
+    }
+
+    cache_stats.glyph_cnt = 0;
+    cache_stats.mem_size = 0;
+    cache_size = size;
+}
+
+/**
+ * Drop the cached glyphs of a font. Needs to be called before freeing a font which might be cached.
+ * @param font pointer to a font or NULL to drop all glyphs
+ */
+void lv_font_glyph_cache_invalidate_font(const lv_font_t * font)
+{
+    if(LV_GC_ROOT(_lv_font_glyph_cache_buf) == NULL) return;
+
+    uint32_t i;
+    for(i = 0; i < LV_FONT_GLYPH_CACHE_PAGE_CNT; i++) {
+        page_release(i, font, false);
+    }
+}
+
+/**
+ * Get the statistics of the glyph cache
+ * @param stats pointer to a variable to store the statistics
+ */
+void lv_font_glyph_cache_get_stats(lv_font_glyph_cache_stats_t * stats)
+{
+    *stats = cache_stats;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool cache_is_usable(void)
+{
+    if(cache_size == 0) return false;
+
+#if LV_USE_REFR_PARALLEL
+    /*A glyph could be dropped by an other rendering thread while it's being drawn*/
+    if(_lv_refr_is_parallel()) return false;
+#endif
+
+    return true;
+}
+
+/**
+ * Allocate the hash table and the atlas and reset the cache
+ * @return true: success; false: out of memory
+ */
+static bool cache_alloc(void)
+{
+    uint32_t slot_cnt = 16;
+    while(slot_cnt * LV_FONT_GLYPH_CACHE_BYTES_PER_SLOT < cache_size) slot_cnt <<= 1;
+
+    uint32_t table_size = slot_cnt * sizeof(lv_font_glyph_cache_rec_t *);
+    if(cache_size <= table_size) return false;
+
+    page_size = ((cache_size - table_size) / LV_FONT_GLYPH_CACHE_PAGE_CNT) & ~(sizeof(void *) - 1);
+    if(page_size < LV_FONT_GLYPH_CACHE_HEADER_SIZE) return false;
+
+    uint8_t * buf = lv_mem_alloc(table_size + page_size * LV_FONT_GLYPH_CACHE_PAGE_CNT);
+    LV_ASSERT_MALLOC(buf);
+    if(buf == NULL) {
+        LV_LOG_WARN("Couldn't allocate the glyph cache");
+        return false;
+    }
+
+    LV_GC_ROOT(_lv_font_glyph_cache_buf) = buf;
+    hash_table = (lv_font_glyph_cache_rec_t **)buf;
+    hash_mask = slot_cnt - 1;
+    pages = buf + table_size;
+    lv_memset_00(hash_table, table_size);
+    lv_memset_00(page_used, sizeof(page_used));
+    lv_memset_00(page_stamp, sizeof(page_stamp));
+    page_act = 0;
+    cache_clock = 0;
+    cache_stats.glyph_cnt = 0;
+    cache_stats.mem_size = 0;
+
+    return true;
+}
+
+static uint32_t cache_hash(const lv_font_t * font, uint32_t letter)
+{
+    uint32_t h = (uint32_t)((lv_uintptr_t)font >> 2) ^ (letter * 2654435761u);
+    h ^= h >> 16;
+    return h;
+}
+
+/**
+ * Remove a glyph from its hash chain
+ */
+static void cache_unlink(lv_font_glyph_cache_rec_t * rec)
+{
+    lv_font_glyph_cache_rec_t ** link = &hash_table[cache_hash(rec->font, rec->letter) & hash_mask];
+    while(*link) {
+        if(*link == rec) {
+            *link = rec->hash_next;
+            break;
+        }
+        link = &(*link)->hash_next;
+    }
+
+    cache_stats.glyph_cnt--;
+    cache_stats.mem_size -= rec->size;
+    rec->font = NULL;
+}
+
+/**
+ * Drop the glyphs of a page
+ * @param page_id index of the page
+ * @param font drop only the glyphs of this font, the others are kept; NULL: empty the whole page
+ * @param evict true: count the dropped glyphs as evicted
+ */
+static void page_release(uint32_t page_id, const lv_font_t * font, bool evict)
+{
+    uint8_t * page = pages + page_id * page_size;
+    uint32_t ofs = 0;
+    while(ofs < page_used[page_id]) {
+        lv_font_glyph_cache_rec_t * rec = (lv_font_glyph_cache_rec_t *)(page + ofs);
+        ofs += rec->size;
+        if(rec->font == NULL) continue;
+        if(font && rec->font != font) continue;
+
+        cache_unlink(rec);
+        if(evict) cache_stats.evict_cnt++;
+    }
+
+    /*The space of the dropped glyphs can be reused only if the whole page is emptied*/
+    if(font == NULL) page_used[page_id] = 0;
+}
+
+/**
+ * Find the least recently used page
+ */
+static uint32_t page_get_lru(void)
+{
+    uint32_t lru = 0;
+    uint32_t i;
+    for(i = 1; i < LV_FONT_GLYPH_CACHE_PAGE_CNT; i++) {
+        if(page_stamp[i] < page_stamp[lru]) lru = i;
+    }
+
+    return lru;
+}
+
+static void page_touch(uint32_t page_id)
+{
+    /*Rebase the stamps to avoid overflow*/
+    if(cache_clock == UINT32_MAX) {
+        uint32_t min = page_stamp[page_get_lru()];
+        uint32_t i;
+        for(i = 0; i < LV_FONT_GLYPH_CACHE_PAGE_CNT; i++) page_stamp[i] -= min;
+        cache_clock -= min;
+        if(cache_clock == UINT32_MAX) {
+            lv_memset_00(page_stamp, sizeof(page_stamp));
+            cache_clock = 0;
+        }
+    }
+
+    cache_clock++;
+    page_stamp[page_id] = cache_clock;
+}
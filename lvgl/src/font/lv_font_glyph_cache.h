@@ -0,0 +1,89 @@
+/**
+ * @file lv_font_glyph_cache.h
+ *
+ */
+
+#ifndef LV_FONT_GLYPH_CACHE_H
+#define LV_FONT_GLYPH_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_font.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Statistics about the usage of the glyph cache
+ */
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of glyphs served from the cache*/
+    uint32_t miss_cnt;      /**< Number of glyphs which had to be decompressed or rendered*/
+    uint32_t evict_cnt;     /**< Number of glyphs dropped to make room for others*/
+    uint32_t mem_size;      /**< Memory used by the cached glyphs in the atlas [bytes]*/
+    uint32_t glyph_cnt;     /**< Number of cached glyphs*/
+} lv_font_glyph_cache_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get a glyph's bitmap from the cache.
+ * @param font pointer to the font
+ * @param letter the unicode letter
+ * @param dsc_out if not NULL the glyph descriptor stored with the bitmap is copied here
+ * @return pointer to the bitmap in the font's own format (`bpp`) or NULL if not cached.
+ *         Valid only until the next `_lv_font_glyph_cache_add()`.
+ */
+const uint8_t * _lv_font_glyph_cache_get(const lv_font_t * font, uint32_t letter, lv_font_glyph_dsc_t * dsc_out);
+
+/**
+ * Reserve space in the cache for a glyph's bitmap. The caller should write the bitmap to the returned buffer.
+ * The least recently used glyphs are dropped if there is not enough space.
+ * @param font pointer to the font
+ * @param letter the unicode letter
+ * @param dsc the glyph descriptor to store with the bitmap (can be NULL if not needed)
+ * @param size size of the bitmap in bytes
+ * @return pointer to a `size` bytes long buffer or NULL if the glyph can't be cached
+ */
+uint8_t * _lv_font_glyph_cache_add(const lv_font_t * font, uint32_t letter, const lv_font_glyph_dsc_t * dsc,
+                                   uint32_t size);
+
+/**
+ * Set the memory used by the glyph cache. The memory is allocated when the first glyph is cached.
+ * @param size size of the atlas in bytes. 0: disable the cache
+ */
+void lv_font_glyph_cache_set_size(uint32_t size);
+
+/**
+ * Drop the cached glyphs of a font. Needs to be called before freeing a font which might be cached.
+ * @param font pointer to a font or NULL to drop all glyphs
+ */
+void lv_font_glyph_cache_invalidate_font(const lv_font_t * font);
+
+/**
+ * Get the statistics of the glyph cache
+ * @param stats pointer to a variable to store the statistics
+ */
+void lv_font_glyph_cache_get_stats(lv_font_glyph_cache_stats_t * stats);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_FONT_GLYPH_CACHE_H*/
@@ -117,9 +117,12 @@ lv_font_t * lv_font_load(const char * font_name)
 void lv_font_free(lv_font_t * font)
 {
     if(NULL != font) {
+        lv_font_glyph_cache_invalidate_font(font);
+
         lv_font_fmt_txt_dsc_t * dsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
         if(NULL != dsc) {
+            lv_font_fmt_txt_free_index(font);
 
             if(dsc->kern_classes == 0) {
                 lv_font_fmt_txt_kern_pair_t * kern_dsc =
@@ -172,6 +175,9 @@ void lv_font_free(lv_font_t * font)
             if(NULL != dsc->glyph_dsc) {
                 lv_mem_free((void *)dsc->glyph_dsc);
             }
+            if(NULL != dsc->cache) {
+                lv_mem_free(dsc->cache);
+            }
             lv_mem_free(dsc);
         }
         lv_mem_free(font);
@@ -489,6 +495,13 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
 
     font->dsc = font_dsc;
 
+    /*Cache the glyph IDs like the built-in fonts. It also stores the index built by `lv_font_fmt_txt_build_index`*/
+    font_dsc->cache = lv_mem_alloc(sizeof(lv_font_fmt_txt_glyph_cache_t));
+    if(font_dsc->cache == NULL) {
+        return false;
+    }
+    memset(font_dsc->cache, 0, sizeof(lv_font_fmt_txt_glyph_cache_t));
+
     /*header*/
     int32_t header_length = read_label(fp, 0, "head");
     if(header_length < 0) {
@@ -218,6 +218,8 @@ void lv_disp_drv_update(lv_disp_t * disp, lv_disp_drv_t * new_drv)
     lv_memset_00(disp->inv_areas, sizeof(disp->inv_areas));
     lv_memset_00(disp->inv_area_joined, sizeof(disp->inv_area_joined));
     disp->inv_p = 0;
+    disp->scroll_blit_ofs.x = 0;
+    disp->scroll_blit_ofs.y = 0;
     if(disp->act_scr != NULL) lv_obj_invalidate(disp->act_scr);
 
     lv_obj_tree_walk(NULL, invalidate_layout_cb, NULL);
@@ -503,6 +505,22 @@ lv_disp_draw_buf_t * lv_disp_get_draw_buf(lv_disp_t * disp)
     return disp->driver->draw_buf;
 }
 
+/**
+ * Get the statistics of the last refresh of a display
+ * @param disp pointer to a display (NULL to use the default display)
+ * @param stats pointer to a variable to store the statistics
+ */
+void lv_disp_get_refr_stats(lv_disp_t * disp, lv_disp_refr_stats_t * stats)
+{
+    if(disp == NULL) disp = lv_disp_get_default();
+    if(disp == NULL) {
+        lv_memset_00(stats, sizeof(lv_disp_refr_stats_t));
+        return;
+    }
+
+    *stats = disp->refr_stats;
+}
+
 /**
  * Set the rotation of this display.
  * @param disp pointer to a display (NULL to use the default display)
@@ -27,10 +27,6 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
-#ifndef LV_INV_BUF_SIZE
-#define LV_INV_BUF_SIZE 32 /*Buffer size for invalid areas*/
-#endif
-
 #ifndef LV_ATTRIBUTE_FLUSH_READY
 #define LV_ATTRIBUTE_FLUSH_READY
 #endif
@@ -96,6 +92,8 @@ typedef struct _lv_disp_drv_t {
     uint32_t rotated : 2;            /**< 1: turn the display by 90 degree. @warning Does not update coordinates for you!*/
     uint32_t screen_transp : 1;      /**Handle if the screen doesn't have a solid (opa == LV_OPA_COVER) background.
                                        * Use only if required because it's slower.*/
+    uint32_t scroll_blit : 1;        /**< 1: In direct mode move the content of the scrolled objects in the frame buffer
+                                       * instead of redrawing it if possible*/
 
     uint32_t dpi : 10;              /** DPI (dot per inch) of the display. Default value is `LV_DPI_DEF`.*/
 
@@ -113,6 +111,14 @@ typedef struct _lv_disp_drv_t {
     void (*set_px_cb)(struct _lv_disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y,
                       lv_color_t color, lv_opa_t opa);
 
+    /** OPTIONAL: Set a horizontal run of `len` pixels from (`x`;`y`) in a buffer. If set it's used instead of `set_px_cb`
+     * so the driver can convert several pixels in one call.
+     * `colors` has a color for every pixel or it's `NULL` if all pixels have `color`.
+     * `mask` has an opacity for every pixel or it's `NULL`. With a mask the opacity of the i-th pixel is
+     * `(opa * mask[i]) >> 8` and the pixels where `mask[i] == 0` should be left unchanged.*/
+    void (*set_px_span_cb)(struct _lv_disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y,
+                           lv_coord_t len, const lv_color_t * colors, lv_color_t color, const lv_opa_t * mask, lv_opa_t opa);
+
     /** OPTIONAL: Called after every refresh cycle to tell the rendering and flushing time + the
      * number of flushed pixels*/
     void (*monitor_cb)(struct _lv_disp_drv_t * disp_drv, uint32_t time, uint32_t px);
@@ -145,6 +151,19 @@ typedef struct _lv_disp_drv_t {
 
 } lv_disp_drv_t;
 
+/**
+ * Statistics about the refreshing of a display
+ */
+typedef struct {
+    uint32_t inv_cnt;           /**< Number of areas invalidated*/
+    uint32_t merge_cnt;         /**< Number of areas merged because the buffer of the invalid areas was full*/
+    uint32_t area_cnt;          /**< Number of areas redrawn*/
+    uint32_t px_cnt;            /**< Number of pixels redrawn*/
+    uint32_t style_lookup_cnt;  /**< Number of style properties got while updating the layouts and redrawing*/
+    uint32_t style_resolve_cnt; /**< Number of style properties not found in the style cache of the objects*/
+    uint32_t blit_px_cnt;       /**< Number of pixels moved in the frame buffer by scrolling instead of redrawing them*/
+} lv_disp_refr_stats_t;
+
 /**
  * Display structure.
  * @note `lv_disp_drv_t` should be the first member of the structure.
@@ -179,6 +198,12 @@ uint8_t del_prev  :
     lv_area_t inv_areas[LV_INV_BUF_SIZE];
     uint8_t inv_area_joined[LV_INV_BUF_SIZE];
     uint16_t inv_p;
+    lv_disp_refr_stats_t inv_stats;     /**< Statistics collected since the last refresh*/
+    lv_disp_refr_stats_t refr_stats;    /**< Statistics of the last refresh*/
+
+    /** Area of the frame buffer to move by `scroll_blit_ofs` before the next refresh. See `scroll_blit`*/
+    lv_area_t scroll_blit_area;
+    lv_point_t scroll_blit_ofs;
 
     /*Miscellaneous data*/
     uint32_t last_activity_time;        /**< Last time when there was activity on this display*/
@@ -349,6 +374,13 @@ lv_disp_t * lv_disp_get_next(lv_disp_t * disp);
  */
 lv_disp_draw_buf_t * lv_disp_get_draw_buf(lv_disp_t * disp);
 
+/**
+ * Get the statistics of the last refresh of a display
+ * @param disp pointer to a display (NULL to use the default display)
+ * @param stats pointer to a variable to store the statistics
+ */
+void lv_disp_get_refr_stats(lv_disp_t * disp, lv_disp_refr_stats_t * stats);
+
 void lv_disp_drv_use_generic_set_px_cb(lv_disp_drv_t * disp_drv, lv_img_cf_t cf);
 
 /**********************
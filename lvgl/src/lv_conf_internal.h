@@ -203,6 +203,26 @@
 #  endif
 #endif
 
+/*Number of invalidated areas to save for redrawing. If more areas are invalidated
+ *the two areas which can be joined with the fewest extra pixels are joined*/
+#ifndef LV_INV_BUF_SIZE
+#  ifdef CONFIG_LV_INV_BUF_SIZE
+#    define LV_INV_BUF_SIZE CONFIG_LV_INV_BUF_SIZE
+#  else
+#    define LV_INV_BUF_SIZE 32
+#  endif
+#endif
+
+/*Cost of redrawing one more area expressed in pixels.
+ *Two areas are redrawn as one if it adds fewer extra pixels than this*/
+#ifndef LV_REFR_AREA_COST
+#  ifdef CONFIG_LV_REFR_AREA_COST
+#    define LV_REFR_AREA_COST CONFIG_LV_REFR_AREA_COST
+#  else
+#    define LV_REFR_AREA_COST 256     /*[px]*/
+#  endif
+#endif
+
 /*Input device read period in milliseconds*/
 #ifndef LV_INDEV_DEF_READ_PERIOD
 #  ifdef CONFIG_LV_INDEV_DEF_READ_PERIOD
@@ -248,6 +268,16 @@
 #  endif
 #endif
 
+/*Enable the pthread based thread, mutex and condition variable wrappers of `lv_thread.h`.
+ *Required by the features which use worker threads. With LV_MEM_CUSTOM == 0 the built-in allocator is locked by a mutex too.*/
+#ifndef LV_USE_PTHREAD
+#  ifdef CONFIG_LV_USE_PTHREAD
+#    define LV_USE_PTHREAD CONFIG_LV_USE_PTHREAD
+#  else
+#    define LV_USE_PTHREAD 0
+#  endif
+#endif
+
 /*=======================
  * FEATURE CONFIGURATION
  *=======================*/
@@ -273,7 +303,8 @@
 
 /*Allow buffering some shadow calculation.
  *LV_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
- *Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
+ *A buffered shadow has shadow size^2 RAM cost. Several shadows are buffered and
+ *the least recently used ones are dropped if they need more than LV_SHADOW_CACHE_MEM_SIZE bytes*/
 #ifndef LV_SHADOW_CACHE_SIZE
 #  ifdef CONFIG_LV_SHADOW_CACHE_SIZE
 #    define LV_SHADOW_CACHE_SIZE CONFIG_LV_SHADOW_CACHE_SIZE
@@ -281,10 +312,27 @@
 #    define LV_SHADOW_CACHE_SIZE 0
 #  endif
 #endif
+#ifndef LV_SHADOW_CACHE_MEM_SIZE
+#  ifdef CONFIG_LV_SHADOW_CACHE_MEM_SIZE
+#    define LV_SHADOW_CACHE_MEM_SIZE CONFIG_LV_SHADOW_CACHE_MEM_SIZE
+#  else
+#    define LV_SHADOW_CACHE_MEM_SIZE (LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE * 4)
+#  endif
+#endif
+
+/*1: Blur the shadows with one box blur instead of two. It's faster but the shadows are less smooth*/
+#ifndef LV_SHADOW_BLUR_FAST
+#  ifdef CONFIG_LV_SHADOW_BLUR_FAST
+#    define LV_SHADOW_BLUR_FAST CONFIG_LV_SHADOW_BLUR_FAST
+#  else
+#    define LV_SHADOW_BLUR_FAST 0
+#  endif
+#endif
 
 /* Set number of maximally cached circle data.
  * The circumference of 1/4 circle are saved for anti-aliasing
- * radius * 4 bytes are used per circle (the most often used radiuses are saved)
+ * radius * 6 bytes are used per circle (the least recently used radiuses are dropped)
+ * The cache is kept between the refreshes and shared by the rendering threads
  * 0: to disable caching */
 #ifndef LV_CIRCLE_CACHE_SIZE
 #  ifdef CONFIG_LV_CIRCLE_CACHE_SIZE
@@ -309,6 +357,43 @@
 #  endif
 #endif
 
+/*Default memory limit of the decoded images in the image cache [bytes].
+ *If exceeded the least valuable images are closed even if there are free entries.
+ *0: no limit, only LV_IMG_CACHE_DEF_SIZE matters*/
+#ifndef LV_IMG_CACHE_DEF_MEM_SIZE
+#  ifdef CONFIG_LV_IMG_CACHE_DEF_MEM_SIZE
+#    define LV_IMG_CACHE_DEF_MEM_SIZE CONFIG_LV_IMG_CACHE_DEF_MEM_SIZE
+#  else
+#    define LV_IMG_CACHE_DEF_MEM_SIZE 0
+#  endif
+#endif
+
+/*Open the images which are slow to decode (files and PNG, JPG, etc. in C arrays) on background threads.
+ *Until an image is decoded nothing is drawn in its place and its area is redrawn when it's ready.
+ *The callbacks of a decoder are called one by one (unless it's thread-safe) but the file system drivers need to be thread-safe.
+ *Requires LV_USE_PTHREAD and LV_IMG_CACHE_DEF_SIZE > 0*/
+#ifndef LV_IMG_CACHE_ASYNC
+#  ifdef CONFIG_LV_IMG_CACHE_ASYNC
+#    define LV_IMG_CACHE_ASYNC CONFIG_LV_IMG_CACHE_ASYNC
+#  else
+#    define LV_IMG_CACHE_ASYNC 0
+#  endif
+#endif
+#if LV_IMG_CACHE_ASYNC
+/*Number of decoding threads*/
+#ifndef LV_IMG_CACHE_ASYNC_THREAD_CNT
+#  ifdef _LV_KCONFIG_PRESENT
+#    ifdef CONFIG_LV_IMG_CACHE_ASYNC_THREAD_CNT
+#      define LV_IMG_CACHE_ASYNC_THREAD_CNT CONFIG_LV_IMG_CACHE_ASYNC_THREAD_CNT
+#    else
+#      define LV_IMG_CACHE_ASYNC_THREAD_CNT 0
+#    endif
+#  else
+#    define LV_IMG_CACHE_ASYNC_THREAD_CNT 1
+#  endif
+#endif
+#endif
+
 /*Maximum buffer size to allocate for rotation. Only used if software rotation is enabled in the display driver.*/
 #ifndef LV_DISP_ROT_MAX_BUF
 #  ifdef CONFIG_LV_DISP_ROT_MAX_BUF
@@ -318,6 +403,42 @@
 #  endif
 #endif
 
+/*Render the bands of the invalidated areas on more threads in parallel. Requires LV_USE_PTHREAD.
+ *Every extra thread allocates a draw buffer with the same size as the display's draw buffer.
+ *The draw events of the widgets are sent from the rendering threads so their handlers can't modify any objects.*/
+#ifndef LV_USE_REFR_PARALLEL
+#  ifdef CONFIG_LV_USE_REFR_PARALLEL
+#    define LV_USE_REFR_PARALLEL CONFIG_LV_USE_REFR_PARALLEL
+#  else
+#    define LV_USE_REFR_PARALLEL 0
+#  endif
+#endif
+#if LV_USE_REFR_PARALLEL
+/*Max. number of rendering threads including the one calling `lv_timer_handler()`*/
+#ifndef LV_REFR_PARALLEL_THREAD_CNT
+#  ifdef CONFIG_LV_REFR_PARALLEL_THREAD_CNT
+#    define LV_REFR_PARALLEL_THREAD_CNT CONFIG_LV_REFR_PARALLEL_THREAD_CNT
+#  else
+#    define LV_REFR_PARALLEL_THREAD_CNT 4
+#  endif
+#endif
+#endif
+
+/*Use the SIMD instructions of the CPU in the software blending: SSE2 and AVX2 on x86, NEON on ARM.
+ *The fastest instruction set supported by the CPU is selected in `lv_init()`.
+ *Used with 32 bit and not swapped 16 bit color depths. The result is the same as without SIMD.*/
+#ifndef LV_USE_DRAW_SIMD
+#  ifdef _LV_KCONFIG_PRESENT
+#    ifdef CONFIG_LV_USE_DRAW_SIMD
+#      define LV_USE_DRAW_SIMD CONFIG_LV_USE_DRAW_SIMD
+#    else
+#      define LV_USE_DRAW_SIMD 0
+#    endif
+#  else
+#    define LV_USE_DRAW_SIMD 1
+#  endif
+#endif
+
 /*-------------
  * GPU
  *-----------*/
@@ -692,6 +813,18 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 #  endif
 #endif
 
+/*Number of resolved style properties to cache per object. Must be a power of 2.
+ *It makes the `lv_obj_get_style_...()` functions faster but uses (LV_OBJ_STYLE_CACHE_SIZE * 8) bytes per object.
+ *The changes of the shared styles are seen only after `lv_obj_report_style_change()`.
+ *0: to disable caching*/
+#ifndef LV_OBJ_STYLE_CACHE_SIZE
+#  ifdef CONFIG_LV_OBJ_STYLE_CACHE_SIZE
+#    define LV_OBJ_STYLE_CACHE_SIZE CONFIG_LV_OBJ_STYLE_CACHE_SIZE
+#  else
+#    define LV_OBJ_STYLE_CACHE_SIZE 0
+#  endif
+#endif
+
 /*Garbage Collector settings
  *Used if lvgl is bound to higher level language and the memory is managed by that language*/
 #ifndef LV_ENABLE_GC
@@ -1064,6 +1197,16 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 #  endif
 #endif
 
+/*Number of letters whose glyph ID is cached by every built-in font to not search it again.
+ *Uses 8 bytes RAM per letter and font. Use 1 for the smallest RAM usage.*/
+#ifndef LV_FONT_FMT_TXT_CACHE_SIZE
+#  ifdef CONFIG_LV_FONT_FMT_TXT_CACHE_SIZE
+#    define LV_FONT_FMT_TXT_CACHE_SIZE CONFIG_LV_FONT_FMT_TXT_CACHE_SIZE
+#  else
+#    define LV_FONT_FMT_TXT_CACHE_SIZE 8
+#  endif
+#endif
+
 /*Enables/disables support for compressed fonts.*/
 #ifndef LV_USE_FONT_COMPRESSED
 #  ifdef CONFIG_LV_USE_FONT_COMPRESSED
@@ -1073,6 +1216,16 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 #  endif
 #endif
 
+/*Size of the atlas caching the decompressed glyphs of compressed fonts
+ *and the glyphs of FreeType fonts without FreeType's cache [bytes]. 0: disable the cache*/
+#ifndef LV_FONT_GLYPH_CACHE_SIZE
+#  ifdef CONFIG_LV_FONT_GLYPH_CACHE_SIZE
+#    define LV_FONT_GLYPH_CACHE_SIZE CONFIG_LV_FONT_GLYPH_CACHE_SIZE
+#  else
+#    define LV_FONT_GLYPH_CACHE_SIZE 0
+#  endif
+#endif
+
 /*Enable subpixel rendering*/
 #ifndef LV_USE_FONT_SUBPX
 #  ifdef CONFIG_LV_USE_FONT_SUBPX
@@ -1324,6 +1477,13 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 #    define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
 #  endif
 #endif
+#ifndef LV_LABEL_LAYOUT_CACHE
+#  ifdef CONFIG_LV_LABEL_LAYOUT_CACHE
+#    define LV_LABEL_LAYOUT_CACHE CONFIG_LV_LABEL_LAYOUT_CACHE
+#  else
+#    define LV_LABEL_LAYOUT_CACHE 0   /*Store the line breaks of the labels (6 bytes per line) to not measure the text again on every redraw*/
+#  endif
+#endif
 #endif
 
 #ifndef LV_USE_LINE
@@ -1878,6 +2038,55 @@ e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
 #  endif
 #endif
 
+/*FFmpeg library for image decoding and playing videos
+ *Supports all major image formats so do not enable other image decoder with it*/
+#ifndef LV_USE_FFMPEG
+#  ifdef CONFIG_LV_USE_FFMPEG
+#    define LV_USE_FFMPEG CONFIG_LV_USE_FFMPEG
+#  else
+#    define LV_USE_FFMPEG  0
+#  endif
+#endif
+#if LV_USE_FFMPEG
+    /*Dump input information to stderr*/
+#ifndef LV_FFMPEG_AV_DUMP_FORMAT
+#  ifdef CONFIG_LV_FFMPEG_AV_DUMP_FORMAT
+#    define LV_FFMPEG_AV_DUMP_FORMAT CONFIG_LV_FFMPEG_AV_DUMP_FORMAT
+#  else
+#    define LV_FFMPEG_AV_DUMP_FORMAT 0
+#  endif
+#endif
+
+    /*Keep the YUV 4:2:0 frames of the video player as they are decoded (LV_IMG_CF_YUV_I420/NV12)
+     *and convert only the drawn pixels. Rotating and zooming the player is not supported then.*/
+#ifndef LV_FFMPEG_PLAYER_USE_YUV
+#  ifdef CONFIG_LV_FFMPEG_PLAYER_USE_YUV
+#    define LV_FFMPEG_PLAYER_USE_YUV CONFIG_LV_FFMPEG_PLAYER_USE_YUV
+#  else
+#    define LV_FFMPEG_PLAYER_USE_YUV 0
+#  endif
+#endif
+
+    /*Demux, decode and convert the frames of the video player on a worker thread. Requires LV_USE_PTHREAD.*/
+#ifndef LV_FFMPEG_PLAYER_USE_THREAD
+#  ifdef CONFIG_LV_FFMPEG_PLAYER_USE_THREAD
+#    define LV_FFMPEG_PLAYER_USE_THREAD CONFIG_LV_FFMPEG_PLAYER_USE_THREAD
+#  else
+#    define LV_FFMPEG_PLAYER_USE_THREAD 0
+#  endif
+#endif
+    #if LV_FFMPEG_PLAYER_USE_THREAD
+        /*Number of converted frame buffers (>= 2). One is shown, the others are filled ahead by the worker thread.*/
+#ifndef LV_FFMPEG_PLAYER_FRAME_CNT
+#  ifdef CONFIG_LV_FFMPEG_PLAYER_FRAME_CNT
+#    define LV_FFMPEG_PLAYER_FRAME_CNT CONFIG_LV_FFMPEG_PLAYER_FRAME_CNT
+#  else
+#    define LV_FFMPEG_PLAYER_FRAME_CNT 4
+#  endif
+#endif
+    #endif
+#endif
+
 /*-----------
  * Others
  *----------*/
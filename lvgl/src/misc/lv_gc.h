@@ -19,8 +19,10 @@ extern "C" {
 #include "lv_ll.h"
 #include "lv_timer.h"
 #include "lv_types.h"
+#include "lv_thread.h"
 #include "../draw/lv_img_cache.h"
 #include "../draw/lv_draw_mask.h"
+#include "../draw/lv_draw_rect.h"
 #include "../core/lv_obj_pos.h"
 
 /*********************
@@ -32,6 +34,12 @@ extern "C" {
 #    define LV_IMG_CACHE_DEF            0
 #endif
 
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE > 0
+#    define LV_SHADOW_CACHE_DEF         1
+#else
+#    define LV_SHADOW_CACHE_DEF         0
+#endif
+
 #define LV_DISPATCH(f, t, n)            f(t, n)
 #define LV_DISPATCH_COND(f, t, n, m, v) LV_CONCAT3(LV_DISPATCH, m, v)(f, t, n)
 
@@ -53,11 +61,13 @@ extern "C" {
     LV_DISPATCH_COND(f, _lv_img_cache_entry_t*, _lv_img_cache_array, LV_IMG_CACHE_DEF, 1)              \
     LV_DISPATCH_COND(f, _lv_img_cache_entry_t, _lv_img_cache_single, LV_IMG_CACHE_DEF, 0)              \
     LV_DISPATCH(f, lv_timer_t*, _lv_timer_act)                                                         \
-    LV_DISPATCH(f, lv_mem_buf_arr_t , lv_mem_buf)                                                      \
+    LV_DISPATCH(f, LV_DRAW_THREAD_LOCAL lv_mem_buf_arr_t , lv_mem_buf)                                 \
     LV_DISPATCH_COND(f, _lv_draw_mask_radius_circle_dsc_arr_t , _lv_circle_cache, LV_DRAW_COMPLEX, 1)  \
-    LV_DISPATCH_COND(f, _lv_draw_mask_saved_arr_t , _lv_draw_mask_list, LV_DRAW_COMPLEX, 1)            \
+    LV_DISPATCH_COND(f, LV_DRAW_THREAD_LOCAL _lv_draw_mask_saved_arr_t , _lv_draw_mask_list, LV_DRAW_COMPLEX, 1)            \
+    LV_DISPATCH_COND(f, _lv_draw_shadow_cache_t, _lv_shadow_cache, LV_SHADOW_CACHE_DEF, 1)           \
     LV_DISPATCH(f, void * , _lv_theme_default_styles)                                                  \
-    LV_DISPATCH_COND(f, uint8_t *, _lv_font_decompr_buf, LV_USE_FONT_COMPRESSED, 1)
+    LV_DISPATCH_COND(f, LV_DRAW_THREAD_LOCAL uint8_t *, _lv_font_decompr_buf, LV_USE_FONT_COMPRESSED, 1)   \
+    LV_DISPATCH(f, uint8_t *, _lv_font_glyph_cache_buf)
 
 #define LV_DEFINE_ROOT(root_type, root_name) root_type root_name;
 #define LV_ROOTS LV_ITERATE_ROOTS(LV_DEFINE_ROOT)
@@ -66,6 +76,9 @@ extern "C" {
 #if LV_MEM_CUSTOM != 1
 #error "GC requires CUSTOM_MEM"
 #endif /*LV_MEM_CUSTOM*/
+#if LV_USE_REFR_PARALLEL
+#error "GC can't track the thread local roots of LV_USE_REFR_PARALLEL"
+#endif /*LV_USE_REFR_PARALLEL*/
 #include LV_GC_INCLUDE
 #else  /*LV_ENABLE_GC*/
 #define LV_GC_ROOT(x) x
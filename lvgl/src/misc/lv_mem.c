@@ -12,6 +12,7 @@
 #include "lv_gc.h"
 #include "lv_assert.h"
 #include "lv_log.h"
+#include "lv_thread.h"
 
 #if LV_MEM_CUSTOM != 0
     #include LV_MEM_CUSTOM_INCLUDE
@@ -57,6 +58,10 @@
     static lv_tlsf_t tlsf;
 #endif
 
+#if LV_MEM_CUSTOM == 0 && LV_USE_PTHREAD
+    static lv_mutex_t tlsf_mutex;   /*The features running on worker threads allocate memory too*/
+#endif
+
 static uint32_t zero_mem = ZERO_MEM_SENTINEL; /*Give the address of this variable if 0 byte should be allocated*/
 
 /**********************
@@ -68,6 +73,14 @@ static uint32_t zero_mem = ZERO_MEM_SENTINEL; /*Give the address of this variabl
     #define MEM_TRACE(...)
 #endif
 
+#if LV_MEM_CUSTOM == 0 && LV_USE_PTHREAD
+    #define TLSF_LOCK() lv_mutex_lock(&tlsf_mutex)
+    #define TLSF_UNLOCK() lv_mutex_unlock(&tlsf_mutex)
+#else
+    #define TLSF_LOCK()
+    #define TLSF_UNLOCK()
+#endif
+
 #define COPY32 *d32 = *s32; d32++; s32++;
 #define COPY8 *d8 = *s8; d8++; s8++;
 #define SET32(x) *d32 = x; d32++;
@@ -85,6 +98,10 @@ void lv_mem_init(void)
 {
 #if LV_MEM_CUSTOM == 0
 
+#if LV_USE_PTHREAD
+    lv_mutex_init(&tlsf_mutex);
+#endif
+
 #if LV_MEM_ADR == 0
 #ifdef LV_MEM_POOL_ALLOC
     tlsf = lv_tlsf_create_with_pool((void *)LV_MEM_POOL_ALLOC(LV_MEM_SIZE), LV_MEM_SIZE);
@@ -111,6 +128,9 @@ void lv_mem_deinit(void)
 {
 #if LV_MEM_CUSTOM == 0
     lv_tlsf_destroy(tlsf);
+#if LV_USE_PTHREAD
+    lv_mutex_delete(&tlsf_mutex);
+#endif
     lv_mem_init();
 #endif
 }
@@ -129,7 +149,9 @@ void * lv_mem_alloc(size_t size)
     }
 
 #if LV_MEM_CUSTOM == 0
+    TLSF_LOCK();
     void * alloc = lv_tlsf_malloc(tlsf, size);
+    TLSF_UNLOCK();
 #else
     void * alloc = LV_MEM_CUSTOM_ALLOC(size);
 #endif
@@ -166,7 +188,9 @@ void lv_mem_free(void * data)
 #  if LV_MEM_ADD_JUNK
     lv_memset(data, 0xbb, lv_tlsf_block_size(data));
 #  endif
+    TLSF_LOCK();
     lv_tlsf_free(tlsf, data);
+    TLSF_UNLOCK();
 #else
     LV_MEM_CUSTOM_FREE(data);
 #endif
@@ -191,7 +215,9 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
     if(data_p == &zero_mem) return lv_mem_alloc(new_size);
 
 #if LV_MEM_CUSTOM == 0
+    TLSF_LOCK();
     void * new_p = lv_tlsf_realloc(tlsf, data_p, new_size);
+    TLSF_UNLOCK();
 #else
     void * new_p = LV_MEM_CUSTOM_REALLOC(data_p, new_size);
 #endif
@@ -212,12 +238,17 @@ lv_res_t lv_mem_test(void)
     }
 
 #if LV_MEM_CUSTOM == 0
-    if(lv_tlsf_check(tlsf)) {
+    TLSF_LOCK();
+    int tlsf_res = lv_tlsf_check(tlsf);
+    int pool_res = lv_tlsf_check_pool(lv_tlsf_get_pool(tlsf));
+    TLSF_UNLOCK();
+
+    if(tlsf_res) {
         LV_LOG_WARN("failed");
         return LV_RES_INV;
     }
 
-    if(lv_tlsf_check_pool(lv_tlsf_get_pool(tlsf))) {
+    if(pool_res) {
         LV_LOG_WARN("pool failed");
         return LV_RES_INV;
     }
@@ -238,7 +269,9 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 #if LV_MEM_CUSTOM == 0
     MEM_TRACE("begin");
 
+    TLSF_LOCK();
     lv_tlsf_walk_pool(lv_tlsf_get_pool(tlsf), lv_mem_walker, mon_p);
+    TLSF_UNLOCK();
 
     mon_p->total_size = LV_MEM_SIZE;
     mon_p->used_pct = 100 - (100U * mon_p->free_size) / mon_p->total_size;
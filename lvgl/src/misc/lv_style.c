@@ -148,36 +148,46 @@ void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_
     if(style->prop_cnt > 1) {
         uint8_t * tmp = style->v_p.values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
         uint16_t * props = (uint16_t *)tmp;
-        int32_t i;
-        for(i = style->prop_cnt - 1; i >= 0; i--) {
-            if(props[i] == prop) {
-                lv_style_value_t * values = (lv_style_value_t *)style->v_p.values_and_props;
-                values[i] = value;
-                return;
-            }
+        lv_style_value_t * values = (lv_style_value_t *)style->v_p.values_and_props;
+        uint32_t idx = _lv_style_find_prop(props, style->prop_cnt, prop);
+        if(idx < style->prop_cnt && props[idx] == prop) {
+            values[idx] = value;
+            return;
+        }
+
+        if(style->prop_cnt == UINT8_MAX) {
+            LV_LOG_WARN("Too many properties in the style");
+            return;
         }
 
         size_t size = (style->prop_cnt + 1) * (sizeof(lv_style_value_t) + sizeof(uint16_t));
         uint8_t * values_and_props = lv_mem_realloc(style->v_p.values_and_props, size);
         if(values_and_props == NULL) return;
         style->v_p.values_and_props = values_and_props;
+        values = (lv_style_value_t *)values_and_props;
 
+        /*Shift all props to make place for the new value before them and leave a gap at `idx` for the new prop.
+         *The props move to higher addresses so copy them from the end.*/
         tmp = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+        uint16_t * old_props = (uint16_t *)tmp;
+        tmp = values_and_props + (style->prop_cnt + 1) * sizeof(lv_style_value_t);
         props = (uint16_t *)tmp;
-        /*Shift all props to make place for the value before them*/
-        for(i = style->prop_cnt - 1; i >= 0; i--) {
-            props[i + sizeof(lv_style_value_t) / sizeof(uint16_t)] = props[i];
+        int32_t i;
+        for(i = style->prop_cnt - 1; i >= (int32_t)idx; i--) {
+            props[i + 1] = old_props[i];
+        }
+        for(i = (int32_t)idx - 1; i >= 0; i--) {
+            props[i] = old_props[i];
         }
-        style->prop_cnt++;
 
-        /*Go to the new position wit the props*/
-        tmp = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-        props = (uint16_t *)tmp;
-        lv_style_value_t * values = (lv_style_value_t *)values_and_props;
+        /*The last value overwrites the beginning of the old props so shift them only now*/
+        for(i = style->prop_cnt - 1; i >= (int32_t)idx; i--) {
+            values[i + 1] = values[i];
+        }
 
-        /*Set the new property and value*/
-        props[style->prop_cnt - 1] = prop;
-        values[style->prop_cnt - 1] = value;
+        props[idx] = prop;
+        values[idx] = value;
+        style->prop_cnt++;
     }
     else if(style->prop_cnt == 1) {
         if(style->prop1 == prop) {
@@ -194,10 +204,11 @@ void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_
         uint8_t * tmp = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
         uint16_t * props = (uint16_t *)tmp;
         lv_style_value_t * values = (lv_style_value_t *)values_and_props;
-        props[0] = style->prop1;
-        props[1] = prop;
-        values[0] = value_tmp;
-        values[1] = value;
+        uint32_t idx = prop < style->prop1 ? 0 : 1;
+        props[1 - idx] = style->prop1;
+        props[idx] = prop;
+        values[1 - idx] = value_tmp;
+        values[idx] = value;
     }
     else {
         style->prop_cnt = 1;
@@ -291,9 +302,7 @@ bool lv_style_is_empty(const lv_style_t * style)
 
 uint8_t _lv_style_get_prop_group(lv_style_prop_t prop)
 {
-    uint16_t group = (prop & 0x1FF) >> 4;
-    if(group > 7) group = 7;    /*The MSB marks all the custom properties*/
-    return (uint8_t)group;
+    return (uint8_t)LV_STYLE_PROP_GROUP(prop);
 }
 
 /**********************
@@ -44,12 +44,30 @@ extern "C" {
 #define LV_IMG_ZOOM_NONE            256        /*Value for not zooming the image*/
 LV_EXPORT_CONST_INT(LV_IMG_ZOOM_NONE);
 
+/**
+ * The group of a property. If a property from a group is set in a style the (1 << group) bit of `has_group` is set.
+ * 7 means all the custom properties with index > 112
+ */
+#define LV_STYLE_PROP_GROUP(prop)   ((((prop) & 0x1FF) >> 4) > 7 ? 7 : (((prop) & 0x1FF) >> 4))
+
+/**
+ * The `has_group` bit of a property. Can be used in constant expressions.
+ */
+#define LV_STYLE_PROP_GROUP_BIT(prop)   (1 << LV_STYLE_PROP_GROUP(prop))
+
 #if LV_USE_ASSERT_STYLE
-#define LV_STYLE_CONST_INIT(var_name, prop_array) const lv_style_t var_name = { .sentinel = LV_STYLE_SENTINEL_VALUE, .v_p = { .const_props = prop_array }, .has_group = 0xFF, .is_const = 1 }
+#define LV_STYLE_CONST_INIT_GROUPS(var_name, prop_array, groups) const lv_style_t var_name = { .sentinel = LV_STYLE_SENTINEL_VALUE, .v_p = { .const_props = prop_array }, .has_group = (groups), .is_const = 1 }
 #else
-#define LV_STYLE_CONST_INIT(var_name, prop_array) const lv_style_t var_name = { .v_p = { .const_props = prop_array }, .has_group = 0xFF, .is_const = 1 }
+#define LV_STYLE_CONST_INIT_GROUPS(var_name, prop_array, groups) const lv_style_t var_name = { .v_p = { .const_props = prop_array }, .has_group = (groups), .is_const = 1 }
 #endif
 
+/**
+ * Create a constant style from an array of `lv_style_const_prop_t` terminated by an `LV_STYLE_PROP_INV` property.
+ * The style will be checked for every property because its groups are unknown.
+ * Use `LV_STYLE_CONST_INIT_GROUPS` with the OR-ed `LV_STYLE_PROP_GROUP_BIT()` of the properties to skip it faster.
+ */
+#define LV_STYLE_CONST_INIT(var_name, prop_array) LV_STYLE_CONST_INIT_GROUPS(var_name, prop_array, 0xFF)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -263,7 +281,7 @@ typedef struct {
 #endif
 
     /*If there is only one property store it directly.
-     *For more properties allocate an array*/
+     *For more properties allocate an array with the values and then the properties, sorted by property ID*/
     union {
         lv_style_value_t value1;
         uint8_t * values_and_props;
@@ -341,6 +359,25 @@ void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_
 lv_res_t lv_style_get_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_t * value);
 
 
+/**
+ * Find the index of a property in the sorted properties of a style
+ * @param props     the sorted properties
+ * @param cnt       number of properties
+ * @param prop      the property to find
+ * @return          the index of the property or the index where it should be inserted
+ */
+static inline uint32_t _lv_style_find_prop(const uint16_t * props, uint32_t cnt, lv_style_prop_t prop)
+{
+    uint32_t min = 0;
+    uint32_t max = cnt;
+    while(min < max) {
+        uint32_t mid = (min + max) >> 1;
+        if(props[mid] < prop) min = mid + 1;
+        else max = mid;
+    }
+    return min;
+}
+
 /**
  * Get the value of a property
  * @param style pointer to a style
@@ -353,6 +390,8 @@ lv_res_t lv_style_get_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_va
  */
 static inline lv_res_t lv_style_get_prop_inlined(lv_style_t * style, lv_style_prop_t prop, lv_style_value_t * value)
 {
+    if((style->has_group & LV_STYLE_PROP_GROUP_BIT(prop)) == 0) return LV_RES_INV;
+
     if(style->is_const) {
         const lv_style_const_prop_t * const_prop;
         for(const_prop = style->v_p.const_props; const_prop->prop != LV_STYLE_PROP_INV; const_prop++) {
@@ -369,13 +408,11 @@ static inline lv_res_t lv_style_get_prop_inlined(lv_style_t * style, lv_style_pr
     if(style->prop_cnt > 1) {
         uint8_t * tmp = style->v_p.values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
         uint16_t * props = (uint16_t *)tmp;
-        uint32_t i;
-        for(i = 0; i < style->prop_cnt; i++) {
-            if(props[i] == prop) {
-                lv_style_value_t * values = (lv_style_value_t *)style->v_p.values_and_props;
-                *value = values[i];
-                return LV_RES_OK;
-            }
+        uint32_t i = _lv_style_find_prop(props, style->prop_cnt, prop);
+        if(i < style->prop_cnt && props[i] == prop) {
+            lv_style_value_t * values = (lv_style_value_t *)style->v_p.values_and_props;
+            *value = values[i];
+            return LV_RES_OK;
         }
     }
     else if(style->prop1 == prop) {
@@ -0,0 +1,130 @@
+/**
+ * @file lv_thread.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_thread.h"
+
+#if LV_USE_PTHREAD
+
+#include <errno.h>
+#include <time.h>
+#include "lv_log.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void * thread_entry(void * p);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_res_t lv_thread_init(lv_thread_t * thread, void (*callback)(void *), void * user_data)
+{
+    thread->callback = callback;
+    thread->user_data = user_data;
+
+    if(pthread_create(&thread->thread, NULL, thread_entry, thread) != 0) {
+        LV_LOG_ERROR("couldn't create a thread");
+        return LV_RES_INV;
+    }
+
+    return LV_RES_OK;
+}
+
+lv_res_t lv_thread_delete(lv_thread_t * thread)
+{
+    return pthread_join(thread->thread, NULL) == 0 ? LV_RES_OK : LV_RES_INV;
+}
+
+lv_res_t lv_mutex_init(lv_mutex_t * mutex)
+{
+    return pthread_mutex_init(mutex, NULL) == 0 ? LV_RES_OK : LV_RES_INV;
+}
+
+void lv_mutex_lock(lv_mutex_t * mutex)
+{
+    pthread_mutex_lock(mutex);
+}
+
+void lv_mutex_unlock(lv_mutex_t * mutex)
+{
+    pthread_mutex_unlock(mutex);
+}
+
+void lv_mutex_delete(lv_mutex_t * mutex)
+{
+    pthread_mutex_destroy(mutex);
+}
+
+lv_res_t lv_cond_init(lv_cond_t * cond)
+{
+    return pthread_cond_init(cond, NULL) == 0 ? LV_RES_OK : LV_RES_INV;
+}
+
+void lv_cond_wait(lv_cond_t * cond, lv_mutex_t * mutex)
+{
+    pthread_cond_wait(cond, mutex);
+}
+
+bool lv_cond_timedwait(lv_cond_t * cond, lv_mutex_t * mutex, uint32_t timeout)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += timeout / 1000;
+    ts.tv_nsec += (long)(timeout % 1000) * 1000000;
+    if(ts.tv_nsec >= 1000000000) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000;
+    }
+
+    return pthread_cond_timedwait(cond, mutex, &ts) != ETIMEDOUT;
+}
+
+void lv_cond_signal(lv_cond_t * cond)
+{
+    pthread_cond_signal(cond);
+}
+
+void lv_cond_broadcast(lv_cond_t * cond)
+{
+    pthread_cond_broadcast(cond);
+}
+
+void lv_cond_delete(lv_cond_t * cond)
+{
+    pthread_cond_destroy(cond);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void * thread_entry(void * p)
+{
+    lv_thread_t * thread = p;
+    thread->callback(thread->user_data);
+    return NULL;
+}
+
+#endif /*LV_USE_PTHREAD*/
@@ -0,0 +1,150 @@
+/**
+ * @file lv_thread.h
+ * Thin wrappers around the OS threading primitives used by the features which run on worker threads.
+ */
+
+#ifndef LV_THREAD_H
+#define LV_THREAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include <stdbool.h>
+#include "lv_types.h"
+
+#if LV_USE_PTHREAD
+#include <pthread.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*Storage class of the variables which belong to a single rendering thread.
+ *With the parallel renderer every rendering thread needs its own copy of them.*/
+#if LV_USE_REFR_PARALLEL
+#define LV_DRAW_THREAD_LOCAL _Thread_local
+#else
+#define LV_DRAW_THREAD_LOCAL
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+#if LV_USE_PTHREAD
+
+typedef struct {
+    pthread_t thread;
+    void (*callback)(void *);
+    void * user_data;
+} lv_thread_t;
+typedef pthread_mutex_t lv_mutex_t;
+typedef pthread_cond_t lv_cond_t;
+
+#endif /*LV_USE_PTHREAD*/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#if LV_USE_PTHREAD
+
+/**
+ * Create a new thread
+ * @param thread pointer to a thread handle to initialize. It has to be valid until the thread returns.
+ * @param callback the function to run on the new thread
+ * @param user_data custom parameter passed to `callback`
+ * @return LV_RES_OK: success; LV_RES_INV: the thread couldn't be created
+ */
+lv_res_t lv_thread_init(lv_thread_t * thread, void (*callback)(void *), void * user_data);
+
+/**
+ * Wait until a thread returns from its callback and release its resources
+ * @param thread pointer to a thread handle
+ * @return LV_RES_OK: success; LV_RES_INV: error
+ */
+lv_res_t lv_thread_delete(lv_thread_t * thread);
+
+/**
+ * Initialize a (non-recursive) mutex
+ * @param mutex pointer to a mutex
+ * @return LV_RES_OK: success; LV_RES_INV: error
+ */
+lv_res_t lv_mutex_init(lv_mutex_t * mutex);
+
+/**
+ * Lock a mutex. Blocks until the mutex is available.
+ * @param mutex pointer to a mutex
+ */
+void lv_mutex_lock(lv_mutex_t * mutex);
+
+/**
+ * Unlock a mutex
+ * @param mutex pointer to a mutex
+ */
+void lv_mutex_unlock(lv_mutex_t * mutex);
+
+/**
+ * Free the resources of a mutex
+ * @param mutex pointer to a mutex
+ */
+void lv_mutex_delete(lv_mutex_t * mutex);
+
+/**
+ * Initialize a condition variable
+ * @param cond pointer to a condition variable
+ * @return LV_RES_OK: success; LV_RES_INV: error
+ */
+lv_res_t lv_cond_init(lv_cond_t * cond);
+
+/**
+ * Atomically unlock `mutex` and wait until `cond` is signaled. `mutex` is locked again on return.
+ * @param cond pointer to a condition variable
+ * @param mutex pointer to a mutex locked by the calling thread
+ */
+void lv_cond_wait(lv_cond_t * cond, lv_mutex_t * mutex);
+
+/**
+ * Like `lv_cond_wait` but return after at most `timeout` milliseconds
+ * @param cond pointer to a condition variable
+ * @param mutex pointer to a mutex locked by the calling thread
+ * @param timeout maximal waiting time in milliseconds
+ * @return true: `cond` was signaled; false: timed out
+ */
+bool lv_cond_timedwait(lv_cond_t * cond, lv_mutex_t * mutex, uint32_t timeout);
+
+/**
+ * Wake up one thread waiting on a condition variable
+ * @param cond pointer to a condition variable
+ */
+void lv_cond_signal(lv_cond_t * cond);
+
+/**
+ * Wake up all the threads waiting on a condition variable
+ * @param cond pointer to a condition variable
+ */
+void lv_cond_broadcast(lv_cond_t * cond);
+
+/**
+ * Free the resources of a condition variable
+ * @param cond pointer to a condition variable
+ */
+void lv_cond_delete(lv_cond_t * cond);
+
+#endif /*LV_USE_PTHREAD*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_THREAD_H*/
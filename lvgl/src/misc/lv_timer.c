@@ -27,6 +27,7 @@
  **********************/
 static bool lv_timer_exec(lv_timer_t * timer);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
+static void lv_timer_handler_resume(void);
 
 /**********************
  *  STATIC VARIABLES
@@ -35,6 +36,9 @@ static bool lv_timer_run = false;
 static uint8_t idle_last = 0;
 static bool timer_deleted;
 static bool timer_created;
+static bool handler_running;
+static lv_timer_handler_resume_cb_t resume_cb;
+static void * resume_data;
 
 /**********************
  *      MACROS
@@ -69,15 +73,14 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
     TIMER_TRACE("begin");
 
     /*Avoid concurrent running of the timer handler*/
-    static bool already_running = false;
-    if(already_running) {
+    if(handler_running) {
         TIMER_TRACE("already running, concurrent calls are not allow, returning");
         return 1;
     }
-    already_running = true;
+    handler_running = true;
 
     if(lv_timer_run == false) {
-        already_running = false; /*Release mutex*/
+        handler_running = false; /*Release mutex*/
         return 1;
     }
 
@@ -139,12 +142,24 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
         idle_period_start = lv_tick_get();
     }
 
-    already_running = false; /*Release the mutex*/
+    handler_running = false; /*Release the mutex*/
 
     TIMER_TRACE("finished (%d ms until the next timer call)", time_till_next);
     return time_till_next;
 }
 
+/**
+ * Set a callback to call when a timer is created, resumed, made ready or its period is changed
+ * outside of `lv_timer_handler()`.
+ * @param cb the callback or NULL to not call anything
+ * @param data custom parameter passed to `cb`
+ */
+void lv_timer_handler_set_resume_cb(lv_timer_handler_resume_cb_t cb, void * data)
+{
+    resume_cb = cb;
+    resume_data = data;
+}
+
 /**
  * Create an "empty" timer. It needs to initialized with at least
  * `lv_timer_set_cb` and `lv_timer_set_period`
@@ -180,6 +195,7 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->user_data = user_data;
 
     timer_created = true;
+    lv_timer_handler_resume();
 
     return new_timer;
 }
@@ -217,7 +233,10 @@ void lv_timer_pause(lv_timer_t * timer)
 
 void lv_timer_resume(lv_timer_t * timer)
 {
+    if(timer->paused == 0) return;
+
     timer->paused = false;
+    lv_timer_handler_resume();
 }
 
 /**
@@ -228,6 +247,7 @@ void lv_timer_resume(lv_timer_t * timer)
 void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     timer->period = period;
+    lv_timer_handler_resume();
 }
 
 /**
@@ -237,6 +257,7 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 void lv_timer_ready(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get() - timer->period - 1;
+    lv_timer_handler_resume();
 }
 
 /**
@@ -266,6 +287,7 @@ void lv_timer_reset(lv_timer_t * timer)
 void lv_timer_enable(bool en)
 {
     lv_timer_run = en;
+    if(en) lv_timer_handler_resume();
 }
 
 /**
@@ -339,3 +361,12 @@ static uint32_t lv_timer_time_remaining(lv_timer_t * timer)
         return 0;
     return timer->period - elp;
 }
+
+/**
+ * Tell the main loop that `lv_timer_handler()` might need to run earlier.
+ * Inside `lv_timer_handler()` it's not needed because its return value considers the changes.
+ */
+static void lv_timer_handler_resume(void)
+{
+    if(resume_cb && !handler_running) resume_cb(resume_data);
+}
@@ -37,6 +37,11 @@ struct _lv_timer_t;
  */
 typedef void (*lv_timer_cb_t)(struct _lv_timer_t *);
 
+/**
+ * Called when a timer might need to run earlier than `lv_timer_handler()` last reported.
+ */
+typedef void (*lv_timer_handler_resume_cb_t)(void * data);
+
 /**
  * Descriptor of a lv_timer
  */
@@ -68,6 +73,16 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void);
 
 //! @endcond
 
+/**
+ * Set a callback to call when a timer is created, resumed, made ready or its period is changed
+ * outside of `lv_timer_handler()`. That is, when `lv_timer_handler()` might need to be called earlier
+ * than its last return value told. E.g. `lv_obj_invalidate()` resumes the refresh timer of the display.
+ * Useful to wake up a main loop which sleeps until the next timer.
+ * @param cb the callback or NULL to not call anything
+ * @param data custom parameter passed to `cb`
+ */
+void lv_timer_handler_set_resume_cb(lv_timer_handler_resume_cb_t cb, void * data);
+
 /**
  * Create an "empty" timer. It needs to initialized with at least
  * `lv_timer_set_cb` and `lv_timer_set_period`
@@ -674,6 +674,8 @@ static void inv_arc_area(lv_obj_t * obj, uint16_t start_angle, uint16_t end_angl
 
 static void get_center(lv_obj_t * obj, lv_point_t * center, lv_coord_t * arc_r)
 {
+    _lv_obj_sync_coords(obj);
+
     lv_coord_t left_bg = lv_obj_get_style_pad_left(obj, LV_PART_MAIN);
     lv_coord_t right_bg = lv_obj_get_style_pad_right(obj, LV_PART_MAIN);
     lv_coord_t top_bg = lv_obj_get_style_pad_top(obj, LV_PART_MAIN);
@@ -421,6 +421,7 @@ void lv_dropdown_open(lv_obj_t * dropdown_obj)
     lv_dropdown_t * dropdown = (lv_dropdown_t *)dropdown_obj;
 
     lv_obj_add_state(dropdown_obj, LV_STATE_CHECKED);
+    _lv_obj_sync_coords(dropdown_obj);
 
     if(dropdown->list == NULL) {
         lv_obj_t * list_obj = lv_dropdown_list_create(lv_obj_get_screen(dropdown_obj));
@@ -15,6 +15,7 @@
 #include "../misc/lv_txt.h"
 #include "../misc/lv_math.h"
 #include "../misc/lv_log.h"
+#include "../core/lv_refr.h"
 
 /*********************
  *      DEFINES
@@ -190,6 +191,8 @@ void lv_img_set_angle(lv_obj_t * obj, int16_t angle)
     lv_img_t * img = (lv_img_t *)obj;
     if(angle == img->angle) return;
 
+    _lv_obj_sync_coords(obj);
+
     lv_coord_t transf_zoom = lv_obj_get_style_transform_zoom(obj, LV_PART_MAIN);
     transf_zoom = ((int32_t)transf_zoom * img->zoom) >> 8;
 
@@ -221,6 +224,8 @@ void lv_img_set_pivot(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
     lv_img_t * img = (lv_img_t *)obj;
     if(img->pivot.x == x && img->pivot.y == y) return;
 
+    _lv_obj_sync_coords(obj);
+
     lv_coord_t transf_zoom = lv_obj_get_style_transform_zoom(obj, LV_PART_MAIN);
     transf_zoom = ((int32_t)transf_zoom * img->zoom) >> 8;
 
@@ -256,6 +261,8 @@ void lv_img_set_zoom(lv_obj_t * obj, uint16_t zoom)
 
     if(zoom == 0) zoom = 1;
 
+    _lv_obj_sync_coords(obj);
+
     lv_coord_t transf_zoom = lv_obj_get_style_transform_zoom(obj, LV_PART_MAIN);
 
     lv_coord_t transf_angle = lv_obj_get_style_transform_angle(obj, LV_PART_MAIN);
@@ -622,14 +629,18 @@ static void draw_img(lv_event_t * e)
             bg_coords.y2 += obj->coords.y1;
         }
 
+        /*The parallel rendering threads read the coordinates concurrently so they can't be modified temporarily.
+         *In this case the background is drawn on the original coordinates.*/
+        bool swap_coords = !_lv_refr_is_parallel();
+
         lv_area_t ori_coords;
         lv_area_copy(&ori_coords, &obj->coords);
-        lv_area_copy(&obj->coords, &bg_coords);
+        if(swap_coords) lv_area_copy(&obj->coords, &bg_coords);
 
         lv_res_t res = lv_obj_event_base(MY_CLASS, e);
         if(res != LV_RES_OK) return;
 
-        lv_area_copy(&obj->coords, &ori_coords);
+        if(swap_coords) lv_area_copy(&obj->coords, &ori_coords);
 
         if(code == LV_EVENT_DRAW_MAIN) {
             if(img->h == 0 || img->w == 0) return;
@@ -11,12 +11,14 @@
 #include "../core/lv_obj.h"
 #include "../misc/lv_assert.h"
 #include "../core/lv_group.h"
+#include "../core/lv_refr.h"
 #include "../draw/lv_draw.h"
 #include "../misc/lv_color.h"
 #include "../misc/lv_math.h"
 #include "../misc/lv_bidi.h"
 #include "../misc/lv_txt_ap.h"
 #include "../misc/lv_printf.h"
+#include <string.h>
 
 /*********************
  *      DEFINES
@@ -46,6 +48,12 @@ static void lv_label_revert_dots(lv_obj_t * label);
 static bool lv_label_set_dot_tmp(lv_obj_t * label, char * data, uint32_t len);
 static char * lv_label_get_dot_tmp(lv_obj_t * label);
 static void lv_label_dot_tmp_free(lv_obj_t * label);
+static void lv_label_text_changed(lv_obj_t * obj);
+static lv_res_t lv_label_layout_create(lv_obj_t * obj);
+static lv_res_t lv_label_append_text(lv_obj_t * obj, const char * txt);
+static bool lv_label_remove_first_lines(lv_obj_t * obj);
+static void lv_label_get_txt_size(lv_obj_t * obj, lv_point_t * size_res, lv_coord_t max_w, lv_text_flag_t flag,
+                                  bool refr_layout);
 static void set_ofs_x_anim(void * obj, int32_t v);
 static void set_ofs_y_anim(void * obj, int32_t v);
 
@@ -141,6 +149,7 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
         label->static_txt = 0;
     }
 
+    lv_label_text_changed(obj);
     lv_label_refr_text(obj);
 }
 
@@ -169,6 +178,7 @@ void lv_label_set_text_fmt(lv_obj_t * obj, const char * fmt, ...)
     va_end(args);
     label->static_txt = 0; /*Now the text is dynamically allocated*/
 
+    lv_label_text_changed(obj);
     lv_label_refr_text(obj);
 }
 
@@ -187,6 +197,7 @@ void lv_label_set_text_static(lv_obj_t * obj, const char * text)
         label->text       = (char *)text;
     }
 
+    lv_label_text_changed(obj);
     lv_label_refr_text(obj);
 }
 
@@ -229,6 +240,20 @@ void lv_label_set_recolor(lv_obj_t * obj, bool en)
     lv_label_refr_text(obj);
 }
 
+void lv_label_set_max_lines(lv_obj_t * obj, uint32_t cnt)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_label_t * label = (lv_label_t *)obj;
+    if(label->max_lines == cnt) return;
+
+    /*The lines are counted with the layout*/
+    if(cnt > 0 && lv_label_layout_create(obj) != LV_RES_OK) return;
+
+    label->max_lines = cnt;
+    lv_label_refr_text(obj);
+}
+
 void lv_label_set_text_sel_start(lv_obj_t * obj, uint32_t index)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
@@ -283,6 +308,14 @@ bool lv_label_get_recolor(const lv_obj_t * obj)
     return label->recolor == 0 ? false : true;
 }
 
+uint32_t lv_label_get_max_lines(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_label_t * label = (lv_label_t *)obj;
+    return label->max_lines;
+}
+
 void lv_label_get_letter_pos(const lv_obj_t * obj, uint32_t char_id, lv_point_t * pos)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
@@ -327,14 +360,31 @@ void lv_label_get_letter_pos(const lv_obj_t * obj, uint32_t char_id, lv_point_t
 
     uint32_t byte_id = _lv_txt_encoded_get_byte_id(txt, char_id);
 
-    /*Search the line of the index letter*/;
-    while(txt[new_line_start] != '\0') {
-        new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
-        if(byte_id < new_line_start || txt[new_line_start] == '\0')
-            break; /*The line of 'index' letter begins at 'line_start'*/
+    const lv_draw_label_layout_t * layout = label->layout;
+    if(layout && _lv_draw_label_layout_is_valid(layout, txt, font, letter_space, max_w, flag) && layout->line_cnt > 0) {
+        /*Binary search for the last line starting before the letter*/
+        uint32_t min = 0;
+        uint32_t max = layout->line_cnt - 1;
+        while(min < max) {
+            uint32_t mid = (min + max + 1) / 2;
+            if(layout->line_starts[mid] <= byte_id) min = mid;
+            else max = mid - 1;
+        }
 
-        y += letter_height + line_space;
-        line_start = new_line_start;
+        line_start = layout->line_starts[min];
+        new_line_start = layout->line_starts[min + 1];
+        y = min * (letter_height + line_space);
+    }
+    else {
+        /*Search the line of the index letter*/;
+        while(txt[new_line_start] != '\0') {
+            new_line_start += _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_w, flag);
+            if(byte_id < new_line_start || txt[new_line_start] == '\0')
+                break; /*The line of 'index' letter begins at 'line_start'*/
+
+            y += letter_height + line_space;
+            line_start = new_line_start;
+        }
     }
 
     /*If the last character is line break then go to the next line*/
@@ -645,6 +695,8 @@ void lv_label_ins_text(lv_obj_t * obj, uint32_t pos, const char * txt)
     /*Can not append to static text*/
     if(label->static_txt != 0) return;
 
+    if(pos == LV_LABEL_POS_LAST && lv_label_append_text(obj, txt) == LV_RES_OK) return;
+
     lv_obj_invalidate(obj);
 
     /*Allocate space for the new text*/
@@ -678,6 +730,7 @@ void lv_label_cut_text(lv_obj_t * obj, uint32_t pos, uint32_t cnt)
     _lv_txt_cut(label_txt, pos, cnt);
 
     /*Refresh the label*/
+    lv_label_text_changed(obj);
     lv_label_refr_text(obj);
 }
 
@@ -706,6 +759,13 @@ static void lv_label_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     label->hint.y          = 0;
 #endif
 
+    label->layout = NULL;
+    label->text_cap = 0;
+    label->max_lines = 0;
+#if LV_LABEL_LAYOUT_CACHE
+    lv_label_layout_create(obj);
+#endif
+
 #if LV_LABEL_TEXT_SELECTION
     label->sel_start = LV_DRAW_LABEL_NO_TXT_SEL;
     label->sel_end   = LV_DRAW_LABEL_NO_TXT_SEL;
@@ -729,6 +789,12 @@ static void lv_label_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     lv_label_dot_tmp_free(obj);
     if(!label->static_txt) lv_mem_free(label->text);
     label->text = NULL;
+
+    if(label->layout) {
+        _lv_draw_label_layout_free(label->layout);
+        lv_mem_free(label->layout);
+        label->layout = NULL;
+    }
 }
 
 static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
@@ -765,9 +831,6 @@ static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
     else if(code == LV_EVENT_GET_SELF_SIZE) {
         lv_point_t size;
         lv_label_t * label = (lv_label_t *)obj;
-        const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
-        lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
-        lv_coord_t line_space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
         lv_text_flag_t flag = LV_TEXT_FLAG_NONE;
         if(label->recolor != 0) flag |= LV_TEXT_FLAG_RECOLOR;
         if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
@@ -776,7 +839,8 @@ static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
         if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) w = LV_COORD_MAX;
         else w = lv_obj_get_content_width(obj);
 
-        lv_txt_get_size(&size, label->text, font, letter_space, line_space, w, flag);
+        /*Use the layout if it happens to have the same parameters but don't replace it*/
+        lv_label_get_txt_size(obj, &size, w, flag, false);
 
         lv_point_t * self_size = lv_event_get_param(e);
         self_size->x = LV_MAX(self_size->x, size.x);
@@ -810,6 +874,8 @@ static void draw_main(lv_event_t * e)
 
     label_draw_dsc.flag = flag;
     lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &label_draw_dsc);
+    /*It's only read while drawing so it can be used by parallel rendering threads too*/
+    label_draw_dsc.layout = label->layout;
     lv_bidi_calculate_align(&label_draw_dsc.align, &label_draw_dsc.bidi_dir, label->text);
 
     label_draw_dsc.sel_start = lv_label_get_text_selection_start(obj);
@@ -824,8 +890,7 @@ static void draw_main(lv_event_t * e)
     if((label->long_mode == LV_LABEL_LONG_SCROLL || label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR) &&
        (label_draw_dsc.align == LV_TEXT_ALIGN_CENTER || label_draw_dsc.align == LV_TEXT_ALIGN_RIGHT)) {
         lv_point_t size;
-        lv_txt_get_size(&size, label->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
-                        LV_COORD_MAX, flag);
+        lv_label_get_txt_size(obj, &size, LV_COORD_MAX, flag, false);
         if(size.x > lv_area_get_width(&txt_coords)) {
             label_draw_dsc.align = LV_TEXT_ALIGN_LEFT;
         }
@@ -835,6 +900,9 @@ static void draw_main(lv_event_t * e)
     if(label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR || lv_area_get_height(&txt_coords) < LV_LABEL_HINT_HEIGHT_LIMIT)
         hint = NULL;
 
+    /*The hint is updated while drawing so it can't be shared by parallel rendering threads*/
+    if(_lv_refr_is_parallel()) hint = NULL;
+
 #else
     /*Just for compatibility*/
     lv_draw_label_hint_t * hint = NULL;
@@ -858,8 +926,7 @@ static void draw_main(lv_event_t * e)
 
     if(label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR) {
         lv_point_t size;
-        lv_txt_get_size(&size, label->text, label_draw_dsc.font, label_draw_dsc.letter_space, label_draw_dsc.line_space,
-                        LV_COORD_MAX, flag);
+        lv_label_get_txt_size(obj, &size, LV_COORD_MAX, flag, false);
 
         /*Draw the text again on label to the original to make a circular effect */
         if(size.x > lv_area_get_width(&txt_coords)) {
@@ -906,7 +973,8 @@ static void lv_label_refr_text(lv_obj_t * obj)
     if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
     if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
 
-    lv_txt_get_size(&size, label->text, font, letter_space, line_space, max_w, flag);
+    lv_label_get_txt_size(obj, &size, max_w, flag, true);
+    if(lv_label_remove_first_lines(obj)) lv_label_get_txt_size(obj, &size, max_w, flag, true);
 
     lv_obj_refresh_self_size(obj);
 
@@ -1134,6 +1202,10 @@ static void lv_label_refr_text(lv_obj_t * obj)
                 }
                 label->text[byte_id_ori + LV_LABEL_DOT_NUM] = '\0';
                 label->dot_end                              = letter_id + LV_LABEL_DOT_NUM;
+
+                /*Measure the text with the dots*/
+                lv_label_text_changed(obj);
+                lv_label_get_txt_size(obj, &size, max_w, flag, true);
             }
         }
     }
@@ -1164,6 +1236,7 @@ static void lv_label_revert_dots(lv_obj_t * obj)
     }
     label->text[byte_i + i] = dot_tmp[i];
     lv_label_dot_tmp_free(obj);
+    lv_label_text_changed(obj);
 
     label->dot_end = LV_LABEL_DOT_END_INV;
 }
@@ -1232,6 +1305,205 @@ static void lv_label_dot_tmp_free(lv_obj_t * obj)
 }
 
 
+/**
+ * Forget the data calculated from the text. Needs to be called if the text was modified or reallocated.
+ * @param obj pointer to a label object
+ */
+static void lv_label_text_changed(lv_obj_t * obj)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    if(label->layout) _lv_draw_label_layout_invalidate(label->layout);
+    label->text_cap = 0;
+}
+
+/**
+ * Allocate the layout of a label if it has none. It's calculated when the text is refreshed.
+ * @param obj pointer to a label object
+ * @return LV_RES_OK: the label has a layout; LV_RES_INV: out of memory
+ */
+static lv_res_t lv_label_layout_create(lv_obj_t * obj)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    if(label->layout) return LV_RES_OK;
+
+    label->layout = lv_mem_alloc(sizeof(lv_draw_label_layout_t));
+    LV_ASSERT_MALLOC(label->layout);
+    if(label->layout == NULL) return LV_RES_INV;
+
+    lv_memset_00(label->layout, sizeof(lv_draw_label_layout_t));
+    return LV_RES_OK;
+}
+
+/**
+ * Add text to the end of the label's text without measuring and redrawing the whole text
+ * @param obj pointer to a label object
+ * @param txt the text to append
+ * @return LV_RES_OK: the text is appended; LV_RES_INV: it can't be appended this way, insert it normally
+ */
+static lv_res_t lv_label_append_text(lv_obj_t * obj, const char * txt)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+
+    /*The other modes set animations or dots according to the whole text*/
+    if(label->long_mode != LV_LABEL_LONG_WRAP && label->long_mode != LV_LABEL_LONG_CLIP) return LV_RES_INV;
+
+    /*Keep the layout from now on. The first time the text is inserted normally and that calculates it.*/
+    if(label->layout == NULL) {
+        lv_label_layout_create(obj);
+        return LV_RES_INV;
+    }
+
+    lv_area_t txt_coords;
+    lv_obj_get_content_coords(obj, &txt_coords);
+    const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+    lv_coord_t line_space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
+    lv_text_flag_t flag = LV_TEXT_FLAG_NONE;
+    if(label->recolor != 0) flag |= LV_TEXT_FLAG_RECOLOR;
+    if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
+    if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
+
+    /*The layout is required to know the end of the text and where its last line starts*/
+    lv_draw_label_layout_t * layout = label->layout;
+    if(!_lv_draw_label_layout_is_valid(layout, label->text, font, letter_space, lv_area_get_width(&txt_coords), flag)) {
+        return LV_RES_INV;
+    }
+
+    uint32_t old_len = layout->line_starts[layout->line_cnt];
+#if LV_USE_ARABIC_PERSIAN_CHARS
+    /*The form of the last letters might depend on the new letters*/
+    if(old_len > 0 && label->text[old_len - 1] != '\n' && label->text[old_len - 1] != '\r') return LV_RES_INV;
+    uint32_t new_size = old_len + _lv_txt_ap_calc_bytes_cnt(txt);
+#else
+    uint32_t new_size = old_len + strlen(txt) + 1;
+#endif
+
+    /*Allocate with some reserve to not reallocate on every append*/
+    uint32_t cap = LV_MAX(label->text_cap, old_len + 1);
+    if(new_size > cap) {
+        cap = LV_MAX(new_size, cap * 2);
+        char * new_txt = lv_mem_realloc(label->text, cap);
+        LV_ASSERT_MALLOC(new_txt);
+        if(new_txt == NULL) return LV_RES_INV;
+        label->text = new_txt;
+    }
+    label->text_cap = cap;
+
+#if LV_USE_ARABIC_PERSIAN_CHARS
+    _lv_txt_ap_proc(txt, &label->text[old_len]);
+#else
+    lv_memcpy(&label->text[old_len], txt, new_size - old_len);
+#endif
+
+    uint32_t changed_line;
+    if(_lv_draw_label_layout_append(layout, label->text, &changed_line) != LV_RES_OK) {
+        lv_label_refr_text(obj);
+        return LV_RES_OK;
+    }
+
+    /*Removing the first lines moves all the others so everything needs to be redrawn*/
+    if(lv_label_remove_first_lines(obj)) {
+        lv_obj_invalidate(obj);
+    }
+    else {
+        /*Redraw only from the first changed line*/
+        lv_area_t inv_area;
+        lv_area_copy(&inv_area, &obj->coords);
+        inv_area.y1 = txt_coords.y1 + label->offset.y + changed_line * (lv_font_get_line_height(font) + line_space);
+        if(label->long_mode == LV_LABEL_LONG_WRAP) inv_area.y1 -= lv_obj_get_scroll_top(obj);
+
+        if(inv_area.y1 < obj->coords.y1) inv_area.y1 = obj->coords.y1;
+        if(inv_area.y1 <= inv_area.y2) lv_obj_invalidate_area(obj, &inv_area);
+    }
+
+    lv_obj_refresh_self_size(obj);
+
+    return LV_RES_OK;
+}
+
+/**
+ * Remove the first lines of the text if it has more lines than `max_lines`.
+ * Only whole lines are removed. The layout needs to be valid.
+ * @param obj pointer to a label object
+ * @return true: some lines were removed
+ */
+static bool lv_label_remove_first_lines(lv_obj_t * obj)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    lv_draw_label_layout_t * layout = label->layout;
+
+    if(layout == NULL || label->max_lines == 0 || label->static_txt) return false;
+    if(layout->txt != label->text || layout->line_cnt <= label->max_lines) return false;
+
+    /*Find the first line which starts after a line break*/
+    uint32_t line_id = layout->line_cnt - label->max_lines;
+    while(line_id < layout->line_cnt) {
+        char c = label->text[layout->line_starts[line_id] - 1];
+        if(c == '\n' || c == '\r') break;
+        line_id++;
+    }
+
+    /*If the last line is too long alone keep it*/
+    if(line_id == layout->line_cnt) {
+        line_id = layout->line_cnt - label->max_lines;
+        while(line_id > 0) {
+            char c = label->text[layout->line_starts[line_id] - 1];
+            if(c == '\n' || c == '\r') break;
+            line_id--;
+        }
+        if(line_id == 0) return false;
+    }
+
+    uint32_t byte_cnt = layout->line_starts[line_id];
+    uint32_t len = layout->line_starts[layout->line_cnt];
+    memmove(label->text, &label->text[byte_cnt], len - byte_cnt + 1);
+    _lv_draw_label_layout_remove_lines(layout, line_id);
+
+#if LV_LABEL_LONG_TXT_HINT
+    label->hint.line_start = -1;
+#endif
+
+#if LV_LABEL_TEXT_SELECTION
+    label->sel_start = LV_DRAW_LABEL_NO_TXT_SEL;
+    label->sel_end = LV_DRAW_LABEL_NO_TXT_SEL;
+#endif
+
+    return true;
+}
+
+/**
+ * Get the size of the label's text with the label's font and letter and line space.
+ * @param obj pointer to a label object
+ * @param size_res store the result here
+ * @param max_w max width of the lines
+ * @param flag settings for the text from `lv_text_flag_t`
+ * @param refr_layout true: if the layout of the label is not valid for these parameters calculate it again;
+ *                    false: use the layout only if it's already valid
+ */
+static void lv_label_get_txt_size(lv_obj_t * obj, lv_point_t * size_res, lv_coord_t max_w, lv_text_flag_t flag,
+                                  bool refr_layout)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+    const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+    lv_coord_t line_space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
+
+    lv_draw_label_layout_t * layout = label->layout;
+    if(layout) {
+        bool valid = _lv_draw_label_layout_is_valid(layout, label->text, font, letter_space, max_w, flag);
+        if(!valid && refr_layout) {
+            valid = _lv_draw_label_layout_update(layout, label->text, font, letter_space, max_w, flag) == LV_RES_OK;
+        }
+
+        if(valid) {
+            _lv_draw_label_layout_get_size(layout, line_space, size_res);
+            return;
+        }
+    }
+
+    lv_txt_get_size(size_res, label->text, font, letter_space, line_space, max_w, flag);
+}
+
 static void set_ofs_x_anim(void * obj, int32_t v)
 {
     lv_label_t * label = (lv_label_t *)obj;
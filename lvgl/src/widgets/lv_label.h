@@ -63,6 +63,12 @@ typedef struct {
     lv_draw_label_hint_t hint;
 #endif
 
+    /*The line breaks of the text. Always allocated with `LV_LABEL_LAYOUT_CACHE`,
+     *else only if text is appended to the label or it has `max_lines`. Else NULL*/
+    lv_draw_label_layout_t * layout;
+    uint32_t text_cap;              /*Size of the buffer of `text` if it's larger than the text. Else 0*/
+    uint32_t max_lines;             /*Remove the first lines if there are more lines. 0: no limit*/
+
 #if LV_LABEL_TEXT_SELECTION
     uint32_t sel_start;
     uint32_t sel_end;
@@ -132,6 +138,16 @@ void lv_label_set_long_mode(lv_obj_t * obj, lv_label_long_mode_t long_mode);
  */
 void lv_label_set_recolor(lv_obj_t * obj, bool en);
 
+/**
+ * Set the maximal number of lines of a label. If the text has more lines the first lines are removed.
+ * Useful for logs where the new lines are added with `lv_label_ins_text(label, LV_LABEL_POS_LAST, txt)`.
+ * The lines wrapped by the label count as multiple lines but only whole lines (ending with `\n`) are removed.
+ * It has no effect on static texts. The label stores its line breaks for it (6 bytes per line).
+ * @param obj           pointer to a label object
+ * @param cnt           max number of lines. 0: no limit
+ */
+void lv_label_set_max_lines(lv_obj_t * obj, uint32_t cnt);
+
 /**
  * Set where text selection should start
  * @param obj       pointer to a label object
@@ -171,6 +187,13 @@ lv_label_long_mode_t lv_label_get_long_mode(const lv_obj_t * obj);
  */
 bool lv_label_get_recolor(const lv_obj_t * obj);
 
+/**
+ * Get the maximal number of lines of a label
+ * @param obj       pointer to a label object
+ * @return          max number of lines. 0: no limit
+ */
+uint32_t lv_label_get_max_lines(const lv_obj_t * obj);
+
 /**
  * Get the relative x and y coordinates of a letter
  * @param obj       pointer to a label object
@@ -220,6 +243,7 @@ uint32_t lv_label_get_text_selection_end(const lv_obj_t * obj);
  * @param obj       pointer to a label object
  * @param pos       character index to insert. Expressed in character index and not byte index.
  *                  0: before first char. LV_LABEL_POS_LAST: after last char.
+ *                  Appending with LV_LABEL_POS_LAST is fast: only the new lines are measured and redrawn.
  * @param txt       pointer to the text to insert
  */
 void lv_label_ins_text(lv_obj_t * obj, uint32_t pos, const char * txt);
@@ -196,8 +196,10 @@ void lv_textarea_add_text(lv_obj_t * obj, const char * txt)
         if(txt_act[0] == '\0') lv_obj_invalidate(obj);
     }
 
-    /*Insert the text*/
-    lv_label_ins_text(ta->label, ta->cursor.pos, txt);
+    /*Insert the text. Appending is faster so use it if the cursor is at the end.*/
+    uint32_t ins_pos = ta->cursor.pos;
+    if(ins_pos == _lv_txt_get_encoded_length(lv_label_get_text(ta->label))) ins_pos = LV_LABEL_POS_LAST;
+    lv_label_ins_text(ta->label, ins_pos, txt);
     lv_textarea_clear_selection(obj);
 
     if(ta->pwd_mode != 0) {
@@ -925,6 +927,7 @@ static void cursor_blink_anim_cb(void * obj, int32_t show)
         ta->cursor.show = show == 0 ? 0 : 1;
         lv_area_t area_tmp;
         lv_area_copy(&area_tmp, &ta->cursor.area);
+        _lv_obj_sync_coords(ta->label);
         area_tmp.x1 += ta->label->coords.x1;
         area_tmp.y1 += ta->label->coords.y1;
         area_tmp.x2 += ta->label->coords.x1;
@@ -1051,6 +1054,7 @@ static void start_cursor_blink(lv_obj_t * obj)
 static void refr_cursor_area(lv_obj_t * obj)
 {
     lv_textarea_t * ta = (lv_textarea_t *)obj;
+    _lv_obj_sync_children_coords(obj);
 
     const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
     lv_coord_t line_space = lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
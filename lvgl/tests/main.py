@@ -21,6 +21,7 @@ build_only_options = {
 
 test_options = {
     'OPTIONS_TEST': 'Test config, 32 bit color depth',
+    'OPTIONS_TEST_THREADS': 'Test config with threads (async image decoding, parallel rendering), 32 bit color depth',
 }
 
 
@@ -0,0 +1,124 @@
+/**
+ * @file bench_draw_blend.c
+ * Measure the speed of the blending operations with the plain C and the supported SIMD kernels.
+ */
+
+#include "../lvgl.h"
+#include "lv_test_init.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BUF_W   480
+#define BUF_H   272
+#define REPEAT  20
+
+static lv_color_t buf[BUF_W * BUF_H];
+static lv_color_t map[BUF_W * BUF_H];
+static lv_opa_t mask_ref[BUF_W * BUF_H];
+static lv_opa_t mask[BUF_W * BUF_H];
+
+static const char * simd_names[] = {"C", "SSE2", "AVX2", "NEON"};
+
+typedef enum {
+    OP_FILL,
+    OP_FILL_OPA,
+    OP_FILL_MASK,
+    OP_MAP_OPA,
+    OP_MAP_MASK,
+    _OP_LAST
+} op_t;
+
+static const char * op_names[] = {"fill", "fill_opa", "fill_mask", "map_opa", "map_mask"};
+
+static lv_color_t rand_color(void)
+{
+    return lv_color_make(rand() & 0xFF, rand() & 0xFF, rand() & 0xFF);
+}
+
+/*Blocks of transparent, opaque and mixed mask values as in the anti-aliased edges of real drawings*/
+static void fill_rand_mask(lv_opa_t * m, uint32_t len)
+{
+    uint32_t i = 0;
+    while(i < len) {
+        uint32_t block = 1 + rand() % 24;
+        int type = rand() % 3;
+        uint32_t j;
+        for(j = 0; j < block && i < len; j++, i++) {
+            if(type == 0) m[i] = LV_OPA_TRANSP;
+            else if(type == 1) m[i] = LV_OPA_COVER;
+            else m[i] = rand() & 0xFF;
+        }
+    }
+}
+
+static void blend(op_t op, const lv_area_t * area, lv_color_t color)
+{
+    lv_area_t clip = {0, 0, BUF_W - 1, BUF_H - 1};
+    switch(op) {
+        case OP_FILL:
+            _lv_blend_fill(&clip, area, color, NULL, LV_DRAW_MASK_RES_FULL_COVER, LV_OPA_COVER, LV_BLEND_MODE_NORMAL);
+            break;
+        case OP_FILL_OPA:
+            _lv_blend_fill(&clip, area, color, NULL, LV_DRAW_MASK_RES_FULL_COVER, LV_OPA_50, LV_BLEND_MODE_NORMAL);
+            break;
+        case OP_FILL_MASK:
+            _lv_blend_fill(&clip, area, color, mask, LV_DRAW_MASK_RES_CHANGED, LV_OPA_COVER, LV_BLEND_MODE_NORMAL);
+            break;
+        case OP_MAP_OPA:
+            _lv_blend_map(&clip, area, map, NULL, LV_DRAW_MASK_RES_FULL_COVER, LV_OPA_50, LV_BLEND_MODE_NORMAL);
+            break;
+        default:
+            _lv_blend_map(&clip, area, map, mask, LV_DRAW_MASK_RES_CHANGED, LV_OPA_COVER, LV_BLEND_MODE_NORMAL);
+            break;
+    }
+}
+
+int main(void)
+{
+    lv_test_init();
+
+    /*Draw into `buf` as if it was the draw buffer of the display*/
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp);
+    lv_area_set(&draw_buf->area, 0, 0, BUF_W - 1, BUF_H - 1);
+    draw_buf->buf_act = buf;
+    _lv_refr_set_disp_refreshing(disp);
+
+    srand(1234);
+    uint32_t i;
+    for(i = 0; i < BUF_W * BUF_H; i++) map[i] = rand_color();
+    fill_rand_mask(mask_ref, BUF_W * BUF_H);
+
+    lv_area_t area = {0, 0, BUF_W - 1, BUF_H - 1};
+    op_t op;
+    printf("Blending %dx%d pixels [Mpix/s]\n", BUF_W, BUF_H);
+    printf("      ");
+    for(op = 0; op < _OP_LAST; op++) printf(" %10s", op_names[op]);
+    printf("\n");
+
+    lv_draw_blend_simd_t simd;
+    for(simd = LV_DRAW_BLEND_SIMD_NONE; simd < _LV_DRAW_BLEND_SIMD_LAST; simd++) {
+        if(!lv_draw_blend_simd_is_supported(simd)) continue;
+        lv_draw_blend_simd_set(simd);
+
+        printf("  %-4s", simd_names[simd]);
+        for(op = 0; op < _OP_LAST; op++) {
+            /*The mask is modified by the blending so restore it every time, also for the operations without mask*/
+            clock_t sum = 0;
+            for(i = 0; i < REPEAT; i++) {
+                lv_memcpy(mask, mask_ref, sizeof(mask));
+                clock_t start = clock();
+                blend(op, &area, lv_color_make(0x10, 0x80, 0xC0));
+                sum += clock() - start;
+            }
+            double sec = (double)sum / CLOCKS_PER_SEC;
+            printf(" %10.1f", sec > 0 ? (double)BUF_W * BUF_H * REPEAT / sec / 1000000.0 : 0.0);
+        }
+        printf("\n");
+    }
+
+    _lv_refr_set_disp_refreshing(NULL);
+    lv_test_deinit();
+    return 0;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file bench_font_lookup.c
+ * Measure how many glyphs can be looked up per second in a Latin and a CJK text,
+ * by searching in the cmaps and with the index of `lv_font_fmt_txt_build_index()`.
+ */
+
+#include "../lvgl.h"
+#include "lv_test_init.h"
+#include <stdio.h>
+#include <time.h>
+
+#define REPEAT  20000
+
+static const char * latin_txt = "The quick brown fox jumps over the lazy dog. 0123456789 ,.-;:!?()[]{}";
+static const char * cjk_txt = "你好世界，这是一个测试。我们在这里测量字体查找的速度和内存的使用情况。";
+
+/*Look up the glyphs of a text `REPEAT` times and return the lookups per second*/
+static double measure(const lv_font_t * font, const char * txt)
+{
+    static uint32_t letters[256];
+    uint32_t letter_cnt = 0;
+    uint32_t i = 0;
+    while(txt[i] != '\0' && letter_cnt < sizeof(letters) / sizeof(letters[0])) {
+        letters[letter_cnt] = _lv_txt_encoded_next(txt, &i);
+        letter_cnt++;
+    }
+
+    volatile uint32_t found_cnt = 0;
+    clock_t start = clock();
+    uint32_t r;
+    for(r = 0; r < REPEAT; r++) {
+        for(i = 0; i < letter_cnt; i++) {
+            lv_font_glyph_dsc_t g;
+            uint32_t letter_next = i + 1 < letter_cnt ? letters[i + 1] : 0;
+            if(lv_font_get_glyph_dsc(font, &g, letters[i], letter_next)) found_cnt++;
+        }
+    }
+    double sec = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    return sec > 0 ? (double)letter_cnt * REPEAT / sec : 0.0;
+}
+
+int main(void)
+{
+    lv_test_init();
+
+#if LV_FONT_SIMSUN_16_CJK
+    const lv_font_t * font = &lv_font_simsun_16_cjk;
+#else
+    const lv_font_t * font = &lv_font_montserrat_14;
+    printf("LV_FONT_SIMSUN_16_CJK is disabled, the CJK letters are not found in Montserrat\n");
+#endif
+
+    double latin_search = measure(font, latin_txt);
+    double cjk_search = measure(font, cjk_txt);
+
+    if(lv_font_fmt_txt_build_index(font) != LV_RES_OK) {
+        printf("Couldn't build the index of the font\n");
+        return 1;
+    }
+    double latin_index = measure(font, latin_txt);
+    double cjk_index = measure(font, cjk_txt);
+    lv_font_fmt_txt_free_index(font);
+
+    printf("Glyph lookups [lookups/s]       search        index\n");
+    printf("  Latin               %12.0f %12.0f\n", latin_search, latin_index);
+    printf("  CJK                 %12.0f %12.0f\n", cjk_search, cjk_index);
+
+    lv_test_deinit();
+    return 0;
+}
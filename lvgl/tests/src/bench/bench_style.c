@@ -0,0 +1,58 @@
+/**
+ * @file bench_style.c
+ * Measure how long it takes to redraw a screen with many themed widgets
+ * when every style property has to be resolved again.
+ */
+
+#include "../lvgl.h"
+#include "lv_test_init.h"
+#include <stdio.h>
+#include <time.h>
+
+#define REPEAT  10
+
+int main(void)
+{
+    lv_test_init();
+
+    uint32_t i;
+    for(i = 0; i < 8; i++) {
+        lv_obj_t * cont = lv_obj_create(lv_scr_act());
+        lv_obj_set_size(cont, 190, 230);
+        lv_obj_set_pos(cont, (i % 4) * 200, (i / 4) * 240);
+        lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+
+        lv_obj_t * btn = lv_btn_create(cont);
+        lv_label_set_text(lv_label_create(btn), "Button");
+        lv_slider_create(cont);
+        lv_switch_create(cont);
+        lv_checkbox_create(cont);
+        lv_bar_create(cont);
+        lv_dropdown_create(cont);
+    }
+
+    clock_t start = clock();
+    uint32_t lookup_cnt = 0;
+    uint32_t resolve_cnt = 0;
+    for(i = 0; i < REPEAT; i++) {
+        /*Drop the style caches to resolve every property*/
+        lv_obj_report_style_change(NULL);
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+
+        lv_disp_refr_stats_t stats;
+        lv_disp_get_refr_stats(lv_disp_get_default(), &stats);
+        lookup_cnt += stats.style_lookup_cnt;
+        resolve_cnt += stats.style_resolve_cnt;
+    }
+    double ms = (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC / REPEAT;
+
+    printf("Redrawing a theme-heavy screen after a style change\n");
+    printf("  Time per refresh [ms]:                  %.2f\n", ms);
+    printf("  Style properties got per refresh:       %d\n", (int)(lookup_cnt / REPEAT));
+    printf("  Style properties resolved per refresh:  %d\n", (int)(resolve_cnt / REPEAT));
+
+    lv_obj_clean(lv_scr_act());
+    lv_test_deinit();
+    return 0;
+}
@@ -0,0 +1,204 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include <stdlib.h>
+
+void setUp(void);
+void tearDown(void);
+
+void test_draw_blend_simd_should_select_only_supported_instruction_sets(void);
+void test_draw_blend_simd_should_give_the_same_result_as_plain_c(void);
+
+#define BUF_W   480
+#define BUF_H   272
+
+/*Only the top of the buffer is used to check the results*/
+#define CHECK_H 32
+#define CHECK_PX_CNT (BUF_W * CHECK_H)
+
+static lv_color_t buf_ref[BUF_W * BUF_H];
+static lv_color_t buf[BUF_W * BUF_H];
+static lv_color_t map[BUF_W * BUF_H];
+static lv_opa_t mask_ref[BUF_W * BUF_H];
+static lv_opa_t mask[BUF_W * BUF_H];
+
+static lv_disp_draw_buf_t * draw_buf;
+static lv_area_t area_ori;
+static void * buf_act_ori;
+static lv_draw_blend_simd_t simd_ori;
+
+static const char * simd_names[] = {"C", "SSE2", "AVX2", "NEON"};
+
+typedef enum {
+    OP_FILL,
+    OP_FILL_OPA,
+    OP_FILL_MASK,
+    OP_FILL_MASK_OPA,
+    OP_MAP,
+    OP_MAP_OPA,
+    OP_MAP_MASK,
+    OP_MAP_MASK_OPA,
+    _OP_LAST
+} op_t;
+
+static const char * op_names[] = {"fill", "fill opa", "fill mask", "fill mask opa",
+                                  "map", "map opa", "map mask", "map mask opa"
+                                 };
+
+void setUp(void)
+{
+    /*Draw into `buf` as if it was the draw buffer of the display*/
+    lv_disp_t * disp = lv_disp_get_default();
+    draw_buf = lv_disp_get_draw_buf(disp);
+    area_ori = draw_buf->area;
+    buf_act_ori = draw_buf->buf_act;
+    lv_area_set(&draw_buf->area, 0, 0, BUF_W - 1, BUF_H - 1);
+    draw_buf->buf_act = buf;
+    _lv_refr_set_disp_refreshing(disp);
+
+    simd_ori = lv_draw_blend_simd_get();
+    srand(1234);
+}
+
+void tearDown(void)
+{
+    lv_draw_blend_simd_set(simd_ori);
+    _lv_refr_set_disp_refreshing(NULL);
+    draw_buf->area = area_ori;
+    draw_buf->buf_act = buf_act_ori;
+}
+
+static lv_color_t rand_color(void)
+{
+    return lv_color_make(rand() & 0xFF, rand() & 0xFF, rand() & 0xFF);
+}
+
+/*Blocks of transparent, opaque and mixed mask values to test every branch of the kernels*/
+static void fill_rand_mask(lv_opa_t * m, uint32_t len)
+{
+    uint32_t i = 0;
+    while(i < len) {
+        uint32_t block = 1 + rand() % 24;
+        int type = rand() % 4;
+        uint32_t j;
+        for(j = 0; j < block && i < len; j++, i++) {
+            switch(type) {
+                case 0:
+                    m[i] = LV_OPA_TRANSP;
+                    break;
+                case 1:
+                    m[i] = LV_OPA_COVER;
+                    break;
+                case 2:
+                    m[i] = rand() & 0xFF;
+                    break;
+                default:
+                    m[i] = (rand() & 0x1) ? LV_OPA_COVER - (rand() % 4) : rand() % 4;
+                    break;
+            }
+        }
+    }
+}
+
+static void blend(op_t op, const lv_area_t * area, lv_color_t color, lv_opa_t opa)
+{
+    lv_area_t clip = {0, 0, BUF_W - 1, BUF_H - 1};
+    switch(op) {
+        case OP_FILL:
+        case OP_FILL_OPA:
+            _lv_blend_fill(&clip, area, color, NULL, LV_DRAW_MASK_RES_FULL_COVER, opa, LV_BLEND_MODE_NORMAL);
+            break;
+        case OP_FILL_MASK:
+        case OP_FILL_MASK_OPA:
+            _lv_blend_fill(&clip, area, color, mask, LV_DRAW_MASK_RES_CHANGED, opa, LV_BLEND_MODE_NORMAL);
+            break;
+        case OP_MAP:
+        case OP_MAP_OPA:
+            _lv_blend_map(&clip, area, map, NULL, LV_DRAW_MASK_RES_FULL_COVER, opa, LV_BLEND_MODE_NORMAL);
+            break;
+        default:
+            _lv_blend_map(&clip, area, map, mask, LV_DRAW_MASK_RES_CHANGED, opa, LV_BLEND_MODE_NORMAL);
+            break;
+    }
+}
+
+static lv_opa_t op_opa(op_t op, lv_opa_t opa)
+{
+    return (op == OP_FILL || op == OP_FILL_MASK || op == OP_MAP || op == OP_MAP_MASK) ? LV_OPA_COVER : opa;
+}
+
+void test_draw_blend_simd_should_select_only_supported_instruction_sets(void)
+{
+    TEST_ASSERT_TRUE(lv_draw_blend_simd_is_supported(LV_DRAW_BLEND_SIMD_NONE));
+    TEST_ASSERT_TRUE(lv_draw_blend_simd_is_supported(lv_draw_blend_simd_get()));
+    TEST_ASSERT_FALSE(lv_draw_blend_simd_is_supported(_LV_DRAW_BLEND_SIMD_LAST));
+
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_draw_blend_simd_set(LV_DRAW_BLEND_SIMD_NONE));
+    TEST_ASSERT_EQUAL(LV_DRAW_BLEND_SIMD_NONE, lv_draw_blend_simd_get());
+    TEST_ASSERT_NULL(_lv_draw_blend_simd_get_kernels());
+
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_draw_blend_simd_set(_LV_DRAW_BLEND_SIMD_LAST));
+    TEST_ASSERT_EQUAL(LV_DRAW_BLEND_SIMD_NONE, lv_draw_blend_simd_get());
+
+#if defined(__x86_64__) && (LV_COLOR_DEPTH == 32 || (LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0))
+    /*SSE2 is always available on x86_64*/
+    TEST_ASSERT_TRUE(lv_draw_blend_simd_is_supported(LV_DRAW_BLEND_SIMD_SSE2));
+    TEST_ASSERT_NOT_EQUAL(LV_DRAW_BLEND_SIMD_NONE, simd_ori);
+#endif
+}
+
+void test_draw_blend_simd_should_give_the_same_result_as_plain_c(void)
+{
+    /*Odd sizes and positions to have pixels outside of the whole vectors too*/
+    static const lv_area_t areas[] = {
+        {0, 0, BUF_W - 1, CHECK_H - 1},
+        {3, 1, 3 + 36, 9},
+        {5, 7, 5 + 2, CHECK_H - 2},
+        {BUF_W - 20, 2, BUF_W - 1, 12},
+    };
+    static const lv_opa_t opas[] = {LV_OPA_MIN, 3, LV_OPA_50, 200, LV_OPA_MAX};
+
+    lv_draw_blend_simd_t simd;
+    for(simd = LV_DRAW_BLEND_SIMD_NONE + 1; simd < _LV_DRAW_BLEND_SIMD_LAST; simd++) {
+        if(!lv_draw_blend_simd_is_supported(simd)) continue;
+
+        op_t op;
+        for(op = 0; op < _OP_LAST; op++) {
+            uint32_t a;
+            for(a = 0; a < sizeof(areas) / sizeof(areas[0]); a++) {
+                uint32_t o;
+                for(o = 0; o < sizeof(opas) / sizeof(opas[0]); o++) {
+                    uint32_t i;
+                    for(i = 0; i < CHECK_PX_CNT; i++) buf[i] = rand_color();
+                    for(i = 0; i < CHECK_PX_CNT; i++) map[i] = rand_color();
+                    fill_rand_mask(mask_ref, CHECK_PX_CNT);
+                    lv_color_t color = rand_color();
+                    lv_opa_t opa = op_opa(op, opas[o]);
+                    lv_memcpy(buf_ref, buf, CHECK_PX_CNT * sizeof(lv_color_t));
+
+                    /*Plain C*/
+                    lv_memcpy(mask, mask_ref, CHECK_PX_CNT);
+                    lv_draw_blend_simd_set(LV_DRAW_BLEND_SIMD_NONE);
+                    blend(op, &areas[a], color, opa);
+
+                    /*SIMD on the same input*/
+                    for(i = 0; i < CHECK_PX_CNT; i++) {
+                        lv_color_t tmp = buf[i];
+                        buf[i] = buf_ref[i];
+                        buf_ref[i] = tmp;
+                    }
+                    lv_memcpy(mask, mask_ref, CHECK_PX_CNT);
+                    lv_draw_blend_simd_set(simd);
+                    blend(op, &areas[a], color, opa);
+
+                    char msg[64];
+                    lv_snprintf(msg, sizeof(msg), "%s, %s, area %d, opa %d", simd_names[simd], op_names[op], a, opa);
+                    TEST_ASSERT_EQUAL_MEMORY_MESSAGE(buf_ref, buf, CHECK_PX_CNT * sizeof(lv_color_t), msg);
+                }
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,185 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void);
+void tearDown(void);
+
+void test_draw_mask_circle_cache_should_share_the_circle_of_the_same_radius(void);
+void test_draw_mask_circle_cache_should_drop_the_least_recently_used_circle(void);
+void test_draw_mask_circle_cache_should_not_cache_if_all_entries_are_used(void);
+void test_draw_mask_circle_cache_should_keep_the_circles_between_refreshes(void);
+
+#if LV_DRAW_COMPLEX && LV_CIRCLE_CACHE_SIZE > 0
+
+static lv_draw_mask_circle_cache_stats_t stats_start;
+
+static void radius_init(lv_draw_mask_radius_param_t * param, lv_coord_t radius)
+{
+    lv_area_t rect = {10, 10, 209, 209};
+    lv_draw_mask_radius_init(param, &rect, radius, false);
+}
+
+static lv_draw_mask_circle_cache_stats_t get_stats(void)
+{
+    lv_draw_mask_circle_cache_stats_t stats;
+    lv_draw_mask_circle_cache_get_stats(&stats);
+    stats.hit_cnt -= stats_start.hit_cnt;
+    stats.miss_cnt -= stats_start.miss_cnt;
+    stats.evict_cnt -= stats_start.evict_cnt;
+    stats.uncached_cnt -= stats_start.uncached_cnt;
+    return stats;
+}
+
+/*Use and free a mask with `radius` to mark its circle as used*/
+static void touch(lv_coord_t radius)
+{
+    lv_draw_mask_radius_param_t param;
+    radius_init(&param, radius);
+    lv_draw_mask_free_param(&param);
+}
+
+void setUp(void)
+{
+    _lv_draw_mask_cleanup();
+    lv_draw_mask_circle_cache_get_stats(&stats_start);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    _lv_draw_mask_cleanup();
+}
+
+void test_draw_mask_circle_cache_should_share_the_circle_of_the_same_radius(void)
+{
+    lv_draw_mask_radius_param_t param1;
+    lv_draw_mask_radius_param_t param2;
+    radius_init(&param1, 20);
+    radius_init(&param2, 20);
+
+    TEST_ASSERT_EQUAL_PTR(param1.circle, param2.circle);
+    TEST_ASSERT_EQUAL(2, param1.circle->used_cnt);
+
+    lv_draw_mask_circle_cache_stats_t stats = get_stats();
+    TEST_ASSERT_EQUAL(1, stats.miss_cnt);
+    TEST_ASSERT_EQUAL(1, stats.hit_cnt);
+    TEST_ASSERT_EQUAL(1, stats.circle_cnt);
+    TEST_ASSERT_EQUAL(20 * 6 + 6, stats.mem_size);
+
+    lv_draw_mask_free_param(&param1);
+    lv_draw_mask_free_param(&param2);
+    TEST_ASSERT_EQUAL(0, param1.circle->used_cnt);
+
+    /*Freeing the masks keeps the circle in the cache*/
+    TEST_ASSERT_EQUAL(1, get_stats().circle_cnt);
+    touch(20);
+    TEST_ASSERT_EQUAL(2, get_stats().hit_cnt);
+
+    _lv_draw_mask_cleanup();
+    stats = get_stats();
+    TEST_ASSERT_EQUAL(0, stats.circle_cnt);
+    TEST_ASSERT_EQUAL(0, stats.mem_size);
+}
+
+void test_draw_mask_circle_cache_should_drop_the_least_recently_used_circle(void)
+{
+    lv_coord_t i;
+    for(i = 0; i < LV_CIRCLE_CACHE_SIZE; i++) touch(10 + i);
+
+    /*Use the first one again so the second one becomes the least recently used*/
+    touch(10);
+    touch(100);
+
+    lv_draw_mask_circle_cache_stats_t stats = get_stats();
+    TEST_ASSERT_EQUAL(LV_CIRCLE_CACHE_SIZE + 1, stats.miss_cnt);
+    TEST_ASSERT_EQUAL(1, stats.hit_cnt);
+    TEST_ASSERT_EQUAL(1, stats.evict_cnt);
+    TEST_ASSERT_EQUAL(LV_CIRCLE_CACHE_SIZE, stats.circle_cnt);
+
+    uint32_t mem_size = 100 * 6 + 6;
+    for(i = 0; i < LV_CIRCLE_CACHE_SIZE; i++) {
+        if(i != 1) mem_size += (10 + i) * 6 + 6;
+    }
+    TEST_ASSERT_EQUAL(mem_size, stats.mem_size);
+
+    touch(10);
+    TEST_ASSERT_EQUAL(2, get_stats().hit_cnt);
+    touch(11);
+    TEST_ASSERT_EQUAL(LV_CIRCLE_CACHE_SIZE + 2, get_stats().miss_cnt);
+}
+
+void test_draw_mask_circle_cache_should_not_cache_if_all_entries_are_used(void)
+{
+    lv_draw_mask_radius_param_t params[LV_CIRCLE_CACHE_SIZE + 1];
+    lv_coord_t i;
+    for(i = 0; i < LV_CIRCLE_CACHE_SIZE + 1; i++) radius_init(&params[i], 10 + i);
+
+    lv_draw_mask_circle_cache_stats_t stats = get_stats();
+    TEST_ASSERT_EQUAL(LV_CIRCLE_CACHE_SIZE + 1, stats.miss_cnt);
+    TEST_ASSERT_EQUAL(1, stats.uncached_cnt);
+    TEST_ASSERT_EQUAL(0, stats.evict_cnt);
+    TEST_ASSERT_EQUAL(LV_CIRCLE_CACHE_SIZE, stats.circle_cnt);
+
+    /*The uncached circle is still a valid circle*/
+    lv_draw_mask_radius_param_t * last = &params[LV_CIRCLE_CACHE_SIZE];
+    TEST_ASSERT_NOT_NULL(last->circle);
+    TEST_ASSERT_EQUAL(10 + LV_CIRCLE_CACHE_SIZE, last->circle->radius);
+
+    for(i = 0; i < LV_CIRCLE_CACHE_SIZE + 1; i++) lv_draw_mask_free_param(&params[i]);
+    TEST_ASSERT_EQUAL(LV_CIRCLE_CACHE_SIZE, get_stats().circle_cnt);
+}
+
+void test_draw_mask_circle_cache_should_keep_the_circles_between_refreshes(void)
+{
+    lv_coord_t i;
+    for(i = 0; i < LV_CIRCLE_CACHE_SIZE; i++) {
+        lv_obj_t * btn = lv_btn_create(lv_scr_act());
+        lv_obj_set_pos(btn, 20 + i * 150, 20);
+        lv_obj_set_size(btn, 120, 80);
+        lv_obj_set_style_radius(btn, 5 + i * 5, LV_PART_MAIN);
+    }
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    uint32_t miss_cnt = get_stats().miss_cnt;
+    TEST_ASSERT_GREATER_THAN(0, miss_cnt);
+
+    /*Every circle is taken from the cache now*/
+    uint32_t hit_cnt = get_stats().hit_cnt;
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(miss_cnt, get_stats().miss_cnt);
+    TEST_ASSERT_GREATER_THAN(hit_cnt, get_stats().hit_cnt);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_draw_mask_circle_cache_should_share_the_circle_of_the_same_radius(void)
+{
+}
+
+void test_draw_mask_circle_cache_should_drop_the_least_recently_used_circle(void)
+{
+}
+
+void test_draw_mask_circle_cache_should_not_cache_if_all_entries_are_used(void)
+{
+}
+
+void test_draw_mask_circle_cache_should_keep_the_circles_between_refreshes(void)
+{
+}
+
+#endif
+
+#endif
@@ -0,0 +1,128 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void);
+void tearDown(void);
+
+void test_draw_set_px_span_should_draw_the_same_as_set_px(void);
+void test_draw_set_px_span_should_be_used_instead_of_set_px(void);
+
+#define SCR_W   800
+#define SCR_H   480
+
+/*The callbacks draw here with absolute coordinates*/
+static lv_color_t scr_px[SCR_W * SCR_H];
+static lv_color_t scr_span[SCR_W * SCR_H];
+
+static uint32_t px_call_cnt;
+static uint32_t span_call_cnt;
+
+static lv_disp_drv_t * driver;
+
+static void set_px(lv_color_t * scr, lv_coord_t x, lv_coord_t y, lv_color_t color, lv_opa_t opa)
+{
+    /*`x` and `y` are relative to the area being rendered*/
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(_lv_refr_get_disp_refreshing());
+    lv_color_t * px = &scr[(draw_buf->area.y1 + y) * SCR_W + draw_buf->area.x1 + x];
+    *px = lv_color_mix(color, *px, opa);
+}
+
+static void set_px_cb(lv_disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y,
+                      lv_color_t color, lv_opa_t opa)
+{
+    LV_UNUSED(disp_drv);
+    LV_UNUSED(buf);
+    LV_UNUSED(buf_w);
+    px_call_cnt++;
+    set_px(scr_px, x, y, color, opa);
+}
+
+static void set_px_span_cb(lv_disp_drv_t * disp_drv, uint8_t * buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y,
+                           lv_coord_t len, const lv_color_t * colors, lv_color_t color, const lv_opa_t * mask, lv_opa_t opa)
+{
+    LV_UNUSED(disp_drv);
+    LV_UNUSED(buf);
+    LV_UNUSED(buf_w);
+    span_call_cnt++;
+
+    lv_coord_t i;
+    for(i = 0; i < len; i++) {
+        if(mask && mask[i] == 0) continue;
+        lv_opa_t px_opa = mask ? (uint32_t)((uint32_t)opa * mask[i]) >> 8 : opa;
+        set_px(scr_span, x + i, y, colors ? colors[i] : color, px_opa);
+    }
+}
+
+static void create_ui(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(obj, 300, 200);
+    lv_obj_set_style_radius(obj, 20, LV_PART_MAIN);
+    lv_obj_set_style_border_width(obj, 3, LV_PART_MAIN);
+    lv_obj_set_style_shadow_width(obj, 15, LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_70, LV_PART_MAIN);
+
+    lv_obj_t * label = lv_label_create(obj);
+    lv_label_set_text(label, "Some text to draw\nwith anti-aliased letters");
+
+    lv_obj_t * arc = lv_arc_create(lv_scr_act());
+    lv_obj_align(arc, LV_ALIGN_BOTTOM_RIGHT, -20, -20);
+
+    lv_obj_t * cb = lv_checkbox_create(lv_scr_act());
+    lv_obj_align(cb, LV_ALIGN_TOP_RIGHT, -20, 20);
+    lv_obj_add_state(cb, LV_STATE_CHECKED);
+}
+
+void setUp(void)
+{
+    driver = lv_disp_get_default()->driver;
+    px_call_cnt = 0;
+    span_call_cnt = 0;
+    lv_memset_00(scr_px, sizeof(scr_px));
+    lv_memset_00(scr_span, sizeof(scr_span));
+}
+
+void tearDown(void)
+{
+    driver->set_px_cb = NULL;
+    driver->set_px_span_cb = NULL;
+    lv_obj_clean(lv_scr_act());
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+void test_draw_set_px_span_should_draw_the_same_as_set_px(void)
+{
+    create_ui();
+
+    driver->set_px_cb = set_px_cb;
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    driver->set_px_cb = NULL;
+    driver->set_px_span_cb = set_px_span_cb;
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_GREATER_THAN(0, px_call_cnt);
+    TEST_ASSERT_GREATER_THAN(0, span_call_cnt);
+    TEST_ASSERT_LESS_THAN(px_call_cnt / 10, span_call_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(scr_px, scr_span, sizeof(scr_px));
+}
+
+void test_draw_set_px_span_should_be_used_instead_of_set_px(void)
+{
+    create_ui();
+
+    driver->set_px_cb = set_px_cb;
+    driver->set_px_span_cb = set_px_span_cb;
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    TEST_ASSERT_EQUAL(0, px_call_cnt);
+    TEST_ASSERT_GREATER_THAN(0, span_call_cnt);
+}
+
+#endif
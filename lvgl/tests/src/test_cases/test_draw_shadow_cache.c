@@ -0,0 +1,159 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void);
+void tearDown(void);
+
+void test_draw_shadow_cache_should_share_the_corner_of_the_same_shadows(void);
+void test_draw_shadow_cache_should_not_share_the_corner_of_small_rectangles(void);
+void test_draw_shadow_cache_should_drop_the_least_recently_used_corners(void);
+
+extern lv_color_t test_fb[];
+
+#define SCR_W   800
+#define SCR_H   480
+
+#if LV_DRAW_COMPLEX && LV_SHADOW_CACHE_SIZE > 0
+
+static lv_draw_rect_shadow_cache_stats_t stats_start;
+
+static lv_obj_t * card_create(lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h, lv_coord_t shadow_w)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, w, h);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, LV_PART_MAIN);
+    lv_obj_set_style_radius(obj, 8, LV_PART_MAIN);
+    lv_obj_set_style_shadow_width(obj, shadow_w, LV_PART_MAIN);
+    lv_obj_set_style_shadow_ofs_y(obj, 4, LV_PART_MAIN);
+    lv_obj_set_style_shadow_opa(obj, LV_OPA_70, LV_PART_MAIN);
+    return obj;
+}
+
+static void refr(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+static lv_draw_rect_shadow_cache_stats_t get_stats(void)
+{
+    lv_draw_rect_shadow_cache_stats_t stats;
+    lv_draw_rect_shadow_cache_get_stats(&stats);
+    stats.hit_cnt -= stats_start.hit_cnt;
+    stats.miss_cnt -= stats_start.miss_cnt;
+    stats.evict_cnt -= stats_start.evict_cnt;
+    return stats;
+}
+
+void setUp(void)
+{
+    lv_draw_rect_shadow_cache_clean();
+    lv_draw_rect_shadow_cache_get_stats(&stats_start);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_draw_rect_shadow_cache_clean();
+}
+
+void test_draw_shadow_cache_should_share_the_corner_of_the_same_shadows(void)
+{
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        card_create(20 + (i % 5) * 150, 40 + (i / 5) * 200, 120 + i, 150, 30);
+    }
+    refr();
+
+    static lv_color_t ref_fb[SCR_W * SCR_H];
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    lv_draw_rect_shadow_cache_stats_t stats = get_stats();
+    TEST_ASSERT_EQUAL(1, stats.miss_cnt);
+    TEST_ASSERT_EQUAL(9, stats.hit_cnt);
+    TEST_ASSERT_EQUAL(1, stats.corner_cnt);
+    TEST_ASSERT_EQUAL((30 + 8) * (30 + 8), stats.mem_size);
+
+    /*Every shadow is drawn from the cache now*/
+    refr();
+    stats = get_stats();
+    TEST_ASSERT_EQUAL(1, stats.miss_cnt);
+    TEST_ASSERT_EQUAL(19, stats.hit_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+
+    lv_draw_rect_shadow_cache_clean();
+    stats = get_stats();
+    TEST_ASSERT_EQUAL(0, stats.corner_cnt);
+    TEST_ASSERT_EQUAL(0, stats.mem_size);
+}
+
+void test_draw_shadow_cache_should_not_share_the_corner_of_small_rectangles(void)
+{
+    /*The corner of a small rectangle is different because its other side is close*/
+    lv_obj_t * big = card_create(100, 100, 200, 200, 40);
+    card_create(500, 100, 10, 10, 40);
+
+    lv_obj_add_flag(big, LV_OBJ_FLAG_HIDDEN);
+    refr();
+    static lv_color_t ref_fb[SCR_W * SCR_H];
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    /*Draw the small card with the cached corner of the big card*/
+    lv_draw_rect_shadow_cache_clean();
+    lv_obj_clear_flag(big, LV_OBJ_FLAG_HIDDEN);
+    refr();
+    TEST_ASSERT_EQUAL(2, get_stats().corner_cnt);
+
+    lv_coord_t y;
+    for(y = 40; y < 200; y++) {
+        TEST_ASSERT_EQUAL_MEMORY(&ref_fb[y * SCR_W + 400], &test_fb[y * SCR_W + 400], 200 * sizeof(lv_color_t));
+    }
+}
+
+void test_draw_shadow_cache_should_drop_the_least_recently_used_corners(void)
+{
+    uint32_t i;
+    for(i = 0; i < _LV_SHADOW_CACHE_ENTRY_CNT + 4; i++) {
+        card_create(20 + (i % 8) * 95, 40 + (i / 8) * 140, 60, 80, 10 + i);
+    }
+    refr();
+
+    lv_draw_rect_shadow_cache_stats_t stats = get_stats();
+    TEST_ASSERT_EQUAL(_LV_SHADOW_CACHE_ENTRY_CNT + 4, stats.miss_cnt);
+    TEST_ASSERT_EQUAL(4, stats.evict_cnt);
+    TEST_ASSERT_EQUAL(_LV_SHADOW_CACHE_ENTRY_CNT, stats.corner_cnt);
+
+    uint32_t mem_size = 0;
+    for(i = 4; i < _LV_SHADOW_CACHE_ENTRY_CNT + 4; i++) mem_size += (10 + i + 8) * (10 + i + 8);
+    TEST_ASSERT_EQUAL(mem_size, stats.mem_size);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_draw_shadow_cache_should_share_the_corner_of_the_same_shadows(void)
+{
+}
+
+void test_draw_shadow_cache_should_not_share_the_corner_of_small_rectangles(void)
+{
+}
+
+void test_draw_shadow_cache_should_drop_the_least_recently_used_corners(void)
+{
+}
+
+#endif
+
+#endif
@@ -0,0 +1,91 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void);
+void tearDown(void);
+
+void test_font_fmt_txt_index_should_find_the_same_glyphs(void);
+void test_font_fmt_txt_index_should_measure_the_same_text_width(void);
+
+static const char * latin_txt = "The quick brown fox jumps over the lazy dog. 0123456789 ,.-;:!?()[]{}";
+static const char * cjk_txt = "你好世界，这是一个测试。我们在这里测量字体查找的速度和内存的使用情况。";
+
+static lv_font_fmt_txt_index_t * index_swap(const lv_font_t * font, lv_font_fmt_txt_index_t * index)
+{
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+    lv_font_fmt_txt_index_t * old = fdsc->cache->index;
+    fdsc->cache->index = index;
+    return old;
+}
+
+static void check_font(const lv_font_t * font)
+{
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_font_fmt_txt_build_index(font));
+    lv_font_fmt_txt_index_t * index = index_swap(font, NULL);
+    TEST_ASSERT_NOT_NULL(index);
+
+    uint32_t letter;
+    for(letter = 1; letter < 0x10000; letter++) {
+        lv_font_glyph_dsc_t g_ref;
+        lv_font_glyph_dsc_t g;
+        lv_memset_00(&g_ref, sizeof(g_ref));
+        lv_memset_00(&g, sizeof(g));
+
+        bool found_ref = lv_font_get_glyph_dsc(font, &g_ref, letter, 'A');
+        index_swap(font, index);
+        bool found = lv_font_get_glyph_dsc(font, &g, letter, 'A');
+        index_swap(font, NULL);
+
+        TEST_ASSERT_EQUAL(found_ref, found);
+        TEST_ASSERT_EQUAL_MEMORY(&g_ref, &g, sizeof(g));
+    }
+
+    index_swap(font, index);
+    lv_font_fmt_txt_free_index(font);
+    TEST_ASSERT_NULL(((lv_font_fmt_txt_dsc_t *)font->dsc)->cache->index);
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+void test_font_fmt_txt_index_should_find_the_same_glyphs(void)
+{
+    check_font(&lv_font_montserrat_14);
+#if LV_FONT_MONTSERRAT_28_COMPRESSED
+    check_font(&lv_font_montserrat_28_compressed);
+#endif
+#if LV_FONT_DEJAVU_16_PERSIAN_HEBREW
+    check_font(&lv_font_dejavu_16_persian_hebrew);
+#endif
+#if LV_FONT_SIMSUN_16_CJK
+    check_font(&lv_font_simsun_16_cjk);
+#endif
+}
+
+void test_font_fmt_txt_index_should_measure_the_same_text_width(void)
+{
+#if LV_FONT_SIMSUN_16_CJK
+    const lv_font_t * font = &lv_font_simsun_16_cjk;
+#else
+    const lv_font_t * font = &lv_font_montserrat_14;
+#endif
+
+    lv_coord_t latin_w = lv_txt_get_width(latin_txt, strlen(latin_txt), font, 0, LV_TEXT_FLAG_NONE);
+    lv_coord_t cjk_w = lv_txt_get_width(cjk_txt, strlen(cjk_txt), font, 0, LV_TEXT_FLAG_NONE);
+
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_font_fmt_txt_build_index(font));
+    TEST_ASSERT_EQUAL(latin_w, lv_txt_get_width(latin_txt, strlen(latin_txt), font, 0, LV_TEXT_FLAG_NONE));
+    TEST_ASSERT_EQUAL(cjk_w, lv_txt_get_width(cjk_txt, strlen(cjk_txt), font, 0, LV_TEXT_FLAG_NONE));
+    lv_font_fmt_txt_free_index(font);
+}
+
+#endif
@@ -0,0 +1,155 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void);
+void tearDown(void);
+
+void test_font_glyph_cache_should_return_the_decompressed_bitmap(void);
+void test_font_glyph_cache_should_evict_when_full(void);
+void test_font_glyph_cache_should_drop_the_glyphs_of_a_font(void);
+
+/*Only the compressed fonts are decompressed into the cache*/
+#if LV_FONT_MONTSERRAT_28_COMPRESSED
+
+#define CACHE_SIZE  (16 * 1024)
+
+static const lv_font_t * font = &lv_font_montserrat_28_compressed;
+
+static lv_font_glyph_cache_stats_t stats_diff(const lv_font_glyph_cache_stats_t * start)
+{
+    lv_font_glyph_cache_stats_t now;
+    lv_font_glyph_cache_get_stats(&now);
+    now.hit_cnt -= start->hit_cnt;
+    now.miss_cnt -= start->miss_cnt;
+    now.evict_cnt -= start->evict_cnt;
+    return now;
+}
+
+static uint32_t get_bitmap_size(uint32_t letter)
+{
+    lv_font_glyph_dsc_t g;
+    lv_font_get_glyph_dsc(font, &g, letter, '\0');
+    return (g.box_w * g.box_h + 1) / 2;     /*4 bpp*/
+}
+
+void setUp(void)
+{
+    lv_font_glyph_cache_set_size(CACHE_SIZE);
+}
+
+void tearDown(void)
+{
+    lv_font_glyph_cache_set_size(LV_FONT_GLYPH_CACHE_SIZE);
+}
+
+void test_font_glyph_cache_should_return_the_decompressed_bitmap(void)
+{
+    const char * letters = "AgW@";
+    static uint8_t ref[4][512];
+
+    /*Get the reference bitmaps without the cache*/
+    lv_font_glyph_cache_set_size(0);
+    uint32_t i;
+    for(i = 0; letters[i]; i++) {
+        TEST_ASSERT_LESS_OR_EQUAL(sizeof(ref[i]), get_bitmap_size(letters[i]));
+        lv_memcpy(ref[i], lv_font_get_glyph_bitmap(font, letters[i]), get_bitmap_size(letters[i]));
+    }
+
+    lv_font_glyph_cache_set_size(CACHE_SIZE);
+    lv_font_glyph_cache_stats_t start;
+    lv_font_glyph_cache_get_stats(&start);
+
+    for(i = 0; letters[i]; i++) {
+        const uint8_t * first = lv_font_get_glyph_bitmap(font, letters[i]);
+        TEST_ASSERT_EQUAL_MEMORY(ref[i], first, get_bitmap_size(letters[i]));
+
+        const uint8_t * second = lv_font_get_glyph_bitmap(font, letters[i]);
+        TEST_ASSERT_EQUAL_PTR(first, second);
+    }
+
+    lv_font_glyph_cache_stats_t d = stats_diff(&start);
+    TEST_ASSERT_EQUAL(4, d.miss_cnt);
+    TEST_ASSERT_EQUAL(4, d.hit_cnt);
+    TEST_ASSERT_EQUAL(4, d.glyph_cnt);
+
+    /*The bitmaps are still correct after the others were added*/
+    for(i = 0; letters[i]; i++) {
+        TEST_ASSERT_EQUAL_MEMORY(ref[i], lv_font_get_glyph_bitmap(font, letters[i]), get_bitmap_size(letters[i]));
+    }
+}
+
+void test_font_glyph_cache_should_evict_when_full(void)
+{
+    lv_font_glyph_cache_set_size(4096);
+
+    lv_font_glyph_cache_stats_t start;
+    lv_font_glyph_cache_get_stats(&start);
+
+    uint32_t letter;
+    for(letter = 'A'; letter <= 'Z'; letter++) {
+        TEST_ASSERT_NOT_NULL(lv_font_get_glyph_bitmap(font, letter));
+    }
+
+    lv_font_glyph_cache_stats_t d = stats_diff(&start);
+    TEST_ASSERT_EQUAL(26, d.miss_cnt);
+    TEST_ASSERT_GREATER_THAN(0, d.evict_cnt);
+    TEST_ASSERT_EQUAL(26, d.glyph_cnt + d.evict_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(4096, d.mem_size);
+
+    /*The last letter was used recently so it's still cached*/
+    lv_font_get_glyph_bitmap(font, 'Z');
+    d = stats_diff(&start);
+    TEST_ASSERT_EQUAL(1, d.hit_cnt);
+}
+
+void test_font_glyph_cache_should_drop_the_glyphs_of_a_font(void)
+{
+    lv_font_get_glyph_bitmap(font, 'a');
+    lv_font_get_glyph_bitmap(font, 'b');
+
+    lv_font_glyph_cache_stats_t stats;
+    lv_font_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.glyph_cnt);
+
+    lv_font_glyph_cache_invalidate_font(font);
+    lv_font_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.glyph_cnt);
+    TEST_ASSERT_EQUAL(0, stats.mem_size);
+
+    lv_font_glyph_cache_stats_t start = stats;
+    lv_font_get_glyph_bitmap(font, 'a');
+    lv_font_glyph_cache_stats_t d = stats_diff(&start);
+    TEST_ASSERT_EQUAL(1, d.miss_cnt);
+    TEST_ASSERT_EQUAL(0, d.hit_cnt);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_font_glyph_cache_should_return_the_decompressed_bitmap(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_FONT_MONTSERRAT_28_COMPRESSED");
+}
+
+void test_font_glyph_cache_should_evict_when_full(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_FONT_MONTSERRAT_28_COMPRESSED");
+}
+
+void test_font_glyph_cache_should_drop_the_glyphs_of_a_font(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_FONT_MONTSERRAT_28_COMPRESSED");
+}
+
+#endif
+
+#endif
@@ -0,0 +1,160 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void);
+void tearDown(void);
+
+void test_img_cache_should_hit_after_first_open(void);
+void test_img_cache_should_evict_the_weakest_entry_when_full(void);
+void test_img_cache_should_keep_the_memory_limit(void);
+void test_img_cache_should_reopen_invalidated_src(void);
+
+#define IMG_W   8
+#define IMG_H   8
+#define IMG_SIZE (IMG_W * IMG_H * sizeof(lv_color_t))
+
+static uint32_t open_cnt;
+static lv_img_decoder_t * decoder;
+
+static lv_res_t decoder_info(lv_img_decoder_t * dec, const void * src, lv_img_header_t * header)
+{
+    LV_UNUSED(dec);
+    if(lv_img_src_get_type(src) != LV_IMG_SRC_FILE) return LV_RES_INV;
+    if(strcmp(lv_fs_get_ext(src), "tst")) return LV_RES_INV;
+
+    header->w = IMG_W;
+    header->h = IMG_H;
+    header->cf = LV_IMG_CF_TRUE_COLOR;
+    return LV_RES_OK;
+}
+
+static lv_res_t decoder_open(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(dec);
+    dsc->img_data = lv_mem_alloc(IMG_SIZE);
+    open_cnt++;
+    return LV_RES_OK;
+}
+
+static void decoder_close(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(dec);
+    lv_mem_free((void *)dsc->img_data);
+}
+
+static lv_img_cache_stats_t stats_diff(const lv_img_cache_stats_t * start)
+{
+    lv_img_cache_stats_t now;
+    lv_img_cache_get_stats(&now);
+    now.hit_cnt -= start->hit_cnt;
+    now.miss_cnt -= start->miss_cnt;
+    now.evict_cnt -= start->evict_cnt;
+    return now;
+}
+
+void setUp(void)
+{
+    if(decoder == NULL) {
+        decoder = lv_img_decoder_create();
+        lv_img_decoder_set_info_cb(decoder, decoder_info);
+        lv_img_decoder_set_open_cb(decoder, decoder_open);
+        lv_img_decoder_set_close_cb(decoder, decoder_close);
+    }
+
+    lv_img_cache_set_size(4);
+    lv_img_cache_set_mem_size(0);
+    open_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
+}
+
+void test_img_cache_should_hit_after_first_open(void)
+{
+    lv_img_cache_stats_t start;
+    lv_img_cache_get_stats(&start);
+
+    TEST_ASSERT_NOT_NULL(_lv_img_cache_open("A:a.tst", lv_color_black(), 0));
+    TEST_ASSERT_NOT_NULL(_lv_img_cache_open("A:a.tst", lv_color_black(), 0));
+    /*Different frame of the same source is a different entry*/
+    TEST_ASSERT_NOT_NULL(_lv_img_cache_open("A:a.tst", lv_color_black(), 1));
+
+    lv_img_cache_stats_t d = stats_diff(&start);
+    TEST_ASSERT_EQUAL(2, open_cnt);
+    TEST_ASSERT_EQUAL(1, d.hit_cnt);
+    TEST_ASSERT_EQUAL(2, d.miss_cnt);
+    TEST_ASSERT_EQUAL(2, d.entry_cnt);
+    TEST_ASSERT_EQUAL(2 * IMG_SIZE, d.mem_size);
+}
+
+void test_img_cache_should_evict_the_weakest_entry_when_full(void)
+{
+    const char * srcs[] = {"A:1.tst", "A:2.tst", "A:3.tst", "A:4.tst"};
+    lv_img_cache_stats_t start;
+    lv_img_cache_get_stats(&start);
+
+    uint32_t i;
+    for(i = 0; i < 4; i++) _lv_img_cache_open(srcs[i], lv_color_black(), 0);
+
+    /*Make the first image more valuable*/
+    _lv_img_cache_entry_t * e = _lv_img_cache_open(srcs[0], lv_color_black(), 0);
+    e->dec_dsc.time_to_open = 100;
+    _lv_img_cache_open(srcs[0], lv_color_black(), 0);
+
+    _lv_img_cache_open("A:5.tst", lv_color_black(), 0);
+
+    lv_img_cache_stats_t d = stats_diff(&start);
+    TEST_ASSERT_EQUAL(1, d.evict_cnt);
+    TEST_ASSERT_EQUAL(4, d.entry_cnt);
+
+    /*The valuable image stayed in the cache, the oldest of the others was closed*/
+    uint32_t open_cnt_prev = open_cnt;
+    _lv_img_cache_open(srcs[0], lv_color_black(), 0);
+    TEST_ASSERT_EQUAL(open_cnt_prev, open_cnt);
+    _lv_img_cache_open(srcs[1], lv_color_black(), 0);
+    TEST_ASSERT_EQUAL(open_cnt_prev + 1, open_cnt);
+}
+
+void test_img_cache_should_keep_the_memory_limit(void)
+{
+    lv_img_cache_stats_t start;
+    lv_img_cache_get_stats(&start);
+
+    lv_img_cache_set_mem_size(2 * IMG_SIZE);
+    _lv_img_cache_open("A:1.tst", lv_color_black(), 0);
+    _lv_img_cache_open("A:2.tst", lv_color_black(), 0);
+    _lv_img_cache_open("A:3.tst", lv_color_black(), 0);
+
+    lv_img_cache_stats_t d = stats_diff(&start);
+    TEST_ASSERT_EQUAL(2, d.entry_cnt);
+    TEST_ASSERT_EQUAL(2 * IMG_SIZE, d.mem_size);
+    TEST_ASSERT_EQUAL(1, d.evict_cnt);
+
+    /*Lowering the limit closes images immediately*/
+    lv_img_cache_set_mem_size(IMG_SIZE);
+    d = stats_diff(&start);
+    TEST_ASSERT_EQUAL(1, d.entry_cnt);
+    TEST_ASSERT_EQUAL(IMG_SIZE, d.mem_size);
+}
+
+void test_img_cache_should_reopen_invalidated_src(void)
+{
+    _lv_img_cache_open("A:a.tst", lv_color_black(), 0);
+    _lv_img_cache_open("A:a.tst", lv_color_white(), 0);
+    _lv_img_cache_open("A:b.tst", lv_color_black(), 0);
+
+    lv_img_cache_invalidate_src("A:a.tst");
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.entry_cnt);
+
+    _lv_img_cache_open("A:a.tst", lv_color_black(), 0);
+    TEST_ASSERT_EQUAL(4, open_cnt);
+}
+
+#endif
@@ -0,0 +1,278 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../../src/misc/lv_thread.h"
+
+#include "unity/unity.h"
+#include <unistd.h>
+
+void setUp(void);
+void tearDown(void);
+
+void test_img_cache_async_should_draw_the_image_when_decoded(void);
+void test_img_cache_async_should_not_return_the_failed_images(void);
+void test_img_cache_async_should_not_use_the_decoders_in_parallel(void);
+void test_img_cache_async_should_get_the_info_while_decoding(void);
+
+#if LV_IMG_CACHE_ASYNC
+
+extern lv_color_t test_fb[];
+
+#define SCR_W       800
+#define IMG_W       8
+#define IMG_H       8
+#define IMG_SIZE    (IMG_W * IMG_H * sizeof(lv_color_t))
+
+/*Maximal time to wait for the decoding thread [ms]*/
+#define TIMEOUT     1000
+
+static lv_img_decoder_t * decoder;
+static lv_mutex_t gate;             /*The decoding thread waits in `decoder_open` while it's locked*/
+static uint32_t open_cnt;
+static uint32_t open_done_cnt;
+static uint32_t open_time;          /*Time to spend in `decoder_open` [ms]*/
+static uint32_t active_cnt;         /*Number of decoder callbacks running now*/
+static uint32_t overlap_cnt;        /*Number of decoder callbacks started while an other was running*/
+
+static void decoder_enter(void)
+{
+    if(active_cnt > 0) overlap_cnt++;
+    active_cnt++;
+}
+
+static void decoder_leave(void)
+{
+    active_cnt--;
+}
+
+static lv_res_t decoder_info(lv_img_decoder_t * dec, const void * src, lv_img_header_t * header)
+{
+    LV_UNUSED(dec);
+    if(lv_img_src_get_type(src) != LV_IMG_SRC_FILE) return LV_RES_INV;
+    if(strcmp(lv_fs_get_ext(src), "tsa")) return LV_RES_INV;
+
+    decoder_enter();
+    header->w = IMG_W;
+    header->h = IMG_H;
+    header->cf = LV_IMG_CF_TRUE_COLOR;
+    decoder_leave();
+    return LV_RES_OK;
+}
+
+static lv_res_t decoder_open(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(dec);
+    lv_mutex_lock(&gate);
+    lv_mutex_unlock(&gate);
+
+    decoder_enter();
+    open_cnt++;
+    usleep(open_time * 1000);
+
+    lv_res_t res = LV_RES_INV;
+    if(strstr(dsc->src, "fail") == NULL) {
+        lv_color_t * buf = lv_mem_alloc(IMG_SIZE);
+        uint32_t i;
+        for(i = 0; i < IMG_W * IMG_H; i++) buf[i] = lv_color_make(0xFF, 0x00, 0x00);
+        dsc->img_data = (const uint8_t *)buf;
+        res = LV_RES_OK;
+    }
+    open_done_cnt++;
+    decoder_leave();
+
+    return res;
+}
+
+static void decoder_close(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(dec);
+    decoder_enter();
+    lv_mem_free((void *)dsc->img_data);
+    decoder_leave();
+}
+
+/*Let 1 ms pass for the decoding threads and run the timers (e.g. collecting the decoded images)*/
+static void wait_1ms(void)
+{
+    usleep(1000);
+    lv_tick_inc(1);
+    lv_timer_handler();
+}
+
+/*Wait until the image of a source is not pending*/
+static _lv_img_cache_entry_t * wait_for(const char * src)
+{
+    uint32_t start = lv_tick_get();
+    _lv_img_cache_entry_t * entry = _lv_img_cache_open_async(src, lv_color_black(), 0, NULL);
+    while(entry && entry->job && lv_tick_elaps(start) < TIMEOUT) {
+        wait_1ms();
+        entry = _lv_img_cache_open_async(src, lv_color_black(), 0, NULL);
+    }
+
+    TEST_ASSERT_TRUE(entry == NULL || entry->job == NULL);
+    return entry;
+}
+
+static bool is_red(lv_coord_t x, lv_coord_t y)
+{
+    return (lv_color_to32(test_fb[y * SCR_W + x]) & 0xFFFFFF) == 0xFF0000;
+}
+
+void setUp(void)
+{
+    if(decoder == NULL) {
+        decoder = lv_img_decoder_create();
+        lv_img_decoder_set_info_cb(decoder, decoder_info);
+        lv_img_decoder_set_open_cb(decoder, decoder_open);
+        lv_img_decoder_set_close_cb(decoder, decoder_close);
+        lv_mutex_init(&gate);
+    }
+
+    lv_img_cache_set_size(4);
+    open_cnt = 0;
+    open_done_cnt = 0;
+    open_time = 0;
+    overlap_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
+}
+
+void test_img_cache_async_should_draw_the_image_when_decoded(void)
+{
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, "A:red.tsa");
+    lv_obj_set_pos(img, 10, 20);
+
+    /*Nothing is drawn while the image is being decoded*/
+    lv_mutex_lock(&gate);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    TEST_ASSERT_FALSE(is_red(12, 22));
+    lv_mutex_unlock(&gate);
+
+    /*Only the area of the image is redrawn when the image is ready*/
+    lv_disp_refr_stats_t refr_stats;
+    uint32_t start = lv_tick_get();
+    do {
+        wait_1ms();
+        lv_disp_get_refr_stats(lv_disp_get_default(), &refr_stats);
+    } while(refr_stats.px_cnt != IMG_W * IMG_H && lv_tick_elaps(start) < TIMEOUT);
+    TEST_ASSERT_EQUAL(IMG_W * IMG_H, refr_stats.px_cnt);
+
+    /*The test display can check only full screen refreshes*/
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    TEST_ASSERT_TRUE(is_red(12, 22));
+    TEST_ASSERT_EQUAL(1, open_cnt);
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.entry_cnt);
+    TEST_ASSERT_EQUAL(IMG_SIZE, stats.mem_size);
+}
+
+void test_img_cache_async_should_not_return_the_failed_images(void)
+{
+    /*The synchronous open waits for the failed background decode and tries again*/
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_cache_prefetch("A:fail.tsa"));
+    TEST_ASSERT_NULL(_lv_img_cache_open("A:fail.tsa", lv_color_black(), 0));
+    TEST_ASSERT_EQUAL(2, open_cnt);
+
+    /*Drawing doesn't get the failed entry and doesn't try it again on every refresh*/
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_cache_prefetch("A:fail.tsa"));
+    TEST_ASSERT_NULL(wait_for("A:fail.tsa"));
+    lv_img_cache_stats_t stats_start;
+    lv_img_cache_get_stats(&stats_start);
+    TEST_ASSERT_NULL(_lv_img_cache_open_async("A:fail.tsa", lv_color_black(), 0, NULL));
+    TEST_ASSERT_EQUAL(3, open_cnt);
+
+    /*Prefetching tries it again*/
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_cache_prefetch("A:fail.tsa"));
+
+    /*The failed entry is not used so it's not a hit*/
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL(stats_start.hit_cnt, stats.hit_cnt);
+    TEST_ASSERT_EQUAL(stats_start.miss_cnt + 1, stats.miss_cnt);
+
+    TEST_ASSERT_NULL(wait_for("A:fail.tsa"));
+    TEST_ASSERT_EQUAL(4, open_cnt);
+}
+
+void test_img_cache_async_should_not_use_the_decoders_in_parallel(void)
+{
+    open_time = 20;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_cache_prefetch("A:1.tsa"));
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_cache_prefetch("A:2.tsa"));
+
+    /*Use the decoders from the LVGL thread while the images are decoded*/
+    uint32_t start = lv_tick_get();
+    while(open_cnt < 2 && lv_tick_elaps(start) < TIMEOUT) {
+        lv_img_header_t header;
+        lv_img_decoder_get_info("A:3.tsa", &header);
+        wait_1ms();
+    }
+
+    TEST_ASSERT_NOT_NULL(wait_for("A:1.tsa"));
+    TEST_ASSERT_NOT_NULL(wait_for("A:2.tsa"));
+    TEST_ASSERT_EQUAL(0, overlap_cnt);
+}
+
+void test_img_cache_async_should_get_the_info_while_decoding(void)
+{
+    lv_img_decoder_set_thread_safe(decoder, true);
+    open_time = 200;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_cache_prefetch("A:slow.tsa"));
+
+    uint32_t start = lv_tick_get();
+    while(open_cnt == 0 && lv_tick_elaps(start) < TIMEOUT) {
+        wait_1ms();
+    }
+    TEST_ASSERT_EQUAL(1, open_cnt);
+
+    /*The decoder is not locked for the whole decoding*/
+    lv_img_header_t header;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_get_info("A:3.tsa", &header));
+    TEST_ASSERT_EQUAL(IMG_W, header.w);
+    TEST_ASSERT_EQUAL(0, open_done_cnt);
+
+    TEST_ASSERT_NOT_NULL(wait_for("A:slow.tsa"));
+    lv_img_decoder_set_thread_safe(decoder, false);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_img_cache_async_should_draw_the_image_when_decoded(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_IMG_CACHE_ASYNC");
+}
+
+void test_img_cache_async_should_not_return_the_failed_images(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_IMG_CACHE_ASYNC");
+}
+
+void test_img_cache_async_should_not_use_the_decoders_in_parallel(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_IMG_CACHE_ASYNC");
+}
+
+void test_img_cache_async_should_get_the_info_while_decoding(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_IMG_CACHE_ASYNC");
+}
+
+#endif
+
+#endif
@@ -0,0 +1,140 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void);
+void tearDown(void);
+
+void test_label_append_should_give_the_same_layout_as_set_text(void);
+void test_label_append_should_remove_the_first_lines(void);
+void test_label_append_should_invalidate_only_the_new_lines(void);
+void test_label_append_textarea_should_append_at_the_end(void);
+
+static lv_obj_t * label;
+
+static lv_draw_label_layout_t * get_layout(void)
+{
+    return ((lv_label_t *)label)->layout;
+}
+
+void setUp(void)
+{
+    label = lv_label_create(lv_scr_act());
+    lv_obj_set_width(label, 150);
+    lv_label_set_text(label, "");
+    lv_obj_update_layout(label);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_label_append_should_give_the_same_layout_as_set_text(void)
+{
+    static const char * parts[] = {"Short line\n", "A line long enough to be wrapped into more lines\n", "Not ",
+                                   "finished ", "line", "\n", "\n", "Averylongwordwhichcantbewrapped", "\n"
+                                  };
+    static lv_coord_t widths[128];
+    static uint32_t starts[128];
+
+    uint32_t i;
+    for(i = 0; i < 40; i++) {
+        lv_label_ins_text(label, LV_LABEL_POS_LAST, parts[i % (sizeof(parts) / sizeof(parts[0]))]);
+    }
+    lv_obj_update_layout(label);
+
+    lv_draw_label_layout_t * layout = get_layout();
+    TEST_ASSERT_EQUAL_PTR(lv_label_get_text(label), layout->txt);
+    TEST_ASSERT_LESS_THAN(128, layout->line_cnt);
+
+    uint32_t line_cnt = layout->line_cnt;
+    lv_coord_t max_line_w = layout->max_line_w;
+    lv_coord_t h = lv_obj_get_height(label);
+    lv_memcpy(widths, layout->line_widths, line_cnt * sizeof(lv_coord_t));
+    lv_memcpy(starts, layout->line_starts, (line_cnt + 1) * sizeof(uint32_t));
+
+    /*Measure the whole text again*/
+    lv_label_set_text(label, NULL);
+    lv_obj_update_layout(label);
+
+    TEST_ASSERT_EQUAL(layout->line_cnt, line_cnt);
+    TEST_ASSERT_EQUAL(layout->max_line_w, max_line_w);
+    TEST_ASSERT_EQUAL_MEMORY(layout->line_widths, widths, line_cnt * sizeof(lv_coord_t));
+    TEST_ASSERT_EQUAL_MEMORY(layout->line_starts, starts, (line_cnt + 1) * sizeof(uint32_t));
+    TEST_ASSERT_EQUAL(h, lv_obj_get_height(label));
+}
+
+void test_label_append_should_remove_the_first_lines(void)
+{
+    lv_label_set_max_lines(label, 10);
+    TEST_ASSERT_EQUAL(10, lv_label_get_max_lines(label));
+
+    char buf[32];
+    uint32_t i;
+    for(i = 0; i < 100; i++) {
+        lv_snprintf(buf, sizeof(buf), "Line %d\n", i);
+        lv_label_ins_text(label, LV_LABEL_POS_LAST, buf);
+    }
+
+    TEST_ASSERT_EQUAL_STRING("Line 90\nLine 91\nLine 92\nLine 93\nLine 94\n"
+                             "Line 95\nLine 96\nLine 97\nLine 98\nLine 99\n", lv_label_get_text(label));
+    TEST_ASSERT_EQUAL(10, get_layout()->line_cnt);
+
+    /*A wrapped line counts as more lines but only whole lines are removed*/
+    lv_label_ins_text(label, LV_LABEL_POS_LAST, "A line long enough to be wrapped into more lines\n");
+    TEST_ASSERT_LESS_OR_EQUAL(10, get_layout()->line_cnt);
+    TEST_ASSERT_EQUAL_STRING_LEN("Line 9", lv_label_get_text(label), 6);
+    TEST_ASSERT_EQUAL(0, get_layout()->line_starts[0]);
+
+    /*A smaller limit removes the lines immediately*/
+    lv_label_set_max_lines(label, 3);
+    TEST_ASSERT_EQUAL_STRING("A line long enough to be wrapped into more lines\n", lv_label_get_text(label));
+    lv_label_set_max_lines(label, 1);
+    TEST_ASSERT_EQUAL_STRING("A line long enough to be wrapped into more lines\n", lv_label_get_text(label));
+}
+
+void test_label_append_should_invalidate_only_the_new_lines(void)
+{
+    uint32_t i;
+    for(i = 0; i < 10; i++) {
+        lv_label_ins_text(label, LV_LABEL_POS_LAST, "Some text in a line\n");
+    }
+
+    /*Fixed height to not invalidate the label because of its size change*/
+    lv_obj_set_height(label, 400);
+    lv_refr_now(NULL);
+
+    lv_label_ins_text(label, LV_LABEL_POS_LAST, "A new line\n");
+
+    lv_disp_t * disp = lv_disp_get_default();
+    TEST_ASSERT_EQUAL(1, disp->inv_p);
+    TEST_ASSERT_GREATER_OR_EQUAL(label->coords.y2, disp->inv_areas[0].y2);
+    TEST_ASSERT_GREATER_THAN(label->coords.y1 + lv_obj_get_height(label) / 4, disp->inv_areas[0].y1);
+    lv_refr_now(NULL);
+}
+
+void test_label_append_textarea_should_append_at_the_end(void)
+{
+    lv_obj_t * ta = lv_textarea_create(lv_scr_act());
+    lv_textarea_set_text(ta, "");
+
+    char buf[32];
+    uint32_t i;
+    for(i = 0; i < 20; i++) {
+        lv_snprintf(buf, sizeof(buf), "%d\n", i);
+        lv_textarea_add_text(ta, buf);
+    }
+
+    const char * txt = lv_textarea_get_text(ta);
+    TEST_ASSERT_EQUAL_STRING_LEN("0\n1\n2\n", txt, 6);
+    TEST_ASSERT_EQUAL(_lv_txt_get_encoded_length(txt), lv_textarea_get_cursor_pos(ta));
+
+    /*Insert in the middle too*/
+    lv_textarea_set_cursor_pos(ta, 2);
+    lv_textarea_add_text(ta, "x");
+    TEST_ASSERT_EQUAL_STRING_LEN("0\nx1\n2\n", lv_textarea_get_text(ta), 7);
+}
+
+#endif
@@ -0,0 +1,208 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void);
+void tearDown(void);
+
+void test_label_layout_should_give_the_same_size_as_txt_get_size(void);
+void test_label_layout_should_be_kept_if_only_the_line_space_changes(void);
+void test_label_layout_should_be_refreshed_on_text_and_font_change(void);
+void test_label_layout_should_draw_the_same_as_without_layout(void);
+
+#if LV_LABEL_LAYOUT_CACHE
+
+extern lv_color_t test_fb[];
+
+static lv_obj_t * label;
+
+/*A font which is different from the default*/
+#if LV_FONT_MONTSERRAT_16
+static const lv_font_t * other_font = &lv_font_montserrat_16;
+#else
+static const lv_font_t * other_font = &lv_font_unscii_8;
+#endif
+
+static const char * texts[] = {
+    "",
+    "A",
+    "Short text",
+    "Text with\nnew lines\n",
+    "\n\n\n",
+    "A long text which needs to be wrapped into multiple lines because it doesn't fit into the given width",
+    "Trailing carriage return\r",
+};
+
+static lv_draw_label_layout_t * get_layout(void)
+{
+    return ((lv_label_t *)label)->layout;
+}
+
+void setUp(void)
+{
+    label = lv_label_create(lv_scr_act());
+    lv_obj_set_width(label, 120);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_label_layout_should_give_the_same_size_as_txt_get_size(void)
+{
+    const lv_font_t * font = &lv_font_montserrat_14;
+    lv_draw_label_layout_t layout;
+    lv_memset_00(&layout, sizeof(layout));
+
+    uint32_t i;
+    for(i = 0; i < sizeof(texts) / sizeof(texts[0]); i++) {
+        lv_coord_t max_w;
+        for(max_w = 40; max_w <= 400; max_w += 120) {
+            lv_point_t ref;
+            lv_point_t size;
+            lv_txt_get_size(&ref, texts[i], font, 2, 5, max_w, LV_TEXT_FLAG_NONE);
+
+            TEST_ASSERT_EQUAL(LV_RES_OK, _lv_draw_label_layout_update(&layout, texts[i], font, 2, max_w,
+                                                                       LV_TEXT_FLAG_NONE));
+            TEST_ASSERT_TRUE(_lv_draw_label_layout_is_valid(&layout, texts[i], font, 2, max_w, LV_TEXT_FLAG_NONE));
+            TEST_ASSERT_EQUAL(strlen(texts[i]), layout.line_starts[layout.line_cnt]);
+
+            _lv_draw_label_layout_get_size(&layout, 5, &size);
+            TEST_ASSERT_EQUAL(ref.x, size.x);
+            TEST_ASSERT_EQUAL(ref.y, size.y);
+        }
+    }
+
+    TEST_ASSERT_FALSE(_lv_draw_label_layout_is_valid(&layout, texts[0], font, 2, 400, LV_TEXT_FLAG_NONE));
+    TEST_ASSERT_FALSE(_lv_draw_label_layout_is_valid(&layout, texts[i - 1], font, 0, 400, LV_TEXT_FLAG_NONE));
+    TEST_ASSERT_FALSE(_lv_draw_label_layout_is_valid(&layout, texts[i - 1], font, 2, 399, LV_TEXT_FLAG_NONE));
+    TEST_ASSERT_FALSE(_lv_draw_label_layout_is_valid(&layout, texts[i - 1], other_font, 2, 400,
+                                                     LV_TEXT_FLAG_NONE));
+
+    _lv_draw_label_layout_free(&layout);
+    TEST_ASSERT_NULL(layout.line_starts);
+}
+
+void test_label_layout_should_be_kept_if_only_the_line_space_changes(void)
+{
+    lv_label_set_text(label, texts[5]);
+    lv_draw_label_layout_t * layout = get_layout();
+    TEST_ASSERT_NOT_NULL(layout->txt);
+    TEST_ASSERT_GREATER_THAN(1, layout->line_cnt);
+
+    /*Mark the layout to see whether it's calculated again*/
+    layout->line_widths[0] = -1;
+
+    lv_obj_set_style_text_line_space(label, 10, LV_PART_MAIN);
+    lv_obj_set_style_text_color(label, lv_palette_main(LV_PALETTE_RED), LV_PART_MAIN);
+    TEST_ASSERT_EQUAL(-1, layout->line_widths[0]);
+
+    lv_obj_update_layout(label);
+    lv_point_t ref;
+    lv_txt_get_size(&ref, texts[5], lv_obj_get_style_text_font(label, LV_PART_MAIN), 0, 10,
+                    lv_obj_get_content_width(label), LV_TEXT_FLAG_NONE);
+    TEST_ASSERT_EQUAL(ref.y, lv_obj_get_content_height(label));
+}
+
+void test_label_layout_should_be_refreshed_on_text_and_font_change(void)
+{
+    lv_label_set_text(label, texts[5]);
+    lv_draw_label_layout_t * layout = get_layout();
+    uint32_t line_cnt = layout->line_cnt;
+
+    layout->line_widths[0] = -1;
+    lv_label_set_text(label, texts[5]);
+    TEST_ASSERT_NOT_EQUAL(-1, layout->line_widths[0]);
+
+    layout->line_widths[0] = -1;
+    lv_obj_set_style_text_font(label, other_font, LV_PART_MAIN);
+    TEST_ASSERT_NOT_EQUAL(-1, layout->line_widths[0]);
+    TEST_ASSERT_TRUE(layout->line_cnt >= line_cnt);
+
+    layout->line_widths[0] = -1;
+    lv_obj_set_style_text_letter_space(label, 3, LV_PART_MAIN);
+    TEST_ASSERT_NOT_EQUAL(-1, layout->line_widths[0]);
+
+    layout->line_widths[0] = -1;
+    lv_obj_set_width(label, 200);
+    lv_obj_update_layout(label);
+    TEST_ASSERT_NOT_EQUAL(-1, layout->line_widths[0]);
+
+    lv_label_ins_text(label, 0, "New line\n");
+    TEST_ASSERT_EQUAL_PTR(lv_label_get_text(label), layout->txt);
+    TEST_ASSERT_EQUAL(strlen(lv_label_get_text(label)), layout->line_starts[layout->line_cnt]);
+
+    lv_label_cut_text(label, 0, 4);
+    TEST_ASSERT_EQUAL(strlen(lv_label_get_text(label)), layout->line_starts[layout->line_cnt]);
+}
+
+void test_label_layout_should_draw_the_same_as_without_layout(void)
+{
+    static lv_color_t ref_fb[800 * 480];
+    static char buf[2048];
+    buf[0] = '\0';
+    uint32_t i;
+    for(i = 0; i < 60; i++) {
+        lv_snprintf(buf + strlen(buf), sizeof(buf) - strlen(buf), "Line %d of a scrolled text\n", i);
+    }
+
+    lv_obj_set_size(label, 200, 300);
+    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
+    lv_label_set_text(label, buf);
+    lv_obj_scroll_to_y(label, 500, LV_ANIM_OFF);
+    lv_obj_update_layout(label);
+
+    /*The parameters of the drawing are the same so it will use the layout*/
+    TEST_ASSERT_TRUE(_lv_draw_label_layout_is_valid(get_layout(), lv_label_get_text(label),
+                                                    lv_obj_get_style_text_font(label, LV_PART_MAIN), 0,
+                                                    lv_obj_get_content_width(label), LV_TEXT_FLAG_NONE));
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    /*Draw without the layout*/
+    const char * txt = get_layout()->txt;
+    _lv_draw_label_layout_invalidate(get_layout());
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+
+    get_layout()->txt = txt;
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_label_layout_should_give_the_same_size_as_txt_get_size(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_LABEL_LAYOUT_CACHE");
+}
+
+void test_label_layout_should_be_kept_if_only_the_line_space_changes(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_LABEL_LAYOUT_CACHE");
+}
+
+void test_label_layout_should_be_refreshed_on_text_and_font_change(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_LABEL_LAYOUT_CACHE");
+}
+
+void test_label_layout_should_draw_the_same_as_without_layout(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_LABEL_LAYOUT_CACHE");
+}
+
+#endif
+
+#endif
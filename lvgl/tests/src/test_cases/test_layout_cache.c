@@ -0,0 +1,237 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void);
+void tearDown(void);
+
+void test_layout_cache_should_measure_only_the_changed_children(void);
+void test_layout_cache_should_not_arrange_if_nothing_has_changed(void);
+void test_layout_cache_should_follow_the_style_changes(void);
+void test_layout_cache_should_follow_the_deleted_children(void);
+void test_layout_cache_should_update_the_content_sized_grid_tracks(void);
+void test_layout_cache_should_measure_one_row_per_toggle(void);
+
+#define ROW_CNT     500
+#define ROW_H       20
+
+static lv_layout_stats_t last_stats;
+static lv_style_t style_checked;
+
+static void monitor_cb(lv_obj_t * scr, const lv_layout_stats_t * stats)
+{
+    LV_UNUSED(scr);
+    last_stats = *stats;
+}
+
+static lv_obj_t * list_create(void)
+{
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(cont);
+    lv_obj_set_size(cont, 200, LV_SIZE_CONTENT);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+
+    uint32_t i;
+    for(i = 0; i < ROW_CNT; i++) {
+        lv_obj_t * row = lv_obj_create(cont);
+        lv_obj_remove_style_all(row);
+        lv_obj_set_size(row, LV_PCT(100), ROW_H);
+        lv_obj_add_style(row, &style_checked, LV_STATE_CHECKED);
+    }
+
+    lv_obj_update_layout(lv_scr_act());
+    return cont;
+}
+
+static lv_coord_t get_y(lv_obj_t * obj)
+{
+    return obj->coords.y1 - lv_obj_get_parent(obj)->coords.y1;
+}
+
+void setUp(void)
+{
+    lv_style_init(&style_checked);
+    lv_style_set_height(&style_checked, 2 * ROW_H);
+    lv_obj_update_layout(lv_scr_act());
+    lv_layout_set_monitor_cb(monitor_cb);
+    lv_memset_00(&last_stats, sizeof(last_stats));
+}
+
+void tearDown(void)
+{
+    lv_layout_set_monitor_cb(NULL);
+    lv_obj_clean(lv_scr_act());
+    lv_style_reset(&style_checked);
+}
+
+void test_layout_cache_should_measure_only_the_changed_children(void)
+{
+    lv_obj_t * cont = list_create();
+    TEST_ASSERT_EQUAL(ROW_CNT * ROW_H, lv_obj_get_height(cont));
+
+    lv_obj_add_state(lv_obj_get_child(cont, 10), LV_STATE_CHECKED);
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(1, last_stats.measure_cnt);
+    TEST_ASSERT_GREATER_THAN(0, last_stats.arrange_cnt);
+    TEST_ASSERT_EQUAL(10 * ROW_H, get_y(lv_obj_get_child(cont, 10)));
+    TEST_ASSERT_EQUAL(12 * ROW_H, get_y(lv_obj_get_child(cont, 11)));
+    TEST_ASSERT_EQUAL((ROW_CNT + 1) * ROW_H, lv_obj_get_height(cont));
+
+    /*Hiding doesn't change the style properties*/
+    lv_obj_add_flag(lv_obj_get_child(cont, 20), LV_OBJ_FLAG_HIDDEN);
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(0, last_stats.measure_cnt);
+    TEST_ASSERT_EQUAL(21 * ROW_H, get_y(lv_obj_get_child(cont, 21)));
+    TEST_ASSERT_EQUAL(ROW_CNT * ROW_H, lv_obj_get_height(cont));
+}
+
+void test_layout_cache_should_not_arrange_if_nothing_has_changed(void)
+{
+    lv_obj_t * cont = list_create();
+
+    lv_obj_mark_layout_as_dirty(cont);
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(0, last_stats.measure_cnt);
+    TEST_ASSERT_EQUAL(0, last_stats.arrange_cnt);
+
+    /*A child moved by something else is placed back*/
+    lv_obj_t * row = lv_obj_get_child(cont, 5);
+    row->coords.y1 += 3;
+    row->coords.y2 += 3;
+    lv_obj_mark_layout_as_dirty(cont);
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(1, last_stats.arrange_cnt);
+    TEST_ASSERT_EQUAL(5 * ROW_H, get_y(row));
+
+    /*A change on the container arranges the children*/
+    lv_obj_set_style_pad_row(cont, 2, LV_PART_MAIN);
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(0, last_stats.measure_cnt);
+    TEST_ASSERT_EQUAL(5 * (ROW_H + 2), get_y(row));
+}
+
+void test_layout_cache_should_follow_the_style_changes(void)
+{
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(cont);
+    lv_obj_set_size(cont, 300, 100);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW);
+
+    lv_obj_t * items[3];
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        items[i] = lv_obj_create(cont);
+        lv_obj_remove_style_all(items[i]);
+        lv_obj_set_size(items[i], 50, 50);
+    }
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(100, items[2]->coords.x1 - cont->coords.x1);
+
+    lv_obj_set_flex_grow(items[1], 1);
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(200, lv_obj_get_width(items[1]));
+    TEST_ASSERT_EQUAL(250, items[2]->coords.x1 - cont->coords.x1);
+
+    /*The size of a grow item is set by the layout so the container needs to be updated manually*/
+    lv_obj_set_style_max_width(items[1], 100, LV_PART_MAIN);
+    lv_obj_mark_layout_as_dirty(cont);
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(100, lv_obj_get_width(items[1]));
+    TEST_ASSERT_EQUAL(150, items[2]->coords.x1 - cont->coords.x1);
+
+    lv_obj_set_style_translate_y(items[2], 10, LV_PART_MAIN);
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(10, items[2]->coords.y1 - cont->coords.y1);
+
+    /*The min. and max. sizes are read in the other direction too*/
+    lv_obj_set_style_max_height(items[1], 20, LV_PART_MAIN);
+    lv_obj_set_height(cont, 300);
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(100, lv_obj_get_width(items[1]));
+
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(20, lv_obj_get_height(items[1]));
+}
+
+void test_layout_cache_should_follow_the_deleted_children(void)
+{
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(cont);
+    lv_obj_set_size(cont, 100, 300);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN_REVERSE);
+
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        lv_obj_t * row = lv_obj_create(cont);
+        lv_obj_remove_style_all(row);
+        lv_obj_set_size(row, 100, ROW_H);
+    }
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(3 * ROW_H, get_y(lv_obj_get_child(cont, 0)));
+
+    /*The newest child is the first one in reverse order*/
+    lv_obj_del(lv_obj_get_child(cont, 3));
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(2 * ROW_H, get_y(lv_obj_get_child(cont, 0)));
+    TEST_ASSERT_EQUAL(0, get_y(lv_obj_get_child(cont, 2)));
+}
+
+void test_layout_cache_should_update_the_content_sized_grid_tracks(void)
+{
+    static lv_coord_t col_dsc[] = {LV_GRID_CONTENT, 50, LV_GRID_TEMPLATE_LAST};
+    static lv_coord_t row_dsc[] = {30, 30, LV_GRID_TEMPLATE_LAST};
+
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(cont);
+    lv_obj_set_size(cont, 300, 100);
+    lv_obj_set_grid_dsc_array(cont, col_dsc, row_dsc);
+
+    lv_obj_t * items[4];
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        items[i] = lv_obj_create(cont);
+        lv_obj_remove_style_all(items[i]);
+        lv_obj_set_size(items[i], 20, 20);
+        lv_obj_set_grid_cell(items[i], LV_GRID_ALIGN_START, i % 2, 1, LV_GRID_ALIGN_START, i / 2, 1);
+    }
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(20, items[1]->coords.x1 - cont->coords.x1);
+    TEST_ASSERT_EQUAL(30, items[3]->coords.y1 - cont->coords.y1);
+
+    lv_obj_set_width(items[2], 40);
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(1, last_stats.arrange_cnt);
+    TEST_ASSERT_EQUAL(40, items[1]->coords.x1 - cont->coords.x1);
+    TEST_ASSERT_EQUAL(40, items[3]->coords.x1 - cont->coords.x1);
+
+    lv_obj_set_grid_cell(items[3], LV_GRID_ALIGN_END, 1, 1, LV_GRID_ALIGN_START, 1, 1);
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(1, last_stats.measure_cnt);
+    TEST_ASSERT_EQUAL(70, items[3]->coords.x1 - cont->coords.x1);
+
+    lv_obj_mark_layout_as_dirty(cont);
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(0, last_stats.arrange_cnt);
+}
+
+void test_layout_cache_should_measure_one_row_per_toggle(void)
+{
+    lv_obj_t * cont = list_create();
+
+    uint32_t measure_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < 100; i++) {
+        lv_obj_t * row = lv_obj_get_child(cont, (i * 7) % ROW_CNT);
+        if(lv_obj_has_state(row, LV_STATE_CHECKED)) lv_obj_clear_state(row, LV_STATE_CHECKED);
+        else lv_obj_add_state(row, LV_STATE_CHECKED);
+        lv_obj_update_layout(lv_scr_act());
+        measure_cnt += last_stats.measure_cnt;
+    }
+
+    /*Only the toggled row is measured again in each relayout*/
+    TEST_ASSERT_EQUAL(100, measure_cnt);
+}
+
+#endif
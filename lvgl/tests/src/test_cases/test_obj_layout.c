@@ -0,0 +1,135 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void);
+void tearDown(void);
+
+void test_obj_layout_should_visit_only_the_dirty_path(void);
+void test_obj_layout_should_update_the_content_sized_parents(void);
+void test_obj_layout_should_reposition_the_flex_siblings(void);
+
+static lv_layout_stats_t last_stats;
+static uint32_t monitor_call_cnt;
+
+static void monitor_cb(lv_obj_t * scr, const lv_layout_stats_t * stats)
+{
+    LV_UNUSED(scr);
+    last_stats = *stats;
+    monitor_call_cnt++;
+}
+
+void setUp(void)
+{
+    lv_obj_update_layout(lv_scr_act());
+    lv_layout_set_monitor_cb(monitor_cb);
+    lv_memset_00(&last_stats, sizeof(last_stats));
+    monitor_call_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_layout_set_monitor_cb(NULL);
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_obj_layout_should_visit_only_the_dirty_path(void)
+{
+    /*20 rows with 20 labels in each*/
+    lv_obj_t * label = NULL;
+    uint32_t i;
+    for(i = 0; i < 20; i++) {
+        lv_obj_t * row = lv_obj_create(lv_scr_act());
+        lv_obj_set_size(row, LV_PCT(100), LV_SIZE_CONTENT);
+        lv_obj_set_flex_flow(row, LV_FLEX_FLOW_ROW_WRAP);
+
+        uint32_t j;
+        for(j = 0; j < 20; j++) {
+            label = lv_label_create(row);
+            lv_label_set_text(label, "Text");
+        }
+    }
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(1, monitor_call_cnt);
+    TEST_ASSERT_GREATER_THAN(20 * 20, last_stats.visit_cnt);
+
+    /*Nothing to do*/
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(1, monitor_call_cnt);
+
+    lv_label_set_text(label, "A longer text");
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(2, monitor_call_cnt);
+    TEST_ASSERT_GREATER_THAN(0, last_stats.refr_cnt);
+    TEST_ASSERT_LESS_THAN(50, last_stats.visit_cnt);
+}
+
+void test_obj_layout_should_update_the_content_sized_parents(void)
+{
+    lv_obj_t * parent = lv_scr_act();
+    uint32_t i;
+    for(i = 0; i < 5; i++) {
+        lv_obj_t * cont = lv_obj_create(parent);
+        lv_obj_remove_style_all(cont);
+        lv_obj_set_size(cont, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+        parent = cont;
+    }
+
+    /*Some clean siblings on the top level*/
+    for(i = 0; i < 10; i++) lv_obj_create(lv_scr_act());
+
+    lv_obj_t * leaf = lv_obj_create(parent);
+    lv_obj_set_size(leaf, 50, 30);
+    lv_obj_update_layout(lv_scr_act());
+
+    lv_obj_t * top = lv_obj_get_child(lv_scr_act(), 0);
+    TEST_ASSERT_EQUAL(50, lv_obj_get_width(top));
+    TEST_ASSERT_EQUAL(30, lv_obj_get_height(top));
+
+    lv_obj_set_size(leaf, 120, 70);
+    lv_obj_update_layout(lv_scr_act());
+    TEST_ASSERT_EQUAL(120, lv_obj_get_width(top));
+    TEST_ASSERT_EQUAL(70, lv_obj_get_height(top));
+
+    /*The size changes propagate to the top with several passes but the siblings aren't visited*/
+    TEST_ASSERT_GREATER_THAN(1, last_stats.pass_cnt);
+    TEST_ASSERT_LESS_THAN(10 * last_stats.pass_cnt, last_stats.visit_cnt);
+}
+
+void test_obj_layout_should_reposition_the_flex_siblings(void)
+{
+    lv_obj_t * outer = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(outer);
+    lv_obj_set_size(outer, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+    lv_obj_set_flex_flow(outer, LV_FLEX_FLOW_COLUMN);
+
+    lv_obj_t * items[3];
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        lv_obj_t * row = lv_obj_create(outer);
+        lv_obj_remove_style_all(row);
+        lv_obj_set_size(row, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+        lv_obj_set_flex_flow(row, LV_FLEX_FLOW_ROW);
+
+        items[i] = lv_obj_create(row);
+        lv_obj_remove_style_all(items[i]);
+        lv_obj_set_size(items[i], 40, 20);
+    }
+    lv_obj_update_layout(lv_scr_act());
+    lv_area_t coords;
+    lv_obj_get_coords(items[2], &coords);
+    TEST_ASSERT_EQUAL(40, coords.y1);
+
+    /*Make the first item higher in a nested flex container*/
+    lv_obj_set_height(items[0], 50);
+    lv_obj_update_layout(lv_scr_act());
+
+    lv_obj_get_coords(items[1], &coords);
+    TEST_ASSERT_EQUAL(50, coords.y1);
+    lv_obj_get_coords(items[2], &coords);
+    TEST_ASSERT_EQUAL(70, coords.y1);
+    TEST_ASSERT_EQUAL(90, lv_obj_get_height(outer));
+}
+
+#endif
@@ -0,0 +1,242 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void);
+void tearDown(void);
+
+void test_obj_scroll_lazy_should_not_move_the_descendants_until_used(void);
+void test_obj_scroll_lazy_should_keep_the_coordinates_correct(void);
+void test_obj_scroll_lazy_should_draw_the_same_as_without_scrolling(void);
+void test_obj_scroll_lazy_should_draw_the_same_in_more_threads(void);
+
+extern lv_color_t test_fb[];
+
+#define SCR_W       800
+#define SCR_H       480
+#define ROW_CNT     30
+#define PAD_TOP     60
+#define FLOATING_Y  100
+#define SCROLL_Y    (-57)
+
+static lv_color_t ref_fb[SCR_W * SCR_H];
+
+static lv_obj_t * list_create(lv_coord_t pad_top, lv_coord_t floating_y)
+{
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, 300, 400);
+    lv_obj_set_pos(cont, 100, 40);
+    lv_obj_set_style_pad_top(cont, pad_top, LV_PART_MAIN);
+    lv_obj_set_scrollbar_mode(cont, LV_SCROLLBAR_MODE_OFF);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+
+    uint32_t i;
+    for(i = 0; i < ROW_CNT; i++) {
+        lv_obj_t * row = lv_obj_create(cont);
+        lv_obj_set_size(row, 250, 40);
+        lv_obj_set_style_bg_color(row, lv_palette_main(i % 19), LV_PART_MAIN);
+        lv_obj_t * label = lv_label_create(row);
+        lv_label_set_text_fmt(label, "Row %d", i);
+    }
+
+    lv_obj_t * btn = lv_btn_create(cont);
+    lv_obj_add_flag(btn, LV_OBJ_FLAG_FLOATING);
+    lv_obj_set_size(btn, 80, 40);
+    lv_obj_set_pos(btn, 150, floating_y);
+
+    lv_obj_update_layout(cont);
+    return cont;
+}
+
+static lv_obj_t * get_label(lv_obj_t * cont, uint32_t row)
+{
+    return lv_obj_get_child(lv_obj_get_child(cont, row), 0);
+}
+
+static void refr_all(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/*Scroll in more steps with a refresh in between to have partially applied movements too*/
+static void scroll_in_steps(lv_obj_t * cont)
+{
+    lv_obj_scroll_by(cont, 0, SCROLL_Y / 3, LV_ANIM_OFF);
+    refr_all();
+    lv_obj_scroll_by(cont, 0, SCROLL_Y / 3, LV_ANIM_OFF);
+    lv_obj_scroll_by(cont, 0, SCROLL_Y - 2 * (SCROLL_Y / 3), LV_ANIM_OFF);
+}
+
+/*Draw the list without scrolling but with the children at the same place to get a reference image*/
+static void draw_reference(void)
+{
+    lv_obj_clean(lv_scr_act());
+    list_create(PAD_TOP + SCROLL_Y, FLOATING_Y - SCROLL_Y);
+    refr_all();
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_obj_scroll_lazy_should_not_move_the_descendants_until_used(void)
+{
+    lv_obj_t * cont = list_create(PAD_TOP, FLOATING_Y);
+    lv_obj_t * row = lv_obj_get_child(cont, 5);
+    lv_area_t row_ori;
+    lv_area_t label_ori;
+    lv_area_t other_label_ori;
+    lv_obj_get_coords(row, &row_ori);
+    lv_obj_get_coords(get_label(cont, 5), &label_ori);
+    lv_obj_get_coords(get_label(cont, 6), &other_label_ori);
+
+    lv_obj_scroll_by(cont, 0, SCROLL_Y, LV_ANIM_OFF);
+
+    /*Only the scroll position has changed so far*/
+    TEST_ASSERT_EQUAL(-SCROLL_Y, lv_obj_get_scroll_y(cont));
+    TEST_ASSERT_EQUAL(row_ori.y1, row->coords.y1);
+    TEST_ASSERT_EQUAL(label_ori.y1, get_label(cont, 5)->coords.y1);
+
+    /*Reading an object moves its parents' children*/
+    lv_area_t a;
+    lv_obj_get_coords(get_label(cont, 5), &a);
+    TEST_ASSERT_EQUAL(label_ori.y1 + SCROLL_Y, a.y1);
+    TEST_ASSERT_EQUAL(row_ori.y1 + SCROLL_Y, row->coords.y1);
+    TEST_ASSERT_EQUAL(other_label_ori.y1, get_label(cont, 6)->coords.y1);
+
+    lv_obj_get_coords(get_label(cont, 6), &a);
+    TEST_ASSERT_EQUAL(other_label_ori.y1 + SCROLL_Y, a.y1);
+}
+
+void test_obj_scroll_lazy_should_keep_the_coordinates_correct(void)
+{
+    lv_obj_t * cont = list_create(PAD_TOP, FLOATING_Y);
+    lv_obj_t * btn = lv_obj_get_child(cont, ROW_CNT);
+    lv_obj_t * row = lv_obj_get_child(cont, 3);
+    lv_area_t btn_ori;
+    lv_area_t row_ori;
+    lv_obj_get_coords(btn, &btn_ori);
+    lv_obj_get_coords(row, &row_ori);
+    lv_area_t label_ori;
+    lv_obj_get_coords(get_label(cont, 3), &label_ori);
+    lv_coord_t label_y = lv_obj_get_y(get_label(cont, 3));
+
+    /*Scroll a nested object too*/
+    lv_obj_scroll_by(row, 0, -4, LV_ANIM_OFF);
+    lv_obj_scroll_by(cont, 0, SCROLL_Y, LV_ANIM_OFF);
+    lv_area_t a;
+    lv_obj_get_coords(get_label(cont, 3), &a);
+    TEST_ASSERT_EQUAL(label_ori.y1 + SCROLL_Y - 4, a.y1);
+    TEST_ASSERT_EQUAL(label_y, lv_obj_get_y(get_label(cont, 3)));
+    lv_obj_scroll_by(row, 0, 4, LV_ANIM_OFF);
+
+    /*The floating children are not scrolled*/
+    lv_obj_get_coords(btn, &a);
+    TEST_ASSERT_EQUAL(btn_ori.y1, a.y1);
+
+    /*The hit test finds the scrolled objects*/
+    lv_point_t p = {row_ori.x1 + 10, row_ori.y1 + SCROLL_Y + 10};
+    TEST_ASSERT_EQUAL_PTR(row, lv_indev_search_obj(lv_scr_act(), &p));
+
+    /*Changing the floating flag doesn't apply the earlier scrolling to the object*/
+    lv_obj_scroll_by(cont, 0, -10, LV_ANIM_OFF);
+    lv_obj_clear_flag(btn, LV_OBJ_FLAG_FLOATING);
+    lv_obj_add_flag(btn, LV_OBJ_FLAG_IGNORE_LAYOUT);
+    lv_obj_get_coords(btn, &a);
+    TEST_ASSERT_EQUAL(btn_ori.y1, a.y1);
+    lv_obj_scroll_by(cont, 0, -5, LV_ANIM_OFF);
+    lv_obj_get_coords(btn, &a);
+    TEST_ASSERT_EQUAL(btn_ori.y1 - 5, a.y1);
+
+    /*The earlier scrolling is not applied to the new children either*/
+    lv_obj_scroll_by(cont, 0, -10, LV_ANIM_OFF);
+    lv_obj_t * obj = lv_obj_create(cont);
+    lv_obj_add_flag(obj, LV_OBJ_FLAG_IGNORE_LAYOUT);
+    lv_obj_set_pos(obj, 10, 20);
+    lv_obj_update_layout(obj);
+    TEST_ASSERT_EQUAL(20, lv_obj_get_y(obj));
+    lv_obj_scroll_by(cont, 0, -5, LV_ANIM_OFF);
+    TEST_ASSERT_EQUAL(20, lv_obj_get_y(obj));
+
+    /*Nor to the objects moved to the scrolled object*/
+    lv_obj_scroll_by(cont, 0, -10, LV_ANIM_OFF);
+    lv_obj_t * moved = lv_obj_create(lv_scr_act());
+    lv_obj_set_parent(moved, cont);
+    lv_obj_add_flag(moved, LV_OBJ_FLAG_IGNORE_LAYOUT);
+    lv_obj_set_pos(moved, 30, 40);
+    lv_obj_update_layout(moved);
+    TEST_ASSERT_EQUAL(40, lv_obj_get_y(moved));
+    lv_obj_scroll_by(cont, 0, -5, LV_ANIM_OFF);
+    TEST_ASSERT_EQUAL(40, lv_obj_get_y(moved));
+}
+
+void test_obj_scroll_lazy_should_draw_the_same_as_without_scrolling(void)
+{
+    lv_obj_t * cont = list_create(PAD_TOP, FLOATING_Y);
+    scroll_in_steps(cont);
+    refr_all();
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    draw_reference();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+}
+
+#if LV_USE_REFR_PARALLEL
+
+static lv_color_t band_fb[SCR_W * SCR_H];
+
+static void band_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(&band_fb[y * SCR_W + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+    lv_disp_flush_ready(drv);
+}
+
+void test_obj_scroll_lazy_should_draw_the_same_in_more_threads(void)
+{
+    lv_disp_t * disp = lv_disp_get_default();
+    lv_disp_drv_t * drv = disp->driver;
+    void (*flush_cb)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *) = drv->flush_cb;
+    uint32_t buf_size = drv->draw_buf->size;
+    uint32_t thread_cnt = lv_refr_get_thread_cnt();
+
+    /*Render the screen in bands*/
+    drv->flush_cb = band_flush_cb;
+    drv->draw_buf->size = SCR_W * 50;
+    lv_refr_set_thread_cnt(4);
+
+    lv_obj_t * cont = list_create(PAD_TOP, FLOATING_Y);
+    scroll_in_steps(cont);
+    refr_all();
+    lv_memcpy(ref_fb, band_fb, sizeof(ref_fb));
+
+    draw_reference();
+
+    drv->flush_cb = flush_cb;
+    drv->draw_buf->size = buf_size;
+    lv_refr_set_thread_cnt(thread_cnt);
+
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, band_fb, sizeof(ref_fb));
+}
+
+#else
+
+void test_obj_scroll_lazy_should_draw_the_same_in_more_threads(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_USE_REFR_PARALLEL");
+}
+
+#endif
+
+#endif
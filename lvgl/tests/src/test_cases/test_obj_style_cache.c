@@ -0,0 +1,257 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void);
+void tearDown(void);
+
+void test_obj_style_cache_should_hit_the_cached_properties(void);
+void test_obj_style_cache_should_follow_the_style_and_state_changes(void);
+void test_obj_style_cache_should_follow_the_inherited_properties(void);
+void test_obj_style_cache_should_follow_the_transitions(void);
+void test_obj_style_cache_should_keep_the_cache_of_the_other_objects(void);
+void test_obj_style_cache_should_resolve_fewer_properties_in_the_next_refresh(void);
+
+#if LV_OBJ_STYLE_CACHE_SIZE
+
+static lv_obj_style_stats_t stats_start;
+static lv_style_t style;
+static lv_style_t style_pr;
+
+static lv_obj_style_stats_t get_stats(void)
+{
+    lv_obj_style_stats_t stats;
+    lv_obj_get_style_stats(&stats);
+    stats.lookup_cnt -= stats_start.lookup_cnt;
+    stats.hit_cnt -= stats_start.hit_cnt;
+    return stats;
+}
+
+void setUp(void)
+{
+    lv_style_init(&style);
+    lv_style_init(&style_pr);
+    lv_obj_get_style_stats(&stats_start);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_style_reset(&style);
+    lv_style_reset(&style_pr);
+}
+
+void test_obj_style_cache_should_hit_the_cached_properties(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_style_radius(obj, 7, LV_PART_MAIN);
+    lv_obj_set_style_radius(obj, 3, LV_PART_SCROLLBAR);
+
+    lv_obj_get_style_stats(&stats_start);
+    TEST_ASSERT_EQUAL(7, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL(3, lv_obj_get_style_radius(obj, LV_PART_SCROLLBAR));
+    TEST_ASSERT_EQUAL(0, get_stats().hit_cnt);
+
+    TEST_ASSERT_EQUAL(7, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL(3, lv_obj_get_style_radius(obj, LV_PART_SCROLLBAR));
+    lv_obj_style_stats_t stats = get_stats();
+    TEST_ASSERT_EQUAL(4, stats.lookup_cnt);
+    TEST_ASSERT_EQUAL(2, stats.hit_cnt);
+}
+
+void test_obj_style_cache_should_follow_the_style_and_state_changes(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    lv_obj_add_style(obj, &style, LV_PART_MAIN);
+    lv_obj_add_style(obj, &style_pr, LV_STATE_PRESSED);
+    lv_style_set_bg_opa(&style, LV_OPA_50);
+    lv_style_set_bg_opa(&style_pr, LV_OPA_70);
+
+    TEST_ASSERT_EQUAL(LV_OPA_50, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL(LV_OPA_50, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+
+    /*A shared style changes*/
+    lv_style_set_bg_opa(&style, LV_OPA_40);
+    lv_obj_report_style_change(&style);
+    TEST_ASSERT_EQUAL(LV_OPA_40, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+
+    /*Reported while the style refresh is disabled*/
+    lv_obj_enable_style_refresh(false);
+    lv_style_set_bg_opa(&style, LV_OPA_60);
+    lv_obj_report_style_change(&style);
+    lv_obj_enable_style_refresh(true);
+    TEST_ASSERT_EQUAL(LV_OPA_60, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+    lv_style_set_bg_opa(&style, LV_OPA_40);
+    lv_obj_report_style_change(&style);
+
+    lv_obj_set_style_bg_opa(obj, LV_OPA_30, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL(LV_OPA_30, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+    lv_obj_remove_local_style_prop(obj, LV_STYLE_BG_OPA, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL(LV_OPA_40, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL(LV_OPA_70, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+    lv_obj_clear_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL(LV_OPA_40, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+
+    lv_obj_remove_style(obj, &style, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL(LV_OPA_TRANSP, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+}
+
+void test_obj_style_cache_should_follow_the_inherited_properties(void)
+{
+    lv_obj_t * parent1 = lv_obj_create(lv_scr_act());
+    lv_obj_t * parent2 = lv_obj_create(lv_scr_act());
+    lv_obj_set_style_text_color(parent1, lv_color_hex(0xff0000), LV_PART_MAIN);
+    lv_obj_set_style_text_color(parent2, lv_color_hex(0x00ff00), LV_PART_MAIN);
+    lv_obj_set_style_text_color(parent2, lv_color_hex(0x0000ff), LV_STATE_CHECKED);
+
+    lv_obj_t * label = lv_label_create(parent1);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff0000), lv_obj_get_style_text_color(label, LV_PART_MAIN));
+
+    lv_obj_set_style_text_color(parent1, lv_color_hex(0x00ffff), LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x00ffff), lv_obj_get_style_text_color(label, LV_PART_MAIN));
+
+    lv_obj_set_parent(label, parent2);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x00ff00), lv_obj_get_style_text_color(label, LV_PART_MAIN));
+
+    lv_obj_add_state(parent2, LV_STATE_CHECKED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x0000ff), lv_obj_get_style_text_color(label, LV_PART_MAIN));
+}
+
+void test_obj_style_cache_should_follow_the_transitions(void)
+{
+    static const lv_style_prop_t props[] = {LV_STYLE_BG_OPA, 0};
+    static lv_style_transition_dsc_t trans;
+    lv_style_transition_dsc_init(&trans, props, lv_anim_path_linear, 100, 0, NULL);
+
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    lv_obj_add_style(obj, &style, LV_PART_MAIN);
+    lv_obj_add_style(obj, &style_pr, LV_STATE_PRESSED);
+    lv_style_set_bg_opa(&style, LV_OPA_0);
+    lv_style_set_bg_opa(&style_pr, LV_OPA_100);
+    lv_style_set_transition(&style_pr, &trans);
+
+    TEST_ASSERT_EQUAL(LV_OPA_0, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+
+    lv_tick_inc(50);
+    lv_timer_handler();
+    lv_opa_t opa = lv_obj_get_style_bg_opa(obj, LV_PART_MAIN);
+    TEST_ASSERT_GREATER_THAN(LV_OPA_0, opa);
+    TEST_ASSERT_LESS_THAN(LV_OPA_100, opa);
+
+    lv_tick_inc(100);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(LV_OPA_100, lv_obj_get_style_bg_opa(obj, LV_PART_MAIN));
+}
+
+void test_obj_style_cache_should_keep_the_cache_of_the_other_objects(void)
+{
+    static const lv_style_prop_t props[] = {LV_STYLE_BG_OPA, LV_STYLE_TEXT_COLOR, 0};
+    static lv_style_transition_dsc_t trans;
+    lv_style_transition_dsc_init(&trans, props, lv_anim_path_linear, 100, 0, NULL);
+
+    lv_obj_t * btn = lv_obj_create(lv_scr_act());
+    lv_obj_t * label = lv_label_create(btn);
+    lv_obj_t * other = lv_obj_create(lv_scr_act());
+    lv_obj_set_style_bg_opa(btn, LV_OPA_100, LV_STATE_PRESSED);
+    lv_obj_set_style_text_color(btn, lv_color_hex(0xff0000), LV_STATE_PRESSED);
+    lv_obj_set_style_transition(btn, &trans, LV_STATE_PRESSED);
+
+    lv_obj_get_style_radius(other, LV_PART_MAIN);
+    lv_obj_get_style_text_color(other, LV_PART_MAIN);
+
+    /*A state change, a transition and a local style of an other object don't drop the cache*/
+    lv_obj_add_state(btn, LV_STATE_PRESSED);
+    lv_tick_inc(50);
+    lv_timer_handler();
+    lv_obj_set_style_radius(btn, 5, LV_PART_MAIN);
+    lv_obj_set_style_text_color(btn, lv_color_hex(0x00ff00), LV_PART_MAIN);
+
+    lv_obj_get_style_stats(&stats_start);
+    lv_obj_get_style_radius(other, LV_PART_MAIN);
+    lv_obj_get_style_text_color(other, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL(2, get_stats().hit_cnt);
+
+    /*But the children get the new inherited values*/
+    lv_tick_inc(100);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff0000), lv_obj_get_style_text_color(label, LV_PART_MAIN));
+    lv_obj_clear_state(btn, LV_STATE_PRESSED);
+    lv_tick_inc(150);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x00ff00), lv_obj_get_style_text_color(label, LV_PART_MAIN));
+}
+
+void test_obj_style_cache_should_resolve_fewer_properties_in_the_next_refresh(void)
+{
+    uint32_t i;
+    for(i = 0; i < 12; i++) {
+        lv_obj_t * btn = lv_btn_create(lv_scr_act());
+        lv_obj_set_pos(btn, 20 + (i % 4) * 190, 30 + (i / 4) * 150);
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "Button %d", i);
+    }
+
+    /*Drop the caches*/
+    lv_obj_report_style_change(NULL);
+    lv_refr_now(NULL);
+    lv_disp_refr_stats_t stats1;
+    lv_disp_get_refr_stats(lv_disp_get_default(), &stats1);
+
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_disp_refr_stats_t stats2;
+    lv_disp_get_refr_stats(lv_disp_get_default(), &stats2);
+
+    TEST_ASSERT_GREATER_THAN(0, stats2.style_lookup_cnt);
+    TEST_ASSERT_LESS_THAN(stats1.style_resolve_cnt / 2, stats2.style_resolve_cnt);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_obj_style_cache_should_hit_the_cached_properties(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_OBJ_STYLE_CACHE_SIZE > 0");
+}
+
+void test_obj_style_cache_should_follow_the_style_and_state_changes(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_OBJ_STYLE_CACHE_SIZE > 0");
+}
+
+void test_obj_style_cache_should_follow_the_inherited_properties(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_OBJ_STYLE_CACHE_SIZE > 0");
+}
+
+void test_obj_style_cache_should_follow_the_transitions(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_OBJ_STYLE_CACHE_SIZE > 0");
+}
+
+void test_obj_style_cache_should_keep_the_cache_of_the_other_objects(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_OBJ_STYLE_CACHE_SIZE > 0");
+}
+
+void test_obj_style_cache_should_resolve_fewer_properties_in_the_next_refresh(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_OBJ_STYLE_CACHE_SIZE > 0");
+}
+
+#endif
+
+#endif
@@ -0,0 +1,173 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void);
+void tearDown(void);
+
+void test_refr_inv_area_should_not_redraw_the_screen_if_the_buffer_is_full(void);
+void test_refr_inv_area_should_drop_the_areas_in_a_new_area(void);
+void test_refr_inv_area_should_join_the_close_areas(void);
+void test_refr_inv_area_should_not_redraw_the_overlapping_parts(void);
+void test_refr_inv_area_should_redraw_the_whole_invalidated_region(void);
+
+extern lv_color_t test_fb[];
+
+#define SCR_W   800
+#define SCR_H   480
+
+static lv_disp_t * disp;
+
+static void inv(lv_coord_t x1, lv_coord_t y1, lv_coord_t x2, lv_coord_t y2)
+{
+    lv_area_t a;
+    lv_area_set(&a, x1, y1, x2, y2);
+    _lv_inv_area(disp, &a);
+}
+
+static lv_disp_refr_stats_t refr(void)
+{
+    lv_refr_now(disp);
+    lv_disp_refr_stats_t stats;
+    lv_disp_get_refr_stats(disp, &stats);
+    return stats;
+}
+
+void setUp(void)
+{
+    disp = lv_disp_get_default();
+    lv_refr_now(disp);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_refr_inv_area_should_not_redraw_the_screen_if_the_buffer_is_full(void)
+{
+    uint32_t i;
+    for(i = 0; i < 100; i++) {
+        inv((i % 20) * 40, (i / 20) * 90, (i % 20) * 40 + 3, (i / 20) * 90 + 3);
+    }
+
+    TEST_ASSERT_EQUAL(LV_INV_BUF_SIZE, disp->inv_p);
+    uint32_t px_cnt = 0;
+    for(i = 0; i < disp->inv_p; i++) {
+        px_cnt += lv_area_get_size(&disp->inv_areas[i]);
+    }
+    TEST_ASSERT_LESS_THAN(SCR_W * SCR_H / 20, px_cnt);
+
+    /*Every invalidated area is still in a saved area*/
+    for(i = 0; i < 100; i++) {
+        lv_area_t a;
+        lv_area_set(&a, (i % 20) * 40, (i / 20) * 90, (i % 20) * 40 + 3, (i / 20) * 90 + 3);
+        bool found = false;
+        uint32_t j;
+        for(j = 0; j < disp->inv_p; j++) {
+            if(_lv_area_is_in(&a, &disp->inv_areas[j], 0)) found = true;
+        }
+        TEST_ASSERT_TRUE(found);
+    }
+
+    lv_disp_refr_stats_t stats = refr();
+    TEST_ASSERT_EQUAL(100, stats.inv_cnt);
+    TEST_ASSERT_EQUAL(100 - LV_INV_BUF_SIZE, stats.merge_cnt);
+    TEST_ASSERT_LESS_THAN(SCR_W * SCR_H / 20, stats.px_cnt);
+}
+
+void test_refr_inv_area_should_drop_the_areas_in_a_new_area(void)
+{
+    inv(10, 10, 20, 20);
+    inv(50, 10, 60, 20);
+    inv(300, 300, 310, 310);
+    inv(0, 0, 100, 100);
+    TEST_ASSERT_EQUAL(2, disp->inv_p);
+
+    inv(0, 0, SCR_W - 1, SCR_H - 1);
+    TEST_ASSERT_EQUAL(1, disp->inv_p);
+
+    lv_disp_refr_stats_t stats = refr();
+    TEST_ASSERT_EQUAL(5, stats.inv_cnt);
+    TEST_ASSERT_EQUAL(0, stats.merge_cnt);
+    TEST_ASSERT_EQUAL(1, stats.area_cnt);
+    TEST_ASSERT_EQUAL(SCR_W * SCR_H, stats.px_cnt);
+}
+
+void test_refr_inv_area_should_join_the_close_areas(void)
+{
+    /*Joining adds only 10 pixels which is cheaper than drawing an other area*/
+    inv(10, 10, 19, 19);
+    inv(21, 10, 30, 19);
+    lv_disp_refr_stats_t stats = refr();
+    TEST_ASSERT_EQUAL(1, stats.area_cnt);
+    TEST_ASSERT_EQUAL(21 * 10, stats.px_cnt);
+
+    inv(10, 10, 19, 19);
+    inv(400, 300, 409, 309);
+    stats = refr();
+    TEST_ASSERT_EQUAL(2, stats.area_cnt);
+    TEST_ASSERT_EQUAL(2 * 10 * 10, stats.px_cnt);
+}
+
+void test_refr_inv_area_should_not_redraw_the_overlapping_parts(void)
+{
+    /*The second area is split into 2 pieces*/
+    inv(0, 0, 99, 99);
+    inv(50, 50, 149, 149);
+    lv_disp_refr_stats_t stats = refr();
+    TEST_ASSERT_EQUAL(3, stats.area_cnt);
+    TEST_ASSERT_EQUAL(100 * 100 + 50 * 100 + 50 * 50, stats.px_cnt);
+
+    /*The side of the second area is cropped*/
+    inv(0, 0, 99, 99);
+    inv(50, 0, 249, 99);
+    stats = refr();
+    TEST_ASSERT_EQUAL(1, stats.area_cnt);
+
+    inv(0, 0, 99, 199);
+    inv(50, 50, 249, 99);
+    stats = refr();
+    TEST_ASSERT_EQUAL(2, stats.area_cnt);
+    TEST_ASSERT_EQUAL(100 * 200 + 150 * 50, stats.px_cnt);
+
+    /*A cross*/
+    inv(0, 40, 199, 59);
+    inv(90, 0, 109, 199);
+    stats = refr();
+    TEST_ASSERT_EQUAL(3, stats.area_cnt);
+    TEST_ASSERT_EQUAL(200 * 20 + 20 * 180, stats.px_cnt);
+}
+
+void test_refr_inv_area_should_redraw_the_whole_invalidated_region(void)
+{
+    static lv_color_t ref_fb[SCR_W * SCR_H];
+
+    uint32_t i;
+    for(i = 0; i < 12; i++) {
+        lv_obj_t * btn = lv_btn_create(lv_scr_act());
+        lv_obj_set_pos(btn, 20 + (i % 4) * 190, 30 + (i / 4) * 150);
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "Button %d", i);
+    }
+    lv_obj_invalidate(lv_scr_act());
+    refr();
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    /*Overlapping tiles which cover the screen*/
+    lv_memset_00(test_fb, sizeof(ref_fb));
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < SCR_H; y += 120) {
+        for(x = 0; x < SCR_W; x += 160) {
+            inv(x, y, x + 189 + (y % 7), y + 149);
+        }
+    }
+
+    lv_disp_refr_stats_t stats = refr();
+    TEST_ASSERT_EQUAL(SCR_W * SCR_H, stats.px_cnt);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+}
+
+#endif
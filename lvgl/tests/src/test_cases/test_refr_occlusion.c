@@ -0,0 +1,212 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void);
+void tearDown(void);
+
+void test_refr_occlusion_should_skip_the_panels_under_an_opaque_panel(void);
+void test_refr_occlusion_should_draw_under_not_opaque_objects(void);
+void test_refr_occlusion_should_crop_the_partially_covered_objects(void);
+void test_refr_occlusion_should_draw_the_same_as_without_occlusion(void);
+void test_refr_occlusion_should_not_hide_with_the_children_of_masked_objects(void);
+
+extern lv_color_t test_fb[];
+
+#define SCR_W   800
+#define SCR_H   480
+
+typedef struct {
+    uint32_t cnt;
+    lv_area_t clip;
+} draw_info_t;
+
+static void draw_main_event_cb(lv_event_t * e)
+{
+    draw_info_t * info = lv_event_get_user_data(e);
+    const lv_area_t * clip = lv_event_get_param(e);
+    if(info->cnt == 0) info->clip = *clip;
+    else _lv_area_join(&info->clip, &info->clip, clip);
+    info->cnt++;
+}
+
+static void not_cover_event_cb(lv_event_t * e)
+{
+    lv_cover_check_info_t * info = lv_event_get_param(e);
+    if(info->res == LV_COVER_RES_COVER) info->res = LV_COVER_RES_NOT_COVER;
+}
+
+static lv_obj_t * panel_create(lv_obj_t * parent, lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h,
+                               draw_info_t * info)
+{
+    lv_obj_t * obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, w, h);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, LV_PART_MAIN);
+    lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_BLUE), LV_PART_MAIN);
+    if(info) {
+        lv_memset_00(info, sizeof(draw_info_t));
+        lv_obj_add_event_cb(obj, draw_main_event_cb, LV_EVENT_DRAW_MAIN_BEGIN, info);
+    }
+    return obj;
+}
+
+static void refr(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_refr_occlusion_should_skip_the_panels_under_an_opaque_panel(void)
+{
+    draw_info_t info[3];
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        panel_create(lv_scr_act(), 0, 0, LV_PCT(100), LV_PCT(100), &info[i]);
+    }
+
+    draw_info_t child_info;
+    lv_obj_t * child = panel_create(lv_obj_get_child(lv_scr_act(), 1), 10, 10, 100, 100, &child_info);
+    lv_obj_set_style_radius(child, 10, LV_PART_MAIN);
+
+    refr();
+    TEST_ASSERT_EQUAL(0, info[0].cnt);
+    TEST_ASSERT_EQUAL(0, info[1].cnt);
+    TEST_ASSERT_EQUAL(0, child_info.cnt);
+    TEST_ASSERT_GREATER_THAN(0, info[2].cnt);
+
+    /*The same if the panels don't cover the whole screen*/
+    draw_info_t small_info;
+    lv_obj_clean(lv_scr_act());
+    panel_create(lv_scr_act(), 100, 100, 200, 150, &small_info);
+    panel_create(lv_scr_act(), 50, 50, 400, 300, &info[0]);
+    refr();
+    TEST_ASSERT_EQUAL(0, small_info.cnt);
+    TEST_ASSERT_GREATER_THAN(0, info[0].cnt);
+}
+
+void test_refr_occlusion_should_draw_under_not_opaque_objects(void)
+{
+    draw_info_t info[4];
+    panel_create(lv_scr_act(), 100, 100, 100, 100, &info[0]);
+    lv_obj_t * rounded = panel_create(lv_scr_act(), 50, 50, 200, 200, NULL);
+    lv_obj_set_style_radius(rounded, 20, LV_PART_MAIN);
+
+    panel_create(lv_scr_act(), 400, 100, 100, 100, &info[1]);
+    lv_obj_t * transp = panel_create(lv_scr_act(), 350, 50, 200, 200, NULL);
+    lv_obj_set_style_bg_opa(transp, LV_OPA_50, LV_PART_MAIN);
+
+    panel_create(lv_scr_act(), 100, 300, 100, 100, &info[2]);
+    lv_obj_t * hidden = panel_create(lv_scr_act(), 50, 250, 200, 200, NULL);
+    lv_obj_add_flag(hidden, LV_OBJ_FLAG_HIDDEN);
+
+    /*A child can't hide its parent*/
+    lv_obj_t * parent = panel_create(lv_scr_act(), 400, 300, 100, 100, &info[3]);
+    panel_create(parent, 0, 0, 100, 100, NULL);
+
+    refr();
+    uint32_t i;
+    for(i = 0; i < 4; i++) {
+        TEST_ASSERT_GREATER_THAN(0, info[i].cnt);
+    }
+}
+
+void test_refr_occlusion_should_crop_the_partially_covered_objects(void)
+{
+    draw_info_t info[2];
+    panel_create(lv_scr_act(), 0, 0, 300, 100, &info[0]);
+    panel_create(lv_scr_act(), 100, 200, 100, 200, &info[1]);
+
+    /*Cover the right side of the first and the top of the second panel*/
+    panel_create(lv_scr_act(), 100, 0, 300, 100, NULL);
+    panel_create(lv_scr_act(), 0, 150, 400, 150, NULL);
+
+    refr();
+    TEST_ASSERT_GREATER_THAN(0, info[0].cnt);
+    TEST_ASSERT_EQUAL(0, info[0].clip.x1);
+    TEST_ASSERT_EQUAL(99, info[0].clip.x2);
+    TEST_ASSERT_EQUAL(0, info[0].clip.y1);
+    TEST_ASSERT_EQUAL(99, info[0].clip.y2);
+
+    TEST_ASSERT_GREATER_THAN(0, info[1].cnt);
+    TEST_ASSERT_EQUAL(100, info[1].clip.x1);
+    TEST_ASSERT_EQUAL(199, info[1].clip.x2);
+    TEST_ASSERT_EQUAL(300, info[1].clip.y1);
+    TEST_ASSERT_EQUAL(399, info[1].clip.y2);
+}
+
+void test_refr_occlusion_should_draw_the_same_as_without_occlusion(void)
+{
+    static lv_color_t ref_fb[SCR_W * SCR_H];
+
+    lv_obj_t * tabview = lv_tabview_create(lv_scr_act(), LV_DIR_TOP, 50);
+    lv_obj_t * tab = lv_tabview_add_tab(tabview, "Tab 1");
+    lv_tabview_add_tab(tabview, "Tab 2");
+    lv_obj_set_style_bg_opa(tab, LV_OPA_COVER, LV_PART_MAIN);
+
+    uint32_t i;
+    for(i = 0; i < 6; i++) {
+        lv_obj_t * btn = lv_btn_create(tab);
+        lv_obj_set_pos(btn, 20 + i * 120, 20 + i * 40);
+        lv_obj_t * label = lv_label_create(btn);
+        lv_label_set_text_fmt(label, "Button %d", i);
+    }
+
+    lv_obj_t * panel = panel_create(lv_scr_act(), 150, 0, 400, 300, NULL);
+    lv_obj_t * label = lv_label_create(panel);
+    lv_label_set_text(label, "An opaque panel on the tab view");
+    panel_create(lv_scr_act(), 300, 200, 200, 250, NULL);
+
+    refr();
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    /*Draw everything under the panels too*/
+    lv_obj_add_event_cb(tabview, not_cover_event_cb, LV_EVENT_COVER_CHECK, NULL);
+    lv_obj_add_event_cb(tab, not_cover_event_cb, LV_EVENT_COVER_CHECK, NULL);
+    for(i = 0; i < lv_obj_get_child_cnt(lv_scr_act()); i++) {
+        lv_obj_add_event_cb(lv_obj_get_child(lv_scr_act(), i), not_cover_event_cb, LV_EVENT_COVER_CHECK, NULL);
+    }
+    refr();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+}
+
+void test_refr_occlusion_should_not_hide_with_the_children_of_masked_objects(void)
+{
+    static lv_color_t ref_fb[SCR_W * SCR_H];
+
+    /*A sibling under the rounded corner of the parent*/
+    draw_info_t info;
+    lv_obj_t * sibling = panel_create(lv_scr_act(), 100, 100, 50, 50, &info);
+    lv_obj_set_style_bg_color(sibling, lv_palette_main(LV_PALETTE_RED), LV_PART_MAIN);
+
+    lv_obj_t * parent = panel_create(lv_scr_act(), 100, 100, 300, 200, NULL);
+    lv_obj_set_style_radius(parent, 40, LV_PART_MAIN);
+    lv_obj_set_style_clip_corner(parent, true, LV_PART_MAIN);
+
+    /*An opaque child which is clipped by the corners of the parent*/
+    lv_obj_t * child = panel_create(parent, 0, 0, 300, 200, NULL);
+    lv_obj_set_style_bg_color(child, lv_palette_main(LV_PALETTE_GREEN), LV_PART_MAIN);
+
+    refr();
+    TEST_ASSERT_GREATER_THAN(0, info.cnt);
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    /*Draw everything under the panels too*/
+    lv_obj_add_event_cb(parent, not_cover_event_cb, LV_EVENT_COVER_CHECK, NULL);
+    lv_obj_add_event_cb(child, not_cover_event_cb, LV_EVENT_COVER_CHECK, NULL);
+    refr();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+}
+
+#endif
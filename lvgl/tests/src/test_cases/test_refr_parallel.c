@@ -0,0 +1,157 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void);
+void tearDown(void);
+
+void test_refr_parallel_should_draw_the_same_as_one_thread(void);
+
+#define SCR_W       800
+#define SCR_H       480
+#define BAND_ROWS   5
+
+#if LV_USE_REFR_PARALLEL
+
+static lv_color_t band_fb[SCR_W * SCR_H];
+static lv_color_t ref_fb[SCR_W * SCR_H];
+static volatile bool drawn_in_parallel;
+
+static void (*flush_cb_ori)(lv_disp_drv_t *, const lv_area_t *, lv_color_t *);
+static uint32_t buf_size_ori;
+static uint32_t thread_cnt_ori;
+
+static void band_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(&band_fb[y * SCR_W + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+    lv_disp_flush_ready(drv);
+}
+
+static void draw_event_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    if(_lv_refr_is_parallel()) drawn_in_parallel = true;
+}
+
+/*Overlapping, semi-transparent objects whose edges, corners and shadows cross many bands*/
+static void scene_create(void)
+{
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_palette_lighten(LV_PALETTE_GREY, 2), LV_PART_MAIN);
+    lv_obj_set_style_bg_grad_color(lv_scr_act(), lv_palette_darken(LV_PALETTE_BLUE, 2), LV_PART_MAIN);
+    lv_obj_set_style_bg_grad_dir(lv_scr_act(), LV_GRAD_DIR_VER, LV_PART_MAIN);
+
+    uint32_t i;
+    for(i = 0; i < 12; i++) {
+        lv_obj_t * obj = lv_obj_create(lv_scr_act());
+        lv_obj_remove_style_all(obj);
+        lv_obj_set_pos(obj, 30 + i * 53, 7 + (i % 4) * 97 + i);
+        lv_obj_set_size(obj, 143, 121 + (i % 3) * 17);
+        lv_obj_set_style_bg_color(obj, lv_palette_main(i % 19), LV_PART_MAIN);
+        lv_obj_set_style_bg_opa(obj, LV_OPA_50, LV_PART_MAIN);
+        lv_obj_set_style_radius(obj, 9 + i * 3, LV_PART_MAIN);
+        lv_obj_set_style_border_width(obj, 3, LV_PART_MAIN);
+        lv_obj_set_style_border_color(obj, lv_palette_darken(i % 19, 3), LV_PART_MAIN);
+        lv_obj_set_style_border_opa(obj, LV_OPA_70, LV_PART_MAIN);
+        lv_obj_set_style_shadow_width(obj, 15, LV_PART_MAIN);
+        lv_obj_set_style_shadow_ofs_y(obj, 4, LV_PART_MAIN);
+        lv_obj_set_style_shadow_opa(obj, LV_OPA_40, LV_PART_MAIN);
+        lv_obj_add_event_cb(obj, draw_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+        lv_obj_t * label = lv_label_create(obj);
+        lv_label_set_text_fmt(label, "Band edge %d", i);
+        lv_obj_center(label);
+    }
+
+    /*Rendered on a layer in every band*/
+    lv_obj_t * layer = lv_obj_create(lv_scr_act());
+    lv_obj_set_pos(layer, 400, 173);
+    lv_obj_set_size(layer, 300, 211);
+    lv_obj_set_style_opa(layer, LV_OPA_60, LV_PART_MAIN);
+    lv_obj_t * child = lv_obj_create(layer);
+    lv_obj_set_size(child, 150, 101);
+    lv_obj_set_style_bg_color(child, lv_palette_main(LV_PALETTE_RED), LV_PART_MAIN);
+}
+
+static void refr_all(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+void setUp(void)
+{
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    flush_cb_ori = drv->flush_cb;
+    buf_size_ori = drv->draw_buf->size;
+    thread_cnt_ori = lv_refr_get_thread_cnt();
+
+    /*Render the screen in bands of a few rows*/
+    drv->flush_cb = band_flush_cb;
+    drv->draw_buf->size = SCR_W * BAND_ROWS;
+}
+
+void tearDown(void)
+{
+    lv_disp_drv_t * drv = lv_disp_get_default()->driver;
+    drv->flush_cb = flush_cb_ori;
+    drv->draw_buf->size = buf_size_ori;
+    lv_refr_set_thread_cnt(thread_cnt_ori);
+
+    lv_obj_clean(lv_scr_act());
+    lv_obj_remove_style_all(lv_scr_act());
+    lv_obj_report_style_change(NULL);
+}
+
+void test_refr_parallel_should_draw_the_same_as_one_thread(void)
+{
+    scene_create();
+
+    lv_refr_set_thread_cnt(1);
+    refr_all();
+    lv_memcpy(ref_fb, band_fb, sizeof(ref_fb));
+    TEST_ASSERT_FALSE(drawn_in_parallel);
+
+    lv_refr_set_thread_cnt(4);
+    TEST_ASSERT_EQUAL(4, lv_refr_get_thread_cnt());
+    lv_memset_00(band_fb, sizeof(band_fb));
+    refr_all();
+    TEST_ASSERT_TRUE(drawn_in_parallel);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, band_fb, sizeof(ref_fb));
+
+    /*Redraw only a part crossing some bands*/
+    drawn_in_parallel = false;
+    lv_obj_t * obj = lv_obj_get_child(lv_scr_act(), 3);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_30, LV_PART_MAIN);
+    lv_refr_now(NULL);
+    TEST_ASSERT_TRUE(drawn_in_parallel);
+    lv_memcpy(ref_fb, band_fb, sizeof(ref_fb));
+
+    lv_refr_set_thread_cnt(1);
+    refr_all();
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, band_fb, sizeof(ref_fb));
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_refr_parallel_should_draw_the_same_as_one_thread(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_USE_REFR_PARALLEL");
+}
+
+#endif
+
+#endif
@@ -0,0 +1,210 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+void setUp(void);
+void tearDown(void);
+
+void test_refr_scroll_blit_should_redraw_only_the_uncovered_strip(void);
+void test_refr_scroll_blit_should_move_the_content_several_times(void);
+void test_refr_scroll_blit_should_redraw_the_changes_before_scrolling(void);
+void test_refr_scroll_blit_should_redraw_the_floating_children(void);
+void test_refr_scroll_blit_should_redraw_the_objects_which_are_not_plain(void);
+void test_refr_scroll_blit_should_redraw_less_than_without_blit(void);
+
+extern lv_color_t test_fb[];
+
+#define SCR_W       800
+#define SCR_H       480
+#define ROW_CNT     100
+
+static lv_disp_t * disp;
+static lv_color_t ref_fb[SCR_W * SCR_H];
+
+static lv_disp_refr_stats_t refr(void)
+{
+    lv_refr_now(disp);
+    lv_disp_refr_stats_t stats;
+    lv_disp_get_refr_stats(disp, &stats);
+    return stats;
+}
+
+/*Compare the frame with a full redraw*/
+static void check_frame(void)
+{
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+    lv_obj_invalidate(lv_scr_act());
+    refr();
+    TEST_ASSERT_EQUAL_MEMORY(test_fb, ref_fb, sizeof(ref_fb));
+}
+
+static lv_obj_t * list_create(void)
+{
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, 300, 400);
+    lv_obj_set_pos(cont, 100, 40);
+    lv_obj_set_style_radius(cont, 0, LV_PART_MAIN);
+    lv_obj_set_style_border_width(cont, 3, LV_PART_MAIN);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+
+    uint32_t i;
+    for(i = 0; i < ROW_CNT; i++) {
+        lv_obj_t * row = lv_obj_create(cont);
+        lv_obj_set_size(row, 400, 40);
+        lv_obj_set_style_bg_color(row, lv_palette_main(i % 19), LV_PART_MAIN);
+        lv_obj_t * label = lv_label_create(row);
+        lv_label_set_text_fmt(label, "Row %d", i);
+    }
+
+    lv_obj_update_layout(cont);
+    refr();
+    return cont;
+}
+
+void setUp(void)
+{
+    disp = lv_disp_get_default();
+    disp->driver->direct_mode = 1;
+    disp->driver->scroll_blit = 1;
+
+    /*Make the frame buffer contain the whole screen*/
+    lv_obj_invalidate(lv_scr_act());
+    refr();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    refr();
+    disp->driver->direct_mode = 0;
+    disp->driver->scroll_blit = 0;
+}
+
+void test_refr_scroll_blit_should_redraw_only_the_uncovered_strip(void)
+{
+    lv_obj_t * cont = list_create();
+
+    lv_obj_scroll_by(cont, 0, -17, LV_ANIM_OFF);
+    lv_disp_refr_stats_t stats = refr();
+    TEST_ASSERT_GREATER_THAN(200 * 300, stats.blit_px_cnt);
+    TEST_ASSERT_LESS_THAN(300 * 400 / 4, stats.px_cnt);
+    check_frame();
+
+    lv_obj_scroll_by(cont, -23, 0, LV_ANIM_OFF);
+    stats = refr();
+    TEST_ASSERT_GREATER_THAN(200 * 300, stats.blit_px_cnt);
+    TEST_ASSERT_LESS_THAN(300 * 400 / 4, stats.px_cnt);
+    check_frame();
+}
+
+void test_refr_scroll_blit_should_move_the_content_several_times(void)
+{
+    lv_obj_t * cont = list_create();
+
+    lv_obj_scroll_by(cont, 0, -30, LV_ANIM_OFF);
+    lv_obj_scroll_by(cont, -12, 0, LV_ANIM_OFF);
+    lv_obj_scroll_by(cont, 0, 7, LV_ANIM_OFF);
+    lv_obj_scroll_by(cont, 0, -44, LV_ANIM_OFF);
+    lv_disp_refr_stats_t stats = refr();
+    TEST_ASSERT_GREATER_THAN(0, stats.blit_px_cnt);
+    check_frame();
+
+    /*Scrolling back and forth doesn't move anything*/
+    lv_obj_scroll_by(cont, 0, -20, LV_ANIM_OFF);
+    lv_obj_scroll_by(cont, 0, 20, LV_ANIM_OFF);
+    stats = refr();
+    TEST_ASSERT_EQUAL(0, stats.blit_px_cnt);
+    check_frame();
+}
+
+void test_refr_scroll_blit_should_redraw_the_changes_before_scrolling(void)
+{
+    lv_obj_t * cont = list_create();
+
+    lv_obj_set_style_bg_color(lv_obj_get_child(cont, 3), lv_color_black(), LV_PART_MAIN);
+    lv_obj_set_style_bg_color(lv_obj_get_child(cont, 6), lv_color_white(), LV_PART_MAIN);
+    lv_obj_scroll_by(cont, 0, -25, LV_ANIM_OFF);
+    lv_obj_set_style_bg_color(lv_obj_get_child(cont, 8), lv_color_black(), LV_PART_MAIN);
+    lv_obj_scroll_by(cont, 0, -25, LV_ANIM_OFF);
+    lv_disp_refr_stats_t stats = refr();
+    TEST_ASSERT_GREATER_THAN(0, stats.blit_px_cnt);
+    check_frame();
+}
+
+void test_refr_scroll_blit_should_redraw_the_floating_children(void)
+{
+    lv_obj_t * cont = list_create();
+
+    lv_obj_t * btn = lv_btn_create(cont);
+    lv_obj_add_flag(btn, LV_OBJ_FLAG_FLOATING);
+    lv_obj_align(btn, LV_ALIGN_BOTTOM_RIGHT, -10, -10);
+    refr();
+
+    lv_obj_scroll_by(cont, 0, -31, LV_ANIM_OFF);
+    lv_disp_refr_stats_t stats = refr();
+    TEST_ASSERT_GREATER_THAN(0, stats.blit_px_cnt);
+    check_frame();
+}
+
+void test_refr_scroll_blit_should_redraw_the_objects_which_are_not_plain(void)
+{
+    lv_obj_t * cont = list_create();
+
+    /*Rounded corners*/
+    lv_obj_set_style_radius(cont, 10, LV_PART_MAIN);
+    refr();
+    lv_obj_scroll_by(cont, 0, -10, LV_ANIM_OFF);
+    lv_disp_refr_stats_t stats = refr();
+    TEST_ASSERT_EQUAL(0, stats.blit_px_cnt);
+    check_frame();
+
+    /*An other object on it*/
+    lv_obj_set_style_radius(cont, 0, LV_PART_MAIN);
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_pos(obj, 200, 200);
+    refr();
+    lv_obj_scroll_by(cont, 0, -10, LV_ANIM_OFF);
+    stats = refr();
+    TEST_ASSERT_EQUAL(0, stats.blit_px_cnt);
+    check_frame();
+
+    lv_obj_set_x(obj, 500);
+    refr();
+    lv_obj_scroll_by(cont, 0, -10, LV_ANIM_OFF);
+    stats = refr();
+    TEST_ASSERT_GREATER_THAN(0, stats.blit_px_cnt);
+    check_frame();
+
+    /*Not in direct mode*/
+    disp->driver->direct_mode = 0;
+    lv_obj_scroll_by(cont, 0, -10, LV_ANIM_OFF);
+    stats = refr();
+    TEST_ASSERT_EQUAL(0, stats.blit_px_cnt);
+}
+
+void test_refr_scroll_blit_should_redraw_less_than_without_blit(void)
+{
+    lv_obj_t * cont = list_create();
+
+    uint32_t px_cnt[2];
+    uint32_t blit;
+    for(blit = 0; blit < 2; blit++) {
+        disp->driver->scroll_blit = blit;
+        lv_obj_scroll_to_y(cont, 0, LV_ANIM_OFF);
+        refr();
+
+        px_cnt[blit] = 0;
+        uint32_t i;
+        for(i = 0; i < 20; i++) {
+            lv_obj_scroll_by(cont, 0, -3, LV_ANIM_OFF);
+            px_cnt[blit] += refr().px_cnt;
+        }
+    }
+
+    /*Only a 3 px high strip of the list is redrawn in each frame*/
+    TEST_ASSERT_LESS_THAN(px_cnt[0] / 4, px_cnt[1]);
+    check_frame();
+}
+
+#endif
@@ -3,11 +3,194 @@
 
 #include "unity/unity.h"
 
-//void test_func_1(void);
+void setUp(void);
+void tearDown(void);
 
-//void test_func_1(void)
-//{
-//  TEST_ASSERT_EQUAL(actual, expected);
-//}
+void test_style_should_keep_the_props_sorted(void);
+void test_style_should_find_the_props_after_removing(void);
+void test_style_should_skip_the_groups_of_const_styles(void);
+void test_style_cache_should_resolve_less_on_a_theme_heavy_screen(void);
+
+static const lv_style_prop_t props[] = {
+    LV_STYLE_TEXT_COLOR, LV_STYLE_WIDTH, LV_STYLE_BG_OPA, LV_STYLE_PAD_TOP, LV_STYLE_BASE_DIR,
+    LV_STYLE_BORDER_WIDTH, LV_STYLE_RADIUS, LV_STYLE_HEIGHT, LV_STYLE_SHADOW_WIDTH, LV_STYLE_LINE_WIDTH,
+    LV_STYLE_ARC_WIDTH, LV_STYLE_BG_COLOR, LV_STYLE_OPA, LV_STYLE_PAD_LEFT, LV_STYLE_X,
+};
+
+#define PROP_CNT    (sizeof(props) / sizeof(props[0]))
+
+static lv_style_t style;
+
+static void check_sorted(void)
+{
+    uint8_t * tmp = style.v_p.values_and_props + style.prop_cnt * sizeof(lv_style_value_t);
+    uint16_t * style_props = (uint16_t *)tmp;
+    uint32_t i;
+    for(i = 1; i < style.prop_cnt; i++) {
+        TEST_ASSERT_LESS_THAN(style_props[i], style_props[i - 1]);
+    }
+}
+
+void setUp(void)
+{
+    lv_style_init(&style);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_style_reset(&style);
+}
+
+void test_style_should_keep_the_props_sorted(void)
+{
+    uint32_t i;
+    for(i = 0; i < PROP_CNT; i++) {
+        lv_style_value_t v = {.num = (int32_t)i + 100};
+        lv_style_set_prop(&style, props[i], v);
+    }
+    TEST_ASSERT_EQUAL(PROP_CNT, style.prop_cnt);
+    check_sorted();
+
+    /*Overwrite the values*/
+    for(i = 0; i < PROP_CNT; i++) {
+        lv_style_value_t v = {.num = (int32_t)i};
+        lv_style_set_prop(&style, props[i], v);
+    }
+    TEST_ASSERT_EQUAL(PROP_CNT, style.prop_cnt);
+
+    for(i = 0; i < PROP_CNT; i++) {
+        lv_style_value_t v;
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_style_get_prop(&style, props[i], &v));
+        TEST_ASSERT_EQUAL(i, v.num);
+    }
+
+    lv_style_value_t v;
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_style_get_prop(&style, LV_STYLE_PAD_BOTTOM, &v));
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_style_get_prop(&style, LV_STYLE_TEXT_FONT, &v));
+}
+
+void test_style_should_find_the_props_after_removing(void)
+{
+    uint32_t i;
+    for(i = 0; i < PROP_CNT; i++) {
+        lv_style_value_t v = {.num = (int32_t)i};
+        lv_style_set_prop(&style, props[i], v);
+    }
+
+    for(i = 0; i < PROP_CNT; i += 2) {
+        TEST_ASSERT_TRUE(lv_style_remove_prop(&style, props[i]));
+    }
+    TEST_ASSERT_EQUAL(PROP_CNT / 2, style.prop_cnt);
+    check_sorted();
+
+    for(i = 0; i < PROP_CNT; i++) {
+        lv_style_value_t v;
+        lv_res_t res = lv_style_get_prop(&style, props[i], &v);
+        if(i % 2) {
+            TEST_ASSERT_EQUAL(LV_RES_OK, res);
+            TEST_ASSERT_EQUAL(i, v.num);
+        }
+        else {
+            TEST_ASSERT_EQUAL(LV_RES_INV, res);
+        }
+    }
+
+    /*Add a smaller property to a style with one property*/
+    lv_style_reset(&style);
+    lv_style_set_radius(&style, 5);
+    lv_style_set_width(&style, 50);
+    check_sorted();
+
+    lv_style_value_t v;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_style_get_prop(&style, LV_STYLE_RADIUS, &v));
+    TEST_ASSERT_EQUAL(5, v.num);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_style_get_prop(&style, LV_STYLE_WIDTH, &v));
+    TEST_ASSERT_EQUAL(50, v.num);
+}
+
+static const lv_style_const_prop_t const_props[] = {
+    LV_STYLE_CONST_BG_OPA(LV_OPA_COVER),
+    LV_STYLE_CONST_RADIUS(12),
+    LV_STYLE_CONST_TEXT_LETTER_SPACE(3),
+    {.prop = LV_STYLE_PROP_INV},
+};
+
+LV_STYLE_CONST_INIT_GROUPS(const_style, const_props,
+                           LV_STYLE_PROP_GROUP_BIT(LV_STYLE_BG_OPA) |
+                           LV_STYLE_PROP_GROUP_BIT(LV_STYLE_RADIUS) |
+                           LV_STYLE_PROP_GROUP_BIT(LV_STYLE_TEXT_LETTER_SPACE));
+
+void test_style_should_skip_the_groups_of_const_styles(void)
+{
+    uint8_t groups = (1 << _lv_style_get_prop_group(LV_STYLE_BG_OPA)) |
+                     (1 << _lv_style_get_prop_group(LV_STYLE_RADIUS)) |
+                     (1 << _lv_style_get_prop_group(LV_STYLE_TEXT_LETTER_SPACE));
+    TEST_ASSERT_EQUAL(groups, const_style.has_group);
+    TEST_ASSERT_NOT_EQUAL(0xFF, const_style.has_group);
+
+    lv_style_value_t v;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_style_get_prop((lv_style_t *)&const_style, LV_STYLE_RADIUS, &v));
+    TEST_ASSERT_EQUAL(12, v.num);
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_style_get_prop((lv_style_t *)&const_style, LV_STYLE_LINE_WIDTH, &v));
+
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_add_style(obj, (lv_style_t *)&const_style, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL(12, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL(3, lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN));
+}
+
+static void refr_stats(lv_disp_refr_stats_t * stats)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    lv_disp_get_refr_stats(lv_disp_get_default(), stats);
+}
+
+void test_style_cache_should_resolve_less_on_a_theme_heavy_screen(void)
+{
+    uint32_t i;
+    for(i = 0; i < 8; i++) {
+        lv_obj_t * cont = lv_obj_create(lv_scr_act());
+        lv_obj_set_size(cont, 190, 230);
+        lv_obj_set_pos(cont, (i % 4) * 200, (i / 4) * 240);
+        lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+
+        lv_obj_t * btn = lv_btn_create(cont);
+        lv_label_set_text(lv_label_create(btn), "Button");
+        lv_slider_create(cont);
+        lv_switch_create(cont);
+        lv_checkbox_create(cont);
+        lv_bar_create(cont);
+        lv_dropdown_create(cont);
+    }
+
+    /*The first refresh updates the layouts too so leave it out*/
+    lv_refr_now(NULL);
+
+    /*Drop the style caches to resolve every property*/
+    lv_disp_refr_stats_t changed1;
+    lv_obj_report_style_change(NULL);
+    refr_stats(&changed1);
+
+    lv_disp_refr_stats_t changed2;
+    lv_obj_report_style_change(NULL);
+    refr_stats(&changed2);
+
+    /*Redraw with the cached values*/
+    lv_disp_refr_stats_t cached;
+    refr_stats(&cached);
+
+    /*The same style change needs the same properties every time*/
+    TEST_ASSERT_GREATER_THAN(0, changed1.style_lookup_cnt);
+    TEST_ASSERT_EQUAL(changed1.style_lookup_cnt, changed2.style_lookup_cnt);
+    TEST_ASSERT_EQUAL(changed1.style_resolve_cnt, changed2.style_resolve_cnt);
+
+#if LV_OBJ_STYLE_CACHE_SIZE
+    TEST_ASSERT_LESS_THAN(changed1.style_resolve_cnt, cached.style_resolve_cnt);
+#else
+    TEST_ASSERT_EQUAL(cached.style_lookup_cnt, cached.style_resolve_cnt);
+#endif
+}
 
 #endif
@@ -20,6 +20,7 @@
 #include "lv_drivers/indev/mouse.h"
 #include "lv_drivers/indev/keyboard.h"
 #include "lv_drivers/indev/mousewheel.h"
+#include "lv_drivers/loop/epoll_loop.h"
 
 /*********************
  *      DEFINES
@@ -33,7 +34,6 @@
  *  STATIC PROTOTYPES
  **********************/
 static void hal_init(void);
-static int tick_thread(void *data);
 
 /**********************
  *  STATIC VARIABLES
@@ -99,9 +99,14 @@ int main(int argc, char **argv)
     // lv_demo_widgets();
     lv_example_ffmpeg_2();
 
+  /* Call the lv_timer handler when a timer is due or something happened,
+   * and sleep in between instead of polling.*/
+  if(epoll_loop_init()) {
+      epoll_loop_run();
+  }
+
+  /* Without epoll periodically call the lv_timer handler as before.*/
   while(1) {
-      /* Periodically call the lv_task handler.
-       * It could be done in a timer interrupt or an OS task too.*/
       lv_timer_handler();
       usleep(5 * 1000);
   }
@@ -120,11 +125,8 @@ int main(int argc, char **argv)
 static void hal_init(void)
 {
   /* Use the 'monitor' driver which creates window on PC's monitor to simulate a display*/
+  /* It also starts a thread calling 'lv_tick_inc()'*/
   monitor_init();
-  /* Tick init.
-   * You have to call 'lv_tick_inc()' in periodically to inform LittelvGL about
-   * how much time were elapsed Create an SDL thread to do this*/
-  SDL_CreateThread(tick_thread, "tick", NULL);
 
   /*Create a display buffer*/
   static lv_disp_draw_buf_t disp_buf1;
@@ -182,19 +184,3 @@ static void hal_init(void)
   lv_img_set_src(cursor_obj, &mouse_cursor_icon);           /*Set the image source*/
   lv_indev_set_cursor(mouse_indev, cursor_obj);             /*Connect the image  object to the driver*/
 }
-
-/**
- * A task to measure the elapsed time for LVGL
- * @param data unused
- * @return never return
- */
-static int tick_thread(void *data) {
-    (void)data;
-
-    while(1) { 
-        SDL_Delay(5);
-        lv_tick_inc(5); /*Tell LittelvGL that 5 milliseconds were elapsed*/
-    }
-
-    return 0;
-}